@@ -141,6 +141,15 @@ private:
       return fFunc->EvalPar(x,p);
    }
 
+   /// evaluate function at n points in one go (see TF1::EvalParArray)
+   void DoEvalParArray (unsigned int n, const double * x, double * result, const double * p ) const {
+      if (int(fDim) == fFunc->GetNdim() ) {
+         fFunc->EvalParArray(n, x, result, p);
+         return;
+      }
+      for (unsigned int i = 0; i < n; ++i) result[i] = DoEvalPar(x + i*fDim, p);
+   }
+
    /// evaluate function using the cached parameter values (of TF1)
    /// re-implement for better efficiency
    double DoEval (const double* x) const { 
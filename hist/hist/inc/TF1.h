@@ -190,6 +190,7 @@ protected:
    void DoInitialize();
 
    void IntegrateForNormalization();
+   void ComputeHalfBinIntegrals(Double_t xmin, Double_t dx, Bool_t logbin, std::vector<Double_t> &halfInteg);
 
    virtual Double_t GetMinMaxNDim(Double_t * x , Bool_t findmax, Double_t epsilon = 0, Int_t maxiter = 0) const;
    virtual void GetRange(Double_t * xmin, Double_t * xmax) const;
@@ -323,6 +324,7 @@ public:
    virtual void     DrawF1(Double_t xmin, Double_t xmax, Option_t *option="");
    virtual Double_t Eval(Double_t x, Double_t y=0, Double_t z=0, Double_t t=0) const;
    virtual Double_t EvalPar(const Double_t *x, const Double_t *params=0);
+   virtual void     EvalParArray(Int_t n, const Double_t *x, Double_t *result, const Double_t *params=0);
    virtual Double_t operator()(Double_t x, Double_t y=0, Double_t z = 0, Double_t t = 0) const;
    virtual Double_t operator()(const Double_t *x, const Double_t *params=0);
    virtual void     ExecuteEvent(Int_t event, Int_t px, Int_t py);
@@ -385,6 +387,7 @@ public:
    TAxis           *GetYaxis() const ;
    TAxis           *GetZaxis() const ;
    virtual Double_t GetVariable(const TString &name) { return (fFormula) ? fFormula->GetVariable(name) : 0;}
+   virtual Bool_t   GenerateGradientPar();
    virtual Double_t GradientPar(Int_t ipar, const Double_t *x, Double_t eps=0.01);
    virtual void     GradientPar(const Double_t *x, Double_t *grad, Double_t eps=0.01);
    virtual void     InitArgs(const Double_t *x, const Double_t *params);
@@ -403,6 +406,7 @@ public:
    virtual Bool_t   IsEvalNormalized() const { return fNormalized; }
    /// return kTRUE if the point is inside the function range
    virtual Bool_t   IsInside(const Double_t *x) const { return !(  ( x[0] < fXmin) || ( x[0] > fXmax ) ); }
+   virtual Bool_t   HasGeneratedGradient() const { return (fFormula && !fNormalized) ? fFormula->HasGeneratedGradient() : false; }
    virtual Bool_t   IsLinear() const { return (fFormula) ? fFormula->IsLinear() : false;}
    virtual Bool_t   IsValid() const;
    virtual void     Print(Option_t *option="") const;
@@ -102,6 +102,8 @@ private:
    TString           fClingName;     //! unique name passed to Cling to define the function ( double clingName(double*x, double*p) )
 
    TInterpreter::CallFuncIFacePtr_t::Generic_t fFuncPtr;   //!  function pointer
+   TInterpreter::CallFuncIFacePtr_t::Generic_t fGradFuncPtr = nullptr;   //!  pointer to the function computing the parameter gradient
+   mutable TInterpreter::CallFuncIFacePtr_t::Generic_t fArrayFuncPtr = nullptr;   //!  pointer to the function evaluating arrays of points
    void *   fLambdaPtr;                                    //!  pointer to the lambda function
 
    void     InputFormulaIntoCling();
@@ -141,6 +143,7 @@ protected:
    void   SetPredefinedParamNames(); 
 
    Double_t       DoEval(const Double_t * x, const Double_t * p = nullptr) const;
+   Bool_t         InitArrayEval() const;
 
 public:
 
@@ -169,6 +172,10 @@ public:
    Double_t       Eval(Double_t x, Double_t y , Double_t z) const;
    Double_t       Eval(Double_t x, Double_t y , Double_t z , Double_t t ) const;
    Double_t       EvalPar(const Double_t *x, const Double_t *params=0) const;
+   void           EvalParArray(Int_t n, const Double_t *x, Double_t *result, const Double_t *params=0) const;
+   Bool_t         GenerateGradientPar();
+   void           GradientPar(const Double_t *x, Double_t *grad, const Double_t *params=0) const;
+   Bool_t         HasGeneratedGradient() const { return fGradFuncPtr != nullptr; }
    TString        GetExpFormula(Option_t *option="") const;
    const TObject *GetLinearPart(Int_t i) const;
    Int_t          GetNdim() const {return fNdim;}
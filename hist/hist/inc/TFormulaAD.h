@@ -0,0 +1,215 @@
+// @(#)root/hist:$Id$
+// Author: L. Moneta   2016
+
+/*************************************************************************
+ * Copyright (C) 1995-2016, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TFormulaAD
+#define ROOT_TFormulaAD
+
+#include <cmath>
+
+namespace ROOT {
+
+namespace Internal {
+
+/**
+   Forward-mode automatic differentiation used by TFormula::GenerateGradientPar.
+
+   The expression of a TFormula is compiled a second time by Cling with the
+   parameters declared as Dual<N>, a number carrying its value and its N
+   derivatives with respect to the formula parameters. One evaluation of the
+   compiled code returns the value and the full parameter gradient.
+   The TMath functions used in a formula are mapped to the functions of this
+   namespace, which are defined for both double and Dual arguments.
+*/
+
+namespace TFormulaAD {
+
+template<unsigned int N>
+struct Dual {
+   double fV;      // value
+   double fD[N];   // derivatives with respect to the parameters
+
+   Dual() : fV(0) { for (unsigned int i = 0; i < N; ++i) fD[i] = 0; }
+   Dual(double v) : fV(v) { for (unsigned int i = 0; i < N; ++i) fD[i] = 0; }
+   /// seed the variable corresponding to the parameter ipar
+   Dual(double v, unsigned int ipar) : fV(v) {
+      for (unsigned int i = 0; i < N; ++i) fD[i] = 0;
+      fD[ipar] = 1;
+   }
+
+   /// chain rule: return f(this) given f and df/dx at the value
+   Dual Apply(double f, double df) const {
+      Dual r(f);
+      for (unsigned int i = 0; i < N; ++i) r.fD[i] = df * fD[i];
+      return r;
+   }
+
+   Dual & operator+=(const Dual &rhs) { fV += rhs.fV; for (unsigned int i = 0; i < N; ++i) fD[i] += rhs.fD[i]; return *this; }
+   Dual & operator-=(const Dual &rhs) { fV -= rhs.fV; for (unsigned int i = 0; i < N; ++i) fD[i] -= rhs.fD[i]; return *this; }
+   Dual & operator*=(const Dual &rhs) {
+      for (unsigned int i = 0; i < N; ++i) fD[i] = fD[i] * rhs.fV + fV * rhs.fD[i];
+      fV *= rhs.fV;
+      return *this;
+   }
+   Dual & operator/=(const Dual &rhs) {
+      double inv = 1. / rhs.fV;
+      fV *= inv;
+      for (unsigned int i = 0; i < N; ++i) fD[i] = (fD[i] - fV * rhs.fD[i]) * inv;
+      return *this;
+   }
+   Dual & operator+=(double rhs) { fV += rhs; return *this; }
+   Dual & operator-=(double rhs) { fV -= rhs; return *this; }
+   Dual & operator*=(double rhs) { fV *= rhs; for (unsigned int i = 0; i < N; ++i) fD[i] *= rhs; return *this; }
+   Dual & operator/=(double rhs) { return (*this) *= (1. / rhs); }
+};
+
+// value of a number or of a dual number (used for comparisons and non-differentiable functions)
+inline double Value(double x) { return x; }
+template<unsigned int N> inline double Value(const Dual<N> &x) { return x.fV; }
+
+// arithmetic operators
+template<unsigned int N> inline Dual<N> operator+(const Dual<N> &a) { return a; }
+template<unsigned int N> inline Dual<N> operator-(const Dual<N> &a) { return a.Apply(-a.fV, -1.); }
+template<unsigned int N> inline Dual<N> operator+(Dual<N> a, const Dual<N> &b) { return a += b; }
+template<unsigned int N> inline Dual<N> operator+(Dual<N> a, double b) { return a += b; }
+template<unsigned int N> inline Dual<N> operator+(double a, Dual<N> b) { return b += a; }
+template<unsigned int N> inline Dual<N> operator-(Dual<N> a, const Dual<N> &b) { return a -= b; }
+template<unsigned int N> inline Dual<N> operator-(Dual<N> a, double b) { return a -= b; }
+template<unsigned int N> inline Dual<N> operator-(double a, const Dual<N> &b) { Dual<N> r = -b; return r += a; }
+template<unsigned int N> inline Dual<N> operator*(Dual<N> a, const Dual<N> &b) { return a *= b; }
+template<unsigned int N> inline Dual<N> operator*(Dual<N> a, double b) { return a *= b; }
+template<unsigned int N> inline Dual<N> operator*(double a, Dual<N> b) { return b *= a; }
+template<unsigned int N> inline Dual<N> operator/(Dual<N> a, const Dual<N> &b) { return a /= b; }
+template<unsigned int N> inline Dual<N> operator/(Dual<N> a, double b) { return a /= b; }
+template<unsigned int N> inline Dual<N> operator/(double a, const Dual<N> &b) { return b.Apply(a / b.fV, -a / (b.fV * b.fV)); }
+
+// comparisons and logical operators act on the values
+#define TFORMULAAD_COMPARISON(OP)                                                                     \
+   template<unsigned int N> inline bool operator OP(const Dual<N> &a, const Dual<N> &b) { return a.fV OP b.fV; } \
+   template<unsigned int N> inline bool operator OP(const Dual<N> &a, double b) { return a.fV OP b; }            \
+   template<unsigned int N> inline bool operator OP(double a, const Dual<N> &b) { return a OP b.fV; }
+TFORMULAAD_COMPARISON(<)
+TFORMULAAD_COMPARISON(>)
+TFORMULAAD_COMPARISON(<=)
+TFORMULAAD_COMPARISON(>=)
+TFORMULAAD_COMPARISON(==)
+TFORMULAAD_COMPARISON(!=)
+TFORMULAAD_COMPARISON(&&)
+TFORMULAAD_COMPARISON(||)
+#undef TFORMULAAD_COMPARISON
+template<unsigned int N> inline bool operator!(const Dual<N> &a) { return !a.fV; }
+
+// functions of TMath supported in the differentiated formulae (see TFormula::GenerateGradientPar)
+inline double Sin(double x) { return std::sin(x); }
+inline double Cos(double x) { return std::cos(x); }
+inline double Tan(double x) { return std::tan(x); }
+inline double Exp(double x) { return std::exp(x); }
+inline double Log(double x) { return std::log(x); }
+inline double Log10(double x) { return std::log10(x); }
+inline double SinH(double x) { return std::sinh(x); }
+inline double CosH(double x) { return std::cosh(x); }
+inline double TanH(double x) { return std::tanh(x); }
+inline double ASin(double x) { return std::asin(x); }
+inline double ACos(double x) { return std::acos(x); }
+inline double ATan(double x) { return std::atan(x); }
+inline double ATan2(double y, double x) { return std::atan2(y, x); }
+inline double Sqrt(double x) { return std::sqrt(x); }
+inline double Sq(double x) { return x * x; }
+inline double Abs(double x) { return std::fabs(x); }
+inline double Ceil(double x) { return std::ceil(x); }
+inline double Floor(double x) { return std::floor(x); }
+inline double Power(double x, double y) { return std::pow(x, y); }
+inline double Min(double x, double y) { return (x <= y) ? x : y; }
+inline double Max(double x, double y) { return (x >= y) ? x : y; }
+inline double Sign(double a, double b) { return (b >= 0) ? std::fabs(a) : -std::fabs(a); }
+inline double Erf(double x) { return std::erf(x); }
+inline double Erfc(double x) { return std::erfc(x); }
+inline double Gaus(double x, double mean = 0, double sigma = 1, bool norm = false) {
+   if (sigma == 0) return 1.e30;
+   double arg = (x - mean) / sigma;
+   double res = std::exp(-0.5 * arg * arg);
+   return (norm) ? res / (2.50662827463100024 * sigma) : res; // sqrt(2*Pi)
+}
+
+template<unsigned int N> inline Dual<N> Sin(const Dual<N> &x) { return x.Apply(std::sin(x.fV), std::cos(x.fV)); }
+template<unsigned int N> inline Dual<N> Cos(const Dual<N> &x) { return x.Apply(std::cos(x.fV), -std::sin(x.fV)); }
+template<unsigned int N> inline Dual<N> Tan(const Dual<N> &x) { double t = std::tan(x.fV); return x.Apply(t, 1. + t * t); }
+template<unsigned int N> inline Dual<N> Exp(const Dual<N> &x) { double e = std::exp(x.fV); return x.Apply(e, e); }
+template<unsigned int N> inline Dual<N> Log(const Dual<N> &x) { return x.Apply(std::log(x.fV), 1. / x.fV); }
+template<unsigned int N> inline Dual<N> Log10(const Dual<N> &x) { return x.Apply(std::log10(x.fV), 0.43429448190325182 / x.fV); }
+template<unsigned int N> inline Dual<N> SinH(const Dual<N> &x) { return x.Apply(std::sinh(x.fV), std::cosh(x.fV)); }
+template<unsigned int N> inline Dual<N> CosH(const Dual<N> &x) { return x.Apply(std::cosh(x.fV), std::sinh(x.fV)); }
+template<unsigned int N> inline Dual<N> TanH(const Dual<N> &x) { double t = std::tanh(x.fV); return x.Apply(t, 1. - t * t); }
+template<unsigned int N> inline Dual<N> ASin(const Dual<N> &x) { return x.Apply(std::asin(x.fV), 1. / std::sqrt(1. - x.fV * x.fV)); }
+template<unsigned int N> inline Dual<N> ACos(const Dual<N> &x) { return x.Apply(std::acos(x.fV), -1. / std::sqrt(1. - x.fV * x.fV)); }
+template<unsigned int N> inline Dual<N> ATan(const Dual<N> &x) { return x.Apply(std::atan(x.fV), 1. / (1. + x.fV * x.fV)); }
+template<unsigned int N> inline Dual<N> Sqrt(const Dual<N> &x) { double s = std::sqrt(x.fV); return x.Apply(s, 0.5 / s); }
+template<unsigned int N> inline Dual<N> Sq(const Dual<N> &x) { return x * x; }
+template<unsigned int N> inline Dual<N> Abs(const Dual<N> &x) { return (x.fV >= 0) ? x : -x; }
+template<unsigned int N> inline Dual<N> Ceil(const Dual<N> &x) { return Dual<N>(std::ceil(x.fV)); }
+template<unsigned int N> inline Dual<N> Floor(const Dual<N> &x) { return Dual<N>(std::floor(x.fV)); }
+template<unsigned int N> inline Dual<N> Erf(const Dual<N> &x) { return x.Apply(std::erf(x.fV), 1.12837916709551257 * std::exp(-x.fV * x.fV)); }
+template<unsigned int N> inline Dual<N> Erfc(const Dual<N> &x) { return x.Apply(std::erfc(x.fV), -1.12837916709551257 * std::exp(-x.fV * x.fV)); }
+
+template<unsigned int N> inline Dual<N> ATan2(const Dual<N> &y, const Dual<N> &x) {
+   double r2 = x.fV * x.fV + y.fV * y.fV;
+   Dual<N> r(std::atan2(y.fV, x.fV));
+   for (unsigned int i = 0; i < N; ++i) r.fD[i] = (x.fV * y.fD[i] - y.fV * x.fD[i]) / r2;
+   return r;
+}
+template<unsigned int N> inline Dual<N> ATan2(const Dual<N> &y, double x) { return ATan2(y, Dual<N>(x)); }
+template<unsigned int N> inline Dual<N> ATan2(double y, const Dual<N> &x) { return ATan2(Dual<N>(y), x); }
+
+template<unsigned int N> inline Dual<N> Power(const Dual<N> &x, double y) {
+   double p = std::pow(x.fV, y);
+   return x.Apply(p, (y == 0) ? 0. : y * std::pow(x.fV, y - 1.));
+}
+template<unsigned int N> inline Dual<N> Power(double x, const Dual<N> &y) {
+   double p = std::pow(x, y.fV);
+   return y.Apply(p, p * std::log(x));
+}
+template<unsigned int N> inline Dual<N> Power(const Dual<N> &x, const Dual<N> &y) {
+   double p = std::pow(x.fV, y.fV);
+   double dx = (y.fV == 0) ? 0. : y.fV * std::pow(x.fV, y.fV - 1.);
+   double dy = (x.fV > 0) ? p * std::log(x.fV) : 0.;
+   Dual<N> r(p);
+   for (unsigned int i = 0; i < N; ++i) r.fD[i] = dx * x.fD[i] + dy * y.fD[i];
+   return r;
+}
+// pow is the name used by TFormula for the ^ operator (found for Dual by argument dependent lookup)
+template<unsigned int N> inline Dual<N> pow(const Dual<N> &x, double y) { return Power(x, y); }
+template<unsigned int N> inline Dual<N> pow(double x, const Dual<N> &y) { return Power(x, y); }
+template<unsigned int N> inline Dual<N> pow(const Dual<N> &x, const Dual<N> &y) { return Power(x, y); }
+
+template<class A, class B> inline auto Min(const A &x, const B &y) -> decltype(x + y) { return (Value(x) <= Value(y)) ? decltype(x + y)(x) : decltype(x + y)(y); }
+template<class A, class B> inline auto Max(const A &x, const B &y) -> decltype(x + y) { return (Value(x) >= Value(y)) ? decltype(x + y)(x) : decltype(x + y)(y); }
+template<class A, class B> inline auto Sign(const A &a, const B &b) -> decltype(a + b) {
+   decltype(a + b) absa = (Value(a) >= 0) ? decltype(a + b)(a) : decltype(a + b)(-a);
+   return (Value(b) >= 0) ? absa : -absa;
+}
+
+template<class X, class M, class S>
+inline auto Gaus(const X &x, const M &mean, const S &sigma, bool norm = false) -> decltype(x + mean + sigma) {
+   typedef decltype(x + mean + sigma) R;
+   if (Value(sigma) == 0) return R(1.e30);
+   R arg = (R(x) - mean) / sigma;
+   R res = Exp(-0.5 * arg * arg);
+   return (norm) ? res / (2.50662827463100024 * R(sigma)) : res;
+}
+template<class X, class M>
+inline auto Gaus(const X &x, const M &mean) -> decltype(x + mean) { return Gaus(x, mean, 1.); }
+
+} // namespace TFormulaAD
+
+} // namespace Internal
+
+} // namespace ROOT
+
+#endif
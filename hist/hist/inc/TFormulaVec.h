@@ -0,0 +1,62 @@
+// @(#)root/hist:$Id$
+// Author: L. Moneta   2016
+
+/*************************************************************************
+ * Copyright (C) 1995-2016, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TFormulaVec
+#define ROOT_TFormulaVec
+
+#include <cmath>
+
+// use the fast and vectorisable functions of VDT when they are installed
+#if defined(__has_include)
+#if __has_include("vdt/vdtMath.h")
+#include "vdt/vdtMath.h"
+#define R__TFORMULA_HAS_VDT
+#endif
+#endif
+
+namespace ROOT {
+
+namespace Internal {
+
+/**
+   Mathematical functions used in the code evaluating a TFormula on arrays of
+   points (see TFormula::EvalParArray).
+
+   When VDT is available the exponential and the trigonometric functions are
+   replaced by the inline VDT implementations, which allow the compiler to
+   vectorise the loop on the points. The other functions, for which VDT does
+   not return the same values outside the function domain (e.g. the logarithm
+   of a negative number), are the standard ones.
+*/
+
+namespace TFormulaVec {
+
+#ifdef R__TFORMULA_HAS_VDT
+inline double Exp(double x) { return vdt::fast_exp(x); }
+inline double Sin(double x) { return vdt::fast_sin(x); }
+inline double Cos(double x) { return vdt::fast_cos(x); }
+inline double ATan(double x) { return vdt::fast_atan(x); }
+inline double ATan2(double y, double x) { return vdt::fast_atan2(y, x); }
+#else
+inline double Exp(double x) { return std::exp(x); }
+inline double Sin(double x) { return std::sin(x); }
+inline double Cos(double x) { return std::cos(x); }
+inline double ATan(double x) { return std::atan(x); }
+inline double ATan2(double y, double x) { return std::atan2(y, x); }
+#endif
+
+} // namespace TFormulaVec
+
+} // namespace Internal
+
+} // namespace ROOT
+
+#endif
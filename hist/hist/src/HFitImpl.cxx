@@ -233,6 +233,8 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
 
    // set the fit function
    // if option grad is specified use gradient
+   // (for formula based functions the compiled gradient code is generated)
+   if (fitOption.Gradient && !linear && f1->GetFormula() && !f1->IsEvalNormalized()) f1->GenerateGradientPar();
    if ( (linear || fitOption.Gradient) )
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*f1) );
    else
@@ -816,6 +818,7 @@ TFitResultPtr ROOT::Fit::UnBinFit(ROOT::Fit::UnBinData * data, TF1 * fitfunc, Fo
    // need to create a wrapper for an automatic  normalized TF1 ???
    if ( fitOption.Gradient ) {
       assert ( (int) dim == fitfunc->GetNdim() );
+      if (fitfunc->GetFormula() && !fitfunc->IsEvalNormalized()) fitfunc->GenerateGradientPar();
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*fitfunc) );
    }
    else
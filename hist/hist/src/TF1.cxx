@@ -1257,6 +1257,38 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of this function at n points.
+///
+/// The coordinates of the points are stored contiguously in the array x:
+/// the coordinate j of the point i is x[i*GetNdim()+j]. The n values are
+/// written in the array result, which must be allocated by the caller.
+/// If argument params is omitted or equal 0, the internal values
+/// of parameters (array fParams) will be used instead.
+///
+/// For a function defined by a formula the whole array is evaluated with a
+/// single call of the code compiled by Cling (see TFormula::EvalParArray),
+/// which is much faster than calling EvalPar for each point. For the other
+/// function types the points are evaluated one by one.
+
+void TF1::EvalParArray(Int_t n, const Double_t *x, Double_t *result, const Double_t *params)
+{
+   if (n <= 0) return;
+   if (fType == 0 && fFormula && fFormula->GetNdim() == fNdim) {
+      fFormula->EvalParArray(n, x, result, params);
+      if (fNormalized && fNormIntegral != 0) {
+         for (Int_t i = 0; i < n; ++i) result[i] /= fNormIntegral;
+      }
+      return;
+   }
+   for (Int_t i = 0; i < n; ++i) {
+      const Double_t *xx = x + i*fNdim;
+      if (fType == 2) InitArgs(xx, params);
+      result[i] = EvalPar(xx, params);
+   }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -1774,6 +1806,65 @@ Int_t TF1::GetQuantiles(Int_t nprobSum, Double_t *q, const Double_t *probSum)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the integrals of the function on the 2*fNpx half bins used by
+/// GetRandom, starting at xmin with bin width dx (in log10 scale if logbin).
+///
+/// Each half bin is integrated with the 8 and the 16 point Gauss-Legendre
+/// rules and the function is evaluated at all the sampling points with a
+/// single call to EvalParArray. When the two rules do not agree (e.g. for a
+/// peak narrower than a half bin) the adaptive integration is used for that
+/// half bin. The vector is left empty if the function cannot be evaluated
+/// on arrays faster than point by point.
+
+void TF1::ComputeHalfBinIntegrals(Double_t xmin, Double_t dx, Bool_t logbin, std::vector<Double_t> &halfInteg)
+{
+   halfInteg.clear();
+   if (fType != 0 || !fFormula || fFormula->GetNdim() != 1 || fNpx <= 0 || fgAbsValue) return;
+
+   const Int_t n1 = 8;
+   const Int_t n2 = 16;
+   const Int_t npts = n1 + n2;
+   Double_t xgl[npts], wgl[npts];
+   CalcGaussLegendreSamplingPoints(n1, xgl, wgl, 1.E-15);
+   CalcGaussLegendreSamplingPoints(n2, xgl+n1, wgl+n1, 1.E-15);
+
+   const Int_t nhalf = 2*fNpx;
+   std::vector<Double_t> xlow(nhalf+1);
+   for (Int_t i = 0; i <= nhalf; ++i) {
+      xlow[i] = (i < nhalf) ? xmin + 0.5*i*dx : xmin + fNpx*dx;
+      if (logbin) xlow[i] = TMath::Power(10,xlow[i]);
+   }
+   std::vector<Double_t> xeval(nhalf*npts);
+   std::vector<Double_t> feval(nhalf*npts);
+   for (Int_t i = 0; i < nhalf; ++i) {
+      Double_t xc = 0.5*(xlow[i] + xlow[i+1]);
+      Double_t hw = 0.5*(xlow[i+1] - xlow[i]);
+      for (Int_t k = 0; k < npts; ++k) xeval[i*npts+k] = xc + hw*xgl[k];
+   }
+   EvalParArray(nhalf*npts, xeval.data(), feval.data(), GetParameters());
+
+   halfInteg.resize(nhalf);
+   std::vector<Double_t> lowOrder(nhalf);
+   Double_t total = 0;
+   for (Int_t i = 0; i < nhalf; ++i) {
+      Double_t hw = 0.5*(xlow[i+1] - xlow[i]);
+      const Double_t *f = &feval[i*npts];
+      Double_t sum1 = 0, sum2 = 0;
+      for (Int_t k = 0; k < n1; ++k) sum1 += wgl[k]*f[k];
+      for (Int_t k = n1; k < npts; ++k) sum2 += wgl[k]*f[k];
+      lowOrder[i] = sum1*hw;
+      halfInteg[i] = sum2*hw;
+      total += TMath::Abs(halfInteg[i]);
+   }
+   for (Int_t i = 0; i < nhalf; ++i) {
+      Double_t tol = 1.E-8*TMath::Abs(halfInteg[i]) + 1.E-12*total;
+      if (!(TMath::Abs(halfInteg[i] - lowOrder[i]) <= tol) )
+         halfInteg[i] = Integral(xlow[i], xlow[i+1]);
+   }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return a random number following this function shape
 ///
@@ -1824,8 +1915,13 @@ Double_t TF1::GetRandom()
             xx[i] = xmin +i*dx;
       }
       xx[fNpx] = xmax;
+      // integrals of the two halves of each bin
+      std::vector<Double_t> halfInteg;
+      if (fType == 0 && fNdim == 1) ComputeHalfBinIntegrals(xmin, dx, logbin, halfInteg);
       for (i=0;i<fNpx;i++) {
-         if (logbin) {
+         if (!halfInteg.empty()) {
+            integ = halfInteg[2*i] + halfInteg[2*i+1];
+         } else if (logbin) {
             integ = Integral(TMath::Power(10,xx[i]), TMath::Power(10,xx[i+1]));
          } else {
             integ = Integral(xx[i],xx[i+1]);
@@ -1852,7 +1948,8 @@ Double_t TF1::GetRandom()
       for (i=0;i<fNpx;i++) {
          x0 = xx[i];
          r2 = fIntegral[i+1] - fIntegral[i];
-         if (logbin) r1 = Integral(TMath::Power(10,x0),TMath::Power(10,x0+0.5*dx))/total;
+         if (!halfInteg.empty()) r1 = halfInteg[2*i]/total;
+         else if (logbin) r1 = Integral(TMath::Power(10,x0),TMath::Power(10,x0+0.5*dx))/total;
          else        r1 = Integral(x0,x0+0.5*dx)/total;
          r3 = 2*r2 - 4*r1;
          if (TMath::Abs(r3) > 1e-8) fGamma[i] = r3/(dx*dx);
@@ -1920,8 +2017,12 @@ Double_t TF1::GetRandom(Double_t xmin, Double_t xmax)
       Double_t integ;
       Int_t intNegative = 0;
       Int_t i;
+      // integrals of the two halves of each bin
+      std::vector<Double_t> halfInteg;
+      if (fType == 0 && fNdim == 1) ComputeHalfBinIntegrals(fXmin, dx, kFALSE, halfInteg);
       for (i=0;i<fNpx;i++) {
-         integ = Integral(Double_t(fXmin+i*dx), Double_t(fXmin+i*dx+dx));
+         if (!halfInteg.empty()) integ = halfInteg[2*i] + halfInteg[2*i+1];
+         else integ = Integral(Double_t(fXmin+i*dx), Double_t(fXmin+i*dx+dx));
          if (integ < 0) {intNegative++; integ = -integ;}
          fIntegral[i+1] = fIntegral[i] + integ;
       }
@@ -1943,7 +2044,8 @@ Double_t TF1::GetRandom(Double_t xmin, Double_t xmax)
       for (i=0;i<fNpx;i++) {
          x0 = fXmin+i*dx;
          r2 = fIntegral[i+1] - fIntegral[i];
-         r1 = Integral(x0,x0+0.5*dx)/total;
+         if (!halfInteg.empty()) r1 = halfInteg[2*i]/total;
+         else r1 = Integral(x0,x0+0.5*dx)/total;
          r3 = 2*r2 - 4*r1;
          if (TMath::Abs(r3) > 1e-8) fGamma[i] = r3/(dx*dx);
          else           fGamma[i] = 0;
@@ -2131,6 +2233,28 @@ TAxis *TF1::GetZaxis() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the compiled code computing the derivatives of the function with
+/// respect to its parameters (see TFormula::GenerateGradientPar).
+/// After a successful call GradientPar uses this code instead of the numerical
+/// differentiation, and so do the fits using the option "G".
+/// It is supported only for functions defined by a formula expression
+/// and which are not normalized.
+/// Return true if the gradient code is available.
+
+Bool_t TF1::GenerateGradientPar()
+{
+   if (!fFormula) {
+      Warning("GenerateGradientPar","Gradient code can be generated only for functions based on a formula expression");
+      return false;
+   }
+   if (fNormalized) {
+      Warning("GenerateGradientPar","Gradient code is not supported for normalized functions");
+      return false;
+   }
+   return fFormula->GenerateGradientPar();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Compute the gradient (derivative) wrt a parameter ipar
 ///
@@ -2149,6 +2273,15 @@ Double_t TF1::GradientPar(Int_t ipar, const Double_t *x, Double_t eps)
 {
    if (GetNpar() == 0) return 0;
 
+   if (HasGeneratedGradient()) {
+      Double_t al, bl;
+      ((TF1*)this)->GetParLimits(ipar,al,bl);
+      if (al*bl != 0 && al >= bl) return 0;
+      std::vector<Double_t> grad(GetNpar());
+      fFormula->GradientPar(x, grad.data());
+      return grad[ipar];
+   }
+
    if(eps< 1e-10 || eps > 1) {
       Warning("Derivative","parameter esp=%g out of allowed range[1e-10,1], reset to 0.01",eps);
       eps = 0.01;
@@ -2210,9 +2343,22 @@ Double_t TF1::GradientPar(Int_t ipar, const Double_t *x, Double_t eps)
 /// Method is the same as in Derivative() function
 ///
 /// If a parameter is fixed, the gradient on this parameter = 0
+///
+/// If the code computing the gradient has been generated (see
+/// TF1::GenerateGradientPar) it is used instead of the numerical differentiation
 
 void TF1::GradientPar(const Double_t *x, Double_t *grad, Double_t eps)
 {
+   if (HasGeneratedGradient()) {
+      fFormula->GradientPar(x, grad);
+      for (Int_t ipar=0; ipar< GetNpar(); ipar++){
+         Double_t al, bl;
+         GetParLimits(ipar,al,bl);
+         if (al*bl != 0 && al >= bl) grad[ipar] = 0;
+      }
+      return;
+   }
+
    if(eps< 1e-10 || eps > 1) {
       Warning("Derivative","parameter esp=%g out of allowed range[1e-10,1], reset to 0.01",eps);
       eps = 0.01;
@@ -2762,7 +2908,6 @@ void TF1::Paint(Option_t *option)
 TH1 *  TF1::DoCreateHistogram(Double_t xmin, Double_t  xmax, Bool_t recreate)
 {
    Int_t i;
-   Double_t xv[1];
 
    TH1 * histogram = 0;
 
@@ -2823,11 +2968,12 @@ TH1 *  TF1::DoCreateHistogram(Double_t xmin, Double_t  xmax, Bool_t recreate)
    histogram->GetYaxis()->SetTitle(ytitle.Data());
    Double_t *parameters = GetParameters();
 
-   InitArgs(xv,parameters);
-   for (i=1;i<=fNpx;i++) {
-      xv[0] = histogram->GetBinCenter(i);
-      histogram->SetBinContent(i,EvalPar(xv,parameters));
-   }
+   // evaluate the function at all the bin centers in one go
+   std::vector<Double_t> xcenters(fNpx);
+   std::vector<Double_t> values(fNpx);
+   for (i=1;i<=fNpx;i++) xcenters[i-1] = histogram->GetBinCenter(i);
+   EvalParArray(fNpx, xcenters.data(), values.data(), parameters);
+   for (i=1;i<=fNpx;i++) histogram->SetBinContent(i,values[i-1]);
 
    // Copy Function attributes to histogram attributes.
    histogram->SetBit(TH1::kNoStats);
@@ -147,6 +147,10 @@ static const TString gNamePrefix = "TFormula__";
 // static map of function pointers and expressions
 //static std::unordered_map<std::string,  TInterpreter::CallFuncIFacePtr_t::Generic_t> gClingFunctions = std::unordered_map<TString,  TInterpreter::CallFuncIFacePtr_t::Generic_t>();
 static std::unordered_map<std::string,  void *> gClingFunctions = std::unordered_map<std::string,  void * >();
+// static map of the function pointers computing the parameter gradients, keyed by the expression
+static std::unordered_map<std::string,  void *> gClingGradFunctions = std::unordered_map<std::string,  void * >();
+// static map of the function pointers evaluating arrays of points, keyed by the expression and the dimension
+static std::unordered_map<std::string,  void *> gClingArrayFunctions = std::unordered_map<std::string,  void * >();
 
 Bool_t TFormula::IsOperator(const char c)
 {
@@ -587,6 +591,8 @@ void TFormula::Copy(TObject &obj) const
    }
 
    fnew.fFuncPtr = fFuncPtr;
+   fnew.fGradFuncPtr = fGradFuncPtr;
+   fnew.fArrayFuncPtr = fArrayFuncPtr;
 
 }
 
@@ -598,6 +604,8 @@ void TFormula::Clear(Option_t * )
    fNumber = 0;
    fFormula = "";
    fClingName = "";
+   fGradFuncPtr = nullptr;
+   fArrayFuncPtr = nullptr;
 
 
    if(fMethod) fMethod->Delete();
@@ -1830,6 +1838,8 @@ void TFormula::ProcessFormula(TString &formula)
          // set the cling name using hash of the static formulae map
          auto hasher = gClingFunctions.hash_function();
          fClingName = TString::Format("%s__id%zu",gNamePrefix.Data(), hasher(inputFormula) );
+         fGradFuncPtr = nullptr;
+         fArrayFuncPtr = nullptr;
 
          fClingInput = TString::Format("Double_t %s(%s){ return %s ; }", fClingName.Data(),argumentsPrototype.Data(),inputFormula.c_str());
 
@@ -2513,6 +2523,221 @@ Double_t TFormula::EvalPar(const Double_t *x,const Double_t *params) const
 
    return DoEval(x, params);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check that all the functions called in the Cling expression can be
+/// differentiated by the code generated in GenerateGradientPar, i.e. they are
+/// TMath functions implemented in the namespace ROOT::Internal::TFormulaAD
+
+static Bool_t IsDifferentiableExpression(const TString & expr, TString & badFunc)
+{
+   static const char * supported[] = { "Sin", "Cos", "Tan", "Exp", "Log", "Log10", "SinH", "CosH", "TanH",
+                                       "ASin", "ACos", "ATan", "ATan2", "Sqrt", "Sq", "Abs", "Ceil", "Floor",
+                                       "Power", "Min", "Max", "Sign", "Erf", "Erfc", "Gaus" };
+   int i = 0;
+   int len = expr.Length();
+   while (i < len) {
+      if (!isalpha(expr[i]) && expr[i] != '_') { ++i; continue; }
+      int j = i;
+      while (j < len && (isalnum(expr[j]) || expr[j] == '_' || expr[j] == ':') ) ++j;
+      TString name = expr(i, j-i);
+      int k = j;
+      while (k < len && isspace(expr[k]) ) ++k;
+      if (k < len && expr[k] == '(') {
+         Bool_t ok = (name == "pow");
+         if (!ok && name.BeginsWith("TMath::")) {
+            TString tmathName = name(7, name.Length()-7);
+            for (auto fname : supported) {
+               if (tmathName == fname) { ok = true; break; }
+            }
+         }
+         if (!ok) {
+            badFunc = name;
+            return false;
+         }
+      }
+      i = j;
+   }
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate with Cling the code computing the derivatives of the formula with
+/// respect to all its parameters.
+///
+/// The expression is compiled a second time with the parameters declared as
+/// dual numbers (forward-mode automatic differentiation, see TFormulaAD.h),
+/// so that a single call of the compiled code returns the full gradient,
+/// instead of the 2*npar evaluations needed by numerical differentiation.
+/// Only formulae using the usual mathematical functions (sin, exp, log, pow,
+/// sqrt, TMath::Gaus,...) can be differentiated. The generated code is shared
+/// by all the formulae with the same expression and number of parameters.
+/// Return true if the gradient code is available.
+
+Bool_t TFormula::GenerateGradientPar()
+{
+   if (fGradFuncPtr) return true;
+   if (!IsValid() || fNpar <= 0 || TestBit(TFormula::kLambda) ) return false;
+
+   TString expr = GetExpFormula("CLING");
+   TString badFunc;
+   if (!IsDifferentiableExpression(expr, badFunc) ) {
+      Info("GenerateGradientPar","Function %s used in the formula %s cannot be differentiated - use numerical derivatives",
+           badFunc.Data(), GetExpFormula().Data() );
+      return false;
+   }
+   // the size of the dual numbers depends on the number of parameters, which
+   // can be larger than the largest parameter index used in the expression
+   std::string inputFormula = std::string(TString::Format("%d:%s", fNpar, expr.Data()) );
+
+   R__LOCKGUARD2(gROOTMutex);
+
+   auto funcit = gClingGradFunctions.find(inputFormula);
+   if (funcit != gClingGradFunctions.end() ) {
+      fGradFuncPtr = (  TInterpreter::CallFuncIFacePtr_t::Generic_t) funcit->second;
+      return true;
+   }
+
+   expr.ReplaceAll("TMath::","ROOT::Internal::TFormulaAD::");
+   // the name depends on the number of parameters, as the key of the cache
+   auto hasher = gClingGradFunctions.hash_function();
+   TString gradName = TString::Format("%s__grad%zu",gNamePrefix.Data(), hasher(inputFormula) );
+   TString gradInput = TString::Format(
+      "Double_t %s(Double_t *x, Double_t *pp, Double_t *g){\n"
+      "   typedef ROOT::Internal::TFormulaAD::Dual<%d> D;\n"
+      "   D p[%d];\n"
+      "   for (unsigned int i = 0; i < %d; ++i) p[i] = D(pp[i], i);\n"
+      "   D r = D( %s );\n"
+      "   for (unsigned int i = 0; i < %d; ++i) g[i] = r.fD[i];\n"
+      "   return r.fV;\n"
+      "}", gradName.Data(), fNpar, fNpar, fNpar, expr.Data(), fNpar);
+
+   if (!gCling->Declare("#include \"TFormulaAD.h\"") || !gCling->Declare(gradInput) ) {
+      Error("GenerateGradientPar","Error compiling the gradient code of the formula %s", GetExpFormula().Data() );
+      return false;
+   }
+
+   TMethodCall method;
+   method.InitWithPrototype(gradName,"Double_t*,Double_t*,Double_t*");
+   if (!method.IsValid() ) {
+      Error("GenerateGradientPar","Can't find %s function prototype",gradName.Data() );
+      return false;
+   }
+   TInterpreter::CallFuncIFacePtr_t faceptr = gCling->CallFunc_IFacePtr(method.GetCallFunc() );
+   fGradFuncPtr = faceptr.fGeneric;
+   gClingGradFunctions.insert ( std::make_pair ( inputFormula, (void*) fGradFuncPtr) );
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the gradient of the formula with respect to the parameters at the
+/// point x using the code created by GenerateGradientPar.
+/// If params is null the parameter values stored in the formula are used.
+/// The array grad must have a size of at least GetNpar().
+
+void TFormula::GradientPar(const Double_t *x, Double_t *grad, const Double_t *params) const
+{
+   if (!fGradFuncPtr) {
+      Error("GradientPar","Gradient code is not available - call first TFormula::GenerateGradientPar");
+      return;
+   }
+   Double_t result = 0;
+   void* args[3];
+   double * vars = (x) ? const_cast<double*>(x) : const_cast<double*>(fClingVariables.data());
+   double * pars = (params) ? const_cast<double*>(params) : const_cast<double*>(fClingParameters.data());
+   args[0] = &vars;
+   args[1] = &pars;
+   args[2] = &grad;
+   (*fGradFuncPtr)(0, 3, args, &result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate with Cling the code evaluating the formula on an array of points.
+///
+/// The loop on the points is part of the compiled code, so the expression
+/// can be inlined and vectorised by the compiler and the cost of the call
+/// through the interpreter interface is paid once per array.
+/// The exponential and trigonometric functions are mapped to the inline
+/// versions of TFormulaVec.h, which use VDT when available.
+/// Return false if the code cannot be generated (e.g. for lambda expressions);
+/// in that case EvalParArray evaluates the points one by one.
+
+Bool_t TFormula::InitArrayEval() const
+{
+   if (fArrayFuncPtr) return true;
+   if (!IsValid() || !fClingInitialized || TestBit(TFormula::kLambda) ) return false;
+
+   TString expr = GetExpFormula("CLING");
+   std::string key = std::string(TString::Format("%d:",fNdim).Data() ) + std::string(expr);
+
+   R__LOCKGUARD2(gROOTMutex);
+
+   if (fArrayFuncPtr) return true;
+   auto funcit = gClingArrayFunctions.find(key);
+   if (funcit != gClingArrayFunctions.end() ) {
+      fArrayFuncPtr = (  TInterpreter::CallFuncIFacePtr_t::Generic_t) funcit->second;
+      return true;
+   }
+
+   const char * vecFuncs[] = { "Exp", "Sin", "Cos", "ATan", "ATan2" };
+   for (auto fname : vecFuncs)
+      expr.ReplaceAll(TString::Format("TMath::%s(",fname), TString::Format("ROOT::Internal::TFormulaVec::%s(",fname) );
+
+   auto hasher = gClingArrayFunctions.hash_function();
+   TString arrayName = TString::Format("%s__array%zu",gNamePrefix.Data(), hasher(key) );
+   TString arrayInput = TString::Format(
+      "void %s(Double_t *xx, Double_t *p, Double_t *res, Int_t n){\n"
+      "   for (Int_t i = 0; i < n; ++i) {\n"
+      "      Double_t *x = xx + i*%d;\n"
+      "      res[i] = %s;\n"
+      "   }\n"
+      "}", arrayName.Data(), fNdim, expr.Data() );
+
+   if (!gCling->Declare("#include \"TFormulaVec.h\"") || !gCling->Declare(arrayInput) ) {
+      Error("InitArrayEval","Error compiling the array evaluation code of the formula %s", GetExpFormula().Data() );
+      return false;
+   }
+
+   TMethodCall method;
+   method.InitWithPrototype(arrayName,"Double_t*,Double_t*,Double_t*,Int_t");
+   if (!method.IsValid() ) {
+      Error("InitArrayEval","Can't find %s function prototype",arrayName.Data() );
+      return false;
+   }
+   TInterpreter::CallFuncIFacePtr_t faceptr = gCling->CallFunc_IFacePtr(method.GetCallFunc() );
+   fArrayFuncPtr = faceptr.fGeneric;
+   gClingArrayFunctions.insert ( std::make_pair ( key, (void*) fArrayFuncPtr) );
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula on n points.
+///
+/// The coordinates of the points are stored contiguously in x, i.e. the
+/// coordinate j of the point i is x[i*GetNdim()+j], and the n values are
+/// written in result. If params is null the parameter values stored in the
+/// formula are used.
+/// The first call generates the code evaluating the whole array
+/// (see InitArrayEval). The results can differ from EvalPar in the last bits
+/// when the formula uses exponential or trigonometric functions and VDT is
+/// available.
+
+void TFormula::EvalParArray(Int_t n, const Double_t *x, Double_t *result, const Double_t *params) const
+{
+   if (n <= 0) return;
+   if (!fReadyToExecute || !InitArrayEval() ) {
+      for (Int_t i = 0; i < n; ++i) result[i] = DoEval(x + i*fNdim, params);
+      return;
+   }
+   void* args[4];
+   double * vars = const_cast<double*>(x);
+   double * pars = (params) ? const_cast<double*>(params) : const_cast<double*>(fClingParameters.data());
+   args[0] = &vars;
+   args[1] = &pars;
+   args[2] = &result;
+   args[3] = &n;
+   (*fArrayFuncPtr)(0, 4, args, nullptr);
+}
 Double_t TFormula::Eval(Double_t x, Double_t y, Double_t z, Double_t t) const
 {
    //*-*
@@ -128,6 +128,16 @@ public:
 
    using BaseFunc::operator();
 
+   /**
+      Evaluate the function at n points for the given parameters p.
+      The coordinates of the points are stored contiguously in x (the coordinate j of the
+      point i is x[i*NDim()+j]) and the n function values are written in result.
+      Use the virtual function DoEvalParArray to implement it
+   */
+   void EvalParArray(unsigned int n, const double * x, double * result, const double * p) const {
+      DoEvalParArray(n, x, result, p);
+   }
+
 
 private:
 
@@ -137,6 +147,15 @@ private:
    */
    virtual double DoEvalPar(const double * x, const double * p) const = 0;
 
+   /**
+      Implementation of the evaluation on an array of points. The default calls DoEvalPar
+      for each point; derived classes can re-implement it to evaluate the whole array at once
+   */
+   virtual void DoEvalParArray(unsigned int n, const double * x, double * result, const double * p) const {
+      const unsigned int ndim = NDim();
+      for (unsigned int i = 0; i < n; ++i) result[i] = DoEvalPar(x + i*ndim, p);
+   }
+
    /**
       Implement the ROOT::Math::IBaseFunctionMultiDim interface DoEval(x) using the cached parameter values
    */
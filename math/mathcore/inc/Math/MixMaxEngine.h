@@ -86,6 +86,12 @@ namespace ROOT {
          /// set the generator seed using a 64 bits integer
          void SetSeed64(uint64_t seed);
 
+         /// set the state to the one of the given stream.
+         /// Streams differing by at least one bit in one of the four IDs are
+         /// guaranteed not to overlap for the first 10^100 numbers, so they can be
+         /// used for example as independent and reproducible per-thread generators
+         void SeedUniqueStream(unsigned int clusterID, unsigned int machineID, unsigned int runID, unsigned int streamID);
+
          ///set the full initial generator state and warm up generator by doing some iterations
          void SetState(const std::vector<StateInt_t> & state, bool warmup = true);
 
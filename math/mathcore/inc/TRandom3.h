@@ -41,6 +41,7 @@ public:
    virtual  void      RndmArray(Int_t n, Float_t *array);
    virtual  void      RndmArray(Int_t n, Double_t *array);
    virtual  void      SetSeed(UInt_t seed=0);
+            void      SetSeedStream(UInt_t seed, UInt_t stream);
 
    ClassDef(TRandom3,2)  //Random number generator: Mersenne Twister
 };
@@ -374,15 +374,42 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
 #endif
    double maxResValue = std::numeric_limits<double>::max() /n;
    double wrefVolume = 1.0;
-   std::vector<double> xc;
-   if (useBinVolume) {
-      if (fitOpt.fNormBinVolume) wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
+   if (useBinVolume && fitOpt.fNormBinVolume) wrefVolume /= data.RefVolume();
+
+   // when the bin integral is not needed the function is evaluated on blocks of points
+   // with a single call (see IParamMultiFunction::EvalParArray), which for TF1 formulae
+   // executes a loop compiled together with the expression
+   const unsigned int kChunkSize = 256;
+   const unsigned int ndim = data.NDim();
+   std::vector<double> xchunk;
+   std::vector<double> fchunk;
+   if (!useBinIntegral) {
+      xchunk.resize(kChunkSize*ndim);
+      fchunk.resize(kChunkSize);
    }
+   unsigned int chunkBegin = 0;
+   unsigned int chunkEnd = 0;
 
    (const_cast<IModelFunction &>(func)).SetParameters(p);
    for (unsigned int i = 0; i < n; ++ i) {
 
+      if (!useBinIntegral && i == chunkEnd) {
+         chunkBegin = i;
+         chunkEnd = std::min(n, i + kChunkSize);
+         for (unsigned int k = chunkBegin; k < chunkEnd; ++k) {
+            const double * xk = data.Coords(k);
+            double * xdest = &xchunk[(k-chunkBegin)*ndim];
+            if (useBinVolume) {
+               const double * x2 = data.BinUpEdge(k);
+               for (unsigned int j = 0; j < ndim; ++j) xdest[j] = 0.5*(x2[j]+ xk[j]);
+            }
+            else {
+               std::copy(xk, xk+ndim, xdest);
+            }
+         }
+         func.EvalParArray(chunkEnd-chunkBegin, &xchunk.front(), &fchunk.front(), p);
+      }
+
       double y = 0, invError = 1.;
 
       // in case of no error in y invError=1 is returned
@@ -391,25 +418,18 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
       double fval = 0;
 
       double binVolume = 1.0;
-        if (useBinVolume) {
-         unsigned int ndim = data.NDim();
+      if (useBinVolume) {
+         // the function values of the bin centres are computed with the chunk
          const double * x2 = data.BinUpEdge(i);
          for (unsigned int j = 0; j < ndim; ++j) {
             binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
          }
          // normalize the bin volume using a reference value
          binVolume *= wrefVolume;
       }
 
-      const double * x = (useBinVolume) ? &xc.front() : x1;
-
       if (!useBinIntegral) {
-#ifdef USE_PARAMCACHE
-         fval = func ( x );
-#else
-         fval = func ( x, p );
-#endif
+         fval = fchunk[i-chunkBegin];
       }
       else {
          // calculate integral normalized by bin volume
@@ -432,7 +452,7 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
 
 //#define DEBUG
 #ifdef DEBUG
-      std::cout << x[0] << "  " << y << "  " << 1./invError << " params : ";
+      std::cout << x1[0] << "  " << y << "  " << 1./invError << " params : ";
       for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
          std::cout << p[ipar] << "\t";
       std::cout << "\tfval = " << fval << " bin volume " << binVolume << " ref " << wrefVolume << std::endl;
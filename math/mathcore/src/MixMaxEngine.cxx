@@ -32,9 +32,9 @@ namespace Math {
    }
 
 
-   // void MixMaxEngine::SeedUniqueStream(unsigned int clusterID, unsigned int machineID, unsigned int runID, unsigned int  streamID) { 
-   //    seed_uniquestream(fRngState, clusterID,  machineID,  runID,   streamID);
-   // }
+   void MixMaxEngine::SeedUniqueStream(unsigned int clusterID, unsigned int machineID, unsigned int runID, unsigned int  streamID) { 
+      seed_uniquestream(fRngState, clusterID,  machineID,  runID,   streamID);
+   }
 
    void MixMaxEngine::SetSeed(unsigned int seed) { 
       seed_spbox(fRngState, seed);
@@ -216,6 +216,21 @@ Double_t TRandom::Exp(Double_t tau)
    return t;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill an array of n exponential deviates.
+///
+///          exp( -t/tau )
+///
+/// The uniform numbers are produced with a single call to RndmArray and
+/// converted in place, without any virtual call per number.
+
+void TRandom::ExpArray(Int_t n, Double_t *array, Double_t tau)
+{
+   RndmArray(n, array);
+   for (Int_t i = 0; i < n; i++)
+      array[i] = -tau * TMath::Log( array[i] );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Samples a random number from the standard Normal (Gaussian) Distribution
 /// with the given mean and sigma.
@@ -314,6 +329,37 @@ Double_t TRandom::Gaus(Double_t mean, Double_t sigma)
    return mean + sigma * result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill an array of n Gaussian deviates with the given mean and sigma.
+///
+/// The numbers are generated with the Box-Muller transformation in chunks:
+/// the uniform numbers of a chunk are obtained with one call to RndmArray
+/// and the transformation loop has no branches, so that it can be
+/// vectorized by the compiler. Since it uses a different method, the
+/// sequence is not the same as the one obtained by calling Gaus n times.
+
+void TRandom::GausArray(Int_t n, Double_t *array, Double_t mean, Double_t sigma)
+{
+   const Int_t kChunk = 256;
+   Double_t u[kChunk];
+
+   for (Int_t k = 0; k < n; k += kChunk) {
+      const Int_t m = TMath::Min(n-k, kChunk);
+      const Int_t h = m/2;
+      RndmArray(2*((m+1)/2), u);
+      Double_t *out = array+k;
+      // u[0,h[ give the radii, u[h,2h[ the angles
+      for (Int_t i = 0; i < h; i++) {
+         const Double_t r   = sigma * TMath::Sqrt(-2. * TMath::Log(u[i]));
+         const Double_t phi = TMath::TwoPi() * u[h+i];
+         out[i]   = mean + r * TMath::Cos(phi);
+         out[h+i] = mean + r * TMath::Sin(phi);
+      }
+      if (m & 1)
+         out[m-1] = mean + sigma * TMath::Sqrt(-2. * TMath::Log(u[m-1])) * TMath::Cos(TMath::TwoPi() * u[m]);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns a random integer on [ 0, imax-1 ].
 
@@ -53,6 +53,7 @@ Drawback:  a relative large internal state of 624 integers
 #include "TRandom2.h"
 #include "TClass.h"
 #include "TUUID.h"
+#include "TMath.h"
 
 TRandom *gRandom = new TRandom3();
 #ifdef R__COMPLETE_MEM_TERMINATION
@@ -86,14 +87,7 @@ TRandom3::~TRandom3()
 {
 }
 
-////////////////////////////////////////////////////////////////////////////////
-///  Machine independent random number generator.
-///  Produces uniformly-distributed floating points in (0,1)
-///  Method: Mersenne Twister
-
-Double_t TRandom3::Rndm(Int_t)
-{
-   UInt_t y;
+namespace {
 
    const Int_t  kM = 397;
    const Int_t  kN = 624;
@@ -103,29 +97,83 @@ Double_t TRandom3::Rndm(Int_t)
    const UInt_t kLowerMask =       0x7fffffff;
    const UInt_t kMatrixA =         0x9908b0df;
 
-   if (fCount624 >= kN) {
+   // Regenerate the kN words of the state.
+   // The conditional xor with kMatrixA is written with a mask: the loops have no
+   // branches and their dependencies are longer than a vector register, so
+   // that the compiler can vectorize them.
+   inline void NextState(UInt_t *mt)
+   {
+      UInt_t y;
       Int_t i;
-
       for (i=0; i < kN-kM; i++) {
-         y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
-         fMt[i] = fMt[i+kM] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
+         y = (mt[i] & kUpperMask) | (mt[i+1] & kLowerMask);
+         mt[i] = mt[i+kM] ^ (y >> 1) ^ (kMatrixA & (0U - (y & 0x1)));
       }
-
       for (   ; i < kN-1    ; i++) {
-         y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
-         fMt[i] = fMt[i+kM-kN] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
+         y = (mt[i] & kUpperMask) | (mt[i+1] & kLowerMask);
+         mt[i] = mt[i+kM-kN] ^ (y >> 1) ^ (kMatrixA & (0U - (y & 0x1)));
+      }
+      y = (mt[kN-1] & kUpperMask) | (mt[0] & kLowerMask);
+      mt[kN-1] = mt[kM-1] ^ (y >> 1) ^ (kMatrixA & (0U - (y & 0x1)));
+   }
+
+   inline UInt_t Temper(UInt_t y)
+   {
+      y ^=  (y >> 11);
+      y ^= ((y << 7 ) & kTemperingMaskB );
+      y ^= ((y << 15) & kTemperingMaskC );
+      y ^=  (y >> 18);
+      return y;
+   }
+
+   // Fill array with n numbers in ]0,1], tempering and converting all the
+   // words left in the state in one loop. The (rare) zeros are skipped like
+   // in TRandom3::Rndm, so the sequence is the same as the one of Rndm.
+   template<class Element>
+   void FillArray(UInt_t *mt, Int_t &count, Int_t n, Element *array)
+   {
+      Int_t k = 0;
+      while (k < n) {
+         if (count >= kN) {
+            NextState(mt);
+            count = 0;
+         }
+         const Int_t m = TMath::Min(n-k, kN-count);
+         const UInt_t *src = mt+count;
+         Element *dst = array+k;
+         UInt_t nzero = 0;
+         for (Int_t j = 0; j < m; j++) {
+            const UInt_t y = Temper(src[j]);
+            nzero += (y == 0);
+            dst[j] = Element( y * 2.3283064365386963e-10); // * Power(2,-32)
+         }
+         count += m;
+         if (nzero == 0) {
+            k += m;
+         } else {
+            Int_t kk = 0;
+            for (Int_t j = 0; j < m; j++)
+               if (Temper(src[j])) dst[kk++] = dst[j];
+            k += kk;
+         }
       }
+   }
 
-      y = (fMt[kN-1] & kUpperMask) | (fMt[0] & kLowerMask);
-      fMt[kN-1] = fMt[kM-1] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///  Machine independent random number generator.
+///  Produces uniformly-distributed floating points in (0,1)
+///  Method: Mersenne Twister
+
+Double_t TRandom3::Rndm(Int_t)
+{
+   if (fCount624 >= kN) {
+      NextState(fMt);
       fCount624 = 0;
    }
 
-   y = fMt[fCount624++];
-   y ^=  (y >> 11);
-   y ^= ((y << 7 ) & kTemperingMaskB );
-   y ^= ((y << 15) & kTemperingMaskC );
-   y ^=  (y >> 18);
+   UInt_t y = Temper(fMt[fCount624++]);
 
    // 2.3283064365386963e-10 == 1./(max<UINt_t>+1)  -> then returned value cannot be = 1.0
    if (y) return ( (Double_t) y * 2.3283064365386963e-10); // * Power(2,-32)
@@ -137,7 +185,7 @@ Double_t TRandom3::Rndm(Int_t)
 
 void TRandom3::RndmArray(Int_t n, Float_t *array)
 {
-  for(Int_t i=0; i<n; i++) array[i]=(Float_t)Rndm();
+   FillArray(fMt, fCount624, n, array);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -145,48 +193,7 @@ void TRandom3::RndmArray(Int_t n, Float_t *array)
 
 void TRandom3::RndmArray(Int_t n, Double_t *array)
 {
-   Int_t k = 0;
-
-   UInt_t y;
-
-   const Int_t  kM = 397;
-   const Int_t  kN = 624;
-   const UInt_t kTemperingMaskB =  0x9d2c5680;
-   const UInt_t kTemperingMaskC =  0xefc60000;
-   const UInt_t kUpperMask =       0x80000000;
-   const UInt_t kLowerMask =       0x7fffffff;
-   const UInt_t kMatrixA =         0x9908b0df;
-
-   while (k < n) {
-      if (fCount624 >= kN) {
-         Int_t i;
-
-         for (i=0; i < kN-kM; i++) {
-            y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
-            fMt[i] = fMt[i+kM] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-         }
-
-         for (   ; i < kN-1    ; i++) {
-            y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
-            fMt[i] = fMt[i+kM-kN] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-         }
-
-         y = (fMt[kN-1] & kUpperMask) | (fMt[0] & kLowerMask);
-         fMt[kN-1] = fMt[kM-1] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-         fCount624 = 0;
-      }
-
-      y = fMt[fCount624++];
-      y ^=  (y >> 11);
-      y ^= ((y << 7 ) & kTemperingMaskB );
-      y ^= ((y << 15) & kTemperingMaskC );
-      y ^=  (y >> 18);
-
-      if (y) {
-         array[k] = Double_t( y * 2.3283064365386963e-10); // * Power(2,-32)
-         k++;
-      }
-   }
+   FillArray(fMt, fCount624, n, array);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -226,6 +233,49 @@ void TRandom3::SetSeed(UInt_t seed)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the generator state for the stream number stream of the sequence
+/// identified by seed.
+///
+/// The state is computed with the init_by_array procedure of the reference
+/// implementation, using (seed,stream) as key. This gives reproducible and
+/// statistically independent generators, for example one for each thread
+/// of a parallel toy Monte Carlo:
+///
+///     TRandom3 r;
+///     r.SetSeedStream(4357, threadIndex);
+///
+/// Note that, unlike SetSeed, a zero seed is used as such and does not
+/// produce a random seed. For streams with a mathematical guarantee of non
+/// overlap, use ROOT::Math::MixMaxEngine::SeedUniqueStream.
+
+void TRandom3::SetSeedStream(UInt_t seed, UInt_t stream)
+{
+   const UInt_t key[2] = { seed, stream };
+   const Int_t nkey = 2;
+
+   fSeed = seed;
+   fCount624 = kN;
+
+   fMt[0] = 19650218U;
+   for (Int_t i = 1; i < kN; i++)
+      fMt[i] = (1812433253 * ( fMt[i-1]  ^ ( fMt[i-1] >> 30)) + i );
+
+   Int_t i = 1, j = 0;
+   for (Int_t k = kN; k; k--) {
+      fMt[i] = (fMt[i] ^ ((fMt[i-1] ^ (fMt[i-1] >> 30)) * 1664525U)) + key[j] + j;
+      i++; j++;
+      if (i >= kN) { fMt[0] = fMt[kN-1]; i = 1; }
+      if (j >= nkey) j = 0;
+   }
+   for (Int_t k = kN-1; k; k--) {
+      fMt[i] = (fMt[i] ^ ((fMt[i-1] ^ (fMt[i-1] >> 30)) * 1566083941U)) - i;
+      i++;
+      if (i >= kN) { fMt[0] = fMt[kN-1]; i = 1; }
+   }
+   fMt[0] = 0x80000000U; // MSB is 1, assuring non-zero initial array
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Stream an object of class TRandom3.
 
@@ -149,7 +149,11 @@ void iterate_and_fill_array(rng_state_t* X, double *array){
         tempP = modadd(tempP,Y[i]);
         Y[i] = ( tempV = modadd(tempV,tempP) );
         sumtot += tempV; if (sumtot < tempV) {ovflow++;}
-        array[i-1] = (int64_t)tempV * (double)(INV_MERSBASE);
+    }
+    // the conversion is done in a separate loop (before the special entry is
+    // modified), since, unlike the recursion above, it can be vectorized
+    for (i=1; i<N; i++){
+        array[i-1] = (int64_t)Y[i] * (double)(INV_MERSBASE);
     }
 #if (SPECIAL != 0)
     temp2 = MOD_MULSPEC(temp2);
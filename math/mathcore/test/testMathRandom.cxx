@@ -16,6 +16,7 @@
 
 #include "TStopwatch.h"
 #include <iostream>
+#include <cmath>
 
 #include <random>
 
@@ -164,6 +165,71 @@ bool test2() {
    return ret; 
 }
 
+bool test3() {
+
+   bool ret = true;
+
+   std::cout << "\nTesting TRandom3 array generation" << std::endl;
+
+   // RndmArray must give the same sequence as Rndm
+   TRandom3 r1(4357);
+   TRandom3 r2(4357);
+   std::vector<double> x(NR);
+   std::vector<double> y(NR);
+
+   TStopwatch w; w.Start();
+   r1.RndmArray(NR, x.data());
+   w.Stop();
+   std::cout << "time for RndmArray ";
+   w.Print();
+   int ndiff = 0;
+   for (int i = 0; i < NR; ++i)
+      if (x[i] != r2.Rndm()) ndiff++;
+   if (ndiff) {
+      std::cout << "RndmArray differs from Rndm for " << ndiff << " numbers" << std::endl;
+      ret = false;
+   }
+
+   w.Start();
+   r1.GausArray(NR, x.data());
+   w.Stop();
+   std::cout << "time for GausArray ";
+   w.Print();
+   for (int i = 0; i < NR; ++i) {
+      x[i] = ROOT::Math::normal_cdf(x[i],1);
+      y[i] = ROOT::Math::normal_cdf(r2.Gaus(0,1),1);
+   }
+   ret &= testCompatibility(x,y);
+
+   r1.ExpArray(NR, x.data(), 2.);
+   for (int i = 0; i < NR; ++i) {
+      x[i] = 1. - std::exp(-x[i]/2.);
+      y[i] = 1. - std::exp(-r2.Exp(2.)/2.);
+   }
+   ret &= testCompatibility(x,y);
+
+   // streams are reproducible and independent
+   std::cout << "\nTesting TRandom3 and MIXMAX streams" << std::endl;
+   r1.SetSeedStream(4357, 0);
+   r2.SetSeedStream(4357, 1);
+   r1.RndmArray(NR, x.data());
+   r2.RndmArray(NR, y.data());
+   ret &= testCompatibility(x,y);
+   r2.SetSeedStream(4357, 0);
+   if (r2.Rndm() != x[0]) {
+      std::cout << "TRandom3 stream is not reproducible" << std::endl;
+      ret = false;
+   }
+
+   MixMaxEngine e1, e2;
+   e1.SeedUniqueStream(0, 0, 1, 0);
+   e2.SeedUniqueStream(0, 0, 1, 1);
+   e1.RndmArray(NR, x.data());
+   e2.RndmArray(NR, y.data());
+   ret &= testCompatibility(x,y);
+
+   return ret;
+}
 
 bool testMathRandom() {
 
@@ -181,6 +247,7 @@ bool testMathRandom() {
 
    ret &= test1(); 
    ret &= test2(); 
+   ret &= test3();
 
    if (!ret) Error("testMathRandom","Test Failed");
    else
@@ -44,7 +44,7 @@ include/%.h:    $(MATRIXDIRI)/%.h
 $(MATRIXLIB):   $(MATRIXO) $(MATRIXDO) $(ORDER_) $(MAINLIBS) $(MATRIXLIBDEP)
 		@$(MAKELIB) $(PLATFORM) $(LD) "$(LDFLAGS)" \
 		   "$(SOFLAGS)" libMatrix.$(SOEXT) $@ "$(MATRIXO) $(MATRIXDO)" \
-		   "$(MATRIXLIBEXTRA)"
+		   "$(MATRIXLIBEXTRA) $(TBBLIBDIR) $(TBBLIB)"
 
 $(call pcmrule,MATRIX)
 	$(noop)
@@ -70,3 +70,8 @@ distclean-$(MODNAME): clean-$(MODNAME)
 		@rm -f $(MATRIXDEP) $(MATRIXDS) $(MATRIXDH) $(MATRIXLIB) $(MATRIXMAP)
 
 distclean::     distclean-$(MODNAME)
+
+##### extra rules ######
+ifeq ($(BUILDTBB),yes)
+$(MATRIXO): CXXFLAGS += $(TBBINCDIR:%=-I%)
+endif
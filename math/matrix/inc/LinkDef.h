@@ -40,6 +40,10 @@
 #pragma link C++ function  TMatrixTSymCramerInv::Inv6x6(TMatrixTSym<float>&,Double_t*);
 #pragma link C++ function  TMatrixTSymCramerInv::Inv6x6(TMatrixTSym<double>&,Double_t*);
 
+#pragma link C++ namespace TMatrixTKernels;
+#pragma link C++ function  TMatrixTKernels::SetMinBlockedSize(Int_t);
+#pragma link C++ function  TMatrixTKernels::GetMinBlockedSize();
+
 #pragma link C++ class TVectorT                <float>-;
 #pragma link C++ class TMatrixTBase            <float>-;
 #pragma link C++ class TMatrixT                <float>-;
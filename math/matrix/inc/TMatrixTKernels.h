@@ -0,0 +1,50 @@
+// @(#)root/matrix:$Id$
+// Authors: Fons Rademakers, Eddy Offermann  Jan 2004
+
+/*************************************************************************
+ * Copyright (C) 1995-2016, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMatrixTKernels
+#define ROOT_TMatrixTKernels
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TMatrixTKernels                                                      //
+//                                                                      //
+// Encapsulate the cache-blocked kernels used for large matrices:       //
+// general matrix multiplication, LU and Cholesky decompositions and    //
+// inversion of an LU decomposed matrix.                                //
+//                                                                      //
+// All the matrices are stored row-wise, like in TMatrixT. When ROOT is //
+// built with implicit multi-threading support and it is enabled with   //
+// ROOT::EnableImplicitMT(), the kernels use several threads.           //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+namespace TMatrixTKernels {
+
+   void   SetMinBlockedSize(Int_t n);
+   Int_t  GetMinBlockedSize();
+   Bool_t UseBlocked(Int_t nrows,Int_t ncols,Int_t ninner);
+
+   template<class Element> void Gemm(Bool_t transa,Bool_t transb,Int_t m,Int_t n,Int_t k,Element alpha,
+                                     const Element *a,Int_t lda,const Element *b,Int_t ldb,
+                                     Element beta,Element *c,Int_t ldc);
+
+   Bool_t LUDecompose     (Double_t *a,Int_t n,Int_t *index,Double_t &sign,Double_t tol,Int_t &nrZeros,
+                           Bool_t implicitPivot);
+   void   LUInvert        (Double_t *lu,Int_t n,const Int_t *index);
+   Bool_t CholeskyDecompose(Double_t *a,Int_t n);
+
+}
+
+#endif
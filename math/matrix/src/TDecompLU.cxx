@@ -11,6 +11,7 @@
 
 #include "TDecompLU.h"
 #include "TMath.h"
+#include "TMatrixTKernels.h"
 
 ClassImp(TDecompLU)
 
@@ -595,6 +596,8 @@ TDecompLU &TDecompLU::operator=(const TDecompLU &source)
 /// and L is in multiplier form in the subdiagionals .
 /// Row permutations are mapped out in fIndex. fSign, used for calculating the
 /// determinant, is +/- 1 for even/odd row permutations. .
+/// Above TMatrixTKernels::GetMinBlockedSize() the blocked algorithm
+/// TMatrixTKernels::LUDecompose is used.
 
 Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
                                    Double_t tol,Int_t &nrZeros)
@@ -602,6 +605,14 @@ Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
    const Int_t     n     = lu.GetNcols();
    Double_t *pLU   = lu.GetMatrixArray();
 
+   if (n >= TMatrixTKernels::GetMinBlockedSize()) {
+      if (!TMatrixTKernels::LUDecompose(pLU,n,index,sign,tol,nrZeros,kTRUE)) {
+         ::Error("TDecompLU::DecomposeLUCrout","matrix is singular");
+         return kFALSE;
+      }
+      return kTRUE;
+   }
+
    Double_t work[kWorkMax];
    Bool_t isAllocated = kFALSE;
    Double_t *scale = work;
@@ -704,6 +715,8 @@ Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
 /// fSign, used for calculating the determinant, is +/- 1 for even/odd row permutations.
 /// Since this algorithm uses partial pivoting without scaling like in Crout/Doolitle.
 /// it is somewhat faster but less precise .
+/// Above TMatrixTKernels::GetMinBlockedSize() the blocked algorithm
+/// TMatrixTKernels::LUDecompose is used.
 
 Bool_t TDecompLU::DecomposeLUGauss(TMatrixD &lu,Int_t *index,Double_t &sign,
                                    Double_t tol,Int_t &nrZeros)
@@ -711,6 +724,14 @@ Bool_t TDecompLU::DecomposeLUGauss(TMatrixD &lu,Int_t *index,Double_t &sign,
    const Int_t     n   = lu.GetNcols();
    Double_t *pLU = lu.GetMatrixArray();
 
+   if (n >= TMatrixTKernels::GetMinBlockedSize()) {
+      if (!TMatrixTKernels::LUDecompose(pLU,n,index,sign,tol,nrZeros,kFALSE)) {
+         ::Error("TDecompLU::DecomposeLUGauss","matrix is singular");
+         return kFALSE;
+      }
+      return kTRUE;
+   }
+
    sign    = 1.0;
    nrZeros = 0;
 
@@ -771,6 +792,8 @@ Bool_t TDecompLU::DecomposeLUGauss(TMatrixD &lu,Int_t *index,Double_t &sign,
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate matrix inversion through in place forward/backward substitution
+/// Above TMatrixTKernels::GetMinBlockedSize() the blocked algorithm
+/// TMatrixTKernels::LUInvert is used.
 
 Bool_t TDecompLU::InvertLU(TMatrixD &lu,Double_t tol,Double_t *det)
 {
@@ -811,6 +834,13 @@ Bool_t TDecompLU::InvertLU(TMatrixD &lu,Double_t tol,Double_t *det)
       *det = d1*TMath::Power(2.0,d2);
    }
 
+   if (n >= TMatrixTKernels::GetMinBlockedSize()) {
+      TMatrixTKernels::LUInvert(pLU,n,index);
+      if (isAllocatedI)
+         delete [] index;
+      return kTRUE;
+   }
+
    //  Form inv(U).
 
    Int_t j;
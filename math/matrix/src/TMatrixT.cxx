@@ -25,6 +25,7 @@
 #include "TMatrixTSym.h"
 #include "TMatrixTLazy.h"
 #include "TMatrixTCramerInv.h"
+#include "TMatrixTKernels.h"
 #include "TDecompLU.h"
 #include "TMatrixDEigen.h"
 #include "TClass.h"
@@ -3072,11 +3073,18 @@ TMatrixT<Element> &ElementDiv(TMatrixT<Element> &target,const TMatrixTSym<Elemen
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A*B
+/// Above TMatrixTKernels::GetMinBlockedSize() the blocked TMatrixTKernels::Gemm is used
 
 template<class Element>
 void AMultB(const Element * const ap,Int_t na,Int_t ncolsa,
             const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+   const Int_t nrowsa = (ncolsa > 0) ? na/ncolsa : 0;
+   if (TMatrixTKernels::UseBlocked(nrowsa,ncolsb,ncolsa)) {
+      TMatrixTKernels::Gemm(kFALSE,kFALSE,nrowsa,ncolsb,ncolsa,Element(1),ap,ncolsa,bp,ncolsb,Element(0),cp,ncolsb);
+      return;
+   }
+
    const Element *arp0 = ap;                     // Pointer to  A[i,0];
    while (arp0 < ap+na) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
@@ -3095,11 +3103,18 @@ void AMultB(const Element * const ap,Int_t na,Int_t ncolsa,
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A^T*B
+/// Above TMatrixTKernels::GetMinBlockedSize() the blocked TMatrixTKernels::Gemm is used
 
 template<class Element>
 void AtMultB(const Element * const ap,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+   const Int_t nrowsb = (ncolsb > 0) ? nb/ncolsb : 0;
+   if (TMatrixTKernels::UseBlocked(ncolsa,ncolsb,nrowsb)) {
+      TMatrixTKernels::Gemm(kTRUE,kFALSE,ncolsa,ncolsb,nrowsb,Element(1),ap,ncolsa,bp,ncolsb,Element(0),cp,ncolsb);
+      return;
+   }
+
    const Element *acp0 = ap;           // Pointer to  A[i,0];
    while (acp0 < ap+ncolsa) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
@@ -3119,11 +3134,19 @@ void AtMultB(const Element * const ap,Int_t ncolsa,
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A*B^T
+/// Above TMatrixTKernels::GetMinBlockedSize() the blocked TMatrixTKernels::Gemm is used
 
 template<class Element>
 void AMultBt(const Element * const ap,Int_t na,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+   const Int_t nrowsa = (ncolsa > 0) ? na/ncolsa : 0;
+   const Int_t nrowsb = (ncolsb > 0) ? nb/ncolsb : 0;
+   if (TMatrixTKernels::UseBlocked(nrowsa,nrowsb,ncolsa)) {
+      TMatrixTKernels::Gemm(kFALSE,kTRUE,nrowsa,nrowsb,ncolsa,Element(1),ap,ncolsa,bp,ncolsb,Element(0),cp,nrowsb);
+      return;
+   }
+
    const Element *arp0 = ap;                    // Pointer to  A[i,0];
    while (arp0 < ap+na) {
       const Element *brp0 = bp;                  // Pointer to  B[j,0];
@@ -0,0 +1,565 @@
+// @(#)root/matrix:$Id$
+// Authors: Fons Rademakers, Eddy Offermann  Jan 2004
+
+/*************************************************************************
+ * Copyright (C) 1995-2016, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TMatrixTKernels
+    \ingroup Matrix
+
+TMatrixTKernels
+
+Encapsulate the cache-blocked kernels used for large matrices.
+
+The elementary routines of TMatrixT (AMultB, AtMultB, AMultBt) and the
+decompositions of TDecompLU and TDecompChol switch to these kernels when
+the matrix dimensions exceed GetMinBlockedSize() (default 128), unless ROOT
+has been compiled with an external CBLAS library.
+
+The matrix multiplication follows the scheme of the optimized BLAS
+libraries: blocks of the two operands fitting in the cache are copied in
+contiguous panels and the product is computed in small tiles of
+kMR x kNR elements kept in registers, a loop that the compiler can
+vectorize. The LU (with partial pivoting) and Cholesky decompositions and
+the inversion of the LU decomposed matrix are right-looking blocked
+algorithms (see Golub & Van Loan, Matrix Computations, 3rd edition,
+sections 3.2.11 and 4.2.9), which spend most of their time in the matrix
+multiplication.
+
+When ROOT is built with implicit multi-threading support and it has been
+enabled with ROOT::EnableImplicitMT(), the work is distributed over the
+threads of the pool. Each matrix element is always computed by a single
+thread with the same sequence of operations, so that the results do not
+depend on the number of threads.
+
+For Example:
+~~~
+  ROOT::EnableImplicitMT();
+  TMatrixD a(2000,2000), b(2000,2000);
+  ...
+  TMatrixD c(a,TMatrixD::kMult,b);   // blocked, multi-threaded multiplication
+  a.Invert();                        // blocked LU decomposition and inversion
+
+  TMatrixTKernels::SetMinBlockedSize(100000); // go back to the elementary routines
+~~~
+*/
+
+#include "TMatrixTKernels.h"
+#include "TMath.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#endif
+
+#if !defined(R__SOLARIS) && !defined(R__ACC) && !defined(R__FBSD)
+NamespaceImp(TMatrixTKernels);
+#endif
+
+namespace {
+
+   // register tile of the multiplication micro-kernel
+   const Int_t kMR = 4;
+   const Int_t kNR = 8;
+   // cache blocks of the multiplication: kMC x kKC of A, kKC x kNC of B
+   const Int_t kMC = 64;
+   const Int_t kKC = 256;
+   const Int_t kNC = 2048;
+   // block size of the decompositions
+   const Int_t kNB = 64;
+
+   Int_t gMinBlockedSize = 128;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call f(first,last) on sub-ranges covering [0,n), in parallel when
+/// implicit multi-threading is enabled. grain is the minimal sub-range size.
+
+template<class F>
+void ParallelFor(Int_t n,Int_t grain,const F &f)
+{
+   if (n <= 0) return;
+#ifdef R__USE_IMT
+   if (n > grain && ROOT::IsImplicitMTEnabled()) {
+      tbb::parallel_for(tbb::blocked_range<Int_t>(0,n,grain),
+                        [&](const tbb::blocked_range<Int_t> &r) { f(r.begin(),r.end()); });
+      return;
+   }
+#else
+   (void)grain;
+#endif
+   f(0,n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy op(A)[i0:i0+mc,k0:k0+kc] in panels of kMR rows, stored k-major:
+/// ap[(p*kc+k)*kMR+r] = op(A)[i0+p*kMR+r,k0+k]. Rows beyond mc are set to 0
+
+template<class Element>
+void PackA(Bool_t trans,const Element *a,Int_t lda,Int_t i0,Int_t k0,Int_t mc,Int_t kc,Element *ap)
+{
+   for (Int_t p = 0; p < mc; p += kMR) {
+      const Int_t mr = TMath::Min(kMR,mc-p);
+      Element *dest = ap+p*kc;
+      for (Int_t r = 0; r < kMR; r++) {
+         if (r >= mr) {
+            for (Int_t k = 0; k < kc; k++) dest[k*kMR+r] = 0;
+         } else if (trans) {
+            const Element *src = a+(k0)*lda+i0+p+r;
+            for (Int_t k = 0; k < kc; k++) dest[k*kMR+r] = src[k*lda];
+         } else {
+            const Element *src = a+(i0+p+r)*lda+k0;
+            for (Int_t k = 0; k < kc; k++) dest[k*kMR+r] = src[k];
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy op(B)[k0:k0+kc,j0:j0+nc] in panels of kNR columns, stored k-major:
+/// bp[(q*kc+k)*kNR+c] = op(B)[k0+k,j0+q*kNR+c]. Columns beyond nc are set to 0
+
+template<class Element>
+void PackB(Bool_t trans,const Element *b,Int_t ldb,Int_t k0,Int_t j0,Int_t kc,Int_t nc,Element *bp)
+{
+   for (Int_t q = 0; q < nc; q += kNR) {
+      const Int_t nr = TMath::Min(kNR,nc-q);
+      Element *dest = bp+q*kc;
+      for (Int_t k = 0; k < kc; k++) {
+         Element *d = dest+k*kNR;
+         if (trans) {
+            const Element *src = b+(j0+q)*ldb+k0+k;
+            for (Int_t c = 0; c < nr; c++) d[c] = src[c*ldb];
+         } else {
+            const Element *src = b+(k0+k)*ldb+j0+q;
+            for (Int_t c = 0; c < nr; c++) d[c] = src[c];
+         }
+         for (Int_t c = nr; c < kNR; c++) d[c] = 0;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// C[0:mr,0:nr] += alpha * (packed A panel) * (packed B panel)
+
+template<class Element>
+inline void MicroKernel(Int_t kc,const Element * __restrict ap,const Element * __restrict bp,
+                        Element *c,Int_t ldc,Int_t mr,Int_t nr,Element alpha)
+{
+   Element acc[kMR][kNR];
+   for (Int_t r = 0; r < kMR; r++)
+      for (Int_t j = 0; j < kNR; j++)
+         acc[r][j] = 0;
+
+   for (Int_t k = 0; k < kc; k++) {
+      const Element *a = ap+k*kMR;
+      const Element *b = bp+k*kNR;
+      for (Int_t r = 0; r < kMR; r++) {
+         const Element ar = a[r];
+         for (Int_t j = 0; j < kNR; j++)
+            acc[r][j] += ar*b[j];
+      }
+   }
+
+   for (Int_t r = 0; r < mr; r++) {
+      Element *cr = c+r*ldc;
+      for (Int_t j = 0; j < nr; j++)
+         cr[j] += alpha*acc[r][j];
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// C = alpha*op(A)*op(B) + beta*C; rows of C are distributed over the threads
+/// when parallel is true
+
+template<class Element>
+void GemmImpl(Bool_t transa,Bool_t transb,Int_t m,Int_t n,Int_t k,Element alpha,
+              const Element *a,Int_t lda,const Element *b,Int_t ldb,
+              Element beta,Element *c,Int_t ldc,Bool_t parallel)
+{
+   if (m <= 0 || n <= 0) return;
+
+   const Int_t grain = parallel ? 16 : m;
+   if (beta != 1) {
+      ParallelFor(m,grain,[&](Int_t first,Int_t last) {
+         for (Int_t i = first; i < last; i++) {
+            Element *ci = c+i*ldc;
+            if (beta == 0) std::fill(ci,ci+n,Element(0));
+            else for (Int_t j = 0; j < n; j++) ci[j] *= beta;
+         }
+      });
+   }
+   if (k <= 0 || alpha == 0) return;
+
+   const Int_t ncMax = TMath::Min(kNC,n);
+   std::vector<Element> bpack(kKC*(ncMax+kNR));
+   const Int_t nblocks = (m+kMC-1)/kMC;
+
+   for (Int_t jc = 0; jc < n; jc += kNC) {
+      const Int_t nc = TMath::Min(kNC,n-jc);
+      for (Int_t pc = 0; pc < k; pc += kKC) {
+         const Int_t kc = TMath::Min(kKC,k-pc);
+         PackB(transb,b,ldb,pc,jc,kc,nc,&bpack[0]);
+
+         ParallelFor(nblocks,parallel ? 1 : nblocks,[&](Int_t first,Int_t last) {
+            std::vector<Element> apack(kMC*kc);
+            for (Int_t ib = first; ib < last; ib++) {
+               const Int_t ic = ib*kMC;
+               const Int_t mc = TMath::Min(kMC,m-ic);
+               PackA(transa,a,lda,ic,pc,mc,kc,&apack[0]);
+               for (Int_t jr = 0; jr < nc; jr += kNR) {
+                  const Int_t nr = TMath::Min(kNR,nc-jr);
+                  for (Int_t ir = 0; ir < mc; ir += kMR) {
+                     const Int_t mr = TMath::Min(kMR,mc-ir);
+                     MicroKernel(kc,&apack[ir*kc],&bpack[jr*kc],c+(ic+ir)*ldc+jc+jr,ldc,mr,nr,alpha);
+                  }
+               }
+            }
+         });
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Invert in place the upper triangular block of size nb starting at a
+/// (leading dimension lda), element by element
+
+void InvertUpperUnblocked(Double_t *a,Int_t lda,Int_t nb)
+{
+   for (Int_t j = 0; j < nb; j++) {
+      a[j*lda+j] = 1./a[j*lda+j];
+      const Double_t ajj = -a[j*lda+j];
+      // column j above the diagonal: x = inv(U(0:j,0:j)) * x * ajj
+      for (Int_t i = 0; i < j; i++) {
+         Double_t sum = 0.;
+         for (Int_t r = i; r < j; r++)
+            sum += a[i*lda+r]*a[r*lda+j];
+         a[i*lda+j] = sum;
+      }
+      for (Int_t i = 0; i < j; i++)
+         a[i*lda+j] *= ajj;
+   }
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the minimal matrix dimension for which the blocked kernels are used
+
+void TMatrixTKernels::SetMinBlockedSize(Int_t n)
+{
+   gMinBlockedSize = n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the minimal matrix dimension for which the blocked kernels are used
+
+Int_t TMatrixTKernels::GetMinBlockedSize()
+{
+   return gMinBlockedSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if a product of (nrows x ninner) * (ninner x ncols) matrices
+/// is large enough to profit from the blocked multiplication
+
+Bool_t TMatrixTKernels::UseBlocked(Int_t nrows,Int_t ncols,Int_t ninner)
+{
+   if (nrows < kMR || ncols < kNR || ninner < kMR) return kFALSE;
+   const Double_t size = gMinBlockedSize;
+   return Double_t(nrows)*Double_t(ncols)*Double_t(ninner) >= size*size*size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// General matrix multiplication C = alpha*op(A)*op(B) + beta*C, with
+/// op(X) = X or X^T according to transa/transb .
+/// op(A) is (m x k), op(B) is (k x n) and C is (m x n). lda, ldb and ldc
+/// are the row lengths of the arrays a, b and c. C may not overlap with A or B.
+
+template<class Element>
+void TMatrixTKernels::Gemm(Bool_t transa,Bool_t transb,Int_t m,Int_t n,Int_t k,Element alpha,
+                           const Element *a,Int_t lda,const Element *b,Int_t ldb,
+                           Element beta,Element *c,Int_t ldc)
+{
+   GemmImpl(transa,transb,m,n,k,alpha,a,lda,b,ldb,beta,c,ldc,kTRUE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Blocked LU decomposition with partial pivoting of the square (n x n)
+/// matrix a. The storage of the result follows TDecompLU::DecomposeLUCrout:
+/// U is explicit in the upper triangle and L is in multiplier form in the
+/// subdiagonals; index[j] is the row interchanged with row j at step j and
+/// sign is +/- 1 for an even/odd number of interchanges. With implicitPivot
+/// the pivot is selected after scaling each row by its largest element
+/// (like the Crout algorithm), otherwise the largest element of the column
+/// is used (like DecomposeLUGauss).
+/// nrZeros counts the diagonal elements of U smaller than tol.
+/// Return kFALSE if the matrix is singular.
+
+Bool_t TMatrixTKernels::LUDecompose(Double_t *a,Int_t n,Int_t *index,Double_t &sign,Double_t tol,
+                                    Int_t &nrZeros,Bool_t implicitPivot)
+{
+   sign    = 1.0;
+   nrZeros = 0;
+
+   std::vector<Double_t> scale;
+   if (implicitPivot) {
+      scale.resize(n);
+      for (Int_t i = 0; i < n; i++) {
+         const Double_t *ai = a+i*n;
+         Double_t max = 0.0;
+         for (Int_t j = 0; j < n; j++)
+            max = TMath::Max(max,TMath::Abs(ai[j]));
+         scale[i] = (max == 0.0 ? 0.0 : 1.0/max);
+      }
+   }
+
+   for (Int_t kb = 0; kb < n; kb += kNB) {
+      const Int_t jb   = TMath::Min(kNB,n-kb);
+      const Int_t kend = kb+jb;
+
+      // Factorize the panel of columns kb:kend
+      for (Int_t j = kb; j < kend; j++) {
+         Int_t imax = j;
+         if (implicitPivot) {
+            Double_t max = 0.0;
+            for (Int_t i = j; i < n; i++) {
+               const Double_t tmp = scale[i]*TMath::Abs(a[i*n+j]);
+               if (tmp >= max) {
+                  max  = tmp;
+                  imax = i;
+               }
+            }
+         } else {
+            Double_t max = TMath::Abs(a[j*n+j]);
+            for (Int_t i = j+1; i < n; i++) {
+               const Double_t tmp = TMath::Abs(a[i*n+j]);
+               if (tmp > max) {
+                  max  = tmp;
+                  imax = i;
+               }
+            }
+         }
+
+         if (imax != j) {
+            std::swap_ranges(a+j*n,a+(j+1)*n,a+imax*n);
+            sign = -sign;
+            if (implicitPivot) scale[imax] = scale[j];
+         }
+         index[j] = imax;
+
+         const Double_t pivot = a[j*n+j];
+         // like DecomposeLUGauss, the last pivot is not checked without implicit pivoting
+         if (!implicitPivot && j == n-1) break;
+         if (pivot == 0.0)
+            return kFALSE;
+         if (TMath::Abs(pivot) < tol)
+            nrZeros++;
+
+         const Double_t invPivot = 1.0/pivot;
+         const Double_t *aj = a+j*n;
+         ParallelFor(n-j-1,256,[&](Int_t first,Int_t last) {
+            for (Int_t i = j+1+first; i < j+1+last; i++) {
+               Double_t *ai = a+i*n;
+               const Double_t l = (ai[j] *= invPivot);
+               for (Int_t c = j+1; c < kend; c++)
+                  ai[c] -= l*aj[c];
+            }
+         });
+      }
+
+      if (kend >= n) break;
+
+      // U12 = inv(L11) * A12
+      ParallelFor(n-kend,kNR*8,[&](Int_t first,Int_t last) {
+         for (Int_t i = kb+1; i < kend; i++) {
+            Double_t *ai = a+i*n+kend;
+            for (Int_t r = kb; r < i; r++) {
+               const Double_t l = a[i*n+r];
+               const Double_t *ar = a+r*n+kend;
+               for (Int_t c = first; c < last; c++)
+                  ai[c] -= l*ar[c];
+            }
+         }
+      });
+
+      // A22 -= L21 * U12
+      GemmImpl(kFALSE,kFALSE,n-kend,n-kend,jb,-1.0,a+kend*n+kb,n,a+kb*n+kend,n,1.0,a+kend*n+kend,n,kTRUE);
+   }
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the LU decomposition of a square matrix (as produced by
+/// LUDecompose or TDecompLU::DecomposeLUCrout) by the inverse of the
+/// matrix. The blocked algorithms first invert U in place and then solve
+/// inv(A)*L = inv(U) (LAPACK dtrtri and dgetri).
+
+void TMatrixTKernels::LUInvert(Double_t *a,Int_t n,const Int_t *index)
+{
+   //  Form inv(U) in the upper triangle
+
+   for (Int_t j = 0; j < n; j += kNB) {
+      const Int_t jb = TMath::Min(kNB,n-j);
+      if (j > 0) {
+         // A(0:j,j:j+jb) = inv(U(0:j,0:j)) * A(0:j,j:j+jb)
+         std::vector<Double_t> block(j*jb);
+         for (Int_t i = 0; i < j; i++)
+            std::copy(a+i*n+j,a+i*n+j+jb,&block[i*jb]);
+         ParallelFor(j,16,[&](Int_t first,Int_t last) {
+            std::vector<Double_t> acc(jb);
+            for (Int_t i = first; i < last; i++) {
+               std::fill(acc.begin(),acc.end(),0.0);
+               const Double_t *ai = a+i*n;
+               for (Int_t r = i; r < j; r++) {
+                  const Double_t t = ai[r];
+                  const Double_t *br = &block[r*jb];
+                  for (Int_t c = 0; c < jb; c++)
+                     acc[c] += t*br[c];
+               }
+               // then A(i,j:j+jb) = -A(i,j:j+jb) * inv(U(j:j+jb,j:j+jb))
+               Double_t *x = a+i*n+j;
+               for (Int_t c = 0; c < jb; c++) {
+                  Double_t s = acc[c];
+                  for (Int_t r = 0; r < c; r++)
+                     s -= x[r]*a[(j+r)*n+j+c];
+                  x[c] = s/a[(j+c)*n+j+c];
+               }
+               for (Int_t c = 0; c < jb; c++)
+                  x[c] = -x[c];
+            }
+         });
+      }
+      InvertUpperUnblocked(a+j*n+j,n,jb);
+   }
+
+   // Solve the equation inv(A)*L = inv(U) for inv(A), from the last block column
+
+   const Int_t nlast = ((n-1)/kNB)*kNB;
+   std::vector<Double_t> work(n*kNB);
+   for (Int_t j = nlast; j >= 0; j -= kNB) {
+      const Int_t jb   = TMath::Min(kNB,n-j);
+      const Int_t jend = j+jb;
+
+      // copy the block column of L to work and replace it with zeros
+      for (Int_t i = j; i < n; i++) {
+         Double_t *ai = a+i*n+j;
+         Double_t *wi = &work[i*jb];
+         for (Int_t c = 0; c < jb; c++) {
+            if (i > j+c) {
+               wi[c] = ai[c];
+               ai[c] = 0.0;
+            } else
+               wi[c] = 0.0;
+         }
+      }
+
+      // A(:,j:jend) -= A(:,jend:n) * L(jend:n,j:jend)
+      if (jend < n)
+         GemmImpl(kFALSE,kFALSE,n,jb,n-jend,-1.0,a+jend,n,&work[jend*jb],jb,1.0,a+j,n,kTRUE);
+
+      // A(:,j:jend) = A(:,j:jend) * inv(L(j:jend,j:jend))
+      ParallelFor(n,64,[&](Int_t first,Int_t last) {
+         for (Int_t i = first; i < last; i++) {
+            Double_t *x = a+i*n+j;
+            for (Int_t c = jb-1; c >= 0; c--) {
+               Double_t s = x[c];
+               for (Int_t r = c+1; r < jb; r++)
+                  s -= x[r]*work[(j+r)*jb+c];
+               x[c] = s;
+            }
+         }
+      });
+   }
+
+   // Apply column interchanges
+   ParallelFor(n,64,[&](Int_t first,Int_t last) {
+      for (Int_t i = first; i < last; i++) {
+         Double_t *ai = a+i*n;
+         for (Int_t j = n-1; j >= 0; j--) {
+            const Int_t jperm = index[j];
+            if (jperm != j) std::swap(ai[j],ai[jperm]);
+         }
+      }
+   });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Blocked Cholesky decomposition A = U^T U of the symmetric positive
+/// definite (n x n) matrix a. Only the upper triangle of a is used and it is
+/// replaced by U; the lower triangle is left in an undefined state.
+/// Return kFALSE if the matrix is not positive definite.
+
+Bool_t TMatrixTKernels::CholeskyDecompose(Double_t *a,Int_t n)
+{
+   for (Int_t kb = 0; kb < n; kb += kNB) {
+      const Int_t jb   = TMath::Min(kNB,n-kb);
+      const Int_t kend = kb+jb;
+
+      // Factorize the diagonal block
+      for (Int_t j = kb; j < kend; j++) {
+         Double_t ujj = a[j*n+j];
+         for (Int_t r = kb; r < j; r++)
+            ujj -= a[r*n+j]*a[r*n+j];
+         if (ujj <= 0)
+            return kFALSE;
+         ujj = TMath::Sqrt(ujj);
+         a[j*n+j] = ujj;
+         for (Int_t c = j+1; c < kend; c++) {
+            Double_t s = a[j*n+c];
+            for (Int_t r = kb; r < j; r++)
+               s -= a[r*n+j]*a[r*n+c];
+            a[j*n+c] = s/ujj;
+         }
+      }
+
+      if (kend >= n) break;
+
+      // U12 = inv(U11^T) * A12
+      ParallelFor(n-kend,kNR*8,[&](Int_t first,Int_t last) {
+         for (Int_t j = kb; j < kend; j++) {
+            Double_t *aj = a+j*n+kend;
+            for (Int_t r = kb; r < j; r++) {
+               const Double_t u = a[r*n+j];
+               const Double_t *ar = a+r*n+kend;
+               for (Int_t c = first; c < last; c++)
+                  aj[c] -= u*ar[c];
+            }
+            const Double_t invDiag = 1.0/a[j*n+j];
+            for (Int_t c = first; c < last; c++)
+               aj[c] *= invDiag;
+         }
+      });
+
+      // A22 -= U12^T * U12 , upper triangle only: block rows of A22 updated
+      // from their diagonal to the last column
+      const Int_t m = n-kend;
+      const Int_t nrowBlocks = (m+kMC-1)/kMC;
+      const Double_t *u12 = a+kb*n+kend;
+      ParallelFor(nrowBlocks,1,[&](Int_t first,Int_t last) {
+         for (Int_t ib = first; ib < last; ib++) {
+            const Int_t i0 = ib*kMC;
+            const Int_t mb = TMath::Min(kMC,m-i0);
+            GemmImpl(kTRUE,kFALSE,mb,m-i0,jb,-1.0,u12+i0,n,u12+i0,n,1.0,a+(kend+i0)*n+kend+i0,n,kFALSE);
+         }
+      });
+   }
+
+   return kTRUE;
+}
+
+template void TMatrixTKernels::Gemm<Float_t> (Bool_t transa,Bool_t transb,Int_t m,Int_t n,Int_t k,Float_t alpha,
+                                              const Float_t *a,Int_t lda,const Float_t *b,Int_t ldb,
+                                              Float_t beta,Float_t *c,Int_t ldc);
+template void TMatrixTKernels::Gemm<Double_t>(Bool_t transa,Bool_t transb,Int_t m,Int_t n,Int_t k,Double_t alpha,
+                                              const Double_t *a,Int_t lda,const Double_t *b,Int_t ldb,
+                                              Double_t beta,Double_t *c,Int_t ldc);
@@ -18,4 +18,18 @@
 #include <stdlib.h>
 #endif
 
+// Use a per-thread pooled arena for the linear algebra temporaries
+// (see StackAllocator.h) unless the non thread-safe stack allocator is
+// requested or MN_NO_THREAD_ARENA is defined. It requires support for the
+// C++11 thread_local keyword.
+#if !defined(MN_USE_STACK_ALLOC) && !defined(MN_NO_THREAD_ARENA) && (__cplusplus >= 201103L)
+# if defined(__clang__)
+#  if __has_feature(cxx_thread_local)
+#   define MN_USE_THREAD_ARENA
+#  endif
+# elif !defined(__GNUC__) || (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)
+#  define MN_USE_THREAD_ARENA
+# endif
+#endif
+
 #endif
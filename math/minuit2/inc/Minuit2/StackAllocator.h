@@ -47,6 +47,11 @@ class StackError {};
     of heap memory which is then used like a stack, otherwise via standard
     malloc/free. Note that defining _MN_NO_THREAD_SAVE_ makes the code thread-
     unsave. The gain in performance is mainly for cost-cheap FCN functions.
+
+    When MN_USE_THREAD_ARENA is defined (the default, see MnConfig.h) the
+    thread-safe path does not call malloc for every block but takes the memory
+    from a pool owned by the calling thread (see ArenaAllocate). Blocks can be
+    released from any thread.
  */
 
 class StackAllocator {
@@ -93,6 +98,8 @@ public:
       CheckConsistency();
 #endif
 
+#elif defined(MN_USE_THREAD_ARENA)
+      void* result = ArenaAllocate(nBytes);
 #else
       void* result = malloc(nBytes);
       if (!result) throw std::bad_alloc();
@@ -123,6 +130,8 @@ public:
 #ifdef DEBUG_ALLOCATOR
       CheckConsistency();
 #endif
+#elif defined(MN_USE_THREAD_ARENA)
+      ArenaDeallocate(p);
 #else
       free(p);
 #endif
@@ -130,6 +139,22 @@ public:
       //   << " deallocated, fStackOffset = " << fStackOffset << std::endl;
   }
 
+#ifdef MN_USE_THREAD_ARENA
+  /// allocate nBytes from the pool of the calling thread. Small blocks are
+  /// recycled through per-size free lists, so that the temporaries created in
+  /// every iteration of the minimization do not go through malloc; when all
+  /// the blocks of a thread are released the whole pool is reset at once.
+  /// Large blocks are taken directly with malloc
+  static void* ArenaAllocate(size_t nBytes);
+
+  /// release a block obtained with ArenaAllocate. It can be called from any
+  /// thread, also after the thread which allocated the block has terminated
+  static void ArenaDeallocate(void* p);
+
+  /// number of blocks allocated by the calling thread and not yet released
+  static long ArenaLiveBlocks();
+#endif
+
   int ReadInt( int offset) {
       int* ip = (int*)(fStack+offset);
 
@@ -0,0 +1,267 @@
+// @(#)root/minuit2:$Id$
+// Authors: M. Winkler, F. James, L. Moneta, A. Zsenei   2003-2005
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2005 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/StackAllocator.h"
+
+#ifdef MN_USE_THREAD_ARENA
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+namespace {
+
+// Memory pool owned by a single thread.
+//
+// Every block is preceded by a header recording the owning pool and the size
+// class. Small blocks are carved from large slabs and recycled through one
+// free list per size class, which only the owning thread touches. Blocks
+// released by another thread are pushed onto a lock-free list which the owner
+// takes over in one go when its free list of that size runs empty.
+// The pool counts the blocks which are still alive (plus one reference held by
+// the owning thread): when the count drops back to the thread reference alone,
+// all the slabs are rewound at once; when it drops to zero (the thread has
+// terminated and the last block has been released) the pool is deleted.
+
+const unsigned int kNClasses  = 12;          // block sizes 32 bytes ... 64 kB
+const unsigned int kMinBlock  = 32;
+const size_t       kSlabSize  = 256 * 1024;
+const unsigned int kLargeBlock = kNClasses;  // size class of the blocks taken with malloc
+
+class ArenaPool;
+
+struct BlockHeader {
+   ArenaPool*   fOwner;
+   unsigned int fClass;
+   unsigned int fPad;
+};
+
+// payload follows the header and keeps the 16-byte alignment of malloc
+const size_t kHeaderSize = 16;
+
+struct FreeBlock {
+   FreeBlock* fNext;
+};
+
+struct Slab {
+   Slab* fNext;
+};
+
+inline BlockHeader* HeaderOf(void* p) {
+   return reinterpret_cast<BlockHeader*>(static_cast<char*>(p) - kHeaderSize);
+}
+
+inline FreeBlock* PayloadOf(BlockHeader* h) {
+   return reinterpret_cast<FreeBlock*>(reinterpret_cast<char*>(h) + kHeaderSize);
+}
+
+inline unsigned int SizeClass(size_t nBytes) {
+   size_t block = nBytes + kHeaderSize;
+   unsigned int c = 0;
+   size_t size = kMinBlock;
+   while (size < block && c < kNClasses) {
+      size <<= 1;
+      ++c;
+   }
+   return c;
+}
+
+class ArenaPool {
+
+public:
+
+   ArenaPool() : fSlabs(0), fCurrentSlab(0), fCurrent(0), fEnd(0), fRefs(1), fRemote(0) {
+      for (unsigned int i = 0; i < kNClasses; ++i) fFree[i] = 0;
+   }
+
+   ~ArenaPool() {
+      while (fSlabs) {
+         Slab* next = fSlabs->fNext;
+         free(fSlabs);
+         fSlabs = next;
+      }
+   }
+
+   void* Allocate(unsigned int c) {
+      FreeBlock* b = fFree[c];
+      if (!b) {
+         DrainRemote();
+         b = fFree[c];
+      }
+      BlockHeader* h;
+      if (b) {
+         fFree[c] = b->fNext;
+         h = HeaderOf(b);
+      }
+      else {
+         h = Carve(c);
+      }
+      h->fOwner = this;
+      h->fClass = c;
+      fRefs.fetch_add(1, std::memory_order_relaxed);
+      return PayloadOf(h);
+   }
+
+   // release from the owning thread
+   void ReleaseLocal(BlockHeader* h) {
+      FreeBlock* b = PayloadOf(h);
+      b->fNext = fFree[h->fClass];
+      fFree[h->fClass] = b;
+      if (fRefs.fetch_sub(1, std::memory_order_acq_rel) == 2) Rewind();
+   }
+
+   // release from any other thread. Returns true if the pool must be deleted
+   bool ReleaseRemote(BlockHeader* h) {
+      FreeBlock* b = PayloadOf(h);
+      FreeBlock* head = fRemote.load(std::memory_order_relaxed);
+      do {
+         b->fNext = head;
+      } while (!fRemote.compare_exchange_weak(head, b, std::memory_order_release, std::memory_order_relaxed));
+      return fRefs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+   }
+
+   // drop the reference of the owning thread. Returns true if the pool must be deleted
+   bool ReleaseOwner() {
+      return fRefs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+   }
+
+   long LiveBlocks() const {
+      return fRefs.load(std::memory_order_acquire) - 1;
+   }
+
+private:
+
+   BlockHeader* Carve(unsigned int c) {
+      size_t size = size_t(kMinBlock) << c;
+      if (size_t(fEnd - fCurrent) < size) {
+         // the tail of the current slab is lost until the next rewind
+         if (fCurrentSlab && fCurrentSlab->fNext) {
+            fCurrentSlab = fCurrentSlab->fNext;
+         }
+         else {
+            Slab* s = static_cast<Slab*>(malloc(kSlabSize));
+            if (!s) throw std::bad_alloc();
+            s->fNext = 0;
+            if (fCurrentSlab) fCurrentSlab->fNext = s;
+            else fSlabs = s;
+            fCurrentSlab = s;
+         }
+         fCurrent = reinterpret_cast<char*>(fCurrentSlab) + kHeaderSize;
+         fEnd = reinterpret_cast<char*>(fCurrentSlab) + kSlabSize;
+      }
+      BlockHeader* h = reinterpret_cast<BlockHeader*>(fCurrent);
+      fCurrent += size;
+      return h;
+   }
+
+   void DrainRemote() {
+      FreeBlock* b = fRemote.exchange(0, std::memory_order_acquire);
+      while (b) {
+         FreeBlock* next = b->fNext;
+         unsigned int c = HeaderOf(b)->fClass;
+         b->fNext = fFree[c];
+         fFree[c] = b;
+         b = next;
+      }
+   }
+
+   // no block is alive any more: reuse all the slabs from the beginning
+   void Rewind() {
+      fRemote.store(0, std::memory_order_relaxed);
+      for (unsigned int i = 0; i < kNClasses; ++i) fFree[i] = 0;
+      fCurrentSlab = fSlabs;
+      if (fSlabs) {
+         fCurrent = reinterpret_cast<char*>(fSlabs) + kHeaderSize;
+         fEnd = reinterpret_cast<char*>(fSlabs) + kSlabSize;
+      }
+   }
+
+   Slab*                   fSlabs;
+   Slab*                   fCurrentSlab;
+   char*                   fCurrent;
+   char*                   fEnd;
+   FreeBlock*              fFree[kNClasses];
+   std::atomic<long>       fRefs;
+   std::atomic<FreeBlock*> fRemote;
+};
+
+// Holds the pool of the thread. The pool survives the thread if some of its
+// blocks are still alive (e.g. a FunctionMinimum returned to another thread)
+struct ArenaHolder {
+   ArenaPool* fPool;
+   ArenaHolder() : fPool(new ArenaPool()) {}
+   ~ArenaHolder() {
+      ArenaPool* pool = fPool;
+      fPool = 0;
+      gCurrentPool = 0;
+      gThreadDone = true;
+      if (pool->ReleaseOwner()) delete pool;
+   }
+   static thread_local ArenaPool* gCurrentPool;
+   static thread_local bool       gThreadDone;
+};
+
+thread_local ArenaPool* ArenaHolder::gCurrentPool = 0;
+thread_local bool       ArenaHolder::gThreadDone = false;
+
+inline ArenaPool* CurrentPool() {
+   ArenaPool* pool = ArenaHolder::gCurrentPool;
+   if (!pool && !ArenaHolder::gThreadDone) {
+      static thread_local ArenaHolder holder;
+      pool = ArenaHolder::gCurrentPool = holder.fPool;
+   }
+   return pool;
+}
+
+} // anonymous namespace
+
+
+void* StackAllocator::ArenaAllocate(size_t nBytes) {
+   unsigned int c = SizeClass(nBytes);
+   ArenaPool* pool = (c < kNClasses) ? CurrentPool() : 0;
+   if (pool) return pool->Allocate(c);
+
+   // large blocks and allocations during the thread shutdown go to malloc
+   BlockHeader* h = static_cast<BlockHeader*>(malloc(nBytes + kHeaderSize));
+   if (!h) throw std::bad_alloc();
+   h->fOwner = 0;
+   h->fClass = kLargeBlock;
+   return PayloadOf(h);
+}
+
+void StackAllocator::ArenaDeallocate(void* p) {
+   if (!p) return;
+   BlockHeader* h = HeaderOf(p);
+   ArenaPool* owner = h->fOwner;
+   if (!owner) {
+      free(h);
+      return;
+   }
+   if (owner == ArenaHolder::gCurrentPool) {
+      owner->ReleaseLocal(h);
+   }
+   else if (owner->ReleaseRemote(h)) {
+      delete owner;
+   }
+}
+
+long StackAllocator::ArenaLiveBlocks() {
+   ArenaPool* pool = ArenaHolder::gCurrentPool;
+   return pool ? pool->LiveBlocks() : 0;
+}
+
+   }  // namespace Minuit2
+
+}  // namespace ROOT
+
+#endif
@@ -0,0 +1,136 @@
+// @(#)root/minuit2:$Id$
+// Authors: M. Winkler, F. James, L. Moneta, A. Zsenei   2003-2005
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2005 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnUserParameters.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnHesse.h"
+#include "Minuit2/FCNBase.h"
+#include "Minuit2/StackAllocator.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// benchmark of many small independent fits executed in parallel threads,
+// which is dominated by the allocation of the Minuit2 linear algebra
+// temporaries. Each fit is a binned chi2 fit of a Gaussian plus a linear
+// background (5 parameters) followed by Hesse.
+// The results obtained in the threads are compared with the ones obtained
+// sequentially, since the fits are independent they must be identical.
+// Usage:
+// ./test_Minuit2_ParallelFits    nthreads  nfits
+
+using namespace ROOT::Minuit2;
+
+const int default_nthreads = 4;
+const int default_nfits = 2000;
+const int nbins = 50;
+
+struct GausPlusLineFCN : public FCNBase {
+
+   GausPlusLineFCN(const std::vector<double> & x, const std::vector<double> & y) : fX(x), fY(y) {}
+
+   double operator() (const std::vector<double> & p) const {
+      double chi2 = 0;
+      for (unsigned int i = 0; i < fX.size(); ++i) {
+         double t = (fX[i] - p[1])/p[2];
+         double f = p[0]*std::exp(-0.5*t*t) + p[3] + p[4]*fX[i];
+         double err2 = std::max(fY[i], 1.);
+         chi2 += (fY[i] - f)*(fY[i] - f)/err2;
+      }
+      return chi2;
+   }
+   double Up() const { return 1.; }
+
+   const std::vector<double> & fX;
+   const std::vector<double> & fY;
+};
+
+// perform the fit with index ifit; the data depend only on the fit index
+double doFit(int ifit) {
+
+   std::mt19937 rng(ifit);
+   std::vector<double> x(nbins);
+   std::vector<double> y(nbins);
+   for (int i = 0; i < nbins; ++i) {
+      x[i] = -5. + 10.*(i + 0.5)/nbins;
+      double mu = 100.*std::exp(-0.5*x[i]*x[i]) + 20. + 0.5*x[i];
+      std::poisson_distribution<int> pois(mu);
+      y[i] = pois(rng);
+   }
+
+   GausPlusLineFCN fcn(x, y);
+
+   MnUserParameters upar;
+   upar.Add("norm", 80., 1.);
+   upar.Add("mean", 0.2, 0.1);
+   upar.Add("sigma", 1.2, 0.1);
+   upar.Add("p0", 10., 1.);
+   upar.Add("p1", 0., 0.1);
+
+   MnMigrad migrad(fcn, upar);
+   FunctionMinimum min = migrad();
+   MnHesse hesse;
+   hesse(fcn, min);
+   return min.Fval();
+}
+
+int main(int argc, char **argv) {
+   int nthreads = default_nthreads;
+   int nfits = default_nfits;
+   if (argc > 1) {
+      nthreads = atoi(argv[1] );
+   }
+   if (argc > 2) {
+      nfits = atoi(argv[2] );
+   }
+   std::cout << "do " << nfits << " fits using " << nthreads << " threads " << std::endl;
+
+   std::vector<double> seqResult(nfits);
+   std::vector<double> parResult(nfits);
+
+   std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+   for (int i = 0; i < nfits; ++i) seqResult[i] = doFit(i);
+   std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+   std::vector<std::thread> threads;
+   for (int it = 0; it < nthreads; ++it) {
+      threads.push_back( std::thread( [&, it]() {
+               for (int i = it; i < nfits; i += nthreads) parResult[i] = doFit(i);
+            } ) );
+   }
+   for (int it = 0; it < nthreads; ++it) threads[it].join();
+   std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+
+   double tseq = std::chrono::duration<double>(t1 - t0).count();
+   double tpar = std::chrono::duration<double>(t2 - t1).count();
+   std::cout << "sequential fits : " << tseq << " s  (" << 1.E6*tseq/nfits << " us/fit)" << std::endl;
+   std::cout << "parallel fits   : " << tpar << " s  (" << 1.E6*tpar/nfits << " us/fit)" << std::endl;
+   if (tpar > 0) std::cout << "speed-up        : " << tseq/tpar << std::endl;
+
+   int nfail = 0;
+   for (int i = 0; i < nfits; ++i) {
+      if (seqResult[i] != parResult[i]) {
+         std::cout << "Error: fit " << i << " gives different results : " << seqResult[i] << "  " << parResult[i] << std::endl;
+         ++nfail;
+      }
+   }
+#ifdef MN_USE_THREAD_ARENA
+   long nlive = StackAllocator::ArenaLiveBlocks();
+   if (nlive != 0) {
+      std::cout << "Error: " << nlive << " blocks of the allocator are not released" << std::endl;
+      ++nfail;
+   }
+#endif
+   return (nfail == 0) ? 0 : 1;
+}
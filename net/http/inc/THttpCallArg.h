@@ -43,6 +43,10 @@ protected:
    void *fBinData;              //! binary data, assigned with http call
    Long_t fBinDataLength;       //! length of binary data
 
+   void *fZipData;              //! content compressed with gzip in advance
+   Long_t fZipDataLength;       //! length of compressed content
+   Bool_t fNotModified;         //! indicate that content not changed since version known by client
+
    Bool_t IsBinData() const
    {
       return fBinData && fBinDataLength > 0;
@@ -268,6 +272,22 @@ public:
 
    Bool_t CompressWithGzip();
 
+   void SetZipData(void *data, Long_t length);
+
+   static void *CompressGzip(const void *data, Long_t objlen, Long_t &zipbuflen);
+
+   void SetNotModified()
+   {
+      // mark reply as 304 - client already has actual content, no content will be send
+
+      fNotModified = kTRUE;
+   }
+
+   Bool_t IsNotModified() const
+   {
+      return fNotModified;
+   }
+
    void SetZipping(Int_t kind)
    {
       // Set kind of content zipping
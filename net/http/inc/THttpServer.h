@@ -21,9 +21,12 @@
 #endif
 
 #include <mutex>
+#include <memory>
+#include <vector>
 
 class THttpEngine;
 class THttpTimer;
+class THttpSnapshot;
 class TRootSniffer;
 
 
@@ -50,9 +53,20 @@ protected:
    std::mutex   fMutex;       //! mutex to protect list with arguments
    TList        fCallArgs;    //! submitted arguments
 
+   Bool_t       fSnapshotMode;     //! when true, read-only requests are processed in engine threads
+   Long_t       fSnapshotInterval; //! interval in ms for automatic publishing of snapshots
+   Long64_t     fLastPublish;      //! time of last publishing
+   ULong64_t    fSnapshotVersion;  //! version of last published snapshot
+   std::shared_ptr<THttpSnapshot> fSnapshot; //! current snapshot, accessed with std::atomic_load/std::atomic_exchange
+   std::vector<std::shared_ptr<THttpSnapshot> > fRetiredSnapshots; //! replaced snapshots, which may be still used by engine threads
+
    // Here any request can be processed
    virtual void ProcessRequest(THttpCallArg *arg);
 
+   Bool_t ProcessSnapshotRequest(THttpCallArg *arg);
+
+   void ReleaseSnapshots();
+
    static Bool_t VerifyFilePath(const char *fname);
 
 public:
@@ -99,6 +113,15 @@ public:
 
    void SetTimer(Long_t milliSec = 100, Bool_t mode = kTRUE);
 
+   void SetSnapshotMode(Bool_t on = kTRUE, Long_t milliSec = 1000);
+
+   Bool_t IsSnapshotMode() const { return fSnapshotMode; }
+
+   /** Publish snapshot of registered objects, must be called from main thread */
+   ULong64_t Publish();
+
+   ULong64_t GetSnapshotVersion() const;
+
    /** Check if file is requested, thread safe */
    Bool_t  IsFileRequested(const char *uri, TString &res) const;
 
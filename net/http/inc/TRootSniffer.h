@@ -12,12 +12,15 @@
 #include "TList.h"
 #endif
 
+#include <memory>
+
 class TFolder;
 class TMemFile;
 class TBufferFile;
 class TDataMember;
 class THttpCallArg;
 class TRootSnifferStore;
+class TRootSnifferCache;
 class TRootSniffer;
 
 class TRootSnifferScanRec {
@@ -128,6 +131,8 @@ protected:
    TString        fCurrentAllowedMethods;  //! list of allowed methods, extracted when analyzed object restrictions
    TList          fRestrictions;    //! list of restrictions for different locations
    TString        fAutoLoad;        //! scripts names, which are add as _autoload parameter to h.json request
+   TFolder       *fTopFolder;       //! top folder of registered objects, when not //root/http (see SetTopFolder)
+   std::shared_ptr<TRootSnifferCache> fCache; //! cache of produced responses, shared with sniffers which copy settings
 
    void ScanObjectMembers(TRootSnifferScanRec &rec, TClass *cl, char *ptr);
 
@@ -146,6 +151,10 @@ protected:
 
    TString DecodeUrlOptionValue(const char *value, Bool_t remove_quotes = kTRUE);
 
+   TFolder *GetTopFolder(Bool_t force = kFALSE);
+
+   TFolder *CopyFolder(TFolder *src);
+
    TObject *GetItem(const char *fullname, TFolder *&parent, Bool_t force = kFALSE, Bool_t within_objects = kTRUE);
 
    TFolder *GetSubFolder(const char *foldername, Bool_t force = kFALSE);
@@ -159,6 +168,13 @@ protected:
 
    Int_t WithCurrentUserName(const char* option);
 
+   virtual ULong_t GetObjectHash(void *obj, TClass *cl);
+
+   Bool_t FindCachedResponse(const char *kind, const char *path, const char *options, void *obj, TClass *cl,
+                             TString &key, ULong_t &hash, TString *str, void **ptr = 0, Long_t *length = 0);
+
+   void AddCachedResponse(const TString &key, ULong_t hash, const void *data, Long_t length);
+
 public:
 
    TRootSniffer(const char *name, const char *objpath = "Objects");
@@ -200,6 +216,21 @@ public:
 
    Bool_t IsScanGlobalDir() const { return fScanGlobalDir; }
 
+   void SetTopFolder(TFolder *topf)
+   {
+      // Use specified folder instead of //root/http as top folder of registered objects
+      // Typically it is copy, produced with CopyTopFolder(); folder is not owned by sniffer
+      fTopFolder = topf;
+   }
+
+   TFolder *CopyTopFolder();
+
+   void SetCacheSize(Int_t maxentries = 100);
+
+   Int_t GetCacheSize() const;
+
+   void CopySettings(const TRootSniffer &src);
+
    Bool_t RegisterObject(const char *subfolder, TObject *obj);
 
    Bool_t UnregisterObject(TObject *obj);
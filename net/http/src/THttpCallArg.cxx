@@ -36,7 +36,10 @@ THttpCallArg::THttpCallArg() :
    fContent(),
    fZipping(0),
    fBinData(0),
-   fBinDataLength(0)
+   fBinDataLength(0),
+   fZipData(0),
+   fZipDataLength(0),
+   fNotModified(kFALSE)
 {
 }
 
@@ -54,6 +57,11 @@ THttpCallArg::~THttpCallArg()
       free(fBinData);
       fBinData = 0;
    }
+
+   if (fZipData) {
+      free(fZipData);
+      fZipData = 0;
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -157,6 +165,18 @@ void THttpCallArg::SetBinData(void *data, Long_t length)
    fContent.Clear();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// set content, compressed with gzip in advance, for instance taken from cache
+/// It will be used by CompressWithGzip() instead of compressing content again
+/// buffer should be allocated with malloc() call
+
+void THttpCallArg::SetZipData(void *data, Long_t length)
+{
+   if (fZipData) free(fZipData);
+   fZipData = data;
+   fZipDataLength = length;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// set complete path of requested http element
 /// For instance, it could be "/folder/subfolder/get.bin"
@@ -216,7 +236,14 @@ void THttpCallArg::FillHttpHeader(TString &hdr, const char *kind)
 {
    if (kind == 0) kind = "HTTP/1.1";
 
-   if ((fContentType.Length() == 0) || Is404()) {
+   if (fNotModified && !Is404()) {
+      hdr.Form("%s 304 Not Modified\r\n"
+               "Connection: keep-alive\r\n"
+               "Content-Length: 0\r\n"
+               "%s\r\n",
+               kind,
+               fHeader.Data());
+   } else if ((fContentType.Length() == 0) || Is404()) {
       hdr.Form("%s 404 Not Found\r\n"
                "Content-Length: 0\r\n"
                "Connection: close\r\n\r\n", kind);
@@ -238,8 +265,31 @@ void THttpCallArg::FillHttpHeader(TString &hdr, const char *kind)
 
 Bool_t THttpCallArg::CompressWithGzip()
 {
-   char *objbuf = (char *) GetContent();
-   Long_t objlen = GetContentLength();
+   // nothing to compress in 304 reply
+   if (fNotModified) return kFALSE;
+
+   if (fZipData) {
+      SetBinData(fZipData, fZipDataLength);
+      fZipData = 0;
+      fZipDataLength = 0;
+   } else {
+      Long_t ziplen = 0;
+      void *buffer = CompressGzip(GetContent(), GetContentLength(), ziplen);
+      SetBinData(buffer, ziplen);
+   }
+
+   SetEncoding("gzip");
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// compress data with gzip compression
+/// returned buffer is allocated with malloc() call
+
+void *THttpCallArg::CompressGzip(const void *data, Long_t objlen, Long_t &zipbuflen)
+{
+   char *objbuf = (char *) data;
 
    unsigned long objcrc = R__crc32(0, NULL, 0);
    objcrc = R__crc32(objcrc, (const unsigned char *) objbuf, objlen);
@@ -285,9 +335,7 @@ Bool_t THttpCallArg::CompressWithGzip()
    *bufcur++ = (objlen >> 16) & 0xff;  // original data length
    *bufcur++ = (objlen >> 24) & 0xff;  // original data length
 
-   SetBinData(buffer, bufcur - (char *) buffer);
+   zipbuflen = bufcur - (char *) buffer;
 
-   SetEncoding("gzip");
-
-   return kTRUE;
+   return buffer;
 }
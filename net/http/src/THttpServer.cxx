@@ -61,6 +61,43 @@ public:
 
 // =======================================================
 
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// THttpSnapshot                                                        //
+//                                                                      //
+// Copy of objects registered to THttpServer, produced in main thread   //
+// by THttpServer::Publish(). Snapshot is never changed after creation  //
+// and therefore can be used by many engine threads at the same time    //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+class THttpSnapshot {
+public:
+
+   ULong64_t     fVersion;    //! version of snapshot
+   TFolder      *fTopFolder;  //! copy of registered objects
+   TRootSniffer  fSettings;   //! restrictions and other settings of server sniffer
+   TString       fTopName;    //! name of top item in objects hierarchy
+
+   THttpSnapshot(ULong64_t version, TRootSniffer *sniff, const char *topname) :
+      fVersion(version), fTopFolder(0), fSettings("snapshot"), fTopName(topname)
+   {
+      // constructor, copies objects registered to the sniffer
+
+      fTopFolder = sniff->CopyTopFolder();
+      fSettings.CopySettings(*sniff);
+   }
+
+   ~THttpSnapshot()
+   {
+      // destructor, deletes copied objects
+
+      delete fTopFolder;
+   }
+};
+
+// =======================================================
+
 //////////////////////////////////////////////////////////////////////////
 //                                                                      //
 // THttpServer                                                          //
@@ -98,6 +135,16 @@ public:
 // enable monitoring flag in the browser - than objects view            //
 // will be regularly updated.                                           //
 //                                                                      //
+// By default all requests are processed in the main thread, when       //
+// gSystem->ProcessEvents() is called. With snapshot mode:              //
+//                                                                      //
+// serv->SetSnapshotMode(kTRUE, 1000);                                  //
+//                                                                      //
+// copies of registered objects are published once per second, and     //
+// read-only requests like root.json are processed directly in the      //
+// threads of the http engine from the last published copy. Commands,   //
+// method execution and images are still processed in the main thread.  //
+//                                                                      //
 // More information: http://root.cern.ch/drupal/content/users-guide     //
 //                                                                      //
 //////////////////////////////////////////////////////////////////////////
@@ -121,13 +168,22 @@ THttpServer::THttpServer(const char *engine) :
    fDefaultPageCont(),
    fDrawPage(),
    fDrawPageCont(),
-   fCallArgs()
+   fCallArgs(),
+   fSnapshotMode(kFALSE),
+   fSnapshotInterval(0),
+   fLastPublish(0),
+   fSnapshotVersion(0),
+   fSnapshot(),
+   fRetiredSnapshots()
 {
    // As argument, one specifies engine kind which should be
    // created like "http:8080". One could specify several engines
    // at once, separating them with ; like "http:8080;fastcgi:9000"
    // One also can configure readonly flag for sniffer like
    // "http:8080;readonly" or "http:8080;readwrite"
+   // With "http:8080;snapshot" read-only requests are processed in
+   // threads of http engines from snapshots of registered objects,
+   // see SetSnapshotMode()
    //
    // Also searches for JavaScript ROOT sources, which are used in web clients
    // Typically JSROOT sources located in $ROOTSYS/etc/http directory,
@@ -194,6 +250,8 @@ THttpServer::THttpServer(const char *engine) :
             GetSniffer()->SetReadOnly(kTRUE);
          } else if ((strcmp(opt, "readwrite") == 0) || (strcmp(opt, "rw") == 0)) {
             GetSniffer()->SetReadOnly(kFALSE);
+         } else if (strcmp(opt, "snapshot") == 0) {
+            SetSnapshotMode(kTRUE);
          } else
             CreateEngine(opt);
       }
@@ -377,6 +435,80 @@ void THttpServer::SetTimer(Long_t milliSec, Bool_t mode)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable snapshot mode
+/// In snapshot mode read-only requests - root.json, root.xml and, when
+/// sniffer does not scan gROOT, h.json, item.json and item.xml - are processed
+/// directly in the threads of http engines, without waiting for the main thread.
+/// Requests use the last snapshot of registered objects, published with Publish().
+/// If milliSec > 0, snapshot is published automatically with such interval,
+/// when ProcessRequests() is invoked by the timer.
+/// Items which are not in the snapshot (like files or trees) and all other
+/// requests, including commands execution, are processed in the main thread.
+
+void THttpServer::SetSnapshotMode(Bool_t on, Long_t milliSec)
+{
+   fSnapshotMode = on;
+   fSnapshotInterval = milliSec;
+
+   if (on) {
+      // objects copies are streamed in different threads
+      ROOT::EnableThreadSafety();
+      Publish();
+   } else {
+      std::shared_ptr<THttpSnapshot> prev = std::atomic_exchange(&fSnapshot, std::shared_ptr<THttpSnapshot>());
+      if (prev) fRetiredSnapshots.push_back(prev);
+      ReleaseSnapshots();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Publish copy of registered objects, used in snapshot mode
+/// Each snapshot gets new version number, which is returned
+/// Snapshot used by engine threads is replaced, but never modified.
+/// Must be called from main thread
+
+ULong64_t THttpServer::Publish()
+{
+   if (!fSnapshotMode || !fSniffer) return 0;
+
+   std::shared_ptr<THttpSnapshot> snap = std::make_shared<THttpSnapshot>(++fSnapshotVersion, fSniffer, fTopName.Data());
+
+   std::shared_ptr<THttpSnapshot> prev = std::atomic_exchange(&fSnapshot, snap);
+   if (prev) fRetiredSnapshots.push_back(prev);
+
+   fLastPublish = (Long64_t) gSystem->Now();
+
+   return fSnapshotVersion;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// returns version of last published snapshot, 0 if none
+/// Method is thread safe
+
+ULong64_t THttpServer::GetSnapshotVersion() const
+{
+   std::shared_ptr<THttpSnapshot> snap = std::atomic_load(&fSnapshot);
+
+   return snap ? snap->fVersion : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// delete replaced snapshots, which are no longer used by any engine thread
+/// Engine threads cannot acquire replaced snapshot again, therefore
+/// objects copies are always deleted in the main thread
+
+void THttpServer::ReleaseSnapshots()
+{
+   std::vector<std::shared_ptr<THttpSnapshot> >::iterator iter = fRetiredSnapshots.begin();
+   while (iter != fRetiredSnapshots.end()) {
+      if (iter->use_count() == 1)
+         iter = fRetiredSnapshots.erase(iter);
+      else
+         iter++;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Checked that filename does not contains relative path below current directory
 /// Used to prevent access to files below current directory
@@ -464,6 +596,9 @@ Bool_t THttpServer::ExecuteHttp(THttpCallArg *arg)
       return kTRUE;
    }
 
+   // read-only requests can be processed in this thread from the snapshot
+   if (ProcessSnapshotRequest(arg)) return kTRUE;
+
    // add call arg to the list
    std::unique_lock<std::mutex> lk(fMutex);
    fCallArgs.Add(arg);
@@ -513,6 +648,11 @@ void THttpServer::ProcessRequests()
       arg->fCond.notify_one();
    }
 
+   if (fSnapshotMode) {
+      if ((fSnapshotInterval > 0) && ((Long64_t) gSystem->Now() - fLastPublish >= fSnapshotInterval)) Publish();
+      ReleaseSnapshots();
+   }
+
    // regularly call Process() method of engine to let perform actions in ROOT context
    TIter iter(&fEngines);
    THttpEngine *engine = 0;
@@ -685,7 +825,72 @@ void THttpServer::ProcessRequest(THttpCallArg *arg)
    }
 
    // try to avoid caching on the browser
-   arg->AddHeader("Cache-Control", "private, no-cache, no-store, must-revalidate, max-age=0, proxy-revalidate, s-maxage=0");
+   // response with ETag can be stored, but browser always has to check if it is still valid
+   if (arg->GetHeader("ETag").Length() > 0)
+      arg->AddHeader("Cache-Control", "private, no-cache, must-revalidate, max-age=0");
+   else
+      arg->AddHeader("Cache-Control", "private, no-cache, no-store, must-revalidate, max-age=0, proxy-revalidate, s-maxage=0");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process read-only request in the calling thread, using last published snapshot
+/// Returns kFALSE when request should be processed in the main thread:
+/// snapshot mode is disabled, request is not read-only or requested item
+/// is not in the snapshot
+
+Bool_t THttpServer::ProcessSnapshotRequest(THttpCallArg *arg)
+{
+   std::shared_ptr<THttpSnapshot> snap = std::atomic_load(&fSnapshot);
+   if (!snap || !snap->fTopFolder) return kFALSE;
+
+   TString filename = arg->fFileName;
+   Bool_t iszip = kFALSE;
+   if (filename.EndsWith(".gz")) {
+      filename.Resize(filename.Length() - 3);
+      iszip = kTRUE;
+   }
+
+   // hierarchy in the snapshot is complete only when gROOT is not scanned
+   Bool_t ishierarchy = (filename == "h.json") || (filename == "item.json") || (filename == "item.xml");
+   if (ishierarchy && snap->fSettings.IsScanGlobalDir()) return kFALSE;
+   if (!ishierarchy && (filename != "root.json") && (filename != "root.xml")) return kFALSE;
+
+   // sniffer used only by this thread, snapshot is never changed
+   TRootSniffer sniff("snapshot");
+   sniff.CopySettings(snap->fSettings);
+   sniff.SetReadOnly(kTRUE);
+   sniff.SetScanGlobalDir(kFALSE);
+   sniff.SetTopFolder(snap->fTopFolder);
+   sniff.SetCurrentCallArg(arg);
+
+   void* bindata(0);
+   Long_t bindatalen(0);
+
+   if (filename == "h.json") {
+      TRootSnifferStoreJson store(arg->fContent, arg->fQuery.Index("compact") != kNPOS);
+      const char *topname = arg->fTopName.Length() > 0 ? arg->fTopName.Data() : snap->fTopName.Data();
+      sniff.ScanHierarchy(topname, arg->fPathName.Data(), &store);
+      arg->SetJson();
+   } else if (sniff.Produce(arg->fPathName.Data(), filename.Data(), arg->fQuery.Data(), bindata, bindatalen, arg->fContent)) {
+      arg->SetContentType(GetMimeType(filename.Data()));
+   } else {
+      // item not found in snapshot, main thread could find it
+      arg->fContent.Clear();
+      return kFALSE;
+   }
+
+   if (iszip) arg->SetZipping(3);
+
+   arg->AddHeader("SVersion", TString::Format("%llu", (unsigned long long) snap->fVersion).Data());
+
+   // try to avoid caching on the browser
+   // response with ETag can be stored, but browser always has to check if it is still valid
+   if (arg->GetHeader("ETag").Length() > 0)
+      arg->AddHeader("Cache-Control", "private, no-cache, must-revalidate, max-age=0");
+   else
+      arg->AddHeader("Cache-Control", "private, no-cache, no-store, must-revalidate, max-age=0, proxy-revalidate, s-maxage=0");
+
+   return kTRUE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
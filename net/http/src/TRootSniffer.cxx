@@ -4,8 +4,19 @@
 #include "TRootSniffer.h"
 
 #include "TH1.h"
+#include "TF1.h"
 #include "TGraph.h"
+#include "TArrayC.h"
+#include "TArrayS.h"
+#include "TArrayI.h"
+#include "TArrayF.h"
+#include "TArrayD.h"
 #include "TProfile.h"
+#include "TAxis.h"
+#include "THashList.h"
+#include "TAttLine.h"
+#include "TAttFill.h"
+#include "TAttMarker.h"
 #include "TCanvas.h"
 #include "TFile.h"
 #include "TKey.h"
@@ -40,6 +51,9 @@
 
 #include <stdlib.h>
 #include <vector>
+#include <map>
+#include <mutex>
+#include <string>
 #include <string.h>
 
 const char *item_prop_kind = "_kind";
@@ -397,6 +411,50 @@ Bool_t TRootSnifferScanRec::GoInside(TRootSnifferScanRec &super, TObject *obj,
 }
 
 
+// ====================================================================
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TRootSnifferCache                                                    //
+//                                                                      //
+// Responses produced by TRootSniffer, stored together with hash of the //
+// object. Response is reused as long as object hash does not change.   //
+// Cache can be shared by several sniffers, running in different        //
+// threads, therefore all accesses are protected by mutex               //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+class TRootSnifferCache {
+public:
+
+   struct Entry {
+      ULong_t     fHash;     ///< hash of the object when response was produced
+      TString     fETag;     ///< entity tag, send to the client together with response
+      std::string fContent;  ///< response content
+      std::string fZipped;   ///< content compressed with gzip, produced when first requested
+      ULong64_t   fLastUse;  ///< value of use counter when entry was last used
+   };
+
+   std::mutex                   fMutex;       ///< protects all members
+   std::map<std::string, Entry> fEntries;     ///< responses, key is request kind, item path and options
+   Int_t                        fMaxEntries;  ///< maximal number of entries
+   ULong64_t                    fUseCounter;  ///< incremented at each use of an entry
+
+   TRootSnifferCache(Int_t maxentries) : fMutex(), fEntries(), fMaxEntries(maxentries), fUseCounter(0) {}
+
+   void RemoveLeastUsed(Int_t maxentries)
+   {
+      // remove least recently used entries until only maxentries remain
+
+      while ((Int_t) fEntries.size() > maxentries) {
+         std::map<std::string, Entry>::iterator iter = fEntries.begin(), oldest = iter;
+         for (; iter != fEntries.end(); ++iter)
+            if (iter->second.fLastUse < oldest->second.fLastUse) oldest = iter;
+         fEntries.erase(oldest);
+      }
+   }
+};
+
 // ====================================================================
 
 //////////////////////////////////////////////////////////////////////////
@@ -427,9 +485,13 @@ TRootSniffer::TRootSniffer(const char *name, const char *objpath) :
    fCurrentRestrict(0),
    fCurrentAllowedMethods(0),
    fRestrictions(),
-   fAutoLoad()
+   fAutoLoad(),
+   fTopFolder(0),
+   fCache()
 {
    fRestrictions.SetOwner(kTRUE);
+
+   SetCacheSize();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -505,6 +567,328 @@ const char* TRootSniffer::GetAutoLoad() const
    return fAutoLoad.Length() > 0 ? fAutoLoad.Data() : 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// copy objects path, access mode, restrictions and autoload scripts
+/// from other sniffer
+
+void TRootSniffer::CopySettings(const TRootSniffer &src)
+{
+   fObjectsPath = src.fObjectsPath;
+   fReadOnly = src.fReadOnly;
+   fScanGlobalDir = src.fScanGlobalDir;
+   fAutoLoad = src.fAutoLoad;
+   fCache = src.fCache;
+
+   fRestrictions.Delete();
+   TIter iter(&src.fRestrictions);
+   TObject *obj = 0;
+   while ((obj = iter()) != 0)
+      fRestrictions.Add(new TNamed(obj->GetName(), obj->GetTitle()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set maximal number of responses, kept in the cache
+/// Responses for root.json, root.xml and root.bin requests are cached
+/// together with hash of the object (see GetObjectHash()) and reused
+/// while object is not changed. Each cached response has ETag header,
+/// which allows the client to get 304 reply without any content for
+/// unchanged object. Compressed response is produced only once.
+/// With maxentries <= 0 cache is disabled.
+
+void TRootSniffer::SetCacheSize(Int_t maxentries)
+{
+   if (maxentries <= 0) {
+      fCache.reset();
+   } else if (!fCache) {
+      fCache = std::make_shared<TRootSnifferCache>(maxentries);
+   } else {
+      std::lock_guard<std::mutex> lk(fCache->fMutex);
+      fCache->fMaxEntries = maxentries;
+      fCache->RemoveLeastUsed(maxentries);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// returns maximal number of cached responses, 0 when cache is disabled
+
+Int_t TRootSniffer::GetCacheSize() const
+{
+   return fCache ? fCache->fMaxEntries : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// hash of the array content
+
+static ULong_t ArrayHash(const TArray *arr)
+{
+   if ((arr == 0) || (arr->GetSize() <= 0)) return 0;
+
+   if (const TArrayD *d = dynamic_cast<const TArrayD *>(arr))
+      return TString::Hash(d->GetArray(), d->GetSize() * sizeof(Double_t));
+   if (const TArrayF *f = dynamic_cast<const TArrayF *>(arr))
+      return TString::Hash(f->GetArray(), f->GetSize() * sizeof(Float_t));
+   if (const TArrayI *i = dynamic_cast<const TArrayI *>(arr))
+      return TString::Hash(i->GetArray(), i->GetSize() * sizeof(Int_t));
+   if (const TArrayS *s = dynamic_cast<const TArrayS *>(arr))
+      return TString::Hash(s->GetArray(), s->GetSize() * sizeof(Short_t));
+   if (const TArrayC *c = dynamic_cast<const TArrayC *>(arr))
+      return TString::Hash(c->GetArray(), c->GetSize() * sizeof(Char_t));
+
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// hash of the values array, 0 for empty array
+
+static ULong_t ValuesHash(const Double_t *values, Int_t n)
+{
+   return ((values == 0) || (n <= 0)) ? 0 : TString::Hash(values, n * sizeof(Double_t));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// hash of the string, 0 for empty string
+
+static ULong_t StringHash(const char *str)
+{
+   return ((str == 0) || (*str == 0)) ? 0 : TString::Hash(str, strlen(str));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// hash of the name, title and drawing attributes of the object
+
+static ULong_t NamedHash(const TObject *obj)
+{
+   ULong_t hash = StringHash(obj->GetName());
+   hash = hash * 1000003 ^ StringHash(obj->GetTitle());
+
+   if (const TAttLine *line = dynamic_cast<const TAttLine *>(obj)) {
+      Double_t values[3] = {(Double_t)line->GetLineColor(), (Double_t)line->GetLineStyle(),
+                            (Double_t)line->GetLineWidth()};
+      hash = hash * 1000003 ^ ValuesHash(values, 3);
+   }
+   if (const TAttFill *fill = dynamic_cast<const TAttFill *>(obj)) {
+      Double_t values[2] = {(Double_t)fill->GetFillColor(), (Double_t)fill->GetFillStyle()};
+      hash = hash * 1000003 ^ ValuesHash(values, 2);
+   }
+   if (const TAttMarker *marker = dynamic_cast<const TAttMarker *>(obj)) {
+      Double_t values[3] = {(Double_t)marker->GetMarkerColor(), (Double_t)marker->GetMarkerStyle(),
+                            (Double_t)marker->GetMarkerSize()};
+      hash = hash * 1000003 ^ ValuesHash(values, 3);
+   }
+
+   return hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// hash of the axis: binning, displayed range, title and bin labels
+
+static ULong_t AxisHash(const TAxis *axis)
+{
+   Double_t values[5] = {(Double_t)axis->GetNbins(), axis->GetXmin(), axis->GetXmax(), (Double_t)axis->GetFirst(),
+                         (Double_t)axis->GetLast()};
+   ULong_t hash = ValuesHash(values, 5);
+   hash = hash * 1000003 ^ ArrayHash(axis->GetXbins());
+   hash = hash * 1000003 ^ StringHash(axis->GetTitle());
+
+   THashList *labels = axis->GetLabels();
+   if (labels) {
+      TIter iter(labels);
+      TObject *label = 0;
+      while ((label = iter()) != 0)
+         hash = hash * 1000003 ^ (StringHash(label->GetName()) + label->GetUniqueID());
+   }
+
+   return hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns hash, used to detect modification of the object between requests
+/// Responses are cached only for objects with non-zero hash.
+/// Implemented for histograms and graphs: hash is calculated from the name,
+/// title and drawing attributes, the axes with their labels, the number of
+/// entries and statistic, the content of all bins or points and the parameters
+/// of the attached functions. It only depends on the content of the object,
+/// therefore it is the same for a copy of the object (see CopyTopFolder()).
+/// Can be reimplemented to provide hash or modification counter for other classes
+
+ULong_t TRootSniffer::GetObjectHash(void *obj, TClass *cl)
+{
+   if ((obj == 0) || (cl == 0) || (cl->GetBaseClassOffset(TObject::Class()) != 0)) return 0;
+
+   TObject *tobj = (TObject *) obj;
+   TList *funcs = 0;
+
+   ULong_t hash = NamedHash(tobj);
+
+   if (cl->InheritsFrom(TH1::Class())) {
+      TH1 *h1 = (TH1 *) tobj;
+      hash = hash * 1000003 ^ AxisHash(h1->GetXaxis());
+      hash = hash * 1000003 ^ AxisHash(h1->GetYaxis());
+      hash = hash * 1000003 ^ AxisHash(h1->GetZaxis());
+
+      Double_t stats[TH1::kNstat + 4];
+      memset(stats, 0, sizeof(stats));
+      h1->GetStats(stats);
+      stats[TH1::kNstat] = h1->GetEntries();
+      stats[TH1::kNstat + 1] = h1->GetMinimumStored();
+      stats[TH1::kNstat + 2] = h1->GetMaximumStored();
+      stats[TH1::kNstat + 3] = h1->GetNormFactor();
+      hash = hash * 1000003 ^ ValuesHash(stats, TH1::kNstat + 4);
+
+      hash = hash * 1000003 ^ ArrayHash(dynamic_cast<TArray *>(h1));
+      hash = hash * 1000003 ^ ArrayHash(h1->GetSumw2());
+      if (TProfile *prof = dynamic_cast<TProfile *>(h1)) {
+         Int_t nbins = prof->GetNbinsX() + 2;
+         std::vector<Double_t> entries(nbins);
+         for (Int_t bin = 0; bin < nbins; ++bin) entries[bin] = prof->GetBinEntries(bin);
+         hash = hash * 1000003 ^ ValuesHash(&entries[0], nbins);
+         hash = hash * 1000003 ^ ArrayHash(prof->GetBinSumw2());
+      }
+      hash = hash * 1000003 ^ StringHash(h1->GetOption());
+      funcs = h1->GetListOfFunctions();
+   } else if (cl->InheritsFrom(TGraph::Class())) {
+      TGraph *gr = (TGraph *) tobj;
+      Int_t npoints = gr->GetN();
+      Double_t values[3] = {(Double_t)npoints, gr->GetMinimum(), gr->GetMaximum()};
+      hash = hash * 1000003 ^ ValuesHash(values, 3);
+      hash = hash * 1000003 ^ ValuesHash(gr->GetX(), npoints);
+      hash = hash * 1000003 ^ ValuesHash(gr->GetY(), npoints);
+      hash = hash * 1000003 ^ ValuesHash(gr->GetEX(), npoints);
+      hash = hash * 1000003 ^ ValuesHash(gr->GetEY(), npoints);
+      hash = hash * 1000003 ^ ValuesHash(gr->GetEXlow(), npoints);
+      hash = hash * 1000003 ^ ValuesHash(gr->GetEXhigh(), npoints);
+      hash = hash * 1000003 ^ ValuesHash(gr->GetEYlow(), npoints);
+      hash = hash * 1000003 ^ ValuesHash(gr->GetEYhigh(), npoints);
+      funcs = gr->GetListOfFunctions();
+   } else {
+      return 0;
+   }
+
+   if (funcs) {
+      hash = hash * 1000003 ^ funcs->GetSize();
+      TIter iter(funcs);
+      TObject *fobj = 0;
+      while ((fobj = iter()) != 0) {
+         hash = hash * 1000003 ^ StringHash(fobj->GetName());
+         TF1 *f1 = dynamic_cast<TF1 *>(fobj);
+         if (f1) hash = hash * 1000003 ^ ValuesHash(f1->GetParameters(), f1->GetNpar());
+      }
+   }
+
+   return hash != 0 ? hash : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// returns current request, when it is request of specified kind like "root.json" or "root.json.gz"
+/// Only such request gets ETag and compressed data of the cached response,
+/// while same method used to produce parts of other requests (like multi.json)
+
+static THttpCallArg *CachedRequest(THttpCallArg *arg, const TString &key)
+{
+   if (arg == 0) return 0;
+
+   TString fname = arg->GetFileName();
+   if (fname.EndsWith(".gz")) fname.Resize(fname.Length() - 3);
+
+   // key starts with request kind
+   return key.BeginsWith(fname + ":") ? arg : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// assign compressed content of cache entry to the request, if it requests gzip data
+/// content is compressed when first required
+
+static void SetCachedZipData(THttpCallArg *arg, TRootSnifferCache::Entry &entry)
+{
+   if ((arg == 0) || !TString(arg->GetFileName()).EndsWith(".gz")) return;
+
+   if (entry.fZipped.empty()) {
+      Long_t ziplen = 0;
+      void *zipped = THttpCallArg::CompressGzip(entry.fContent.data(), entry.fContent.length(), ziplen);
+      entry.fZipped.assign((const char *) zipped, ziplen);
+      free(zipped);
+   }
+
+   void *buf = malloc(entry.fZipped.length());
+   memcpy(buf, entry.fZipped.data(), entry.fZipped.length());
+   arg->SetZipData(buf, entry.fZipped.length());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// search in the cache response, produced for unchanged object
+/// Key of the cache entry and object hash are returned, to be used with AddCachedResponse()
+/// When client already has this response (If-None-Match request header),
+/// request is marked as not modified and no content is returned.
+
+Bool_t TRootSniffer::FindCachedResponse(const char *kind, const char *path, const char *options, void *obj, TClass *cl,
+                                        TString &key, ULong_t &hash, TString *str, void **ptr, Long_t *length)
+{
+   hash = 0;
+   if (!fCache) return kFALSE;
+
+   hash = GetObjectHash(obj, cl);
+   if (hash == 0) return kFALSE;
+
+   key.Form("%s:%s:%s", kind, path, options ? options : "");
+
+   std::lock_guard<std::mutex> lk(fCache->fMutex);
+
+   std::map<std::string, TRootSnifferCache::Entry>::iterator iter = fCache->fEntries.find(key.Data());
+   if ((iter == fCache->fEntries.end()) || (iter->second.fHash != hash)) return kFALSE;
+
+   TRootSnifferCache::Entry &entry = iter->second;
+   entry.fLastUse = ++fCache->fUseCounter;
+
+   THttpCallArg *arg = CachedRequest(fCurrentArg, key);
+
+   if (arg) {
+      arg->AddHeader("ETag", entry.fETag.Data());
+      if (arg->GetRequestHeader("If-None-Match").Index(entry.fETag) != kNPOS) {
+         arg->SetNotModified();
+         if (str) str->Clear();
+         return kTRUE;
+      }
+   }
+
+   if (str) *str = TString(entry.fContent.data(), entry.fContent.length());
+
+   if (ptr && length) {
+      *length = entry.fContent.length();
+      *ptr = malloc(*length);
+      memcpy(*ptr, entry.fContent.data(), *length);
+   }
+
+   SetCachedZipData(arg, entry);
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// add produced response to the cache, see FindCachedResponse()
+
+void TRootSniffer::AddCachedResponse(const TString &key, ULong_t hash, const void *data, Long_t length)
+{
+   if (!fCache || (hash == 0) || (data == 0) || (length <= 0)) return;
+
+   std::lock_guard<std::mutex> lk(fCache->fMutex);
+
+   if (fCache->fEntries.find(key.Data()) == fCache->fEntries.end())
+      fCache->RemoveLeastUsed(fCache->fMaxEntries - 1);
+
+   TRootSnifferCache::Entry &entry = fCache->fEntries[key.Data()];
+   entry.fHash = hash;
+   entry.fETag.Form("\"%lx-%lx\"", (unsigned long) key.Hash(), (unsigned long) hash);
+   entry.fContent.assign((const char *) data, length);
+   entry.fZipped.clear();
+   entry.fLastUse = ++fCache->fUseCounter;
+
+   THttpCallArg *arg = CachedRequest(fCurrentArg, key);
+   if (arg) {
+      arg->AddHeader("ETag", entry.fETag.Data());
+      SetCachedZipData(arg, entry);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Made fast check if item with specified name is in restriction list
 /// If returns true, requires precise check with CheckRestriction() method
@@ -891,7 +1275,7 @@ void TRootSniffer::ScanRoot(TRootSnifferScanRec &rec)
       rec.SetField(item_prop_user, fCurrentArg->GetUserName());
 
    // should be on the top while //root/http folder could have properties for itself
-   TFolder *topf = dynamic_cast<TFolder *>(gROOT->FindObject("//root/http"));
+   TFolder *topf = GetTopFolder();
    if (topf) {
       rec.SetField(item_prop_title, topf->GetTitle());
       ScanCollection(rec, topf->GetListOfFolders());
@@ -1143,8 +1527,16 @@ Bool_t TRootSniffer::ProduceJson(const char *path, const char *options,
    void *obj_ptr = FindInHierarchy(path, &obj_cl, &member);
    if ((obj_ptr == 0) || ((obj_cl == 0) && (member == 0))) return kFALSE;
 
+   // only compact parameter is used, other options should not prevent using the cache
+   TString key;
+   ULong_t hash = 0;
+   if ((member == 0) && FindCachedResponse("root.json", path, TString::Format("compact=%d", compact).Data(),
+                                           obj_ptr, obj_cl, key, hash, &res)) return kTRUE;
+
    res = TBufferJSON::ConvertToJSON(obj_ptr, obj_cl, compact >= 0 ? compact : 0, member ? member->GetName() : 0);
 
+   if (member == 0) AddCachedResponse(key, hash, res.Data(), res.Length());
+
    return res.Length() > 0;
 }
 
@@ -1263,8 +1655,14 @@ Bool_t TRootSniffer::ProduceXml(const char *path, const char * /*options*/,
    void *obj_ptr = FindInHierarchy(path, &obj_cl);
    if ((obj_ptr == 0) || (obj_cl == 0)) return kFALSE;
 
+   TString key;
+   ULong_t hash = 0;
+   if (FindCachedResponse("root.xml", path, 0, obj_ptr, obj_cl, key, hash, &res)) return kTRUE;
+
    res = TBufferXML::ConvertToXML(obj_ptr, obj_cl);
 
+   AddCachedResponse(key, hash, res.Data(), res.Length());
+
    return res.Length() > 0;
 }
 
@@ -1746,6 +2144,14 @@ Bool_t TRootSniffer::ProduceBinary(const char *path, const char * /*query*/, voi
       return kFALSE;
    }
 
+   if (fCurrentArg) fCurrentArg->SetExtraHeader("RootClassName", obj_cl->GetName());
+
+   TString key;
+   ULong_t hash = 0;
+   ptr = 0;
+   length = 0;
+   if (FindCachedResponse("root.bin", path, 0, obj_ptr, obj_cl, key, hash, 0, &ptr, &length)) return kTRUE;
+
    // ensure that memfile exists
    CreateMemFile();
 
@@ -1760,7 +2166,6 @@ Bool_t TRootSniffer::ProduceBinary(const char *path, const char * /*query*/, voi
    sbuf->SetParent(fMemFile);
    sbuf->MapObject(obj);
    obj->Streamer(*sbuf);
-   if (fCurrentArg) fCurrentArg->SetExtraHeader("RootClassName", obj_cl->GetName());
 
    // produce actual version of streamer info
    delete fSinfo;
@@ -1776,6 +2181,8 @@ Bool_t TRootSniffer::ProduceBinary(const char *path, const char * /*query*/, voi
 
    delete sbuf;
 
+   AddCachedResponse(key, hash, ptr, length);
+
    return kTRUE;
 }
 
@@ -1954,10 +2361,13 @@ Bool_t TRootSniffer::Produce(const char *path, const char *file,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// return item from the subfolders structure
+/// return top folder of registered objects
+/// By default it is //root/http folder, created when force is specified
 
-TObject *TRootSniffer::GetItem(const char *fullname, TFolder *&parent, Bool_t force, Bool_t within_objects)
+TFolder *TRootSniffer::GetTopFolder(Bool_t force)
 {
+   if (fTopFolder) return fTopFolder;
+
    TFolder *topf = gROOT->GetRootFolder();
 
    if (topf == 0) {
@@ -1966,14 +2376,75 @@ TObject *TRootSniffer::GetItem(const char *fullname, TFolder *&parent, Bool_t fo
    }
 
    TFolder *httpfold = dynamic_cast<TFolder *>(topf->FindObject("http"));
-   if (httpfold == 0) {
-      if (!force) return 0;
+   if ((httpfold == 0) && force) {
       httpfold = topf->AddFolder("http", "ROOT http server");
       httpfold->SetBit(kCanDelete);
       // register top folder in list of cleanups
       gROOT->GetListOfCleanups()->Add(httpfold);
    }
 
+   return httpfold;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Produce copy of folders structure with all registered objects and item fields
+/// Copy can be used as top folder of other sniffer (see SetTopFolder()),
+/// which then can access objects without interference with the running application.
+/// Objects are cloned; files, directories and trees are not copied together with their fields.
+/// Returned folder owns all its content. Method should be called from main thread.
+
+TFolder *TRootSniffer::CopyTopFolder()
+{
+   TFolder *topf = GetTopFolder();
+
+   return topf ? CopyFolder(topf) : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// copy folder with its content, see CopyTopFolder()
+
+TFolder *TRootSniffer::CopyFolder(TFolder *src)
+{
+   TFolder *dest = new TFolder(src->GetName(), src->GetTitle());
+   dest->SetOwner(kTRUE);
+
+   TIter iter(src->GetListOfFolders());
+   TObject *obj = 0;
+   Bool_t skip = kFALSE;
+   while ((obj = iter()) != 0) {
+      TObject *copy = 0;
+
+      if (IsItemField(obj)) {
+         // fields follow the item in the list, skipped together with the item
+         if (skip) continue;
+         copy = new TNamed(obj->GetName(), obj->GetTitle());
+         copy->SetBit(kItemField);
+      } else if (obj->InheritsFrom(TFolder::Class())) {
+         copy = CopyFolder((TFolder *) obj);
+      } else if (!obj->InheritsFrom(TDirectory::Class()) && !obj->InheritsFrom(TTree::Class())) {
+         // cloned canvas or pad makes itself current pad, which should not change for the application
+         TVirtualPad *save_gPad = gPad;
+         copy = gROOT->CloneObject(obj, kFALSE);
+         gPad = save_gPad;
+         // copy not registered anywhere, therefore no need to cleanup
+         if (copy) copy->ResetBit(kMustCleanup);
+      }
+
+      skip = (copy == 0);
+      if (copy) dest->GetListOfFolders()->Add(copy);
+   }
+
+   return dest;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// return item from the subfolders structure
+
+TObject *TRootSniffer::GetItem(const char *fullname, TFolder *&parent, Bool_t force, Bool_t within_objects)
+{
+   TFolder *httpfold = GetTopFolder(force);
+   if (httpfold == 0) return 0;
+
    parent = httpfold;
    TObject *obj = httpfold;
 
@@ -2063,7 +2534,7 @@ Bool_t TRootSniffer::UnregisterObject(TObject *obj)
 {
    if (obj == 0) return kTRUE;
 
-   TFolder *topf = dynamic_cast<TFolder *>(gROOT->FindObject("//root/http"));
+   TFolder *topf = GetTopFolder();
 
    if (topf == 0) {
       Error("UnregisterObject", "Not found //root/http folder!!!");
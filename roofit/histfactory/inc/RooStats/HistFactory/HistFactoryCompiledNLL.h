@@ -0,0 +1,109 @@
+// @(#)root/roostats:$Id$
+/*************************************************************************
+ * Copyright (C) 1995-2016, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef HISTFACTORY_COMPILEDNLL
+#define HISTFACTORY_COMPILEDNLL
+
+#include "RooAbsReal.h"
+#include "RooListProxy.h"
+#include "RooSetProxy.h"
+#include <vector>
+
+class RooAbsPdf ;
+class RooAbsData ;
+class RooArgSet ;
+class RooDataHist ;
+class PiecewiseInterpolation ;
+
+namespace RooStats{
+  namespace HistFactory{
+
+class HistFactoryCompiledNLL : public RooAbsReal {
+public:
+
+  HistFactoryCompiledNLL() ;
+  HistFactoryCompiledNLL(const char *name, const char *title, RooAbsPdf& pdf, RooAbsData& data,
+                         const RooArgSet* globalObservables=0) ;
+  HistFactoryCompiledNLL(const HistFactoryCompiledNLL& other, const char* name=0) ;
+  virtual TObject* clone(const char* newname) const { return new HistFactoryCompiledNLL(*this,newname); }
+  virtual ~HistFactoryCompiledNLL() ;
+
+  virtual Double_t defaultErrorLevel() const { return 0.5 ; }
+
+  Int_t numChannels() const { return _channels.size() ; }
+  Int_t numBins() const ;
+
+  // Expected number of events in each bin of the channel, for the current parameter values
+  std::vector<Double_t> expectedYields(Int_t channel) const ;
+
+protected:
+
+  // One variation of a PiecewiseInterpolation, stored per bin
+  struct HistoSys {
+    Int_t _param ;                  // index of the interpolation parameter in _parList
+    Int_t _code ;                   // interpolation code
+    std::vector<Double_t> _low ;    // low variation
+    std::vector<Double_t> _high ;   // high variation
+    std::vector<Double_t> _sum ;    // coefficient of the polynomial interpolation (codes 4 and 5)
+    std::vector<Double_t> _asym ;   // coefficient of the polynomial interpolation (codes 4 and 5)
+  } ;
+
+  // A PiecewiseInterpolation of histograms, stored per bin
+  struct Interpolation {
+    std::vector<Double_t> _nominal ;
+    std::vector<HistoSys> _sys ;
+    Bool_t _positiveDefinite ;
+  } ;
+
+  // One term of the RooRealSumPdf of a channel
+  struct Sample {
+    std::vector<Double_t> _shape ;                  // product of the factors that depend on the observables only
+    std::vector<Interpolation> _interps ;           // interpolated factors
+    std::vector<std::vector<Int_t> > _binParams ;   // factors with one parameter per bin (ParamHistFunc)
+    std::vector<Int_t> _scalars ;                   // factors that do not depend on the observables (in _scalarList)
+    std::vector<Int_t> _params ;                    // all parameters of _interps and _binParams
+    mutable std::vector<Double_t> _yields ;         // cached yields, without the scalar factors
+    mutable Bool_t _valid ;                         // _yields are up to date
+  } ;
+
+  struct Channel {
+    std::vector<Double_t> _data ;                   // observed number of events
+    std::vector<Double_t> _binVolume ;
+    std::vector<Sample> _samples ;
+    Double_t _constant ;                            // sum of n * log(binVolume)
+  } ;
+
+  void flattenFactor(RooAbsReal& factor, Sample& sample, RooArgSet& obs, RooDataHist& binning) ;
+  void flattenInterpolation(PiecewiseInterpolation& interp, Sample& sample, RooArgSet& obs, RooDataHist& binning) ;
+  Int_t addParameter(RooAbsArg& param) ;
+  void updateYields() const ;
+
+  Double_t evaluate() const ;
+
+  RooListProxy _parList ;       // parameters that enter per bin
+  RooListProxy _scalarList ;    // factors that do not depend on the observables
+  RooListProxy _constrList ;    // constraint terms
+  RooSetProxy _constrNormSet ;  // normalization set of the constraint terms
+
+  std::vector<Channel> _channels ;              //! flattened model
+  mutable std::vector<Double_t> _parVals ;      //! current parameter values
+  mutable std::vector<Double_t> _lastParVals ;  //! parameter values used for the cached yields
+  mutable std::vector<char> _parChanged ;       //!
+  mutable std::vector<Double_t> _scalarVals ;   //!
+  mutable std::vector<std::vector<Double_t> > _expected ; //! expected yields per channel
+
+private:
+
+  ClassDef(RooStats::HistFactory::HistFactoryCompiledNLL,0) // Flattened -log(L) of a HistFactory model
+};
+
+  }
+}
+
+#endif
@@ -0,0 +1,601 @@
+// @(#)root/roostats:$Id$
+/*************************************************************************
+ * Copyright (C) 1995-2016, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// BEGIN_HTML
+// Class HistFactoryCompiledNLL is the -log(L) of a binned HistFactory model,
+// evaluated on a flattened copy of the model instead of the graph of
+// RooFit objects built by HistoToWorkspaceFactoryFast.
+// <p>
+// At construction, the RooRealSumPdf of each channel is decomposed in its
+// samples and each sample in the factors of its RooProduct. The factors that
+// depend on the observables only (RooHistFunc) are multiplied into one array
+// of yields per bin, the PiecewiseInterpolation of histograms are stored as
+// arrays of nominal, low and high yields per bin, the ParamHistFunc as one
+// parameter index per bin, and the factors that do not depend on the
+// observables (normalization factors, FlexibleInterpVar, luminosity, bin
+// width) are kept as RooAbsReal and evaluated once per sample. The expected
+// yields of all bins and the Poisson -log(L) are then computed in tight loops
+// over contiguous arrays. The yields of a sample are only recomputed when one
+// of its per-bin parameters changes, which is the common case when the
+// minimizer computes a gradient.
+// <p>
+// The constraint terms are taken from the model the same way as
+// RooAbsPdf::createNLL does, and the value is the same as the one of the
+// likelihood created by createNLL(data) (or createNLL(data,GlobalObservables(...))
+// if the global observables are given). The object can be used directly with
+// RooMinimizer:
+// <pre>
+// HistFactoryCompiledNLL nll("nll","nll",*mc->GetPdf(),*data,mc->GetGlobalObservables()) ;
+// RooMinimizer m(nll) ;
+// m.migrad() ;
+// </pre>
+// Models with factors that depend on both the observables and the parameters
+// and are not PiecewiseInterpolation or ParamHistFunc cannot be flattened:
+// the constructor then throws a hf_exc.
+// END_HTML
+//
+
+#include <math.h>
+
+#include "RooFit.h"
+#include "RooStats/HistFactory/HistFactoryCompiledNLL.h"
+#include "RooStats/HistFactory/HistFactoryModelUtils.h"
+#include "RooStats/HistFactory/HistFactoryException.h"
+#include "RooStats/HistFactory/ParamHistFunc.h"
+#include "RooStats/HistFactory/PiecewiseInterpolation.h"
+
+#include "RooAbsPdf.h"
+#include "RooAbsData.h"
+#include "RooDataHist.h"
+#include "RooSimultaneous.h"
+#include "RooRealSumPdf.h"
+#include "RooProduct.h"
+#include "RooRealVar.h"
+#include "RooCatType.h"
+#include "RooMsgService.h"
+#include "TList.h"
+#include "TString.h"
+
+#include <algorithm>
+
+using namespace std ;
+
+ClassImp(RooStats::HistFactory::HistFactoryCompiledNLL)
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the value of arg depends on the observables only
+
+static Bool_t dependsOnObservablesOnly(const RooAbsArg& arg, const RooArgSet& obs)
+{
+  RooArgSet* pars = arg.getParameters(obs) ;
+  Bool_t ret = (pars->getSize()==0) ;
+  delete pars ;
+  return ret ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill values with the value of func in each bin of binning
+
+static void fillPerBin(const RooAbsReal& func, RooArgSet& obs, const RooDataHist& binning, vector<Double_t>& values)
+{
+  values.resize(binning.numEntries()) ;
+  for (Int_t i=0 ; i<binning.numEntries() ; i++) {
+    obs = *binning.get(i) ;
+    values[i] = func.getVal() ;
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor
+
+RooStats::HistFactory::HistFactoryCompiledNLL::HistFactoryCompiledNLL()
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor of the -log(L) of the HistFactory model pdf (a RooSimultaneous
+/// of one RooProdPdf per channel) for the binned dataset data. If given, the
+/// global observables are used to normalize the constraint terms, like the
+/// GlobalObservables() argument of RooAbsPdf::createNLL.
+
+RooStats::HistFactory::HistFactoryCompiledNLL::HistFactoryCompiledNLL(const char *name, const char *title,
+                                                                      RooAbsPdf& pdf, RooAbsData& data,
+                                                                      const RooArgSet* globalObservables) :
+  RooAbsReal(name,title),
+  _parList("!params","Parameters of the flattened model",this),
+  _scalarList("!scalars","Factors that do not depend on the observables",this),
+  _constrList("!constraints","Constraint terms",this),
+  _constrNormSet("!constrNormSet","Normalization set of the constraint terms",this)
+{
+  RooSimultaneous* simPdf = dynamic_cast<RooSimultaneous*>(&pdf) ;
+  if (!simPdf) {
+    coutE(InputArguments) << "HistFactoryCompiledNLL::ctor(" << GetName() << ") ERROR: p.d.f. " << pdf.GetName()
+                          << " is not a RooSimultaneous, it is not a HistFactory model" << endl ;
+    throw hf_exc() ;
+  }
+
+  // The observables are moved to the center of each bin while the model is flattened
+  RooArgSet* allObs = pdf.getObservables(data) ;
+  RooArgSet* allObsSnapshot = (RooArgSet*) allObs->snapshot() ;
+
+  TList* dataByCategory = data.split(simPdf->indexCat(),kTRUE) ;
+
+  TIterator* catIter = simPdf->indexCat().typeIterator() ;
+  RooCatType* type ;
+  while((type=(RooCatType*)catIter->Next())) {
+    RooAbsPdf* channelPdf = simPdf->getPdf(type->GetName()) ;
+    if (!channelPdf) continue ;
+
+    RooRealSumPdf* sumPdf = dynamic_cast<RooRealSumPdf*>(getSumPdfFromChannel(channelPdf)) ;
+    if (!sumPdf) {
+      coutE(InputArguments) << "HistFactoryCompiledNLL::ctor(" << GetName() << ") ERROR: no RooRealSumPdf found in channel "
+                            << channelPdf->GetName() << endl ;
+      throw hf_exc() ;
+    }
+    const RooArgList& funcList = sumPdf->funcList() ;
+    const RooArgList& coefList = sumPdf->coefList() ;
+    if (coefList.getSize()!=0 && coefList.getSize()!=funcList.getSize()) {
+      coutE(InputArguments) << "HistFactoryCompiledNLL::ctor(" << GetName() << ") ERROR: " << sumPdf->GetName()
+                            << " must have one coefficient per function" << endl ;
+      throw hf_exc() ;
+    }
+
+    RooArgSet* obs = sumPdf->getObservables(data) ;
+    RooDataHist binning("binning","binning",*obs) ;
+    const Int_t nBins = binning.numEntries() ;
+
+    _channels.push_back(Channel()) ;
+    Channel& channel = _channels.back() ;
+    channel._binVolume.resize(nBins) ;
+    for (Int_t i=0 ; i<nBins ; i++) {
+      binning.get(i) ;
+      channel._binVolume[i] = binning.binVolume() ;
+    }
+
+    // Observed events, binned like the model
+    channel._data.assign(nBins,0.) ;
+    channel._constant = 0 ;
+    RooAbsData* channelData = dataByCategory ? (RooAbsData*) dataByCategory->FindObject(type->GetName()) : 0 ;
+    if (channelData) {
+      RooDataHist hist("hist","hist",*obs,*channelData) ;
+      for (Int_t i=0 ; i<nBins ; i++) {
+        hist.get(i) ;
+        channel._data[i] = hist.weight() ;
+        if (channel._data[i]>0) channel._constant += channel._data[i]*log(channel._binVolume[i]) ;
+      }
+    }
+
+    for (Int_t j=0 ; j<funcList.getSize() ; j++) {
+      channel._samples.push_back(Sample()) ;
+      Sample& sample = channel._samples.back() ;
+      sample._shape.assign(nBins,1.) ;
+      sample._valid = kFALSE ;
+      if (coefList.getSize()>0) flattenFactor(static_cast<RooAbsReal&>(*coefList.at(j)),sample,*obs,binning) ;
+      flattenFactor(static_cast<RooAbsReal&>(*funcList.at(j)),sample,*obs,binning) ;
+      sort(sample._params.begin(),sample._params.end()) ;
+      sample._params.erase(unique(sample._params.begin(),sample._params.end()),sample._params.end()) ;
+    }
+
+    delete obs ;
+  }
+  delete catIter ;
+
+  if (dataByCategory) {
+    dataByCategory->Delete() ;
+    delete dataByCategory ;
+  }
+
+  *allObs = *allObsSnapshot ;
+  delete allObsSnapshot ;
+  delete allObs ;
+
+  // Constraint terms, selected like in RooAbsPdf::createNLL
+  RooArgSet* cPars = pdf.getParameters(data,kFALSE) ;
+  RooArgSet* constraints = pdf.getAllConstraints(*data.get(),*cPars,kTRUE) ;
+  _constrList.add(*constraints) ;
+  _constrNormSet.add(globalObservables ? *globalObservables : *cPars) ;
+  delete constraints ;
+  delete cPars ;
+
+  _parVals.resize(_parList.getSize()) ;
+  _lastParVals.resize(_parList.getSize()) ;
+  _parChanged.resize(_parList.getSize()) ;
+  _scalarVals.resize(_scalarList.getSize()) ;
+  _expected.resize(_channels.size()) ;
+
+  coutI(Minimization) << "HistFactoryCompiledNLL::ctor(" << GetName() << ") flattened " << _channels.size()
+                      << " channels with " << numBins() << " bins, " << _parList.getSize() << " per-bin parameters and "
+                      << _constrList.getSize() << " constraint terms" << endl ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy constructor
+
+RooStats::HistFactory::HistFactoryCompiledNLL::HistFactoryCompiledNLL(const HistFactoryCompiledNLL& other, const char* name) :
+  RooAbsReal(other,name),
+  _parList("!params",this,other._parList),
+  _scalarList("!scalars",this,other._scalarList),
+  _constrList("!constraints",this,other._constrList),
+  _constrNormSet("!constrNormSet",this,other._constrNormSet),
+  _channels(other._channels),
+  _parVals(other._parVals),
+  _lastParVals(other._lastParVals),
+  _parChanged(other._parChanged),
+  _scalarVals(other._scalarVals),
+  _expected(other._expected)
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+RooStats::HistFactory::HistFactoryCompiledNLL::~HistFactoryCompiledNLL()
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Total number of bins of all channels
+
+Int_t RooStats::HistFactory::HistFactoryCompiledNLL::numBins() const
+{
+  Int_t n(0) ;
+  for (vector<Channel>::const_iterator iter = _channels.begin() ; iter != _channels.end() ; ++iter) {
+    n += iter->_data.size() ;
+  }
+  return n ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add param to the list of per-bin parameters if needed and return its index
+
+Int_t RooStats::HistFactory::HistFactoryCompiledNLL::addParameter(RooAbsArg& param)
+{
+  Int_t idx = _parList.index(&param) ;
+  if (idx<0) {
+    _parList.add(param) ;
+    idx = _parList.getSize()-1 ;
+  }
+  return idx ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store the factor of a sample in the flattened sample
+
+void RooStats::HistFactory::HistFactoryCompiledNLL::flattenFactor(RooAbsReal& factor, Sample& sample,
+                                                                  RooArgSet& obs, RooDataHist& binning)
+{
+  // Factor that does not depend on the observables: evaluated once per sample
+  if (!factor.dependsOn(obs)) {
+    Int_t idx = _scalarList.index(&factor) ;
+    if (idx<0) {
+      _scalarList.add(factor) ;
+      idx = _scalarList.getSize()-1 ;
+    }
+    sample._scalars.push_back(idx) ;
+    return ;
+  }
+
+  // Factor that depends on the observables only: merged in the constant shape
+  if (dependsOnObservablesOnly(factor,obs)) {
+    vector<Double_t> values ;
+    fillPerBin(factor,obs,binning,values) ;
+    for (UInt_t i=0 ; i<values.size() ; i++) sample._shape[i] *= values[i] ;
+    return ;
+  }
+
+  RooProduct* prod = dynamic_cast<RooProduct*>(&factor) ;
+  if (prod) {
+    RooArgList components(prod->components()) ;
+    RooFIter iter = components.fwdIterator() ;
+    RooAbsArg* arg ;
+    while((arg=iter.next())) {
+      RooAbsReal* comp = dynamic_cast<RooAbsReal*>(arg) ;
+      if (!comp) {
+        coutE(InputArguments) << "HistFactoryCompiledNLL::flattenFactor(" << GetName() << ") ERROR: cannot flatten "
+                              << arg->ClassName() << "::" << arg->GetName() << " in " << prod->GetName() << endl ;
+        throw hf_exc() ;
+      }
+      flattenFactor(*comp,sample,obs,binning) ;
+    }
+    return ;
+  }
+
+  ParamHistFunc* paramHist = dynamic_cast<ParamHistFunc*>(&factor) ;
+  if (paramHist) {
+    vector<Int_t> params(binning.numEntries()) ;
+    for (Int_t i=0 ; i<binning.numEntries() ; i++) {
+      obs = *binning.get(i) ;
+      params[i] = addParameter(paramHist->getParameter()) ;
+      sample._params.push_back(params[i]) ;
+    }
+    sample._binParams.push_back(params) ;
+    return ;
+  }
+
+  PiecewiseInterpolation* interp = dynamic_cast<PiecewiseInterpolation*>(&factor) ;
+  if (interp) {
+    flattenInterpolation(*interp,sample,obs,binning) ;
+    return ;
+  }
+
+  coutE(InputArguments) << "HistFactoryCompiledNLL::flattenFactor(" << GetName() << ") ERROR: cannot flatten "
+                        << factor.ClassName() << "::" << factor.GetName()
+                        << ", which depends on both the observables and the parameters" << endl ;
+  throw hf_exc() ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store the PiecewiseInterpolation of histograms interp in the flattened sample
+
+void RooStats::HistFactory::HistFactoryCompiledNLL::flattenInterpolation(PiecewiseInterpolation& interp, Sample& sample,
+                                                                         RooArgSet& obs, RooDataHist& binning)
+{
+  const RooAbsReal* nominal = interp.nominalHist() ;
+  Bool_t ok = dependsOnObservablesOnly(*nominal,obs) ;
+  for (Int_t j=0 ; j<interp.paramList().getSize() ; j++) {
+    ok &= dependsOnObservablesOnly(*interp.lowList().at(j),obs) ;
+    ok &= dependsOnObservablesOnly(*interp.highList().at(j),obs) ;
+    ok &= !interp.paramList().at(j)->dependsOn(obs) ;
+    Int_t code = interp.interpolationCodes()[j] ;
+    ok &= (code>=0 && code<=5) ;
+  }
+  if (!ok) {
+    coutE(InputArguments) << "HistFactoryCompiledNLL::flattenInterpolation(" << GetName() << ") ERROR: cannot flatten "
+                          << interp.GetName() << ", the variations must depend on the observables only and the "
+                          << "interpolation codes must be in [0,5]" << endl ;
+    throw hf_exc() ;
+  }
+
+  sample._interps.push_back(Interpolation()) ;
+  Interpolation& flat = sample._interps.back() ;
+  flat._positiveDefinite = interp.positiveDefinite() ;
+  fillPerBin(*nominal,obs,binning,flat._nominal) ;
+
+  for (Int_t j=0 ; j<interp.paramList().getSize() ; j++) {
+    flat._sys.push_back(HistoSys()) ;
+    HistoSys& sys = flat._sys.back() ;
+    sys._param = addParameter(*interp.paramList().at(j)) ;
+    sys._code = interp.interpolationCodes()[j] ;
+    sample._params.push_back(sys._param) ;
+    fillPerBin(static_cast<const RooAbsReal&>(*interp.lowList().at(j)),obs,binning,sys._low) ;
+    fillPerBin(static_cast<const RooAbsReal&>(*interp.highList().at(j)),obs,binning,sys._high) ;
+
+    // Coefficients of the polynomial interpolation, computed as in PiecewiseInterpolation::evaluate()
+    if (sys._code==4 || sys._code==5) {
+      sys._sum.resize(flat._nominal.size()) ;
+      sys._asym.resize(flat._nominal.size()) ;
+      for (UInt_t i=0 ; i<flat._nominal.size() ; i++) {
+        Double_t epsPlus = sys._high[i] - flat._nominal[i] ;
+        Double_t epsMinus = flat._nominal[i] - sys._low[i] ;
+        if (sys._code==4) {
+          sys._sum[i] = 0.5 * (epsPlus + epsMinus) ;
+          sys._asym[i] = 0.0625 * (epsPlus - epsMinus) ;
+        } else {
+          sys._sum[i] = (epsPlus + epsMinus)/2 ;
+          sys._asym[i] = (epsPlus - epsMinus)/2 ;
+        }
+      }
+    }
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Recompute the expected yields of all bins. The yields of a sample, without its
+/// factors that do not depend on the observables, are only recomputed if one of
+/// its per-bin parameters changed since the last call.
+
+void RooStats::HistFactory::HistFactoryCompiledNLL::updateYields() const
+{
+  Int_t k(0) ;
+  RooFIter parIter = _parList.fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=parIter.next())) {
+    _parVals[k] = static_cast<RooAbsReal*>(arg)->getVal() ;
+    _parChanged[k] = (_parVals[k]!=_lastParVals[k]) ;
+    k++ ;
+  }
+  k = 0 ;
+  RooFIter scalarIter = _scalarList.fwdIterator() ;
+  while((arg=scalarIter.next())) {
+    _scalarVals[k++] = static_cast<RooAbsReal*>(arg)->getVal() ;
+  }
+
+  for (UInt_t c=0 ; c<_channels.size() ; c++) {
+    const Channel& channel = _channels[c] ;
+    const Int_t nBins = channel._data.size() ;
+    vector<Double_t>& expected = _expected[c] ;
+    expected.assign(nBins,0.) ;
+
+    for (vector<Sample>::const_iterator siter = channel._samples.begin() ; siter != channel._samples.end() ; ++siter) {
+      const Sample& sample = *siter ;
+
+      Bool_t valid = sample._valid ;
+      for (UInt_t j=0 ; valid && j<sample._params.size() ; j++) {
+        if (_parChanged[sample._params[j]]) valid = kFALSE ;
+      }
+
+      if (!valid) {
+        vector<Double_t>& yields = sample._yields ;
+        yields = sample._shape ;
+
+        for (vector<Interpolation>::const_iterator iiter = sample._interps.begin() ; iiter != sample._interps.end() ; ++iiter) {
+          const Interpolation& interp = *iiter ;
+          const Double_t* nom = &interp._nominal[0] ;
+          vector<Double_t> sum(interp._nominal) ;
+          Double_t* s = &sum[0] ;
+
+          for (vector<HistoSys>::const_iterator hiter = interp._sys.begin() ; hiter != interp._sys.end() ; ++hiter) {
+            const HistoSys& sys = *hiter ;
+            const Double_t x = _parVals[sys._param] ;
+            const Double_t* lo = &sys._low[0] ;
+            const Double_t* hi = &sys._high[0] ;
+
+            switch (sys._code) {
+            case 0:
+              // piece-wise linear
+              if (x>0) {
+                for (Int_t i=0 ; i<nBins ; i++) s[i] += x*(hi[i] - nom[i]) ;
+              } else {
+                for (Int_t i=0 ; i<nBins ; i++) s[i] += x*(nom[i] - lo[i]) ;
+              }
+              break ;
+            case 1:
+              // piece-wise log
+              if (x>=0) {
+                for (Int_t i=0 ; i<nBins ; i++) s[i] *= pow(hi[i]/nom[i], +x) ;
+              } else {
+                for (Int_t i=0 ; i<nBins ; i++) s[i] *= pow(lo[i]/nom[i], -x) ;
+              }
+              break ;
+            case 2:
+            case 3:
+              // parabolic with linear extrapolation
+              for (Int_t i=0 ; i<nBins ; i++) {
+                Double_t a = 0.5*(hi[i]+lo[i])-nom[i] ;
+                Double_t b = 0.5*(hi[i]-lo[i]) ;
+                if (x>1) {
+                  s[i] += (2*a+b)*(x-1)+hi[i]-nom[i] ;
+                } else if (x<-1) {
+                  s[i] += -1*(2*a-b)*(x+1)+lo[i]-nom[i] ;
+                } else {
+                  s[i] += a*x*x + b*x ;
+                }
+              }
+              break ;
+            case 4: {
+              // polynomial interpolation and linear extrapolation
+              const Double_t* S = &sys._sum[0] ;
+              const Double_t* A = &sys._asym[0] ;
+              if (x>1) {
+                for (Int_t i=0 ; i<nBins ; i++) s[i] += x*(hi[i] - nom[i]) ;
+              } else if (x<-1) {
+                for (Int_t i=0 ; i<nBins ; i++) s[i] += x*(nom[i] - lo[i]) ;
+              } else {
+                const Double_t x2 = x*x ;
+                for (Int_t i=0 ; i<nBins ; i++) {
+                  Double_t val = nom[i] + x * (S[i] + x * A[i] * ( 15 + x2 * (-10 + x2 * 3  ) ) ) ;
+                  if (val<0) val = 0 ;
+                  s[i] += val-nom[i] ;
+                }
+              }
+              break ;
+            }
+            case 5: {
+              const Double_t* S = &sys._sum[0] ;
+              const Double_t* A = &sys._asym[0] ;
+              if (x>1) {
+                for (Int_t i=0 ; i<nBins ; i++) s[i] += x*(hi[i] - nom[i]) ;
+              } else if (x<-1) {
+                for (Int_t i=0 ; i<nBins ; i++) s[i] += x*(nom[i] - lo[i]) ;
+              } else {
+                for (Int_t i=0 ; i<nBins ; i++) {
+                  if (nom[i]==0) continue ;
+                  Double_t val = nom[i] + S[i]*x + 3*A[i]/2*x*x - A[i]/2*x*x*x*x ;
+                  if (val<0) val = 0 ;
+                  s[i] += val-nom[i] ;
+                }
+              }
+              break ;
+            }
+            }
+          }
+
+          if (interp._positiveDefinite) {
+            for (Int_t i=0 ; i<nBins ; i++) if (s[i]<0) s[i] = 0 ;
+          }
+          for (Int_t i=0 ; i<nBins ; i++) yields[i] *= s[i] ;
+        }
+
+        for (vector<vector<Int_t> >::const_iterator biter = sample._binParams.begin() ; biter != sample._binParams.end() ; ++biter) {
+          const Int_t* idx = &(*biter)[0] ;
+          for (Int_t i=0 ; i<nBins ; i++) yields[i] *= _parVals[idx[i]] ;
+        }
+
+        sample._valid = kTRUE ;
+      }
+
+      Double_t scale(1) ;
+      for (vector<Int_t>::const_iterator iter = sample._scalars.begin() ; iter != sample._scalars.end() ; ++iter) {
+        scale *= _scalarVals[*iter] ;
+      }
+      const Double_t* y = &sample._yields[0] ;
+      Double_t* e = &expected[0] ;
+      for (Int_t i=0 ; i<nBins ; i++) e[i] += scale*y[i] ;
+    }
+
+    for (Int_t i=0 ; i<nBins ; i++) expected[i] *= channel._binVolume[i] ;
+  }
+
+  _lastParVals = _parVals ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the expected number of events in each bin of the given channel
+/// for the current values of the parameters
+
+vector<Double_t> RooStats::HistFactory::HistFactoryCompiledNLL::expectedYields(Int_t channel) const
+{
+  updateYields() ;
+  return _expected[channel] ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return -log(L) = sum_bins (nu - n log(nu) + n log(binVolume)) - sum_constraints log(constraint)
+
+Double_t RooStats::HistFactory::HistFactoryCompiledNLL::evaluate() const
+{
+  updateYields() ;
+
+  // Kahan summation of the bin terms
+  Double_t result(0), carry(0) ;
+  for (UInt_t c=0 ; c<_channels.size() ; c++) {
+    const Channel& channel = _channels[c] ;
+    const vector<Double_t>& expected = _expected[c] ;
+    Double_t term(channel._constant) ;
+    for (UInt_t i=0 ; i<expected.size() ; i++) {
+      const Double_t n = channel._data[i] ;
+      const Double_t nu = expected[i] ;
+      term += nu ;
+      if (n>0) {
+        if (nu<=0) {
+          logEvalError(Form("expected yield %g in bin %d of channel %d is not positive",nu,i,c)) ;
+          continue ;
+        }
+        term -= n*log(nu) ;
+      }
+    }
+    Double_t y = term - carry ;
+    Double_t t = result + y ;
+    carry = (t - result) - y ;
+    result = t ;
+  }
+
+  RooFIter iter = _constrList.fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=iter.next())) {
+    result -= static_cast<RooAbsPdf*>(arg)->getLogVal(&_constrNormSet) ;
+  }
+
+  return result ;
+}
@@ -39,6 +39,7 @@ protected:
   RooRealProxy c;
 
   Double_t evaluate() const;
+  Bool_t evaluateBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data) const ;
 
 private:
   ClassDef(RooExponential,1) // Exponential PDF
@@ -30,6 +30,9 @@ Exponential p.d.f
 
 #include "RooExponential.h"
 #include "RooRealVar.h"
+#include "RooVectorDataStore.h"
+
+#include <vector>
 
 using namespace std;
 
@@ -63,6 +66,23 @@ Double_t RooExponential::evaluate() const{
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate() for the events [begin,end[ of data
+
+Bool_t RooExponential::evaluateBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data) const
+{
+  const Int_t n = end-begin ;
+  std::vector<Double_t> xVal(n), cVal(n) ;
+  if (!x.arg().getValBatch(&xVal[0],begin,end,data,x.nset()) ||
+      !c.arg().getValBatch(&cVal[0],begin,end,data,c.nset())) return kFALSE ;
+
+  for (Int_t i=0 ; i<n ; i++) {
+    output[i] = exp(cVal[i]*xVal[i]) ;
+  }
+  return kTRUE ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooExponential::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const 
@@ -33,6 +33,9 @@ Plain Gaussian p.d.f
 #include "RooRealVar.h"
 #include "RooRandom.h"
 #include "RooMath.h"
+#include "RooVectorDataStore.h"
+
+#include <vector>
 
 using namespace std;
 
@@ -77,6 +80,26 @@ Double_t RooGaussian::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate() for the events [begin,end[ of data
+
+Bool_t RooGaussian::evaluateBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data) const
+{
+  const Int_t n = end-begin ;
+  std::vector<Double_t> xVal(n), meanVal(n), sigmaVal(n) ;
+  if (!x.arg().getValBatch(&xVal[0],begin,end,data,x.nset()) ||
+      !mean.arg().getValBatch(&meanVal[0],begin,end,data,mean.nset()) ||
+      !sigma.arg().getValBatch(&sigmaVal[0],begin,end,data,sigma.nset())) return kFALSE ;
+
+  for (Int_t i=0 ; i<n ; i++) {
+    const Double_t arg = xVal[i] - meanVal[i] ;
+    const Double_t sig = sigmaVal[i] ;
+    output[i] = exp(-0.5*arg*arg/(sig*sig)) ;
+  }
+  return kTRUE ;
+}
+
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// calculate and return the negative log-likelihood of the Poisson                                                                                                                                    
@@ -28,11 +28,13 @@ less than polynomial functions due to the normalization condition
 
 #include <cmath>
 #include <cassert>
+#include <algorithm>
 
 #include "RooPolynomial.h"
 #include "RooAbsReal.h"
 #include "RooArgList.h"
 #include "RooMsgService.h"
+#include "RooVectorDataStore.h"
 
 #include "TError.h"
 
@@ -136,6 +138,44 @@ Double_t RooPolynomial::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate() for the events [begin,end[ of data.
+/// Only coefficients that do not depend on the observables of the data
+/// are supported.
+
+Bool_t RooPolynomial::evaluateBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data) const
+{
+  const unsigned sz = _coefList.getSize();
+  const int lowestOrder = _lowestOrder;
+  const Int_t n = end - begin;
+  if (!sz) {
+    std::fill(output, output + n, lowestOrder ? 1. : 0.);
+    return kTRUE;
+  }
+  _wksp.clear();
+  _wksp.reserve(sz);
+  {
+    const RooArgSet* nset = _coefList.nset();
+    RooFIter it = _coefList.fwdIterator();
+    RooAbsReal* c;
+    while ((c = (RooAbsReal*) it.next())) {
+      if (c->dependsOnValue(*data.get())) return kFALSE;
+      _wksp.push_back(c->getVal(nset));
+    }
+  }
+  if (!_x.arg().getValBatch(output, begin, end, data, _x.nset())) return kFALSE;
+
+  const Double_t* coef = &_wksp[0];
+  for (Int_t j = 0; j < n; ++j) {
+    const Double_t x = output[j];
+    Double_t retVal = coef[sz - 1];
+    for (unsigned i = sz - 1; i--; ) retVal = coef[i] + x * retVal;
+    output[j] = retVal * std::pow(x, lowestOrder) + (lowestOrder ? 1.0 : 0.0);
+  }
+  return kTRUE;
+}
+
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
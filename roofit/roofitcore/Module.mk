@@ -81,7 +81,7 @@ ROOFITCOREH4   := RooConstraintSum.h RooRecursiveFraction.h RooDataWeightedAvera
                   RooDerivative.h RooGenFunction.h RooMultiGenFunction.h RooAdaptiveIntegratorND.h \
                   RooAbsNumGenerator.h RooFoamGenerator.h RooNumGenConfig.h RooNumGenFactory.h \
                   RooMultiVarGaussian.h RooXYChi2Var.h RooAbsDataStore.h RooTreeDataStore.h RooTreeData.h \
-                  RooMinimizer.h RooMinimizerFcn.h RooMoment.h RooStudyManager.h RooAbsStudy.h \
+                  RooMinimizer.h RooMinimizerFcn.h RooDependencyIndex.h RooTreeColumnDataStore.h RooMoment.h RooStudyManager.h RooAbsStudy.h \
                   RooGenFitStudy.h RooProofDriverSelector.h RooStudyPackage.h RooCompositeDataStore.h \
 		  RooRangeBoolean.h RooVectorDataStore.h RooUnitTest.h RooExtendedBinding.h \
                   RooAbsMoment.h RooFirstMoment.h RooSecondMoment.h
@@ -118,7 +118,7 @@ $(ROOFITCORELIB): $(ROOFITCOREO) $(ROOFITCOREDO) $(ORDER_) $(MAINLIBS) \
 		@$(MAKELIB) $(PLATFORM) $(LD) "$(LDFLAGS)" \
 		   "$(SOFLAGS)" libRooFitCore.$(SOEXT) $@ \
 		   "$(ROOFITCOREO) $(ROOFITCOREDO)" \
-		   "$(ROOFITCORELIBEXTRA) $(OSTHREADLIBDIR) $(OSTHREADLIB)"
+		   "$(ROOFITCORELIBEXTRA) $(OSTHREADLIBDIR) $(OSTHREADLIB) $(TBBLIBDIR) $(TBBLIB)"
 
 $(call pcmrule,ROOFITCORE)
 	$(noop)
@@ -148,3 +148,8 @@ distclean::     distclean-$(MODNAME)
 
 # Optimize dictionary with stl containers.
 $(ROOFITCOREDO): NOOPT = $(OPT)
+
+##### extra rules ######
+ifeq ($(BUILDTBB),yes)
+$(ROOFITCOREO): CXXFLAGS += $(TBBINCDIR:%=-I%)
+endif
@@ -55,6 +55,8 @@
 #pragma link C++ class std::pair<std::string,RooAbsData*>+ ;
 #pragma link C++ class std::pair<int,RooLinkedListElem*>+ ;
 #pragma link C++ class RooUnitTest+ ;
+#pragma link C++ class RooDependencyIndex+ ;
+#pragma link C++ class RooTreeColumnDataStore+ ;
 //#pragma link C++ class RooHistFunc2- ;
 #ifndef __ROOFIT_NOROOMINIMIZER
 #pragma link C++ class RooMinimizer+ ;
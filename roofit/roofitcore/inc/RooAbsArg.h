@@ -281,6 +281,7 @@ public:
   void printDirty(Bool_t depth=kTRUE) const ;
 
   static void setDirtyInhibit(Bool_t flag) ;
+  static ULong64_t graphGeneration() { return _graphGeneration ; }
 
   virtual Bool_t operator==(const RooAbsArg& other) = 0 ;
   virtual Bool_t isIdentical(const RooAbsArg& other, Bool_t assumeSameType=kFALSE) = 0 ;
@@ -533,6 +534,7 @@ public:
   friend class RooTreeData ;
   friend class RooDataSet ;
   friend class RooRealMPFE ;
+  friend class RooDependencyIndex ;
   virtual void syncCache(const RooArgSet* nset=0) = 0 ;
   virtual void copyCache(const RooAbsArg* source, Bool_t valueOnly=kFALSE, Bool_t setValDirty=kTRUE) = 0 ;
 
@@ -551,6 +553,7 @@ public:
   // Debug stuff
   static Bool_t _verboseDirty ; // Static flag controlling verbose messaging for dirty state changes
   static Bool_t _inhibitDirty ; // Static flag controlling global inhibit of dirty state propagation
+  static ULong64_t _graphGeneration ; // Static counter of changes of client-server links
   Bool_t _deleteWatch ; //! Delete watch flag 
 
   Bool_t inhibitDirty() const ;
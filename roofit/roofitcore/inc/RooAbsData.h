@@ -209,7 +209,7 @@ public:
   static void claimVars(RooAbsData*) ;
   static Bool_t releaseVars(RooAbsData*) ;
 
-  enum StorageType { Tree, Vector} ;
+  enum StorageType { Tree, Vector, Column } ;
 
   static void setDefaultStorageType(StorageType s) ;
 
@@ -63,6 +63,16 @@ public:
 
   virtual std::list<Double_t>* binBoundaries(Int_t) const { return 0 ; }
 
+  virtual RooAbsFunc* cloneForThread() const {
+    // Return an independent copy of this binding that can be evaluated concurrently
+    // with it, or null if not supported by the binding implementation
+    return 0 ;
+  }
+  virtual void syncThreadClone() const {
+    // Interface to copy the current parameter values of the original binding
+    // into a copy made by cloneForThread()
+  }
+
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& /*obs*/, Double_t /*xlo*/, Double_t /*xhi*/) const {
     // Interface for returning an optional hint for initial sampling points when constructing a curve 
     // projected on observable.  
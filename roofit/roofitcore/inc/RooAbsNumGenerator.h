@@ -62,7 +62,7 @@ public:
   virtual void printClassName(std::ostream& os) const ;
   virtual void printArgs(std::ostream& os) const ;
   
-  void attachParameters(const RooArgSet& vars) ;
+  virtual void attachParameters(const RooArgSet& vars) ;
 
   // Advertisement of capabilities
   virtual Bool_t canSampleCategories() const { return kFALSE ; }
@@ -21,6 +21,7 @@
 #include "RooNameSet.h"
 #include "RooObjCacheManager.h"
 #include "RooCmdArg.h"
+#include <atomic>
 
 class RooDataSet;
 class RooDataHist ;
@@ -185,6 +186,7 @@ public:
   // Function evaluation support
   virtual Bool_t traceEvalHook(Double_t value) const ;  
   virtual Double_t getValV(const RooArgSet* set=0) const ;
+  virtual Bool_t getValBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data, const RooArgSet* normSet=0) const ;
   virtual Double_t getLogVal(const RooArgSet* set=0) const ;
 
   Double_t getNorm(const RooArgSet& nset) const { 
@@ -332,7 +334,7 @@ protected:
 
   static void raiseEvalError() ;
 
-  static Bool_t _evalError ;
+  static std::atomic<Bool_t> _evalError ; // Raised concurrently by threaded test statistics
 
   RooNumGenConfig* _specGeneratorConfig ; //! MC generator configuration specific for this object
   
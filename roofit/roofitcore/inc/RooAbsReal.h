@@ -73,6 +73,9 @@ public:
 
   virtual Double_t getValV(const RooArgSet* set=0) const ;
 
+  // Batch evaluation over a range of events of a vector data store
+  virtual Bool_t getValBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data, const RooArgSet* normSet=0) const ;
+
   Double_t getPropagatedError(const RooFitResult& fr) ;
 
   Bool_t operator==(Double_t value) const ;
@@ -371,10 +374,13 @@ protected:
     return kFALSE ;
   }
   virtual Double_t evaluate() const = 0 ;
+  virtual Bool_t evaluateBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data) const ;
+  Bool_t getCachedBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data, const RooArgSet* normSet) const ;
 
   // Hooks for RooDataSet interface
   friend class RooRealIntegral ;
   friend class RooVectorDataStore ;
+  friend class RooTreeColumnDataStore ;
   virtual void syncCache(const RooArgSet* set=0) { getVal(set) ; }
   virtual void copyCache(const RooAbsArg* source, Bool_t valueOnly=kFALSE, Bool_t setValDirty=kTRUE) ;
   virtual void attachToTree(TTree& t, Int_t bufSize=32000) ;
@@ -64,6 +64,9 @@ public:
   virtual Double_t offset() const { return _offset ; }
   virtual Double_t offsetCarry() const { return _offsetCarry; }
 
+  static void setThreadedEvaluation(Bool_t flag) ;
+  static Bool_t threadedEvaluation() ;
+
 protected:
 
   virtual void printCompactTreeHook(std::ostream& os, const char* indent="") ;
@@ -96,9 +99,9 @@ protected:
   
   RooSetProxy _paramSet ;          // Parameters of the test statistic (=parameters of the input function)
 
-  enum GOFOpMode { SimMaster,MPMaster,Slave } ;
+  enum GOFOpMode { SimMaster,MPMaster,Slave,MTMaster } ;
   GOFOpMode operMode() const { 
-    // Return test statistic operation mode of this instance (SimMaster, MPMaster or Slave)
+    // Return test statistic operation mode of this instance (SimMaster, MPMaster, MTMaster or Slave)
     return _gofOpMode ; 
   }
 
@@ -113,6 +116,7 @@ protected:
   Bool_t _verbose ;                // Verbose messaging if true
 
   virtual Bool_t setDataSlave(RooAbsData& /*data*/, Bool_t /*cloneData*/=kTRUE, Bool_t /*ownNewDataAnyway*/=kFALSE) { return kTRUE ; }
+  virtual Bool_t shareDataSlave(const RooAbsTestStatistic& /*other*/) { return kFALSE ; }
 
   //private:  
 
@@ -122,6 +126,7 @@ protected:
   Bool_t initialize() ;
   void initSimMode(RooSimultaneous* pdf, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;    
   void initMPMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  void initMTMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
 
   mutable Bool_t _init ;          //! Is object initialized  
   GOFOpMode   _gofOpMode ;        // Operation mode of test statistic instance 
@@ -139,6 +144,9 @@ protected:
   // Parallel mode data
   Int_t          _nCPU ;      //  Number of processors to use in parallel calculation mode
   pRooRealMPFE*  _mpfeArray ; //! Array of parallel execution frond ends
+  mutable Bool_t _mtReady ;   //! Caches of the partitions are built, they may be calculated in parallel threads
+
+  static Bool_t _threadedEval ; // Calculate partitions in threads rather than in forked processes
 
   RooFit::MPSplit        _mpinterl ; // Use interleaving strategy rather than N-wise split for partioning of dataset for multiprocessor-split
   Bool_t         _doOffset ; // Apply interval value offset to control numeric precision?
@@ -19,8 +19,11 @@
 #include "RooAbsNumGenerator.h"
 #include "RooPrintable.h"
 #include "RooArgSet.h"
+#include <vector>
 
 class RooAbsReal;
+class RooAbsFunc;
+class RooVectorDataStore;
 class RooRealVar;
 class RooDataSet;
 class RooRealBinding;
@@ -28,7 +31,8 @@ class RooNumGenFactory ;
 
 class RooAcceptReject : public RooAbsNumGenerator {
 public:
-  RooAcceptReject() : _nextCatVar(0), _nextRealVar(0) {
+  RooAcceptReject() : _nextCatVar(0), _nextRealVar(0), _batchSize(0), _nThreads(1), _vstore(0), _binding(0),
+    _funcClonesFailed(kFALSE), _params(0) {
     // coverity[UNINIT_CTOR]
   } ; 
   RooAcceptReject(const RooAbsReal &func, const RooArgSet &genVars, const RooNumGenConfig& config, Bool_t verbose=kFALSE, const RooAbsReal* maxFuncVal=0);
@@ -41,6 +45,13 @@ public:
   const RooArgSet *generateEvent(UInt_t remaining, Double_t& resampleRatio);
   Double_t getFuncMax() ;
 
+  virtual void attachParameters(const RooArgSet& vars) ;
+
+  // Batched and parallel evaluation of trial samples
+  void setBatchSize(Int_t nTrials) ;
+  Int_t getBatchSize() const { return _batchSize ; }
+  void setNumThreads(Int_t nThreads) ;
+  Int_t getNumThreads() const { return _nThreads ; }
 
   // Advertisement of capabilities
   virtual Bool_t canSampleConditional() const { return kTRUE ; }
@@ -53,6 +64,10 @@ protected:
   static void registerSampler(RooNumGenFactory& fact) ;	
 
   void addEventToCache();
+  void addEventsToCache(Long64_t nEvents);
+  void evaluateTrials(Double_t* output, Int_t begin, Int_t end);
+  Bool_t parametersChanged();
+  void deleteFunctionClones();
   const RooArgSet *nextAcceptedEvent();
 
   Double_t _maxFuncVal, _funcSum;      // Maximum function value found, and sum of all samples made
@@ -65,6 +80,17 @@ protected:
 
   UInt_t _minTrialsArray[4];           // Minimum number of trials samples for 1,2,3 dimensional problems
 
+  Int_t _batchSize ;                   // Number of trial samples added to the cache together, 0 for one by one
+  Int_t _nThreads ;                    // Number of threads evaluating the function for the trial samples
+  RooVectorDataStore* _vstore ;        //! Storage of the event cache in batch mode
+  std::vector<Double_t> _trialVals ;   //! Function values of the current batch of trial samples
+  std::vector<Double_t> _acceptVals ;  //! Random numbers of the accept step of the cached trial samples, with a known maximum
+  RooAbsFunc* _binding ;               //! Binding of the function to the real observables
+  std::vector<RooAbsFunc*> _funcClones ; //! Copies of the binding for the evaluation in threads
+  Bool_t _funcClonesFailed ;           //! The function could not be copied
+  RooArgSet* _params ;                 //! Parameters of the function
+  std::vector<Double_t> _paramVals ;   //! Parameter values for the trial samples in the cache
+
   ClassDef(RooAcceptReject,0) // Context for generating a dataset from a PDF
 };
 
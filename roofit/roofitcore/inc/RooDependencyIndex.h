@@ -0,0 +1,66 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ *    File: $Id$
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+#ifndef ROO_DEPENDENCY_INDEX
+#define ROO_DEPENDENCY_INDEX
+
+#include "Rtypes.h"
+#include "RooArgList.h"
+#include <vector>
+
+class RooAbsArg ;
+
+class RooDependencyIndex {
+public:
+
+  RooDependencyIndex(const RooAbsArg& top, const RooArgList& params) ;
+  ~RooDependencyIndex() ;
+
+  // Deferred dirty state propagation
+  void beginUpdate() ;
+  void setValueDirty(Int_t iparam) ;
+  void endUpdate() ;
+
+  Bool_t isValid() const ;
+  void rebuild() ;
+
+  Int_t numParams() const { return _params.getSize() ; }
+  Int_t numNodes() const { return _nodes.size() ; }
+  const RooAbsArg* node(Int_t inode) const { return _nodes[inode] ; }
+  Bool_t dependsOn(Int_t inode, Int_t iparam) const {
+    // Return true if the value of node inode depends on parameter iparam
+    return (_masks[iparam][inode/64] >> (inode%64)) & 1 ;
+  }
+
+  // Operation mode of the nodes that do not depend on any parameter
+  void freeze() ;
+  void unfreeze() ;
+  Int_t numFrozen() const { return _frozen.size() ; }
+
+protected:
+
+  RooDependencyIndex(const RooDependencyIndex&) ;
+  RooDependencyIndex& operator=(const RooDependencyIndex&) ;
+
+  const RooAbsArg* _top ;                        // Top node of the expression
+  RooArgList _params ;                           // Indexed parameters
+  std::vector<RooAbsArg*> _nodes ;               // Nodes that depend on at least one parameter
+  std::vector<std::vector<ULong64_t> > _masks ;  // Per parameter, bitset of the nodes that depend on it
+  std::vector<ULong64_t> _pending ;              // Union of the masks of the changed parameters
+  std::vector<RooAbsArg*> _boundary ;            // Value clients of indexed nodes not in Auto mode
+  std::vector<Int_t> _boundaryMode ;             // Operation mode of the boundary nodes at build time
+  std::vector<RooAbsArg*> _frozen ;              // Nodes switched to AClean by freeze()
+  ULong64_t _generation ;                        // Graph generation at build time
+  Bool_t _inUpdate ;                             // Between beginUpdate() and endUpdate()
+  Bool_t _anyPending ;                           // At least one parameter changed in this update
+  Bool_t _savedInhibit ;                         // Global dirty inhibit state before beginUpdate()
+
+} ;
+
+#endif
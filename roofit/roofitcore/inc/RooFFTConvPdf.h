@@ -61,6 +61,11 @@ public:
   virtual Int_t getMaxVal(const RooArgSet& vars) const { return _pdf1.arg().getMaxVal(vars) ; }
   virtual Double_t maxVal(Int_t code) const { return _pdf1.arg().maxVal(code) ; }
 
+  // Planning of the FFT transforms, whose plans are reused between cache elements
+  static void setPlanningFlag(const char* flag) ;
+  static const char* getPlanningFlag() ;
+  static void clearPlanCache() ;
+
 
 protected:
 
@@ -74,6 +79,7 @@ protected:
   Bool_t redirectServersHook(const RooAbsCollection& newServerList, Bool_t mustReplaceAll, Bool_t nameChange, Bool_t isRecursive) ;
 
   Double_t*  scanPdf(RooRealVar& obs, RooAbsPdf& pdf, const RooDataHist& hist, const RooArgSet& slicePos, Int_t& N, Int_t& N2, Int_t& zeroBin, Double_t shift) const ;
+  Double_t*  scanPdf(RooRealVar& scanX, const RooArgSet& scanObs, RooAbsPdf& pdf, Int_t& N, Int_t& N2, Int_t& zeroBin, Double_t shift) const ;
 
   class FFTCacheElem : public PdfCacheElem {
   public:
@@ -82,12 +88,17 @@ protected:
 
     virtual RooArgList containedArgs(Action) ;
 
+    void acquirePlans(Int_t N2) ;
+    void releasePlans() ;
+
     TVirtualFFT* fftr2c1 ;
     TVirtualFFT* fftr2c2 ;
     TVirtualFFT* fftc2r ;
 
     RooAbsPdf* pdf1Clone ;
     RooAbsPdf* pdf2Clone ;
+    RooArgSet* pdf2Obs ;     // Private copy of the cache observables for pdf2Clone, if both are sampled in parallel
+    Bool_t sampledOnce ;     // Both p.d.f.s have been sampled sequentially once, setting up their normalization objects
 
     RooAbsBinning* histBinning ;
     RooAbsBinning* scanBinning ;
@@ -20,6 +20,7 @@
 #include "RooGrid.h"
 #include "RooNumIntConfig.h"
 #include "TStopwatch.h"
+#include <vector>
 
 class RooMCIntegrator : public RooAbsIntegrator {
 public:
@@ -48,6 +49,9 @@ public:
 
   const RooGrid &grid() const { return _grid; }
 
+  Int_t getNumThreads() const { return _nThreads; }
+  void setNumThreads(Int_t nThreads) { _nThreads= nThreads; }
+
   virtual Bool_t canIntegrate1D() const { return kTRUE ; }
   virtual Bool_t canIntegrate2D() const { return kTRUE ; }
   virtual Bool_t canIntegrateND() const { return kTRUE ; }
@@ -58,6 +62,9 @@ protected:
   friend class RooNumIntFactory ;
   static void registerIntegrator(RooNumIntFactory& fact) ;	
 
+  void evaluatePoints(UInt_t npoints, const Double_t* x, Double_t* fval) ;
+  void deleteFunctionClones() ;
+
   mutable RooGrid _grid;  // Sampling grid definition
 
   // control variables
@@ -68,6 +75,10 @@ protected:
   Int_t _nRefineIter ;      // Number of refinement iterations
   Int_t _nRefinePerDim ;    // Number of refinement samplings (per dim)
   Int_t _nIntegratePerDim ; // Number of integration samplings (per dim)
+  Int_t _nThreads ;         // Number of threads evaluating the integrand
+
+  std::vector<RooAbsFunc*> _funcClones ; //! Copies of the integrand evaluated in parallel
+  Bool_t _funcClonesFailed ;             //! Integrand does not support copies
 
   TStopwatch _timer;        // Timer
 
@@ -49,6 +49,8 @@ public:
   void optimizeConst(Int_t flag) ;
   void setEvalErrorWall(Bool_t flag) { fitterFcn()->SetEvalErrorWall(flag); }
   void setOffsetting(Bool_t flag) ;
+  void setDependencyIndex(Bool_t flag) ;
+  void setFreezeConstantNodes(Bool_t flag) ;
   void setMaxIterations(Int_t n) ;
   void setMaxFunctionCalls(Int_t n) ; 
 
@@ -29,6 +29,7 @@
 #include <fstream>
 
 class RooMinimizer;
+class RooDependencyIndex;
 
 class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
 
@@ -64,6 +65,11 @@ class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
   Int_t evalCounter() const { return _evalCounter ; }
   void zeroEvalCount() { _evalCounter = 0 ; }
 
+  void SetUseDependencyIndex(Bool_t flag) ;
+  Bool_t GetUseDependencyIndex() const { return _useDepIndex ; }
+  void SetFreezeConstantNodes(Bool_t flag) ;
+  Bool_t GetFreezeConstantNodes() const { return _freezeNodes ; }
+
 
  private:
   
@@ -78,6 +84,7 @@ class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
 
   virtual double DoEval(const double * x) const;  
   void updateFloatVec() ;
+  void updateDependencyIndex() const ;
 
 private:
 
@@ -101,6 +108,10 @@ private:
   RooArgList* _initFloatParamList;
   RooArgList* _initConstParamList;
 
+  mutable Bool_t _useDepIndex ;          // Propagate parameter changes with the dependency index
+  Bool_t _freezeNodes ;                  // Freeze the constant nodes during minimization
+  mutable RooDependencyIndex* _depIndex ; // Dependency index of _funct on the floating parameters
+
 };
 
 #endif
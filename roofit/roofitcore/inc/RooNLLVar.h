@@ -58,11 +58,15 @@ public:
 
   virtual Double_t defaultErrorLevel() const { return 0.5 ; }
 
+  static void setBatchEvaluation(Bool_t flag) ;
+  static Bool_t batchEvaluation() ;
+
 protected:
 
   virtual Bool_t processEmptyDataSets() const { return _extended ; }
 
   static RooArgSet _emptySet ; // Supports named argument constructor
+  static Bool_t _batchEval ; // Evaluate the p.d.f. on batches of events when possible
 
   Bool_t _extended ;
   virtual Double_t evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const ;
@@ -54,7 +54,9 @@ public:
   virtual ~RooProdPdf() ;
 
   virtual Double_t getValV(const RooArgSet* set=0) const ;
+  virtual Bool_t getValBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data, const RooArgSet* normSet=0) const ;
   Double_t evaluate() const ;
+  virtual Bool_t evaluateBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data) const ;
   virtual Bool_t checkObservables(const RooArgSet* nset) const ;	
 
   virtual Bool_t forceAnalyticalInt(const RooAbsArg& dep) const ; 
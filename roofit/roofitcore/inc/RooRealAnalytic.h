@@ -26,6 +26,8 @@ public:
 
   virtual Double_t operator()(const Double_t xvector[]) const;
 
+  virtual RooAbsFunc* cloneForThread() const ;
+
 protected:
   Int_t _code;
 
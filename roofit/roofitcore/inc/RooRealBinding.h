@@ -41,9 +41,15 @@ public:
   virtual std::list<Double_t>* binBoundaries(Int_t) const ;
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& /*obs*/, Double_t /*xlo*/, Double_t /*xhi*/) const ;
 
+  virtual RooAbsFunc* cloneForThread() const ;
+  virtual void syncThreadClone() const ;
+
 protected:
 
   void loadValues(const Double_t xvector[]) const;
+  RooAbsReal* cloneFunction(RooArgSet*& ownedSet, RooArgSet& varsClone) const ;
+  void setThreadCloneOf(const RooRealBinding& orig, RooArgSet* ownedSet) ;
+
   const RooAbsReal *_func;
   RooAbsRealLValue **_vars;
   const RooArgSet *_nset;
@@ -55,6 +61,10 @@ protected:
   mutable std::list<RooAbsReal*> _compList ; //!
   mutable std::list<Double_t>    _compSave ; //!
   mutable Double_t _funcSave ; //!
+
+  RooArgSet* _cloneOwned ;      //! Copy of the function tree owned by a binding made by cloneForThread()
+  RooArgSet* _cloneParams ;     //! Parameters of the copy of the function tree
+  RooArgSet* _origParams ;      //! Parameters of the original function
   
   ClassDef(RooRealBinding,0) // Function binding to RooAbsReal object
 };
@@ -22,6 +22,8 @@
 #include "RooRealProxy.h"
 #include "RooSetProxy.h"
 #include "RooListProxy.h"
+#include <list>
+#include <vector>
 
 class RooArgSet ;
 class TH1F ;
@@ -70,6 +72,10 @@ public:
 
   static Int_t getCacheAllNumeric() ;
 
+  static void setNumericMemoSize(Int_t size) ;
+
+  static Int_t getNumericMemoSize() ;
+
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& obs, Double_t xlo, Double_t xhi) const {
     // Forward plot sampling hint of integrand
     return _function.arg().plotSamplingHint(obs,xlo,xhi) ;
@@ -87,6 +93,8 @@ protected:
   //friend class RooAbsPdf ;
 
   Bool_t initNumIntegrator() const;
+  void fillMemoKey(std::vector<Double_t>& key) const ;
+  Bool_t findMemo(const std::vector<Double_t>& key, Double_t& value) const ;
   void autoSelectDirtyMode() ;
 
   virtual Double_t sum() const ;
@@ -95,6 +103,7 @@ protected:
 
   // Evaluation and validation implementation
   Double_t evaluate() const ;
+  virtual Bool_t evaluateBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data) const ;
   virtual Bool_t isValidReal(Double_t value, Bool_t printError=kFALSE) const ;
   Bool_t servesExclusively(const RooAbsArg* server,const RooArgSet& exclLVBranches, const RooArgSet& allBranches) const ;
 
@@ -136,6 +145,9 @@ protected:
 
   Bool_t _cacheNum ;           // Cache integral if numeric
   static Int_t _cacheAllNDim ; //! Cache all integrals with given numeric dimension
+  static Int_t _numMemoSize ;  //! Number of numeric integral values memoized per integral
+
+  mutable std::list<std::pair<std::vector<Double_t>,Double_t> > _memo ; //! Last numeric integral values, most recent first
 
 
   virtual void operModeHook() ; // cache operation mode
@@ -0,0 +1,132 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ *    File: $Id$
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+#ifndef ROO_TREE_COLUMN_DATA_STORE
+#define ROO_TREE_COLUMN_DATA_STORE
+
+#include "RooAbsDataStore.h"
+#include <vector>
+#include <memory>
+
+class RooAbsArg ;
+class RooArgList ;
+class RooRealVar ;
+class RooAbsReal ;
+class RooFormulaVar ;
+class TTree ;
+
+
+class RooTreeColumnDataStore : public RooAbsDataStore {
+public:
+
+  RooTreeColumnDataStore() ;
+
+  // Ctors from TTree
+  RooTreeColumnDataStore(const char* name, const char* title, const RooArgSet& vars, TTree& t, const char* selExpr=0,
+			 const char* wgtVarName=0, Bool_t floatStorage=kFALSE) ;
+  RooTreeColumnDataStore(const char* name, const char* title, const RooArgSet& vars, TTree& t, const RooFormulaVar& select,
+			 const char* wgtVarName=0, Bool_t floatStorage=kFALSE) ;
+
+  // Ctor for reduced views of other column store
+  RooTreeColumnDataStore(const char *name, const char *title, const RooTreeColumnDataStore& other,
+			 const RooArgSet& vars, const RooFormulaVar* cutVar, const char* cutRange,
+			 Int_t nStart, Int_t nStop, const char* wgtVarName=0) ;
+
+  RooTreeColumnDataStore(const RooTreeColumnDataStore& other, const char* newname=0) ;
+  RooTreeColumnDataStore(const RooTreeColumnDataStore& other, const RooArgSet& vars, const char* newname=0) ;
+  virtual RooAbsDataStore* clone(const char* newname=0) const { return new RooTreeColumnDataStore(*this,newname) ; }
+  virtual RooAbsDataStore* clone(const RooArgSet& vars, const char* newname=0) const { return new RooTreeColumnDataStore(*this,vars,newname) ; }
+  virtual ~RooTreeColumnDataStore() ;
+
+  // Write current row (not supported, the store is read-only)
+  virtual Int_t fill() ;
+
+  // Retrieve a row
+  using RooAbsDataStore::get ;
+  virtual const RooArgSet* get(Int_t index) const ;
+  virtual Double_t weight() const { return _curWgt ; }
+  virtual Double_t weightError(RooAbsData::ErrorType etype=RooAbsData::Poisson) const ;
+  virtual void weightError(Double_t& lo, Double_t& hi, RooAbsData::ErrorType etype=RooAbsData::Poisson) const ;
+  virtual Double_t weight(Int_t index) const ;
+  virtual Bool_t isWeighted() const { return _wgtVar!=0 ; }
+
+  // Change observable name
+  virtual Bool_t changeObservableName(const char* from, const char* to) ;
+
+  // Add one or more columns
+  virtual RooAbsArg* addColumn(RooAbsArg& var, Bool_t adjustRange=kTRUE) ;
+  virtual RooArgSet* addColumns(const RooArgList& varList) ;
+
+  // Merge column-wise
+  RooAbsDataStore* merge(const RooArgSet& allvars, std::list<RooAbsDataStore*> dstoreList) ;
+
+  // Add rows (not supported, the store is read-only)
+  virtual void append(RooAbsDataStore& other) ;
+
+  // General & bookkeeping methods
+  virtual Bool_t valid() const ;
+  virtual Int_t numEntries() const ;
+  virtual Double_t sumEntries() const ;
+  virtual void reset() ;
+
+  // Buffer redirection routines used in inside RooAbsOptTestStatistics
+  virtual void attachBuffers(const RooArgSet& extObs) ;
+  virtual void resetBuffers() ;
+
+  // Constant term  optimizer interface (no caching of function values)
+  virtual void cacheArgs(const RooAbsArg* cacheOwner, RooArgSet& varSet, const RooArgSet* nset=0, Bool_t skipZeroWeights=kFALSE) ;
+  virtual const RooAbsArg* cacheOwner() { return 0 ; }
+  virtual void attachCache(const RooAbsArg* /*newOwner*/, const RooArgSet& /*cachedVars*/) {}
+  virtual void setArgStatus(const RooArgSet& /*set*/, Bool_t /*active*/) {}
+  virtual void resetCache() {}
+
+  virtual void checkInit() const ;
+
+  virtual void loadValues(const RooAbsDataStore *tds, const RooFormulaVar* select=0, const char* rangeName=0, Int_t nStart=0, Int_t nStop=2000000000) ;
+
+  // Column storage
+  void loadColumns() const { checkInit() ; }
+  Bool_t floatStorage() const ;
+  Long64_t columnMemory() const ;
+  const TTree* sourceTree() const ;
+  const RooRealVar* weightVar() const { return _wgtVar ; }
+
+protected:
+
+  struct ColumnSource ;
+
+  void initialize(const char* wgtVarName, const RooTreeColumnDataStore* parent=0) ;
+  void attachColumns() const ;
+  void selectRows(const RooFormulaVar* select, const char* rangeName, Int_t nStart, Int_t nStop) const ;
+  void sumWeights() const ;
+  inline Int_t row(Int_t index) const { return _rows ? (*_rows)[index] : index ; }
+  inline Double_t value(Int_t icol, Int_t irow) const { return _fcol[icol] ? Double_t(_fcol[icol][irow]) : _dcol[icol][irow] ; }
+
+  RooArgSet _varsww ;                                  // Observables including weight variable
+  RooRealVar* _wgtVar ;                                // Pointer to weight variable (if set)
+
+  std::shared_ptr<ColumnSource> _source ;              //! Columns shared by all views of the same tree
+  mutable std::shared_ptr<const std::vector<Int_t> > _rows ; //! Selected rows of the tree, null if all rows are selected
+  std::vector<RooRealVar*> _colVars ;                  //! Observables with a column, in the order of _colIndex
+  std::vector<Int_t> _colIndex ;                       //! Column of each observable in the source
+  std::vector<RooAbsReal*> _colBuf ;                   //! Objects the values are loaded into (see attachBuffers())
+  mutable std::vector<const Double_t*> _dcol ;         //! Column arrays in double precision
+  mutable std::vector<const Float_t*> _fcol ;          //! Column arrays in single precision
+  Int_t _wgtCol ;                                      //! Position of weight variable in _colVars, or -1
+  mutable RooFormulaVar* _select ;                     //! Pending selection for the rows of the tree
+  mutable Bool_t _init ;                               //! Columns loaded and rows selected
+  mutable Bool_t _selectPending ;                      //! Rows of the tree not yet checked against ranges and selection
+  mutable Double_t _curWgt ;                           //! Weight of the current event
+  mutable Double_t _sumWeight ;                        //! Sum of weights
+
+  ClassDef(RooTreeColumnDataStore,1) // Read-only data storage in columns read from a TTree
+};
+
+
+#endif
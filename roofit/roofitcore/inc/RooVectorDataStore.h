@@ -110,6 +110,14 @@ public:
 
   const RooVectorDataStore* cache() const { return _cache ; }
 
+  // Column access for batch evaluation
+  const Double_t* realColumn(const RooAbsReal& real) const ;
+  const Double_t* weightColumn() const ;
+  Bool_t setRealColumn(const RooAbsReal& real, Int_t begin, Int_t end, const Double_t* values) ;
+
+  // Read-only sharing of the columns of an identical store
+  Bool_t shareColumns(const RooVectorDataStore& other) ;
+
   void loadValues(const RooAbsDataStore *tds, const RooFormulaVar* select=0, const char* rangeName=0, Int_t nStart=0, Int_t nStop=2000000000) ;
   
   void dump() ;
@@ -135,12 +143,12 @@ public:
   class RealVector {
   public:
     RealVector(UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(Double_t))) : 
-      _nativeReal(0), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0) { 
+      _nativeReal(0), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0), _nShared(0) { 
       _vec.reserve(initialCapacity);
     }
 
     RealVector(RooAbsReal* arg, UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(Double_t))) : 
-      _nativeReal(arg), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0) { 
+      _nativeReal(arg), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0), _nShared(0) { 
       _vec.reserve(initialCapacity);
     }
 
@@ -150,7 +158,9 @@ public:
     }
 
     RealVector(const RealVector& other, RooAbsReal* real=0) : 
-      _vec(other._vec), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf), _nset(0)   {
+      _vec(other._vec), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf), _nset(0), _nShared(0)   {
+      // A copy of shared columns owns its values
+      if (other._nShared) _vec.assign(other._vec0,other._vec0+other._nShared) ;
       _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
       if (other._tracker) {
 	_tracker = new RooChangeTracker(Form("track_%s",_nativeReal->GetName()),"tracker",other._tracker->parameters()) ;
@@ -168,7 +178,10 @@ public:
       _real = other._real;
       _buf = other._buf;
       _nativeBuf = other._nativeBuf;
-      if (other._vec.size() <= _vec.capacity() / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Double_t))) {
+      _nShared = 0;
+      if (other._nShared) {
+	_vec.assign(other._vec0, other._vec0 + other._nShared);
+      } else if (other._vec.size() <= _vec.capacity() / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Double_t))) {
 	std::vector<Double_t> tmp;
 	tmp.reserve(std::max(other._vec.size(), VECTOR_BUFFER_SIZE / sizeof(Double_t)));
 	tmp.assign(other._vec.begin(), other._vec.end());
@@ -212,11 +225,13 @@ public:
     }
 
     void fill() { 
+      unshare() ;
       _vec.push_back(*_buf) ; 
       _vec0 = &_vec.front() ;
     } ;
 
     void write(Int_t i) {
+      unshare() ;
 /*         std::cout << "write(" << this << ") [" << i << "] nativeReal = " << _nativeReal << " = " << _nativeReal->GetName() << " real = " << _real << " buf = " << _buf << " value = " << *_buf << " native getVal() = " << _nativeReal->getVal() << " getVal() = " << _real->getVal() << std::endl ;  */
       _vec[i] = *_buf ;
     }
@@ -226,6 +241,22 @@ public:
       std::vector<Double_t> tmp;
       _vec.swap(tmp);
       _vec0 = 0;
+      _nShared = 0;
+    }
+
+    // Read the values from the column of other instead of our own, see RooVectorDataStore::shareColumns()
+    void share(const RealVector& other) {
+      reset() ;
+      _vec0 = other._vec0 ;
+      _nShared = other.size() ;
+    }
+
+    // Take a private copy of shared values before they are modified or written out
+    void unshare() {
+      if (!_nShared) return ;
+      _vec.assign(_vec0, _vec0 + _nShared) ;
+      _nShared = 0 ;
+      _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
     }
 
     inline void get(Int_t idx) const { 
@@ -236,9 +267,10 @@ public:
       *_nativeBuf = *(_vec0+idx) ; 
     }
 
-    Int_t size() const { return _vec.size() ; }
+    Int_t size() const { return _nShared ? _nShared : Int_t(_vec.size()) ; }
 
     void resize(Int_t siz) {
+      unshare() ;
       if (siz < Int_t(_vec.capacity()) / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Double_t))) {
 	// do an expensive copy, if we save at least a factor 2 in size
 	std::vector<Double_t> tmp;
@@ -255,6 +287,7 @@ public:
     }
 
     void reserve(Int_t siz) {
+      unshare() ;
       _vec.reserve(siz);
       _vec0 = _vec.size() > 0 ? &_vec.front() : 0;
     }
@@ -271,6 +304,7 @@ public:
     Double_t* _vec0 ; //!
     RooChangeTracker* _tracker ; //
     RooArgSet* _nset ; //! 
+    Int_t _nShared ; //! Number of values read from the column of another store, 0 if the values are owned
     ClassDef(RealVector,1) // STL-vector-based Data Storage class
   } ;
   
@@ -461,13 +495,13 @@ public:
   class CatVector {
   public:
     CatVector(UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(RooCatType))) : 
-      _cat(0), _buf(0), _nativeBuf(0), _vec0(0)
+      _cat(0), _buf(0), _nativeBuf(0), _vec0(0), _nShared(0)
     {
       _vec.reserve(initialCapacity);
     }
 
     CatVector(RooAbsCategory* cat, UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(RooCatType))) : 
-      _cat(cat), _buf(0), _nativeBuf(0), _vec0(0)
+      _cat(cat), _buf(0), _nativeBuf(0), _vec0(0), _nShared(0)
     {
       _vec.reserve(initialCapacity);
     }
@@ -476,8 +510,10 @@ public:
     }
 
     CatVector(const CatVector& other, RooAbsCategory* cat=0) : 
-      _cat(cat?cat:other._cat), _buf(other._buf), _nativeBuf(other._nativeBuf), _vec(other._vec) 
+      _cat(cat?cat:other._cat), _buf(other._buf), _nativeBuf(other._nativeBuf), _vec(other._vec), _nShared(0) 
       {
+	// A copy of shared columns owns its values
+	if (other._nShared) _vec.assign(other._vec0,other._vec0+other._nShared) ;
 	_vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
       }
 
@@ -486,7 +522,10 @@ public:
       _cat = other._cat;
       _buf = other._buf;
       _nativeBuf = other._nativeBuf;
-      if (other._vec.size() <= _vec.capacity() / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(RooCatType))) {
+      _nShared = 0;
+      if (other._nShared) {
+	_vec.assign(other._vec0, other._vec0 + other._nShared);
+      } else if (other._vec.size() <= _vec.capacity() / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(RooCatType))) {
 	std::vector<RooCatType> tmp;
 	tmp.reserve(std::max(other._vec.size(), VECTOR_BUFFER_SIZE / sizeof(RooCatType)));
 	tmp.assign(other._vec.begin(), other._vec.end());
@@ -508,10 +547,12 @@ public:
     }
     
     void fill() { 
+      unshare() ;
       _vec.push_back(*_buf) ; 
       _vec0 = &_vec.front() ;
     } ;
     void write(Int_t i) { 
+      unshare() ;
       _vec[i]=*_buf ; 
     } ;
     void reset() { 
@@ -519,6 +560,20 @@ public:
       std::vector<RooCatType> tmp;
       _vec.swap(tmp);
       _vec0 = 0;
+      _nShared = 0;
+    }
+    // Read the values from the column of other instead of our own, see RooVectorDataStore::shareColumns()
+    void share(const CatVector& other) {
+      reset() ;
+      _vec0 = other._vec0 ;
+      _nShared = other.size() ;
+    }
+    // Take a private copy of shared values before they are modified or written out
+    void unshare() {
+      if (!_nShared) return ;
+      _vec.assign(_vec0, _vec0 + _nShared) ;
+      _nShared = 0 ;
+      _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
     }
     inline void get(Int_t idx) const { 
       _buf->assignFast(*(_vec0+idx)) ;
@@ -526,9 +581,10 @@ public:
     inline void getNative(Int_t idx) const { 
       _nativeBuf->assignFast(*(_vec0+idx)) ;
     }
-    Int_t size() const { return _vec.size() ; }
+    Int_t size() const { return _nShared ? _nShared : Int_t(_vec.size()) ; }
 
     void resize(Int_t siz) {
+      unshare() ;
       if (siz < Int_t(_vec.capacity()) / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(RooCatType))) {
 	// do an expensive copy, if we save at least a factor 2 in size
 	std::vector<RooCatType> tmp;
@@ -545,6 +601,7 @@ public:
     }
 
     void reserve(Int_t siz) {
+      unshare() ;
       _vec.reserve(siz);
       _vec0 = _vec.size() > 0 ? &_vec.front() : 0;
     }
@@ -559,6 +616,7 @@ public:
     RooCatType* _nativeBuf ;  //!
     std::vector<RooCatType> _vec ;
     RooCatType* _vec0 ; //!
+    Int_t _nShared ; //! Number of values read from the column of another store, 0 if the values are owned
     ClassDef(CatVector,1) // STL-vector-based Data Storage class
   } ;
   
@@ -81,6 +81,7 @@ ClassImp(RooAbsArg)
 
 Bool_t RooAbsArg::_verboseDirty(kFALSE) ;
 Bool_t RooAbsArg::_inhibitDirty(kFALSE) ;
+ULong64_t RooAbsArg::_graphGeneration(0) ;
 Bool_t RooAbsArg::inhibitDirty() const { return _inhibitDirty && !_localNoInhibitDirty; }
 
 std::map<RooAbsArg*,TRefArray*> RooAbsArg::_ioEvoList ;
@@ -387,6 +388,8 @@ void RooAbsArg::addServer(RooAbsArg& server, Bool_t valueProp, Bool_t shapeProp)
   server._clientList.Add(this) ;
   if (valueProp) server._clientListValue.Add(this) ;
   if (shapeProp) server._clientListShape.Add(this) ;
+
+  _graphGeneration++ ;
 }
 
 
@@ -437,6 +440,8 @@ void RooAbsArg::removeServer(RooAbsArg& server, Bool_t force)
     server._clientListValue.RemoveAll(this) ;
     server._clientListShape.RemoveAll(this) ;
   }
+
+  _graphGeneration++ ;
 }
 
 
@@ -482,6 +487,8 @@ void RooAbsArg::changeServer(RooAbsArg& server, Bool_t valueProp, Bool_t shapePr
   if (shapeProp) {
     server._clientListShape.Add(this, scount) ;
   }
+
+  _graphGeneration++ ;
 }
 
 
@@ -44,6 +44,7 @@ points for its contents and provides an iterator over its elements
 #include "RooAbsDataStore.h"
 #include "RooVectorDataStore.h"
 #include "RooTreeDataStore.h"
+#include "RooTreeColumnDataStore.h"
 #include "RooDataHist.h"
 #include "RooCompositeDataStore.h"
 #include "RooCategory.h"
@@ -72,6 +73,9 @@ static std::map<RooAbsData*,int> _dcc ;
 RooAbsData::StorageType RooAbsData::defaultStorageType=RooAbsData::Vector ;
 
 ////////////////////////////////////////////////////////////////////////////////
+/// Set the storage type of new datasets. With Column storage, datasets
+/// imported from a TTree read the branches of their observables into a
+/// read-only RooTreeColumnDataStore, all other datasets use Vector storage.
 
 void RooAbsData::setDefaultStorageType(RooAbsData::StorageType s)
 {
@@ -233,7 +237,7 @@ RooAbsData::~RooAbsData()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Convert tree-based storage to vector-based storage
+/// Convert tree-based or column-based storage to vector-based storage
 
 void RooAbsData::convertToVectorStore()
 {
@@ -241,6 +245,12 @@ void RooAbsData::convertToVectorStore()
     RooVectorDataStore* newStore =  new RooVectorDataStore(*(RooTreeDataStore*)_dstore,_vars,GetName()) ;
     delete _dstore ;
     _dstore = newStore ;
+  } else if (dynamic_cast<RooTreeColumnDataStore*>(_dstore)) {
+    const RooRealVar* wgtVar = ((RooTreeColumnDataStore*)_dstore)->weightVar() ;
+    RooVectorDataStore* newStore = new RooVectorDataStore(GetName(),GetTitle(),_vars,wgtVar?wgtVar->GetName():0) ;
+    newStore->append(*_dstore) ;
+    delete _dstore ;
+    _dstore = newStore ;
   }
 }
 
@@ -2298,12 +2308,23 @@ void RooAbsData::Streamer(TBuffer &R__b)
       R__b.ReadClassBuffer(RooAbsData::Class(),this);
 
       // Convert on the fly to vector storage if that the current working default
-      if (defaultStorageType==RooAbsData::Vector) {
+      if (defaultStorageType!=RooAbsData::Tree) {
    convertToVectorStore() ;
       }
 
    } else {
+      // Column stores do not own their data, write their contents as vector storage
+      RooTreeColumnDataStore* columnStore = dynamic_cast<RooTreeColumnDataStore*>(_dstore) ;
+      if (columnStore) {
+         const RooRealVar* wgtVar = columnStore->weightVar() ;
+         _dstore = new RooVectorDataStore(GetName(),GetTitle(),_vars,wgtVar?wgtVar->GetName():0) ;
+         _dstore->append(*columnStore) ;
+      }
       R__b.WriteClassBuffer(RooAbsData::Class(),this);
+      if (columnStore) {
+         delete _dstore ;
+         _dstore = columnStore ;
+      }
    }
 }
 
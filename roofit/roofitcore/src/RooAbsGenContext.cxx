@@ -35,6 +35,7 @@ prototype data etc..
 #include "RooRandom.h"
 #include "RooAbsPdf.h"
 #include "RooDataSet.h"
+#include "RooVectorDataStore.h"
 #include "RooMsgService.h"
 #include "RooGlobalFunc.h"
 
@@ -216,6 +217,12 @@ RooDataSet *RooAbsGenContext::generate(Double_t nEvents, Bool_t skipInit, Bool_t
   // WVE need specialization here for simultaneous pdfs
   _genData = createDataSet(name.Data(),title.Data(),*_theEvent) ; 
 
+  // Preallocate the storage for the events to be generated
+  RooVectorDataStore* vstore = dynamic_cast<RooVectorDataStore*>(_genData->store()) ;
+  if (vstore && nEvents<2e9) {
+    vstore->reserve(Int_t(nEvents)) ;
+  }
+
   // Perform any subclass implementation-specific initialization
   // Can be skipped if this is a rerun with an identical configuration
   if (!skipInit) {
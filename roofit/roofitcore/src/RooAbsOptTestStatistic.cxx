@@ -481,6 +481,27 @@ Bool_t RooAbsOptTestStatistic::redirectServersHook(const RooAbsCollection& newSe
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the events from the dataset of 'other', a test statistic constructed
+/// from the same function and data, instead of from the internal clone of the
+/// dataset, which is released. Both test statistics keep their own value
+/// buffers and caches, so that they can be calculated concurrently. Return
+/// kFALSE if the storage of the data does not allow such sharing.
+
+Bool_t RooAbsOptTestStatistic::shareDataSlave(const RooAbsTestStatistic& other) 
+{
+  const RooAbsOptTestStatistic* otherOpt = dynamic_cast<const RooAbsOptTestStatistic*>(&other) ;
+  if (operMode()!=Slave || !otherOpt || otherOpt->operMode()!=Slave) return kFALSE ;
+
+  RooVectorDataStore* vstore = dynamic_cast<RooVectorDataStore*>(_dataClone->store()) ;
+  const RooVectorDataStore* otherVstore = dynamic_cast<const RooVectorDataStore*>(otherOpt->_dataClone->store()) ;
+  if (!vstore || !otherVstore) return kFALSE ;
+
+  return vstore->shareColumns(*otherVstore) ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Catch print hook function and forward to function clone
 
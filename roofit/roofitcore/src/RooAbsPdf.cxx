@@ -158,6 +158,7 @@ the proxy holds a function, and will trigger an assert
 #include "RooRealIntegral.h"
 #include "Math/CholeskyDecomp.h"
 #include <string>
+#include <vector>
 
 using namespace std;
 
@@ -167,7 +168,7 @@ ClassImp(RooAbsPdf::GenSpec)
 ;
 
 Int_t RooAbsPdf::_verboseEval = 0;
-Bool_t RooAbsPdf::_evalError = kFALSE ;
+std::atomic<Bool_t> RooAbsPdf::_evalError(kFALSE) ;
 TString RooAbsPdf::_normRangeOverride ;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -311,6 +312,52 @@ Double_t RooAbsPdf::getValV(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of getValV(), see RooAbsReal::getValBatch(). The values of
+/// evaluateBatch() are divided by the normalization integral for normSet.
+///
+/// If any of the values is negative or NaN, kFALSE is returned, so that the
+/// evaluation errors are reported by the event by event evaluation.
+
+Bool_t RooAbsPdf::getValBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  if (getCachedBatch(output,begin,end,data,normSet)) return kTRUE ;
+
+  const Int_t n = end-begin ;
+
+  // Special handling of case without normalization set
+  if (!normSet) {
+    RooArgSet* tmp = _normSet ;
+    _normSet = 0 ;
+    Bool_t ok = evaluateBatch(output,begin,end,data) ;
+    _normSet = tmp ;
+    for (Int_t i=0 ; ok && i<n ; i++) {
+      if (TMath::IsNaN(output[i]) || output[i]<0) ok = kFALSE ;
+    }
+    return ok ;
+  }
+
+  if (normSet!=_normSet || _norm==0) {
+    syncNormalization(normSet) ;
+  }
+
+  if (!evaluateBatch(output,begin,end,data)) return kFALSE ;
+
+  std::vector<Double_t> normVal(n) ;
+  if (!_norm->getValBatch(&normVal[0],begin,end,data)) return kFALSE ;
+
+  for (Int_t i=0 ; i<n ; i++) {
+    if (TMath::IsNaN(output[i]) || output[i]<0 || normVal[i]<=0) return kFALSE ;
+  }
+  for (Int_t i=0 ; i<n ; i++) {
+    output[i] /= normVal[i] ;
+  }
+
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Analytical integral with normalization (see RooAbsReal::analyticalIntegralWN() for further information)
 ///
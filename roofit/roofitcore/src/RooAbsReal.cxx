@@ -103,8 +103,10 @@
 #include "TF3.h"
 #include "TMatrixD.h"
 #include "TVector.h"
+#include "TVirtualMutex.h"
 
 #include <sstream>
+#include <algorithm>
 
 using namespace std ;
 
@@ -120,6 +122,9 @@ Bool_t RooAbsReal::hideOffset() { return _hideOffset ; }
 
 RooAbsReal::ErrorLoggingMode RooAbsReal::_evalErrorMode = RooAbsReal::PrintErrors ;
 Int_t RooAbsReal::_evalErrorCount = 0 ;
+
+// Protects the evaluation error log when test statistics are calculated in several threads
+static TVirtualMutex* gRooEvalErrorMutex = 0 ;
 map<const RooAbsArg*,pair<string,list<RooAbsReal::EvalError> > > RooAbsReal::_evalErrorList ;
 
 
@@ -266,6 +271,72 @@ Double_t RooAbsReal::getValV(const RooArgSet* nset) const
 }
 
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of this object for the events [begin,end[ of the
+/// given vector data store and write them in output, in the same order.
+/// This is equivalent to calling getVal(normSet) after loading each event
+/// with data.get(i), but it avoids the per-event virtual calls and the
+/// dirty state bookkeeping.
+///
+/// The values are taken from the data if this object is an observable or a
+/// node precalculated by the constant term optimizer; they are constant if
+/// this object does not depend on the observables of the data. Otherwise
+/// evaluateBatch() is called.
+///
+/// Return kFALSE if the values could not be computed in batch: the caller
+/// must then fall back to the event by event evaluation.
+
+Bool_t RooAbsReal::getValBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  if (getCachedBatch(output,begin,end,data,normSet)) return kTRUE ;
+
+  if (normSet && normSet!=_lastNSet) {
+    ((RooAbsReal*) this)->setProxyNormSet(normSet) ;
+    _lastNSet = (RooArgSet*) normSet ;
+  }
+
+  return evaluateBatch(output,begin,end,data) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill output with the values of this object for the events [begin,end[
+/// of data, when they do not need to be calculated: if the values are stored
+/// in the data (observables and cached nodes), or if this object does
+/// not depend on the observables of the data. Return kFALSE otherwise.
+
+Bool_t RooAbsReal::getCachedBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  const Double_t* column = data.realColumn(*this) ;
+  if (column) {
+    std::copy(column+begin,column+end,output) ;
+    return kTRUE ;
+  }
+
+  if (!dependsOnValue(*data.get())) {
+    std::fill(output,output+(end-begin),getVal(normSet)) ;
+    return kTRUE ;
+  }
+
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of evaluate() for the events [begin,end[ of data,
+/// see getValBatch(). The values of the servers can be obtained with their
+/// getValBatch() method. This default implementation returns kFALSE, i.e.
+/// classes that do not implement it are evaluated event by event.
+
+Bool_t RooAbsReal::evaluateBatch(Double_t* /*output*/, Int_t /*begin*/, Int_t /*end*/, const RooVectorDataStore& /*data*/) const
+{
+  return kFALSE ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooAbsReal::numEvalErrorItems()
@@ -3581,6 +3652,8 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
     return ;
   }
 
+  R__LOCKGUARD_IMT2(gRooEvalErrorMutex) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
@@ -3636,6 +3709,8 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
     return ;
   }
 
+  R__LOCKGUARD_IMT2(gRooEvalErrorMutex) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
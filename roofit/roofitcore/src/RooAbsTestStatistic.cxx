@@ -32,6 +32,12 @@ organizes multi-processor parallel calculation of test statistic
 values. For the latter, the test statistic value is calculated in
 partitions in parallel executing processes and a posteriori
 combined in the main thread.
+
+If threaded evaluation is enabled with setThreadedEvaluation(), the
+partitions are instead calculated as tasks of the implicit multi-threading
+pool of this process (see ROOT::EnableImplicitMT()). Each partition has
+its own clone of the function and its own caches of precalculated values,
+but all of them read the events from one shared copy of the dataset.
 **/
 
 
@@ -51,14 +57,22 @@ combined in the main thread.
 #include "TTimeStamp.h"
 #include "RooProdPdf.h"
 #include "RooRealSumPdf.h"
+#include "TROOT.h"
 
 #include <string>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "tbb/parallel_for.h"
+#endif
 
 using namespace std;
 
 ClassImp(RooAbsTestStatistic)
 ;
 
+Bool_t RooAbsTestStatistic::_threadedEval = kFALSE ;
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor
@@ -66,7 +80,7 @@ ClassImp(RooAbsTestStatistic)
 RooAbsTestStatistic::RooAbsTestStatistic() :
   _func(0), _data(0), _projDeps(0), _splitRange(0), _simCount(0),
   _verbose(kFALSE), _init(kFALSE), _gofOpMode(Slave), _nEvents(0), _setNum(0),
-  _numSets(0), _extSet(0), _nGof(0), _gofArray(0), _nCPU(1), _mpfeArray(0),
+  _numSets(0), _extSet(0), _nGof(0), _gofArray(0), _nCPU(1), _mpfeArray(0), _mtReady(kFALSE),
   _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
   _offsetCarry(0), _evalCarry(0)
 {
@@ -105,6 +119,7 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _gofArray(0),
   _nCPU(nCPU),
   _mpfeArray(0),
+  _mtReady(kFALSE),
   _mpinterl(interleave),
   _doOffset(kFALSE),
   _offset(0),
@@ -122,7 +137,7 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
       _nCPU=1 ;
     }
 
-    _gofOpMode = MPMaster ;
+    _gofOpMode = _threadedEval ? MTMaster : MPMaster ;
 
   } else {
 
@@ -164,6 +179,7 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   _gofSplitMode(other._gofSplitMode),
   _nCPU(other._nCPU),
   _mpfeArray(0),
+  _mtReady(kFALSE),
   _mpinterl(other._mpinterl),
   _doOffset(other._doOffset),
   _offset(other._offset),
@@ -179,7 +195,7 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
       _nCPU=1 ;
     }
       
-    _gofOpMode = MPMaster ;
+    _gofOpMode = _threadedEval ? MTMaster : MPMaster ;
 
   } else {
 
@@ -219,6 +235,12 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
     delete[] _gofArray ;
   }
 
+  if (MTMaster == _gofOpMode && _init) {
+    // Partitions share the data of the first one, delete that one last
+    for (Int_t i = _nGof - 1; i >= 0; --i) delete _gofArray[i];
+    delete[] _gofArray ;
+  }
+
   delete _projDeps ;
 
 }
@@ -230,7 +252,7 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
 /// is calculated from on a RooSimultaneous, the test statistic calculation
 /// is performed separately on each simultaneous p.d.f component and associated
 /// data and then combined. If the test statistic calculation is parallelized
-/// partitions are calculated in nCPU processes and a posteriori combined.
+/// partitions are calculated in nCPU processes or threads and a posteriori combined.
 
 Double_t RooAbsTestStatistic::evaluate() const
 {
@@ -290,6 +312,42 @@ Double_t RooAbsTestStatistic::evaluate() const
     _evalCarry = carry;
     return ret ;
 
+  } else if (MTMaster == _gofOpMode) {
+
+    // Calculate the partitions, as parallel tasks if implicit multi-threading is enabled.
+    // The first calculation, which sets up the normalization integrals and the other
+    // caches of the partitions, is always done sequentially
+    std::vector<Double_t> val(_nGof), valCarry(_nGof);
+    auto calcPartition = [&](Int_t i) {
+      val[i] = _gofArray[i]->getValV();
+      valCarry[i] = _gofArray[i]->getCarry();
+    };
+#ifdef R__USE_IMT
+    if (_mtReady && _nGof > 1 && ROOT::IsImplicitMTEnabled()) {
+      tbb::parallel_for(0, _nGof, calcPartition);
+    } else
+#endif
+    {
+      for (Int_t i = 0; i < _nGof; ++i) calcPartition(i);
+    }
+    _mtReady = kTRUE;
+
+    // Combine the partitions in a fixed order, so that the result does not
+    // depend on the number of threads nor on the order in which tasks ran
+    Double_t sum(0), carry = 0.;
+    for (Int_t i = 0; i < _nGof; ++i) {
+      Double_t y = val[i];
+      carry += valCarry[i];
+      y -= carry;
+      const Double_t t = sum + y;
+      carry = (t - sum) - y;
+      sum = t;
+    }
+
+    Double_t ret = sum ;
+    _evalCarry = carry;
+    return ret ;
+
   } else {
 
     // Evaluate as straight FUNC
@@ -345,6 +403,8 @@ Bool_t RooAbsTestStatistic::initialize()
   
   if (MPMaster == _gofOpMode) {
     initMPMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
+  } else if (MTMaster == _gofOpMode) {
+    initMTMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   } else if (SimMaster == _gofOpMode) {
     initSimMode((RooSimultaneous*)_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   }
@@ -359,7 +419,7 @@ Bool_t RooAbsTestStatistic::initialize()
 
 Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServerList, Bool_t mustReplaceAll, Bool_t nameChange, Bool_t)
 {
-  if (SimMaster == _gofOpMode && _gofArray) {
+  if ((SimMaster == _gofOpMode || MTMaster == _gofOpMode) && _gofArray) {
     // Forward to slaves
     for (Int_t i = 0; i < _nGof; ++i) {
       if (_gofArray[i]) {
@@ -386,7 +446,7 @@ Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServe
 
 void RooAbsTestStatistic::printCompactTreeHook(ostream& os, const char* indent)
 {
-  if (SimMaster == _gofOpMode) {
+  if (SimMaster == _gofOpMode || MTMaster == _gofOpMode) {
     // Forward to slaves
     os << indent << "RooAbsTestStatistic begin GOF contents" << endl ;
     for (Int_t i = 0; i < _nGof; ++i) {
@@ -424,6 +484,11 @@ void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t
     for (Int_t i = 0; i < _nCPU; ++i) {
       _mpfeArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
     }
+  } else if (MTMaster == _gofOpMode) {
+    for (Int_t i = 0; i < _nGof; ++i) {
+      _gofArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
+    }
+    _mtReady = kFALSE;
   }
 }
 
@@ -481,6 +546,37 @@ void RooAbsTestStatistic::initMPMode(RooAbsReal* real, RooAbsData* data, const R
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Initialize multi-threaded calculation mode. Create one component test statistic
+/// per partition of the data, each with its own clone of the function and its own
+/// caches. The data of the first component is shared read-only by the others when
+/// its storage allows it (see RooVectorDataStore::shareColumns()), so that the
+/// dataset is held only once in memory.
+
+void RooAbsTestStatistic::initMTMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName)
+{
+  _nGof = _nCPU;
+  _gofArray = new pRooAbsTestStatistic[_nGof];
+
+  Int_t nShared(0);
+  for (Int_t i = 0; i < _nGof; ++i) {
+    RooAbsTestStatistic* gof = create(Form("%s_GOF%d",GetName(),i),Form("%s_GOF%d",GetTitle(),i),*real,*data,*projDeps,
+				      rangeName,addCoefRangeName,1,_mpinterl,_verbose,_splitRange);
+    gof->recursiveRedirectServers(_paramSet);
+    gof->setMPSet(i,_nGof);
+    if (i > 0 && gof->shareDataSlave(*_gofArray[0])) {
+      ++nShared;
+    }
+    _gofArray[i] = gof;
+  }
+  _mtReady = kFALSE;
+
+  coutI(Eval) << "RooAbsTestStatistic::initMTMode: created " << _nGof << " partitions for calculation in parallel threads, "
+	      << nShared << " of them share the data of the first partition" << endl;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize simultaneous p.d.f processing mode. Strip simultaneous
 /// p.d.f into individual components, split dataset in subset
@@ -667,6 +763,11 @@ Bool_t RooAbsTestStatistic::setData(RooAbsData& indata, Bool_t cloneData)
     coutF(DataHandling) << "RooAbsTestStatistic::setData(" << GetName() << ") FATAL: setData() is not supported in multi-processor mode" << endl;
     throw string("RooAbsTestStatistic::setData is not supported in MPMaster mode");
     break;
+  case MTMaster:
+    // Not supported
+    coutF(DataHandling) << "RooAbsTestStatistic::setData(" << GetName() << ") FATAL: setData() is not supported in multi-threaded mode" << endl;
+    throw string("RooAbsTestStatistic::setData is not supported in MTMaster mode");
+    break;
   }
 
   return kTRUE;
@@ -703,9 +804,54 @@ void RooAbsTestStatistic::enableOffsetting(Bool_t flag)
       _mpfeArray[i]->enableOffsetting(flag);
     }
     break;
+  case MTMaster:
+    _doOffset = flag;
+    for (Int_t i = 0; i < _nGof; ++i) {
+      _gofArray[i]->enableOffsetting(flag);
+    }
+    _mtReady = kFALSE;
+    break;
   }
 }
 
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// If flag is true, test statistics constructed afterwards with more than one
+/// CPU calculate their partitions as tasks of the implicit multi-threading pool
+/// (see ROOT::EnableImplicitMT()) instead of in forked server processes. The
+/// partitions read their events from one shared copy of the data, each with its
+/// own clone of the function and its own caches, and their results are combined
+/// in a fixed order so that the value does not depend on the number of threads.
+/// If implicit multi-threading is not enabled, the partitions are calculated
+/// sequentially in the calling thread. The globals touched during the evaluation
+/// are guarded: the RooArgSet memory pool, the evaluation error log and flag,
+/// and the stream selection of RooMsgService (messages of different threads
+/// may still be interleaved in the output). Functions that share other state
+/// between their clones through global objects are not supported in this mode.
+
+void RooAbsTestStatistic::setThreadedEvaluation(Bool_t flag)
+{
+#ifdef R__USE_IMT
+  _threadedEval = flag ;
+#else
+  if (flag) {
+    oocoutW((TObject*)0,Eval) << "RooAbsTestStatistic::setThreadedEvaluation: ROOT was built without implicit multi-threading support, "
+			      << "partitions will be calculated in separate processes" << endl ;
+  }
+#endif
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the threaded evaluation is enabled, see setThreadedEvaluation()
+
+Bool_t RooAbsTestStatistic::threadedEvaluation()
+{
+  return _threadedEval ;
+}
+
+
 Double_t RooAbsTestStatistic::getCarry() const
 { return _evalCarry; }
@@ -24,6 +24,30 @@ the accept/reject sampling technique on any positively valued function.
 The RooAcceptReject generator is used by the various generator context
 classes to take care of generation of observables for which p.d.fs
 do not define internal methods
+
+If a batch size is configured (option batchSize, or setBatchSize()), trial
+samples are added to the event cache in batches. The sampling points of a
+batch are drawn first, in the same sequence of random numbers as in the
+event by event mode, and the function is then evaluated for all of them:
+in a single pass over the columns of the cache if the function supports
+batch evaluation (see RooAbsReal::getValBatch()), or else in parallel by
+copies of the function if implicit multi-threading is enabled and more than
+one thread is configured (option nThreads).
+
+The random numbers are drawn in the same order in both modes, so that the
+generated sample does not depend on the batch size or on the number of
+threads. Without known function maximum, all trial points of a refill of the
+cache are drawn before the random numbers of the accept step, as in the event
+by event mode. With a function maximum known a priori, the event by event
+mode draws the random number of the accept step of each trial sample right
+after its point: the batch mode draws them in the same order and keeps them
+with the trial samples. The unused trial samples are kept when the
+parameters, e.g. conditional observables, change from event to event, and
+only the function is evaluated again for them. The size of each refill then
+follows the observed acceptance rate. The generated samples are identical in
+both modes as long as the function does not exceed the known maximum and no
+other random numbers are drawn between two events, e.g. by the internal
+generator of other observables.
 **/
 
 
@@ -47,8 +71,15 @@ do not define internal methods
 #include "RooRealBinding.h"
 #include "RooNumGenFactory.h"
 #include "RooNumGenConfig.h"
+#include "RooVectorDataStore.h"
+#include "TROOT.h"
 
 #include <assert.h>
+#include <algorithm>
+
+#ifdef R__USE_IMT
+#include "tbb/parallel_for.h"
+#endif
 
 using namespace std;
 
@@ -65,9 +96,14 @@ void RooAcceptReject::registerSampler(RooNumGenFactory& fact)
   RooRealVar nTrial1D("nTrial1D","Number of trial samples for 1-dim generation",1000,0,1e9) ;
   RooRealVar nTrial2D("nTrial2D","Number of trial samples for 2-dim generation",100000,0,1e9) ;
   RooRealVar nTrial3D("nTrial3D","Number of trial samples for N-dim generation",10000000,0,1e9) ;
+  RooRealVar batchSize("batchSize","Number of trial samples evaluated together (0: one by one)",0,0,1e9) ;
+  RooRealVar nThreads("nThreads","Number of threads evaluating the trial samples",1,1,1024) ;
+
+  RooArgSet config(nTrial0D,nTrial1D,nTrial2D,nTrial3D) ;
+  config.add(RooArgSet(batchSize,nThreads)) ;
 
   RooAcceptReject* proto = new RooAcceptReject ;
-  fact.storeProtoSampler(proto,RooArgSet(nTrial0D,nTrial1D,nTrial2D,nTrial3D)) ;
+  fact.storeProtoSampler(proto,config) ;
 }
 
 
@@ -79,12 +115,15 @@ void RooAcceptReject::registerSampler(RooNumGenFactory& fact)
 /// cloned and so will not be disturbed during the generation process.
 
 RooAcceptReject::RooAcceptReject(const RooAbsReal &func, const RooArgSet &genVars, const RooNumGenConfig& config, Bool_t verbose, const RooAbsReal* maxFuncVal) :
-  RooAbsNumGenerator(func,genVars,verbose,maxFuncVal), _nextCatVar(0), _nextRealVar(0)
+  RooAbsNumGenerator(func,genVars,verbose,maxFuncVal), _nextCatVar(0), _nextRealVar(0), _batchSize(0), _nThreads(1),
+  _vstore(0), _binding(0), _funcClonesFailed(kFALSE), _params(0)
 {
   _minTrialsArray[0] = static_cast<Int_t>(config.getConfigSection("RooAcceptReject").getRealValue("nTrial0D")) ;
   _minTrialsArray[1] = static_cast<Int_t>(config.getConfigSection("RooAcceptReject").getRealValue("nTrial1D")) ;
   _minTrialsArray[2] = static_cast<Int_t>(config.getConfigSection("RooAcceptReject").getRealValue("nTrial2D")) ;
   _minTrialsArray[3] = static_cast<Int_t>(config.getConfigSection("RooAcceptReject").getRealValue("nTrial3D")) ;
+  setBatchSize(static_cast<Int_t>(config.getConfigSection("RooAcceptReject").getRealValue("batchSize",0))) ;
+  setNumThreads(static_cast<Int_t>(config.getConfigSection("RooAcceptReject").getRealValue("nThreads",1))) ;
 
   _realSampleDim = _realVars.getSize() ;
   TIterator* iter = _catVars.createIterator() ;
@@ -139,6 +178,9 @@ RooAcceptReject::RooAcceptReject(const RooAbsReal &func, const RooArgSet &genVar
       ccoutI(Generation) << "  Category sampling multiplier is " << _catSampleMult << endl ;
       ccoutI(Generation) << "  Min sampling trials is " << _minTrials << endl;
     }
+    if (_batchSize>0) {
+      ccoutI(Generation) << "  Trial samples are evaluated in batches of " << _batchSize << " using up to " << _nThreads << " threads" << endl ;
+    }
     if (_catVars.getSize()>0) {
       ccoutI(Generation) << "  Will generate category vars "<< _catVars << endl ;
     }
@@ -167,6 +209,74 @@ RooAcceptReject::~RooAcceptReject()
 {
   delete _nextCatVar;
   delete _nextRealVar;
+  deleteFunctionClones() ;
+  delete _params ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of trial samples that are added to the event cache
+/// together. With a batch size of zero, the trial samples are added one by
+/// one. In batch mode the event cache is kept in a RooVectorDataStore.
+
+void RooAcceptReject::setBatchSize(Int_t nTrials) 
+{
+  _batchSize = nTrials>0 ? nTrials : 0 ;
+  if (_batchSize==0 || _vstore || !_cache) return ;
+
+  _cache->convertToVectorStore() ;
+  _vstore = dynamic_cast<RooVectorDataStore*>(_cache->store()) ;
+  if (!_vstore) {
+    coutW(Generation) << "RooAcceptReject::setBatchSize(" << GetName() << ") WARNING: event cache can not be converted "
+		      << "to vector storage, trial samples will be added one by one" << endl ;
+    _batchSize = 0 ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of threads that evaluate the function for a batch of
+/// trial samples, if the function does not support batch evaluation. This
+/// requires implicit multi-threading to be enabled, see ROOT::EnableImplicitMT(),
+/// and is not done if categories are generated.
+
+void RooAcceptReject::setNumThreads(Int_t nThreads) 
+{
+  _nThreads = nThreads>1 ? nThreads : 1 ;
+  deleteFunctionClones() ;
+  _funcClonesFailed = kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reattach original parameters to function clone. The copies of the
+/// function used by the threads are recreated on their next use.
+
+void RooAcceptReject::attachParameters(const RooArgSet& vars) 
+{
+  RooAbsNumGenerator::attachParameters(vars) ;
+  deleteFunctionClones() ;
+  delete _params ;
+  _params = 0 ;
+  _paramVals.clear() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the copies of the function used for the evaluation in threads
+
+void RooAcceptReject::deleteFunctionClones() 
+{
+  for (vector<RooAbsFunc*>::iterator iter=_funcClones.begin() ; iter!=_funcClones.end() ; ++iter) {
+    delete *iter ;
+  }
+  _funcClones.clear() ;
+  delete _binding ;
+  _binding = 0 ;
 }
 
 
@@ -189,7 +299,12 @@ const RooArgSet *RooAcceptReject::generateEvent(UInt_t remaining, Double_t& resa
     // maximum function value
 
     while(_totalEvents < _minTrials) {
-      addEventToCache();
+      if (_batchSize>0) {
+	// Stay within the cache size limit applied below
+	addEventsToCache(std::min(Long64_t(_minTrials-_totalEvents),Long64_t(1000001-_cache->numEntries()))) ;
+      } else {
+	addEventToCache();
+      }
 
       // Limit cache size to 1M events
       if (_cache->numEntries()>1000000) {
@@ -225,13 +340,21 @@ const RooArgSet *RooAcceptReject::generateEvent(UInt_t remaining, Double_t& resa
       Long64_t extra= 1 + (Long64_t)(1.05*remaining/eff);
       cxcoutD(Generation) << "RooAcceptReject::generateEvent: adding " << extra << " events to the cache, eff = " << eff << endl;
       Double_t oldMax(_maxFuncVal);
-      while(extra--) {
-	addEventToCache();
+      if (_batchSize>0) {
+	addEventsToCache(extra) ;
 	if((_maxFuncVal > oldMax)) {
 	  cxcoutD(Generation) << "RooAcceptReject::generateEvent: estimated function maximum increased from "
 			      << oldMax << " to " << _maxFuncVal << endl;
-	  oldMax = _maxFuncVal ;
-	  // Trim cache here
+	}
+      } else {
+	while(extra--) {
+	  addEventToCache();
+	  if((_maxFuncVal > oldMax)) {
+	    cxcoutD(Generation) << "RooAcceptReject::generateEvent: estimated function maximum increased from "
+				<< oldMax << " to " << _maxFuncVal << endl;
+	    oldMax = _maxFuncVal ;
+	    // Trim cache here
+	  }
 	}
       }
     }
@@ -246,11 +369,41 @@ const RooArgSet *RooAcceptReject::generateEvent(UInt_t remaining, Double_t& resa
     // Generation with a priori maximum knowledge
     _maxFuncVal = _funcMaxVal->getVal() ;
     
-    // Generate enough trials to produce a single accepted event
-    event = 0 ;
-    while(0==event) {
-      addEventToCache() ;
+    if (_batchSize>0) {
+      // Use the remaining trial samples of the cache first. The trial points
+      // do not depend on the parameters: if these have changed (e.g. the
+      // conditional observables of the previous event), only the function
+      // values of the unused trial samples are calculated again
+      const Bool_t changed = parametersChanged() ;
+      const Int_t nCached = _cache->numEntries() ;
+      if (changed && nCached>Int_t(_eventsUsed)) {
+	_trialVals.resize(nCached-_eventsUsed) ;
+	evaluateTrials(&_trialVals[0],_eventsUsed,nCached) ;
+	_vstore->setRealColumn(*_funcValPtr,_eventsUsed,nCached,&_trialVals[0]) ;
+      }
       event = nextAcceptedEvent() ;
+      while(0==event) {
+	_cache->reset() ;
+	_eventsUsed = 0 ;
+	_acceptVals.clear() ;
+	// Size the refill from the observed efficiency. If the parameters change
+	// from event to event, the trial samples only serve the current event.
+	Long64_t extra = _batchSize ;
+	if (_totalEvents>0 && _funcSum>0 && _maxFuncVal>0) {
+	  Double_t eff = _funcSum/(_totalEvents*_maxFuncVal) ;
+	  Double_t needed = changed ? 1 : std::max(remaining,UInt_t(1)) ;
+	  extra = std::min(1 + (Long64_t)(1.05*needed/eff),Long64_t(changed ? _batchSize : 1000000)) ;
+	}
+	addEventsToCache(extra) ;
+	event = nextAcceptedEvent() ;
+      }
+    } else {
+      // Generate enough trials to produce a single accepted event
+      event = 0 ;
+      while(0==event) {
+	addEventToCache() ;
+	event = nextAcceptedEvent() ;
+      }
     }
 
   }
@@ -270,9 +423,9 @@ const RooArgSet *RooAcceptReject::nextAcceptedEvent()
 {
   const RooArgSet *event = 0;
   while((event= _cache->get(_eventsUsed))) {    
-    _eventsUsed++ ;
-    // accept this cached event?
-    Double_t r= RooRandom::uniform();
+    const UInt_t row = _eventsUsed++ ;
+    // accept this cached event? The random number may have been drawn with the trial sample
+    Double_t r= row<_acceptVals.size() ? _acceptVals[row] : RooRandom::uniform();
     if(r*_maxFuncVal > _funcValPtr->getVal()) {
       //cout << " event number " << _eventsUsed << " has been rejected" << endl ;
       continue;
@@ -327,6 +480,175 @@ void RooAcceptReject::addEventToCache()
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add nEvents trial events to our cache in batches of _batchSize events
+/// and update our estimates of the function maximum value and integral.
+/// The sampling points are drawn in the same order as by addEventToCache(),
+/// the function values of a batch are then calculated by evaluateTrials().
+
+void RooAcceptReject::addEventsToCache(Long64_t nEvents) 
+{
+  if (_batchSize<=0) {
+    while(nEvents-->0) addEventToCache() ;
+    return ;
+  }
+
+  while(nEvents>0) {
+    const Int_t n = Int_t(std::min(nEvents,Long64_t(_batchSize))) ;
+    nEvents -= n ;
+
+    // Draw the sampling points of this batch
+    const Int_t begin = _cache->numEntries() ;
+    for (Int_t i=0 ; i<n ; i++) {
+      _nextCatVar->Reset();
+      RooCategory *cat = 0;
+      while((cat= (RooCategory*)_nextCatVar->Next())) cat->randomize();
+
+      _nextRealVar->Reset();
+      RooRealVar *real = 0;
+      while((real= (RooRealVar*)_nextRealVar->Next())) real->randomize();
+
+      _cache->fill();
+
+      // With a known maximum, the event by event mode draws the random number
+      // of the accept step right after the trial point
+      if (_funcMaxVal) _acceptVals.push_back(RooRandom::uniform()) ;
+    }
+
+    // Calculate and store the function values
+    _trialVals.resize(n) ;
+    evaluateTrials(&_trialVals[0],begin,begin+n) ;
+    _vstore->setRealColumn(*_funcValPtr,begin,begin+n,&_trialVals[0]) ;
+
+    // Update the estimated integral and maximum value in the order of the samples
+    for (Int_t i=0 ; i<n ; i++) {
+      const Double_t val = _trialVals[i] ;
+      if(val > _maxFuncVal) _maxFuncVal= 1.05*val;
+      _funcSum+= val;
+    }
+    _totalEvents+= n;
+
+    if (_verbose) {
+      cerr << "RooAcceptReject: generated " << _totalEvents << " events so far." << endl ;
+    }
+  }
+
+  // Remember the parameter values for which the cached samples were evaluated
+  parametersChanged() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the function values for the cached trial events [begin,end[.
+/// The function is evaluated in batch over the columns of the cache if it
+/// supports this. Otherwise, with more than one thread configured and
+/// implicit multi-threading enabled, blocks of events are evaluated in
+/// parallel by copies of the function (see RooAbsFunc::cloneForThread()),
+/// or else the events are evaluated one by one.
+
+void RooAcceptReject::evaluateTrials(Double_t* output, Int_t begin, Int_t end) 
+{
+  if (_funcClone->getValBatch(output,begin,end,*_vstore)) return ;
+
+#ifdef R__USE_IMT
+  const Int_t n = end-begin ;
+  if (_nThreads>1 && !_funcClonesFailed && ROOT::IsImplicitMTEnabled() && _catVars.getSize()==0 && n>=2*_nThreads) {
+
+    // Make the copies of the function on first use
+    if (_funcClones.empty()) {
+      _binding = new RooRealBinding(*_funcClone,_realVars) ;
+      for (Int_t i=0 ; i<_nThreads ; i++) {
+	RooAbsFunc* clone = _binding->cloneForThread() ;
+	if (!clone || !clone->isValid()) {
+	  delete clone ;
+	  deleteFunctionClones() ;
+	  _funcClonesFailed = kTRUE ;
+	  coutI(Generation) << "RooAcceptReject::evaluateTrials(" << GetName() << ") function " << _funcClone->GetName()
+			    << " can not be copied, evaluating it in a single thread" << endl ;
+	  break ;
+	}
+	_funcClones.push_back(clone) ;
+      }
+    }
+
+    if (!_funcClones.empty()) {
+      const Int_t dim = _realVars.getSize() ;
+      vector<const Double_t*> columns ;
+      RooFIter iter = _realVars.fwdIterator() ;
+      RooAbsArg* arg ;
+      while((arg=iter.next())) {
+	columns.push_back(_vstore->realColumn(*(RooAbsReal*)arg)) ;
+      }
+
+      // Update the parameters of the copies and evaluate each of them once
+      // sequentially, so that their internal caches are set up before the
+      // parallel evaluation
+      vector<Double_t> x0(dim) ;
+      for (Int_t d=0 ; d<dim ; d++) x0[d] = columns[d][begin] ;
+      for (vector<RooAbsFunc*>::iterator fiter=_funcClones.begin() ; fiter!=_funcClones.end() ; ++fiter) {
+	(*fiter)->syncThreadClone() ;
+	(**fiter)(&x0[0]) ;
+      }
+
+      const Int_t nblock = _funcClones.size() ;
+      tbb::parallel_for(0, nblock, [&](Int_t iblock) {
+	  const Int_t first = begin + Int_t((Long64_t(n)*iblock)/nblock) ;
+	  const Int_t last = begin + Int_t((Long64_t(n)*(iblock+1))/nblock) ;
+	  const RooAbsFunc& func = *_funcClones[iblock] ;
+	  vector<Double_t> x(dim) ;
+	  for (Int_t i=first ; i<last ; i++) {
+	    for (Int_t d=0 ; d<dim ; d++) x[d] = columns[d][i] ;
+	    output[i-begin] = func(&x[0]) ;
+	  }
+	}) ;
+      return ;
+    }
+  }
+#endif
+
+  for (Int_t i=begin ; i<end ; i++) {
+    _cache->get(i) ;
+    output[i-begin] = _funcClone->getVal() ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the value of any parameter of the function has changed
+/// since the last call, and record the current values
+
+Bool_t RooAcceptReject::parametersChanged() 
+{
+  if (!_params) {
+    _params = _funcClone->getParameters(*_cache->get()) ;
+  }
+
+  Bool_t changed = (_paramVals.size()!=UInt_t(_params->getSize())) ;
+  _paramVals.resize(_params->getSize()) ;
+
+  RooFIter iter = _params->fwdIterator() ;
+  RooAbsArg* arg ;
+  Int_t i(0) ;
+  while((arg=iter.next())) {
+    Double_t val(0) ;
+    if (RooAbsReal* real = dynamic_cast<RooAbsReal*>(arg)) {
+      val = real->getVal() ;
+    } else if (RooAbsCategory* cat = dynamic_cast<RooAbsCategory*>(arg)) {
+      val = cat->getIndex() ;
+    }
+    if (val!=_paramVals[i]) {
+      _paramVals[i] = val ;
+      changed = kTRUE ;
+    }
+    i++ ;
+  }
+  return changed ;
+}
+
+
+
 Double_t RooAcceptReject::getFuncMax() 
 {
   // Empirically determine maximum value of function by taking a large number
@@ -335,7 +657,11 @@ Double_t RooAcceptReject::getFuncMax()
 
   // Generate the minimum required number of samples for a reliable maximum estimate
   while(_totalEvents < _minTrials) {
-    addEventToCache();
+    if (_batchSize>0) {
+      addEventsToCache(std::min(Long64_t(_minTrials-_totalEvents),Long64_t(1000001-_cache->numEntries()))) ;
+    } else {
+      addEventToCache();
+    }
 
     // Limit cache size to 1M events
     if (_cache->numEntries()>1000000) {
@@ -860,6 +860,53 @@ Double_t RooAddPdf::evaluate() const
 }
 
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): calculate the sum of the coefficients
+/// times the component values for the events [begin,end[ of data
+
+Bool_t RooAddPdf::evaluateBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data) const
+{
+  const RooArgSet* nset = _normSet ; 
+
+  if (nset==0 || nset->getSize()==0) {
+    if (_refCoefNorm.getSize()!=0) {
+      nset = &_refCoefNorm ;
+    }
+  }
+
+  CacheElem* cache = getProjCache(nset) ;
+  updateCoefficients(*cache,nset) ;
+
+  const Int_t n = end-begin ;
+  std::vector<Double_t> pdfVal(n), snormVal(n) ;
+  std::fill(output,output+n,0.) ;
+
+  RooAbsPdf* pdf ;
+  Int_t i(0) ;
+  RooFIter pi = _pdfList.fwdIterator() ;
+  while((pdf = (RooAbsPdf*)pi.next())) {
+    if (pdf->isSelectedComp()) {
+      if (!pdf->getValBatch(&pdfVal[0],begin,end,data,nset)) return kFALSE ;
+      const Double_t coef = _coefCache[i] ;
+      if (cache->_needSupNorm) {
+	if (!((RooAbsReal*)cache->_suppNormList.at(i))->getValBatch(&snormVal[0],begin,end,data)) return kFALSE ;
+	for (Int_t j=0 ; j<n ; j++) {
+	  output[j] += pdfVal[j]*coef/snormVal[j] ;
+	}
+      } else {
+	for (Int_t j=0 ; j<n ; j++) {
+	  output[j] += pdfVal[j]*coef ;
+	}
+      }
+    }
+    i++ ;
+  }
+
+  return kTRUE ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset error counter to given value, limiting the number
 /// of future error messages for this pdf to 'resetValue'
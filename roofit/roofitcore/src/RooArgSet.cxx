@@ -44,6 +44,7 @@
 #include <fstream>
 #include <list>
 #include "TClass.h"
+#include "TVirtualMutex.h"
 #include "RooErrorHandler.h"
 #include "RooArgSet.h"
 #include "RooStreamParser.h"
@@ -77,11 +78,15 @@ struct POOLDATA
 
 static std::list<POOLDATA> _memPoolList ;
 
+// Protects the memory pool when test statistics are calculated in several threads
+static TVirtualMutex* gRooArgSetPoolMutex = 0 ;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Clear memoery pool on exit to avoid reported memory leaks
 
 void RooArgSet::cleanup()
 {
+  R__LOCKGUARD_IMT2(gRooArgSetPoolMutex) ;
   std::list<POOLDATA>::iterator iter = _memPoolList.begin() ;
   while(iter!=_memPoolList.end()) {
     free(iter->_base) ;
@@ -105,6 +110,8 @@ void* RooArgSet::operator new (size_t bytes)
 {
   //cout << " RooArgSet::operator new(" << bytes << ")" << endl ;
 
+  R__LOCKGUARD_IMT2(gRooArgSetPoolMutex) ;
+
   if (!_poolBegin || _poolCur+(sizeof(RooArgSet)) >= _poolEnd) {
 
     if (_poolBegin!=0) {
@@ -180,6 +187,7 @@ void* RooArgSet::operator new (size_t bytes, void* ptr) noexcept
 void RooArgSet::operator delete (void* ptr)
 {
   // Decrease use count in pool that ptr is on
+  R__LOCKGUARD_IMT2(gRooArgSetPoolMutex) ;
   for (std::list<POOLDATA>::iterator poolIter =  _memPoolList.begin() ; poolIter!=_memPoolList.end() ; ++poolIter) {
     if ((char*)ptr > (char*)poolIter->_base && (char*)ptr < (char*)poolIter->_base + POOLSIZE) {
       (*(Int_t*)(poolIter->_base))-- ;
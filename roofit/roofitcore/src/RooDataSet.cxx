@@ -49,6 +49,7 @@ or RooStringVar objects
 #include "TFile.h"
 #include "RooTreeDataStore.h"
 #include "RooVectorDataStore.h"
+#include "RooTreeColumnDataStore.h"
 #include "RooCompositeDataStore.h"
 #include "RooTreeData.h"
 #include "RooSentinel.h"
@@ -375,7 +376,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
     if (defaultStorageType==Tree) {
       tstore = new RooTreeDataStore(name,title,_vars,wgtVarName) ;
       _dstore = tstore ;
-    } else if (defaultStorageType==Vector) {
+    } else if (defaultStorageType==Vector || defaultStorageType==Column) {
       if (wgtVarName && newWeight) {
 	RooAbsArg* wgttmp = _vars.find(wgtVarName) ;
 	if (wgttmp) {
@@ -759,19 +760,27 @@ RooDataSet::RooDataSet(const char *name, const char *title, TTree *intree,
 		       const RooArgSet& vars, const RooFormulaVar& cutVar, const char* wgtVarName) :
   RooAbsData(name,title,vars)
 {
-  // Create tree version of datastore 
-  RooTreeDataStore* tstore = new RooTreeDataStore(name,title,_vars,*intree,cutVar,wgtVarName) ;
-
-  // Convert to vector datastore if needed
-  if (defaultStorageType==Tree) {
-    _dstore = tstore ;
-  } else if (defaultStorageType==Vector) {
-    RooVectorDataStore* vstore = new RooVectorDataStore(name,title,_vars,wgtVarName) ;
-    _dstore = vstore ;
-    _dstore->append(*tstore) ;
-    delete tstore ;
+  if (defaultStorageType==Column) {
+    // Read the branches of the observables into columns, without copying the tree
+    RooTreeColumnDataStore* cstore = new RooTreeColumnDataStore(name,title,_vars,*intree,cutVar,wgtVarName) ;
+    cstore->loadColumns() ;
+    _dstore = cstore ;
   } else {
-    _dstore = 0 ;
+
+    // Create tree version of datastore 
+    RooTreeDataStore* tstore = new RooTreeDataStore(name,title,_vars,*intree,cutVar,wgtVarName) ;
+
+    // Convert to vector datastore if needed
+    if (defaultStorageType==Tree) {
+      _dstore = tstore ;
+    } else if (defaultStorageType==Vector) {
+      RooVectorDataStore* vstore = new RooVectorDataStore(name,title,_vars,wgtVarName) ;
+      _dstore = vstore ;
+      _dstore->append(*tstore) ;
+      delete tstore ;
+    } else {
+      _dstore = 0 ;
+    }
   }
   
   appendToDir(this,kTRUE) ;
@@ -801,19 +810,27 @@ RooDataSet::RooDataSet(const char *name, const char *title, TTree *intree,
 		       const RooArgSet& vars, const char *selExpr, const char* wgtVarName) :
   RooAbsData(name,title,vars)
 {
-  // Create tree version of datastore 
-  RooTreeDataStore* tstore = new RooTreeDataStore(name,title,_vars,*intree,selExpr,wgtVarName) ;
-
-  // Convert to vector datastore if needed
-  if (defaultStorageType==Tree) {
-    _dstore = tstore ;
-  } else if (defaultStorageType==Vector) {
-    RooVectorDataStore* vstore = new RooVectorDataStore(name,title,_vars,wgtVarName) ;
-    _dstore = vstore ;
-    _dstore->append(*tstore) ;
-    delete tstore ;
+  if (defaultStorageType==Column) {
+    // Read the branches of the observables into columns, without copying the tree
+    RooTreeColumnDataStore* cstore = new RooTreeColumnDataStore(name,title,_vars,*intree,selExpr,wgtVarName) ;
+    cstore->loadColumns() ;
+    _dstore = cstore ;
   } else {
-    _dstore = 0 ;
+
+    // Create tree version of datastore 
+    RooTreeDataStore* tstore = new RooTreeDataStore(name,title,_vars,*intree,selExpr,wgtVarName) ;
+
+    // Convert to vector datastore if needed
+    if (defaultStorageType==Tree) {
+      _dstore = tstore ;
+    } else if (defaultStorageType==Vector) {
+      RooVectorDataStore* vstore = new RooVectorDataStore(name,title,_vars,wgtVarName) ;
+      _dstore = vstore ;
+      _dstore->append(*tstore) ;
+      delete tstore ;
+    } else {
+      _dstore = 0 ;
+    }
   }
 
   appendToDir(this,kTRUE) ;
@@ -843,9 +860,14 @@ RooDataSet::RooDataSet(const char *name, const char *title, RooDataSet *dset,
 		       Int_t nStart, Int_t nStop, Bool_t copyCache, const char* wgtVarName) :
   RooAbsData(name,title,vars)
 {
-  _dstore = (defaultStorageType==Tree) ? 
-    ((RooAbsDataStore*) new RooTreeDataStore(name,title,*dset->_dstore,_vars,cutVar,cutRange,nStart,nStop,copyCache,wgtVarName)) :
-    ((RooAbsDataStore*) new RooVectorDataStore(name,title,*dset->_dstore,_vars,cutVar,cutRange,nStart,nStop,copyCache,wgtVarName)) ;
+  if (dynamic_cast<RooTreeColumnDataStore*>(dset->_dstore)) {
+    // Reduced views of column storage share the columns of the original
+    _dstore = new RooTreeColumnDataStore(name,title,*(RooTreeColumnDataStore*)dset->_dstore,_vars,cutVar,cutRange,nStart,nStop,wgtVarName) ;
+  } else {
+    _dstore = (defaultStorageType==Tree) ? 
+      ((RooAbsDataStore*) new RooTreeDataStore(name,title,*dset->_dstore,_vars,cutVar,cutRange,nStart,nStop,copyCache,wgtVarName)) :
+      ((RooAbsDataStore*) new RooVectorDataStore(name,title,*dset->_dstore,_vars,cutVar,cutRange,nStart,nStop,copyCache,wgtVarName)) ;
+  }
 
   _cachedVars.add(_dstore->cachedVars()) ;
 
@@ -0,0 +1,292 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * @(#)root/roofitcore:$Id$
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+/**
+\file RooDependencyIndex.cxx
+\class RooDependencyIndex
+\ingroup Roofitcore
+
+RooDependencyIndex is a precomputed map of the value dependencies of an
+expression graph on a list of parameters. For each parameter it stores a
+bitset of the nodes whose value depends on it, i.e. the nodes that
+RooAbsArg::setValueDirty() reaches when the parameter changes.
+
+When several parameters are changed at once, as in each step of a
+minimization, the changes can be collected between beginUpdate() and
+endUpdate(). The dirty state propagation through the client graph is
+then inhibited while the parameters are set, and endUpdate() raises the
+value dirty flag of the affected nodes in a single pass over the union of
+their bitsets, visiting every node at most once.
+
+The index follows the propagation rules of RooAbsArg: propagation stops at
+nodes that are not in Auto operation mode. Any change of the client-server
+links of the graph, or of the operation mode of a node at which the
+propagation stopped, invalidates the index, see isValid(). An invalid
+index must be rebuilt before it is used.
+
+freeze() switches the branch nodes that feed into the indexed nodes, but
+that depend on constant leaves only, to AClean mode so that their cached
+values are used without any dirty state check until unfreeze() is called.
+**/
+
+
+#include "RooFit.h"
+
+#include "RooDependencyIndex.h"
+#include "RooAbsArg.h"
+#include "RooArgSet.h"
+#include "RooMsgService.h"
+
+#include <map>
+#include <set>
+
+using namespace std ;
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Construct the dependency index of the nodes of the graph of top on the
+/// given list of parameters. The index covers all value clients of the
+/// parameters, including those outside of the expression of top.
+
+RooDependencyIndex::RooDependencyIndex(const RooAbsArg& top, const RooArgList& params) :
+  _top(&top),
+  _params(params),
+  _generation(0),
+  _inUpdate(kFALSE),
+  _anyPending(kFALSE),
+  _savedInhibit(kFALSE)
+{
+  rebuild() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor. Restores the operation mode of the frozen nodes
+
+RooDependencyIndex::~RooDependencyIndex()
+{
+  if (_inUpdate) endUpdate() ;
+  unfreeze() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Recompute the dependency bitsets from the current client-server links
+/// and operation modes of the graph
+
+void RooDependencyIndex::rebuild()
+{
+  _nodes.clear() ;
+  _boundary.clear() ;
+  _boundaryMode.clear() ;
+  _generation = RooAbsArg::graphGeneration() ;
+
+  map<const RooAbsArg*,Int_t> nodeIndex ;
+  set<const RooAbsArg*> boundarySet ;
+  vector<vector<Int_t> > members(_params.getSize()) ;
+
+  for (Int_t ip=0 ; ip<_params.getSize() ; ip++) {
+
+    // Depth-first traversal of the value clients, following the rules of RooAbsArg::setValueDirty()
+    set<const RooAbsArg*> visited ;
+    vector<RooAbsArg*> stack ;
+    stack.push_back(_params.at(ip)) ;
+    visited.insert(_params.at(ip)) ;
+
+    while (!stack.empty()) {
+      RooAbsArg* arg = stack.back() ;
+      stack.pop_back() ;
+
+      map<const RooAbsArg*,Int_t>::iterator it = nodeIndex.find(arg) ;
+      if (it==nodeIndex.end()) {
+	it = nodeIndex.insert(make_pair(arg,Int_t(_nodes.size()))).first ;
+	_nodes.push_back(arg) ;
+      }
+      members[ip].push_back(it->second) ;
+
+      RooFIter iter = arg->valueClientMIterator() ;
+      RooAbsArg* client ;
+      while ((client=iter.next())) {
+	if (client->_operMode!=RooAbsArg::Auto) {
+	  if (boundarySet.insert(client).second) {
+	    _boundary.push_back(client) ;
+	    _boundaryMode.push_back(client->_operMode) ;
+	  }
+	  continue ;
+	}
+	if (visited.insert(client).second) {
+	  stack.push_back(client) ;
+	}
+      }
+    }
+  }
+
+  // Convert the member lists into bitsets
+  const Int_t nwords = (_nodes.size()+63)/64 ;
+  _masks.assign(_params.getSize(),vector<ULong64_t>(nwords,0)) ;
+  _pending.assign(nwords,0) ;
+  for (Int_t ip=0 ; ip<_params.getSize() ; ip++) {
+    for (vector<Int_t>::const_iterator m=members[ip].begin() ; m!=members[ip].end() ; ++m) {
+      _masks[ip][*m/64] |= (ULong64_t(1) << (*m%64)) ;
+    }
+  }
+
+  oocxcoutD((TObject*)0,LinkStateMgmt) << "RooDependencyIndex::rebuild(" << _top->GetName() << "): indexed "
+				       << _nodes.size() << " nodes depending on " << _params.getSize()
+				       << " parameters, " << _boundary.size() << " boundary nodes" << endl ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the graph has not changed since the index was built:
+/// no client-server link was added or removed and the propagation
+/// boundary nodes kept their operation mode
+
+Bool_t RooDependencyIndex::isValid() const
+{
+  if (_generation!=RooAbsArg::graphGeneration()) return kFALSE ;
+  for (UInt_t i=0 ; i<_boundary.size() ; i++) {
+    if (_boundary[i]->_operMode!=_boundaryMode[i]) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start collecting parameter changes. Until endUpdate() is called the
+/// global dirty state propagation is inhibited: values of the parameters
+/// may be changed, but no value of the graph may be evaluated.
+
+void RooDependencyIndex::beginUpdate()
+{
+  if (_inUpdate) return ;
+  _savedInhibit = RooAbsArg::_inhibitDirty ;
+  RooAbsArg::setDirtyInhibit(kTRUE) ;
+  _inUpdate = kTRUE ;
+  _anyPending = kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Declare that the value of parameter iparam has changed. Outside of an
+/// update the dirty state is propagated immediately.
+
+void RooDependencyIndex::setValueDirty(Int_t iparam)
+{
+  if (_params.at(iparam)->_operMode!=RooAbsArg::Auto) return ;
+
+  if (!_inUpdate) {
+    _params.at(iparam)->setValueDirty() ;
+    return ;
+  }
+
+  const vector<ULong64_t>& mask = _masks[iparam] ;
+  for (UInt_t w=0 ; w<mask.size() ; w++) {
+    _pending[w] |= mask[w] ;
+  }
+  _anyPending = kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Restore the global dirty state propagation and raise the value dirty
+/// flag of all nodes depending on the parameters changed since beginUpdate()
+
+void RooDependencyIndex::endUpdate()
+{
+  if (!_inUpdate) return ;
+  _inUpdate = kFALSE ;
+  RooAbsArg::setDirtyInhibit(_savedInhibit) ;
+
+  if (!_anyPending) return ;
+  _anyPending = kFALSE ;
+
+  for (UInt_t w=0 ; w<_pending.size() ; w++) {
+    ULong64_t bits = _pending[w] ;
+    _pending[w] = 0 ;
+    // With global dirty inhibit there is nothing to propagate
+    if (_savedInhibit) continue ;
+    for (Int_t b=0 ; bits ; b++, bits >>= 1) {
+      if (!(bits&1)) continue ;
+      // Nodes that left the Auto mode since the index was built keep their state
+      RooAbsArg* arg = _nodes[w*64+b] ;
+      if (arg->_operMode==RooAbsArg::Auto) arg->_valueDirty = kTRUE ;
+    }
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Switch to AClean mode the branch nodes that are servers of the indexed
+/// nodes but that depend on constant leaf nodes only. The value of top is
+/// expected to be up to date: only nodes with a clean value are frozen. The
+/// frozen nodes must not be deleted, nor their constant leaves modified,
+/// before unfreeze() is called.
+
+void RooDependencyIndex::freeze()
+{
+  if (!_frozen.empty()) return ;
+
+  set<const RooAbsArg*> indexed(_nodes.begin(),_nodes.end()) ;
+  set<const RooAbsArg*> visited ;
+
+  for (vector<RooAbsArg*>::const_iterator n=_nodes.begin() ; n!=_nodes.end() ; ++n) {
+    RooFIter iter = (*n)->serverMIterator() ;
+    RooAbsArg* server ;
+    while ((server=iter.next())) {
+      if (indexed.count(server) || !visited.insert(server).second) continue ;
+      if (!server->isDerived() || server->_operMode!=RooAbsArg::Auto || server->_valueDirty) continue ;
+
+      RooArgSet leaves ;
+      server->leafNodeServerList(&leaves,0,kTRUE) ;
+      Bool_t allConstant(kTRUE) ;
+      RooFIter liter = leaves.fwdIterator() ;
+      RooAbsArg* leaf ;
+      while ((leaf=liter.next())) {
+	if (!leaf->isConstant()) {
+	  allConstant = kFALSE ;
+	  break ;
+	}
+      }
+      if (!allConstant) continue ;
+
+      server->setOperMode(RooAbsArg::AClean) ;
+      _frozen.push_back(server) ;
+    }
+  }
+
+  oocxcoutD((TObject*)0,LinkStateMgmt) << "RooDependencyIndex::freeze(" << _top->GetName() << "): "
+				       << _frozen.size() << " constant nodes switched to AClean mode" << endl ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Restore the Auto operation mode of the nodes frozen by freeze() and
+/// mark their value dirty
+
+void RooDependencyIndex::unfreeze()
+{
+  for (vector<RooAbsArg*>::const_iterator f=_frozen.begin() ; f!=_frozen.end() ; ++f) {
+    if ((*f)->_operMode==RooAbsArg::AClean) {
+      (*f)->setOperMode(RooAbsArg::Auto) ;
+      (*f)->setValueDirty() ;
+    }
+  }
+  _frozen.clear() ;
+}
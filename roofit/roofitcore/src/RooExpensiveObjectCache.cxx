@@ -23,7 +23,9 @@ RooExpensiveObjectCache is a singleton class that serves as repository
 for objects that are expensive to calculate. Owners of such objects
 can registers these here with associated parameter values for which
 the object is valid, so that other instances can, at a later moment
-retrieve these precalculated objects
+retrieve these precalculated objects. Access to the repository is serialized,
+so that objects can be registered and retrieved from concurrently evaluated
+functions.
 **/
 
 
@@ -34,6 +36,7 @@ retrieve these precalculated objects
 #include "RooAbsCategory.h"
 #include "RooArgSet.h"
 #include "RooMsgService.h"
+#include "TVirtualMutex.h"
 #include <iostream>
 #include <math.h>
 using namespace std ;
@@ -45,6 +48,7 @@ ClassImp(RooExpensiveObjectCache::ExpensiveObject)
   ;
 
 RooExpensiveObjectCache* RooExpensiveObjectCache::_instance = 0 ;
+static TVirtualMutex* gRooExpensiveObjectCacheMutex = 0 ;
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -134,6 +138,8 @@ Bool_t RooExpensiveObjectCache::registerObject(const char* ownerName, const char
 
 Bool_t RooExpensiveObjectCache::registerObject(const char* ownerName, const char* objectName, TObject& cacheObject, TIterator* parIter) 
 {
+  R__LOCKGUARD_IMT2(gRooExpensiveObjectCacheMutex) ;
+
   // Delete any previous object
   ExpensiveObject* eo = _map[objectName] ;
   Int_t olduid(-1) ;
@@ -156,6 +162,7 @@ Bool_t RooExpensiveObjectCache::registerObject(const char* ownerName, const char
 
 const TObject* RooExpensiveObjectCache::retrieveObject(const char* name, TClass* tc, const RooArgSet& params) 
 {
+  R__LOCKGUARD_IMT2(gRooExpensiveObjectCacheMutex) ;
   ExpensiveObject* eo = _map[name] ;
 
   // If no cache element found, return 0 ;
@@ -178,6 +185,7 @@ const TObject* RooExpensiveObjectCache::retrieveObject(const char* name, TClass*
 
 const TObject* RooExpensiveObjectCache::getObj(Int_t uid) 
 {
+  R__LOCKGUARD_IMT2(gRooExpensiveObjectCacheMutex) ;
   for (std::map<TString,ExpensiveObject*>::iterator iter = _map.begin() ; iter !=_map.end() ; iter++) {
     if (iter->second->uid() == uid) {
       return iter->second->payload() ;
@@ -194,6 +202,7 @@ const TObject* RooExpensiveObjectCache::getObj(Int_t uid)
 
 Bool_t RooExpensiveObjectCache::clearObj(Int_t uid) 
 {
+  R__LOCKGUARD_IMT2(gRooExpensiveObjectCacheMutex) ;
   for (std::map<TString,ExpensiveObject*>::iterator iter = _map.begin() ; iter !=_map.end() ; iter++) {
     if (iter->second->uid() == uid) {
       _map.erase(iter->first) ;
@@ -211,6 +220,7 @@ Bool_t RooExpensiveObjectCache::clearObj(Int_t uid)
 
 Bool_t RooExpensiveObjectCache::setObj(Int_t uid, TObject* obj) 
 {
+  R__LOCKGUARD_IMT2(gRooExpensiveObjectCacheMutex) ;
   for (std::map<TString,ExpensiveObject*>::iterator iter = _map.begin() ; iter !=_map.end() ; iter++) {
     if (iter->second->uid() == uid) {
       iter->second->setPayload(obj) ;
@@ -227,6 +237,7 @@ Bool_t RooExpensiveObjectCache::setObj(Int_t uid, TObject* obj)
 
 void RooExpensiveObjectCache::clearAll() 
 {
+  R__LOCKGUARD_IMT2(gRooExpensiveObjectCacheMutex) ;
   _map.clear() ;
 }
 
@@ -61,6 +61,12 @@
  // Multi-dimensional convolutions are not supported yet, but will be in the future
  // as FFTW can calculate them
  //
+ // The FFTW plans of the transforms are kept in a pool keyed by the size of the
+ // sampling array when a cache element is deleted, and are reused by the next cache
+ // element of the same size. As plans are reused, a more thorough planning than the
+ // default estimate can be selected with setPlanningFlag(). If implicit multi-threading
+ // is enabled, the two input p.d.f.s are sampled and transformed concurrently.
+ //
  // ---
  // 
  // Installing a copy of FFTW on Linux and compiling ROOT to use it
@@ -121,9 +127,61 @@
 #include "RooConstVar.h"
 #include "TClass.h"
 #include "TSystem.h"
+#include "TROOT.h"
+#include "RooHistPdf.h"
+#include "RooHistFunc.h"
+
+#include <map>
+#include <mutex>
+
+#ifdef R__USE_IMT
+#include "tbb/parallel_invoke.h"
+#endif
 
 using namespace std ;
 
+namespace {
+
+  // Pool of FFT plans of cache elements that no longer exist, keyed by array size
+  struct FFTPlanSet {
+    TVirtualFFT* r2c1 ;
+    TVirtualFFT* r2c2 ;
+    TVirtualFFT* c2r ;
+    TString flag ;
+  } ;
+
+  const UInt_t maxPooledPlans = 16 ;
+
+  std::mutex& planMutex() {
+    static std::mutex m ;
+    return m ;
+  }
+
+  // Never deleted: the plans may not be destructed after the FFTW library is unloaded
+  std::multimap<Int_t,FFTPlanSet>& planPool() {
+    static std::multimap<Int_t,FFTPlanSet>* pool = new std::multimap<Int_t,FFTPlanSet> ;
+    return *pool ;
+  }
+
+  TString& planFlag() {
+    static TString flag("ES") ;
+    return flag ;
+  }
+
+  // Return true if any component shares a histogram with its copies, which
+  // excludes the evaluation of copies in different threads
+  Bool_t sharesHistogram(const RooAbsArg& arg) {
+    RooArgSet comps ;
+    arg.treeNodeServerList(&comps) ;
+    RooFIter iter = comps.fwdIterator() ;
+    RooAbsArg* comp ;
+    while((comp=iter.next())) {
+      if (dynamic_cast<RooHistPdf*>(comp) || dynamic_cast<RooHistFunc*>(comp)) return kTRUE ;
+    }
+    return kFALSE ;
+  }
+}
+
 ClassImp(RooFFTConvPdf) 
 
 
@@ -247,7 +305,7 @@ RooFFTConvPdf::PdfCacheElem* RooFFTConvPdf::createCache(const RooArgSet* nset) c
 
 RooFFTConvPdf::FFTCacheElem::FFTCacheElem(const RooFFTConvPdf& self, const RooArgSet* nsetIn) : 
   PdfCacheElem(self,nsetIn),
-  fftr2c1(0),fftr2c2(0),fftc2r(0) 
+  fftr2c1(0),fftr2c2(0),fftc2r(0),pdf2Obs(0),sampledOnce(kFALSE)
 {
   RooAbsPdf* clonePdf1 = (RooAbsPdf*) self._pdf1.arg().cloneTree() ;
   RooAbsPdf* clonePdf2 = (RooAbsPdf*) self._pdf2.arg().cloneTree() ;
@@ -310,6 +368,14 @@ RooFFTConvPdf::FFTCacheElem::FFTCacheElem(const RooFFTConvPdf& self, const RooAr
 
   delete fftParams ;
 
+  // Give pdf2Clone its own copy of the cache observables, so that both
+  // inputs can be sampled in parallel
+  if (!sharesHistogram(*pdf1Clone) && !sharesHistogram(*pdf2Clone)) {
+    pdf2Obs = (RooArgSet*) RooArgSet(*hist()->get()).snapshot(kFALSE) ;
+    pdf2Clone->recursiveRedirectServers(*pdf2Obs) ;
+    ((RooAbsArg*)pdf2Obs->find(convObs->GetName()))->setOperMode(ADirty,kTRUE) ;
+  }
+
   // Save copy of original histX binning and make alternate binning
   // for extended range scanning
 
@@ -362,12 +428,11 @@ RooArgList RooFFTConvPdf::FFTCacheElem::containedArgs(Action a)
 
 RooFFTConvPdf::FFTCacheElem::~FFTCacheElem() 
 { 
-  delete fftr2c1 ; 
-  delete fftr2c2 ; 
-  delete fftc2r ; 
+  releasePlans() ;
 
   delete pdf1Clone ;
   delete pdf2Clone ;
+  delete pdf2Obs ;
 
   delete histBinning ;
   delete scanBinning ;
@@ -377,6 +442,116 @@ RooFFTConvPdf::FFTCacheElem::~FFTCacheElem()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Take FFT plans for sampling arrays of size N2 from the pool of plans
+/// of deleted cache elements, or create them if none is available
+
+void RooFFTConvPdf::FFTCacheElem::acquirePlans(Int_t N2) 
+{
+  releasePlans() ;
+
+  std::lock_guard<std::mutex> lock(planMutex()) ;
+
+  std::multimap<Int_t,FFTPlanSet>& pool = planPool() ;
+  std::pair<std::multimap<Int_t,FFTPlanSet>::iterator,std::multimap<Int_t,FFTPlanSet>::iterator> range = pool.equal_range(N2) ;
+  for (std::multimap<Int_t,FFTPlanSet>::iterator iter=range.first ; iter!=range.second ; ++iter) {
+    if (iter->second.flag==planFlag()) {
+      fftr2c1 = iter->second.r2c1 ;
+      fftr2c2 = iter->second.r2c2 ;
+      fftc2r = iter->second.c2r ;
+      pool.erase(iter) ;
+      return ;
+    }
+  }
+
+  fftr2c1 = TVirtualFFT::FFT(1, &N2, Form("R2CK %s",planFlag().Data()));
+  fftr2c2 = TVirtualFFT::FFT(1, &N2, Form("R2CK %s",planFlag().Data()));
+  fftc2r  = TVirtualFFT::FFT(1, &N2, Form("C2RK %s",planFlag().Data()));
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the FFT plans of this cache element to the pool of plans
+
+void RooFFTConvPdf::FFTCacheElem::releasePlans() 
+{
+  if (!fftr2c1 || !fftr2c2 || !fftc2r) {
+    delete fftr2c1 ;
+    delete fftr2c2 ;
+    delete fftc2r ;
+  } else {
+    std::lock_guard<std::mutex> lock(planMutex()) ;
+    std::multimap<Int_t,FFTPlanSet>& pool = planPool() ;
+    if (pool.size()<maxPooledPlans) {
+      FFTPlanSet plans ;
+      plans.r2c1 = fftr2c1 ;
+      plans.r2c2 = fftr2c2 ;
+      plans.c2r = fftc2r ;
+      plans.flag = fftr2c1->GetTransformFlag() ;
+      pool.insert(make_pair(fftr2c1->GetN()[0],plans)) ;
+    } else {
+      delete fftr2c1 ;
+      delete fftr2c2 ;
+      delete fftc2r ;
+    }
+  }
+  fftr2c1 = 0 ;
+  fftr2c2 = 0 ;
+  fftc2r = 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the FFTW planning flag of the transforms: "ES" (estimate, default),
+/// "M" (measure), "P" (patient) or "EX" (exhaustive). More thorough planning
+/// takes longer but can yield faster transforms, which pays off as plans
+/// are reused for all cache elements with sampling arrays of the same size.
+/// The flag applies to plans created afterwards.
+
+void RooFFTConvPdf::setPlanningFlag(const char* flag) 
+{
+  TString opt(flag) ;
+  opt.ToUpper() ;
+  if (opt!="ES" && opt!="M" && opt!="P" && opt!="EX") {
+    oocoutE((TObject*)0,InputArguments) << "RooFFTConvPdf::setPlanningFlag: unknown flag " << flag 
+					<< ", allowed values are ES, M, P and EX" << endl ;
+    return ;
+  }
+  std::lock_guard<std::mutex> lock(planMutex()) ;
+  planFlag() = opt ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the FFTW planning flag of the transforms
+
+const char* RooFFTConvPdf::getPlanningFlag() 
+{
+  return planFlag().Data() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the FFT plans kept for reuse by future cache elements
+
+void RooFFTConvPdf::clearPlanCache() 
+{
+  std::lock_guard<std::mutex> lock(planMutex()) ;
+  std::multimap<Int_t,FFTPlanSet>& pool = planPool() ;
+  for (std::multimap<Int_t,FFTPlanSet>::iterator iter=pool.begin() ; iter!=pool.end() ; ++iter) {
+    delete iter->second.r2c1 ;
+    delete iter->second.r2c2 ;
+    delete iter->second.c2r ;
+  }
+  pool.clear() ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill the contents of the cache the FFT convolution output
 
@@ -484,46 +659,85 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
   //
   // 
 
-  Int_t N,N2,binShift1,binShift2 ;
-  
   RooRealVar* histX = (RooRealVar*) cacheHist.get()->find(_x.arg().GetName()) ;
-  if (_bufStrat==Extend) histX->setBinning(*aux.scanBinning) ;
-  Double_t* input1 = scanPdf((RooRealVar&)_x.arg(),*aux.pdf1Clone,cacheHist,slicePos,N,N2,binShift1,_shift1) ;
-  Double_t* input2 = scanPdf((RooRealVar&)_x.arg(),*aux.pdf2Clone,cacheHist,slicePos,N,N2,binShift2,_shift2) ;
-  if (_bufStrat==Extend) histX->setBinning(*aux.histBinning) ;
+  const Int_t N = histX->numBins(binningName()) ;
+  const Int_t N2 = N+2*static_cast<Int_t>((N*bufferFraction())/2 + 0.5) ;
 
+  // Retrieve previously defined FFT transformation plans
+  if (!aux.fftr2c1 || aux.fftr2c1->GetN()[0]!=N2) {
+    aux.acquirePlans(N2) ;
+  }
 
+  // Set position of non-convolution observables to that of the cache slice
+  cacheHist.get(slicePos) ;
 
+  // Observables of p.d.f 2, which are a private copy if it can be sampled in parallel with p.d.f 1
+  RooArgSet* obs2 = aux.pdf2Obs ? aux.pdf2Obs : (RooArgSet*) cacheHist.get() ;
+  RooRealVar* x2 = (RooRealVar*) obs2->find(_x.arg().GetName()) ;
+  if (aux.pdf2Obs) {
+    aux.pdf2Obs->assignValueOnly(*cacheHist.get()) ;
+  }
 
-  // Retrieve previously defined FFT transformation plans
-  if (!aux.fftr2c1) {
-    aux.fftr2c1 = TVirtualFFT::FFT(1, &N2, "R2CK");
-    aux.fftr2c2 = TVirtualFFT::FFT(1, &N2, "R2CK");
-    aux.fftc2r  = TVirtualFFT::FFT(1, &N2, "C2RK");
+  if (_bufStrat==Extend) {
+    histX->setBinning(*aux.scanBinning) ;
+    x2->setBinning(*aux.scanBinning) ;
   }
-  
-  // Real->Complex FFT Transform on p.d.f. 1 sampling
-  aux.fftr2c1->SetPoints(input1);
-  aux.fftr2c1->Transform();
 
-  // Real->Complex FFT Transform on p.d.f 2 sampling
-  aux.fftr2c2->SetPoints(input2);
-  aux.fftr2c2->Transform();
+  // Sample both p.d.f.s and perform the Real->Complex FFT transform of the samplings
+  Int_t n1,n2,n21,n22,binShift1,binShift2 ;
+  Double_t* input1(0) ;
+  Double_t* input2(0) ;
+  auto transform1 = [&]() {
+    input1 = scanPdf(*histX,*cacheHist.get(),*aux.pdf1Clone,n1,n21,binShift1,_shift1) ;
+    aux.fftr2c1->SetPoints(input1);
+    aux.fftr2c1->Transform();
+  } ;
+  auto transform2 = [&]() {
+    input2 = scanPdf(*x2,*obs2,*aux.pdf2Clone,n2,n22,binShift2,_shift2) ;
+    aux.fftr2c2->SetPoints(input2);
+    aux.fftr2c2->Transform();
+  } ;
+
+  // The inputs are only sampled concurrently once both have been sampled
+  // sequentially, so that their normalization integrals and caches exist.
+  // Each input then only changes its own observables; the parameter leaves
+  // shared by the two clones are only read. The global state that can be
+  // reached during the evaluation is guarded: the RooArgSet memory pool, the
+  // logging of evaluation errors, the message service and the expensive
+  // object cache.
+#ifdef R__USE_IMT
+  if (aux.pdf2Obs && aux.sampledOnce && ROOT::IsImplicitMTEnabled()) {
+    tbb::parallel_invoke(transform1,transform2) ;
+  } else
+#endif
+  {
+    transform1() ;
+    transform2() ;
+    aux.sampledOnce = kTRUE ;
+  }
 
-  // Loop over first half +1 of complex output results, multiply 
+  if (_bufStrat==Extend) {
+    histX->setBinning(*aux.histBinning) ;
+    x2->setBinning(*aux.histBinning) ;
+  }
+
+  // Multiply the first half +1 of complex output results 
   // and set as input of reverse transform
-  for (Int_t i=0 ; i<N2/2+1 ; i++) {
-    Double_t re1,re2,im1,im2 ;
-    aux.fftr2c1->GetPointComplex(i,re1,im1) ;
-    aux.fftr2c2->GetPointComplex(i,re2,im2) ;
-    Double_t re = re1*re2 - im1*im2 ;
-    Double_t im = re1*im2 + re2*im1 ;
-    TComplex t(re,im) ;
-    aux.fftc2r->SetPointComplex(i,t) ;
+  const Int_t nc = N2/2+1 ;
+  vector<Double_t> re1(nc), im1(nc), re2(nc), im2(nc) ;
+  aux.fftr2c1->GetPointsComplex(&re1[0],&im1[0]) ;
+  aux.fftr2c2->GetPointsComplex(&re2[0],&im2[0]) ;
+  for (Int_t i=0 ; i<nc ; i++) {
+    Double_t re = re1[i]*re2[i] - im1[i]*im2[i] ;
+    Double_t im = re1[i]*im2[i] + re2[i]*im1[i] ;
+    re1[i] = re ;
+    im1[i] = im ;
   }
+  aux.fftc2r->SetPointsComplex(&re1[0],&im1[0]) ;
 
   // Reverse Complex->Real FFT transform product
   aux.fftc2r->Transform() ;
+  const Double_t* output = aux.fftc2r->GetPointsReal() ;
 
   Int_t totalShift = binShift1 + (N2-N)/2 ;
 
@@ -538,7 +752,7 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
     while (j>=N2) j-= N2 ;
 
     iter->Next() ;
-    cacheHist.set(aux.fftc2r->GetPointReal(j)) ;    
+    cacheHist.set(output[j]) ;    
   }
   delete iter ;
 
@@ -560,8 +774,25 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
 Double_t*  RooFFTConvPdf::scanPdf(RooRealVar& obs, RooAbsPdf& pdf, const RooDataHist& hist, const RooArgSet& slicePos, 
 				  Int_t& N, Int_t& N2, Int_t& zeroBin, Double_t shift) const
 {
+  // Set position of non-convolution observable to that of the cache slice that were are processing now
+  hist.get(slicePos) ;
 
   RooRealVar* histX = (RooRealVar*) hist.get()->find(obs.GetName()) ;
+  return scanPdf(*histX,*hist.get(),pdf,N,N2,zeroBin,shift) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Scan the values of 'pdf' in the bins of its observable 'scanX', which is a member of its
+/// observables 'scanObs', at the current values of the other observables. See above for the
+/// meaning of the other arguments. Both p.d.f.s are sampled with this method in fillCacheSlice(),
+/// if possible in parallel: it only changes the values of scanX.
+
+Double_t*  RooFFTConvPdf::scanPdf(RooRealVar& scanX, const RooArgSet& scanObs, RooAbsPdf& pdf, 
+				  Int_t& N, Int_t& N2, Int_t& zeroBin, Double_t shift) const
+{
+  RooRealVar* histX = &scanX ;
 
   // Calculate number of buffer bins on each size to avoid cyclical flow
   N = histX->numBins(binningName()) ;
@@ -571,9 +802,6 @@ Double_t*  RooFFTConvPdf::scanPdf(RooRealVar& obs, RooAbsPdf& pdf, const RooData
   
   // Allocate array of sampling size plus optional buffer zones
   Double_t* array = new Double_t[N2] ;
-  
-  // Set position of non-convolution observable to that of the cache slice that were are processing now
-  hist.get(slicePos) ;
 
   // Find bin ID that contains zero value
   zeroBin = 0 ;
@@ -602,7 +830,7 @@ Double_t*  RooFFTConvPdf::scanPdf(RooRealVar& obs, RooAbsPdf& pdf, const RooData
     // Sample entire extended range (N2 samples)
     for (k=0 ; k<N2 ; k++) {
       histX->setBin(k) ;
-      tmp[k] = pdf.getVal(hist.get()) ;    
+      tmp[k] = pdf.getVal(&scanObs) ;    
     }  
     break ;
 
@@ -611,16 +839,16 @@ Double_t*  RooFFTConvPdf::scanPdf(RooRealVar& obs, RooAbsPdf& pdf, const RooData
     // bins with p.d.f. value at respective boundary
     {
       histX->setBin(0) ;
-      Double_t val = pdf.getVal(hist.get()) ;  
+      Double_t val = pdf.getVal(&scanObs) ;  
       for (k=0 ; k<Nbuf ; k++) {
 	tmp[k] = val ;
       }
       for (k=0 ; k<N ; k++) {
 	histX->setBin(k) ;
-	tmp[k+Nbuf] = pdf.getVal(hist.get()) ;    
+	tmp[k+Nbuf] = pdf.getVal(&scanObs) ;    
       }  
       histX->setBin(N-1) ;
-      val = pdf.getVal(hist.get()) ;  
+      val = pdf.getVal(&scanObs) ;  
       for (k=0 ; k<Nbuf ; k++) {
 	tmp[N+Nbuf+k] = val ;
       }  
@@ -632,13 +860,13 @@ Double_t*  RooFFTConvPdf::scanPdf(RooRealVar& obs, RooAbsPdf& pdf, const RooData
     // bins with mirror image of sampled range
     for (k=0 ; k<N ; k++) {
       histX->setBin(k) ;
-      tmp[k+Nbuf] = pdf.getVal(hist.get()) ;    
+      tmp[k+Nbuf] = pdf.getVal(&scanObs) ;    
     }  
     for (k=1 ; k<=Nbuf ; k++) {
       histX->setBin(k) ;
-      tmp[Nbuf-k] = pdf.getVal(hist.get()) ;    
+      tmp[Nbuf-k] = pdf.getVal(&scanObs) ;    
       histX->setBin(N-k) ;
-      tmp[Nbuf+N+k-1] = pdf.getVal(hist.get()) ;    
+      tmp[Nbuf+N+k-1] = pdf.getVal(&scanObs) ;    
     }  
     break ;
   }
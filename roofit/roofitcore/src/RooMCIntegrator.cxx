@@ -23,6 +23,13 @@ RooMCIntegrator implements an adaptive multi-dimensional Monte Carlo
 numerical integration, following the VEGAS algorithm originally described
 in G. P. Lepage, J. Comp. Phys. 27, 192(1978). This implementation is
 based on a C version from the 0.9 beta release of the GNU scientific library.
+
+If the number of threads (configuration option nThreads, or setNumThreads())
+is larger than one and ROOT implicit multi-threading is enabled, the
+integrand is evaluated in parallel on copies of the integrated function, see
+RooAbsFunc::cloneForThread(). The sampling points are generated as in the
+sequential case and the results are accumulated in the same order, so the
+result does not depend on the number of threads.
 **/
 
 #include "RooFit.h"
@@ -38,10 +45,15 @@ based on a C version from the 0.9 beta release of the GNU scientific library.
 #include "RooRealVar.h"
 #include "RooCategory.h"
 #include "RooMsgService.h"
+#include "TROOT.h"
 
 #include <math.h>
 #include <assert.h>
 
+#ifdef R__USE_IMT
+#include "tbb/parallel_for.h"
+#endif
+
 
 
 using namespace std;
@@ -78,12 +90,15 @@ void RooMCIntegrator::registerIntegrator(RooNumIntFactory& fact)
   RooRealVar nRefineIter("nRefineIter","Number of refining iterations",5) ;
   RooRealVar nRefinePerDim("nRefinePerDim","Number of refining samples (per dimension)",1000) ;
   RooRealVar nIntPerDim("nIntPerDim","Number of integration samples (per dimension)",5000) ;
+  RooRealVar nThreads("nThreads","Number of threads evaluating the integrand",1) ;
   
   // Create prototype integrator
   RooMCIntegrator* proto = new RooMCIntegrator() ;
 
   // Register prototype and default config with factory
-  fact.storeProtoIntegrator(proto,RooArgSet(samplingMode,genType,verbose,alpha,nRefineIter,nRefinePerDim,nIntPerDim)) ;
+  RooArgSet config(samplingMode,genType,verbose,alpha,nRefineIter,nRefinePerDim,nIntPerDim) ;
+  config.add(nThreads) ;
+  fact.storeProtoIntegrator(proto,config) ;
 
   // Make this method the default for all N>2-dim integrals
   RooNumIntConfig::defaultConfig().methodND().setLabel(proto->IsA()->GetName()) ;
@@ -96,7 +111,8 @@ void RooMCIntegrator::registerIntegrator(RooNumIntFactory& fact)
 /// 
 /// coverity[UNINIT_CTOR] 
 
- RooMCIntegrator::RooMCIntegrator()
+ RooMCIntegrator::RooMCIntegrator() :
+  _nThreads(1), _funcClonesFailed(kFALSE)
 {
 }
 
@@ -113,7 +129,7 @@ RooMCIntegrator::RooMCIntegrator(const RooAbsFunc& function, SamplingMode mode,
 				 GeneratorType genType, Bool_t verbose) :
   RooAbsIntegrator(function), _grid(function), _verbose(verbose),
   _alpha(1.5),  _mode(mode), _genType(genType),
-  _nRefineIter(5),_nRefinePerDim(1000),_nIntegratePerDim(5000)
+  _nRefineIter(5),_nRefinePerDim(1000),_nIntegratePerDim(5000),_nThreads(1),_funcClonesFailed(kFALSE)
 {
   // coverity[UNINIT_CTOR]
   if(!(_valid= _grid.isValid())) return;
@@ -127,7 +143,7 @@ RooMCIntegrator::RooMCIntegrator(const RooAbsFunc& function, SamplingMode mode,
 /// are taken from 'config'
 
 RooMCIntegrator::RooMCIntegrator(const RooAbsFunc& function, const RooNumIntConfig& config) :
-  RooAbsIntegrator(function), _grid(function)
+  RooAbsIntegrator(function), _grid(function), _funcClonesFailed(kFALSE)
 { 
   const RooArgSet& configSet = config.getConfigSection(IsA()->GetName()) ;
   _verbose = (Bool_t) configSet.getCatIndex("verbose",0) ;
@@ -137,6 +153,7 @@ RooMCIntegrator::RooMCIntegrator(const RooAbsFunc& function, const RooNumIntConf
   _nRefineIter = (Int_t) configSet.getRealValue("nRefineIter",5) ;
   _nRefinePerDim = (Int_t) configSet.getRealValue("nRefinePerDim",1000) ;
   _nIntegratePerDim = (Int_t) configSet.getRealValue("nIntPerDim",5000) ;
+  _nThreads = (Int_t) configSet.getRealValue("nThreads",1) ;
 
   // check that our grid initialized without errors
   if(!(_valid= _grid.isValid())) return;
@@ -161,6 +178,78 @@ RooAbsIntegrator* RooMCIntegrator::clone(const RooAbsFunc& function, const RooNu
 
 RooMCIntegrator::~RooMCIntegrator() 
 {
+  deleteFunctionClones() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the copies of the integrand used for parallel evaluation
+
+void RooMCIntegrator::deleteFunctionClones()
+{
+  for (vector<RooAbsFunc*>::iterator iter=_funcClones.begin() ; iter!=_funcClones.end() ; ++iter) {
+    delete *iter ;
+  }
+  _funcClones.clear() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the integrand at the npoints points stored consecutively in x.
+/// With more than one thread, the points are split in one contiguous block
+/// per copy of the integrand and the blocks are evaluated in parallel.
+
+void RooMCIntegrator::evaluatePoints(UInt_t npoints, const Double_t* x, Double_t* fval)
+{
+  const UInt_t dim = _grid.getDimension() ;
+
+#ifdef R__USE_IMT
+  if (_nThreads>1 && !_funcClonesFailed && ROOT::IsImplicitMTEnabled() && npoints>=UInt_t(2*_nThreads)) {
+
+    // Make the copies of the integrand on first use
+    if (_funcClones.empty()) {
+      for (Int_t i=0 ; i<_nThreads ; i++) {
+	RooAbsFunc* clone = integrand()->cloneForThread() ;
+	if (!clone || !clone->isValid()) {
+	  delete clone ;
+	  deleteFunctionClones() ;
+	  _funcClonesFailed = kTRUE ;
+	  oocoutI((TObject*)0,Integration) << "RooMCIntegrator: integrand " << integrand()->getName()
+					   << " can not be copied, evaluating it in a single thread" << endl ;
+	  break ;
+	}
+	_funcClones.push_back(clone) ;
+      }
+    }
+
+    if (!_funcClones.empty()) {
+      // Update the parameters of the copies and evaluate each of them once
+      // sequentially, so that their internal caches are set up before the
+      // parallel evaluation
+      for (vector<RooAbsFunc*>::iterator iter=_funcClones.begin() ; iter!=_funcClones.end() ; ++iter) {
+	(*iter)->syncThreadClone() ;
+	(**iter)(x) ;
+      }
+
+      const Int_t nblock = _funcClones.size() ;
+      tbb::parallel_for(0, nblock, [&](Int_t iblock) {
+	  const UInt_t first = UInt_t((ULong64_t(npoints)*iblock)/nblock) ;
+	  const UInt_t last = UInt_t((ULong64_t(npoints)*(iblock+1))/nblock) ;
+	  const RooAbsFunc& func = *_funcClones[iblock] ;
+	  for (UInt_t i=first ; i<last ; i++) {
+	    fval[i] = func(x+i*dim) ;
+	  }
+	}) ;
+      return ;
+    }
+  }
+#endif
+
+  for (UInt_t i=0 ; i<npoints ; i++) {
+    fval[i] = integrand(x+i*dim) ;
+  }
 }
 
 
@@ -263,9 +352,10 @@ Double_t RooMCIntegrator::vegas(Stage stage, UInt_t calls, UInt_t iterations, Do
   }
 
   // allocate memory for some book-keeping arrays
+  UInt_t dim(_grid.getDimension());
   UInt_t *box= _grid.createIndexVector();
-  UInt_t *bin= _grid.createIndexVector();
-  Double_t *x= _grid.createPoint();
+  vector<Double_t> xbuf, volbuf, fbuf ;
+  vector<UInt_t> binbuf ;
 
   // loop over iterations for this step
   Double_t cum_int(0),cum_sig(0);
@@ -279,17 +369,35 @@ Double_t RooMCIntegrator::vegas(Stage stage, UInt_t calls, UInt_t iterations, Do
     // reset the values associated with each grid cell
     _grid.resetValues();
 
+    // generate the random points of all grid boxes
+    UInt_t npoints(0) ;
+    _grid.firstBox(box);
+    do {
+      for(UInt_t k = 0; k < _calls_per_box; k++) {
+	if (xbuf.size() < (npoints+1)*dim) {
+	  xbuf.resize((npoints+1)*dim) ;
+	  binbuf.resize((npoints+1)*dim) ;
+	  volbuf.resize(npoints+1) ;
+	}
+	_grid.generatePoint(box, &xbuf[npoints*dim], &binbuf[npoints*dim], volbuf[npoints], _genType == QuasiRandom ? kTRUE : kFALSE);
+	npoints++ ;
+      }
+    } while(_grid.nextBox(box));
+
+    // evaluate the integrand at the generated points
+    if (fbuf.size() < npoints) fbuf.resize(npoints) ;
+    evaluatePoints(npoints, &xbuf[0], &fbuf[0]) ;
+
     // loop over grid boxes
+    UInt_t ipoint(0) ;
     _grid.firstBox(box);
     do {
       Double_t m(0),q(0);
+      const UInt_t *bin(0) ;
       // loop over integrand evaluations within this grid box
-      for(UInt_t k = 0; k < _calls_per_box; k++) {
-	// generate a random point in this box
-	Double_t bin_vol(0);
-	_grid.generatePoint(box, x, bin, bin_vol, _genType == QuasiRandom ? kTRUE : kFALSE);
-	// evaluate the integrand at the generated point
-	Double_t fval= jacbin*bin_vol*integrand(x);	
+      for(UInt_t k = 0; k < _calls_per_box; k++, ipoint++) {
+	bin = &binbuf[ipoint*dim] ;
+	Double_t fval= jacbin*volbuf[ipoint]*fbuf[ipoint];
 	// update mean and variance calculations
 	Double_t d = fval - m;
 	m+= d / (k + 1.0);
@@ -359,9 +467,7 @@ Double_t RooMCIntegrator::vegas(Stage stage, UInt_t calls, UInt_t iterations, Do
   }
 
   // cleanup
-  delete[] bin;
   delete[] box;
-  delete[] x;
 
   if(absError) *absError = cum_sig;
   return cum_int;
@@ -242,6 +242,33 @@ void RooMinimizer::setOffsetting(Bool_t flag)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// If flag is true (default), the parameter changes of each function call
+/// are propagated in one pass through a precomputed index of the nodes
+/// that depend on each parameter, see RooDependencyIndex
+
+void RooMinimizer::setDependencyIndex(Bool_t flag)
+{
+  _fcn->SetUseDependencyIndex(flag) ;
+  if (fitterFcn()!=_fcn) fitterFcn()->SetUseDependencyIndex(flag) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// If flag is true, the nodes of the function that depend on constant
+/// parameters only are switched to AClean mode for the duration of each
+/// minimization command, so that their cached values are used without any
+/// dirty state check. Default is false.
+
+void RooMinimizer::setFreezeConstantNodes(Bool_t flag)
+{
+  _fcn->SetFreezeConstantNodes(flag) ;
+  if (fitterFcn()!=_fcn) fitterFcn()->SetFreezeConstantNodes(flag) ;
+}
+
+
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Choose the minimzer algorithm.
@@ -35,6 +35,7 @@
 #include "RooRealVar.h"
 #include "RooAbsRealLValue.h"
 #include "RooMsgService.h"
+#include "RooDependencyIndex.h"
 
 #include "RooMinimizer.h"
 
@@ -47,7 +48,8 @@ RooMinimizerFcn::RooMinimizerFcn(RooAbsReal *funct, RooMinimizer* context,
   _maxFCN(-1e30), _numBadNLL(0),  
   _printEvalErrors(10), _doEvalErrorWall(kTRUE),
   _nDim(0), _logfile(0),
-  _verbose(verbose)
+  _verbose(verbose),
+  _useDepIndex(kTRUE), _freezeNodes(kFALSE), _depIndex(0)
 { 
 
   _evalCounter = 0 ;
@@ -105,7 +107,10 @@ RooMinimizerFcn::RooMinimizerFcn(const RooMinimizerFcn& other) : ROOT::Math::IBa
   _nDim(other._nDim),
   _logfile(other._logfile),
   _verbose(other._verbose),
-  _floatParamVec(other._floatParamVec)
+  _floatParamVec(other._floatParamVec),
+  _useDepIndex(other._useDepIndex),
+  _freezeNodes(other._freezeNodes),
+  _depIndex(0)
 {  
   _floatParamList = new RooArgList(*other._floatParamList) ;
   _constParamList = new RooArgList(*other._constParamList) ;
@@ -116,6 +121,8 @@ RooMinimizerFcn::RooMinimizerFcn(const RooMinimizerFcn& other) : ROOT::Math::IBa
 
 RooMinimizerFcn::~RooMinimizerFcn()
 {
+  // Deleting the index restores the operation mode of the frozen nodes
+  delete _depIndex;
   delete _floatParamList;
   delete _initFloatParamList;
   delete _constParamList;
@@ -140,6 +147,9 @@ Bool_t RooMinimizerFcn::Synchronize(std::vector<ROOT::Fit::ParameterSettings>& p
   Bool_t constStatChange(kFALSE) ;
   
   Int_t index(0) ;
+
+  // Constant parameters may have been changed since the last minimization
+  if (_depIndex) _depIndex->unfreeze() ;
   
   // Handle eventual migrations from constParamList -> floatParamList
   for(index= 0; index < _constParamList->getSize() ; index++) {
@@ -372,6 +382,23 @@ Bool_t RooMinimizerFcn::Synchronize(std::vector<ROOT::Fit::ParameterSettings>& p
 
   updateFloatVec() ;
 
+  // The dependency index is rebuilt for the new set of floating parameters
+  // at the first evaluation. Constant nodes are frozen only when their
+  // values are up to date.
+  delete _depIndex ;
+  _depIndex = 0 ;
+  if (_freezeNodes) {
+    RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::CollectErrors) ;
+    RooAbsReal::setHideOffset(kFALSE) ;
+    _funct->getVal() ;
+    RooAbsReal::setHideOffset(kTRUE) ;
+    RooAbsReal::clearEvalErrorLog() ;
+    RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
+
+    updateDependencyIndex() ;
+    if (_depIndex) _depIndex->freeze() ;
+  }
+
   return 0 ;  
 
 }
@@ -439,6 +466,7 @@ void RooMinimizerFcn::BackProp(const ROOT::Fit::FitResult &results)
     }
   }
 
+  if (_depIndex) _depIndex->unfreeze() ;
 }
 
 Bool_t RooMinimizerFcn::SetLogFile(const char* inLogfile) 
@@ -516,14 +544,84 @@ void RooMinimizerFcn::updateFloatVec()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the propagation of the parameter changes of each
+/// evaluation through a RooDependencyIndex. With the index, the dirty state
+/// of the nodes depending on the changed parameters is raised in one pass
+/// after all parameters are set, instead of one recursive propagation
+/// through the client graph for each changed parameter.
+
+void RooMinimizerFcn::SetUseDependencyIndex(Bool_t flag)
+{
+  _useDepIndex = flag ;
+  if (!_useDepIndex && !_freezeNodes) {
+    delete _depIndex ;
+    _depIndex = 0 ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// If set, the branch nodes of the function that depend on constant
+/// parameters only are switched to AClean mode at each synchronization
+/// and restored to Auto mode when the results are propagated back.
+
+void RooMinimizerFcn::SetFreezeConstantNodes(Bool_t flag)
+{
+  _freezeNodes = flag ;
+  if (!_freezeNodes && _depIndex) {
+    _depIndex->unfreeze() ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the dependency index of the function on the floating
+/// parameters, or rebuild it if the expression graph has changed
+
+void RooMinimizerFcn::updateDependencyIndex() const
+{
+  if (_depIndex) {
+    if (!_depIndex->isValid()) _depIndex->rebuild() ;
+    return ;
+  }
+
+  // Parameter changes are tracked only for RooRealVars
+  RooArgList params ;
+  for (std::vector<RooAbsArg*>::const_iterator p=_floatParamVec.begin() ; p!=_floatParamVec.end() ; ++p) {
+    if (!dynamic_cast<RooRealVar*>(*p)) {
+      _useDepIndex = kFALSE ;
+      return ;
+    }
+    params.add(**p) ;
+  }
+
+  _depIndex = new RooDependencyIndex(*_funct,params) ;
+}
+
+
+
 double RooMinimizerFcn::DoEval(const double *x) const 
 {
 
-  // Set the parameter values for this iteration
+  // Set the parameter values for this iteration. The dirty state of the
+  // nodes depending on the changed parameters is raised in one pass
+  RooDependencyIndex* depIndex(0) ;
+  if (_useDepIndex) {
+    updateDependencyIndex() ;
+    depIndex = _useDepIndex ? _depIndex : 0 ;
+  }
+
+  if (depIndex) depIndex->beginUpdate() ;
   for (int index = 0; index < _nDim; index++) {
     if (_logfile) (*_logfile) << x[index] << " " ;
-    SetPdfParamVal(index,x[index]);
+    if (SetPdfParamVal(index,x[index]) && depIndex) {
+      depIndex->setValueDirty(index) ;
+    }
   }
+  if (depIndex) depIndex->endUpdate() ;
 
   // Calculate the function for these parameters  
   RooAbsReal::setHideOffset(kFALSE) ;
@@ -54,6 +54,7 @@ The singleton instance is accessible through RooMsgService::instance() ;
 #include "RooWorkspace.h"
 
 #include "TSystem.h"
+#include "TVirtualMutex.h"
 #include "Riostream.h"
 #include <iomanip>
 #include <fstream>
@@ -67,6 +68,10 @@ RooMsgService* gMsgService = 0 ;
 RooMsgService* RooMsgService::_instance = 0 ;
 Int_t RooMsgService::_debugCount = 0 ;
 
+// Protects the message counters and the stream selection when test statistics
+// are calculated in several threads
+static TVirtualMutex* gRooMsgServiceMutex = 0 ;
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Cleanup function called by atexit() handler installed by RooSentinel
@@ -484,6 +489,8 @@ Bool_t RooMsgService::StreamConfig::match(RooFit::MsgLevel level, RooFit::MsgTop
 
 ostream& RooMsgService::log(const RooAbsArg* self, RooFit::MsgLevel level, RooFit::MsgTopic topic, Bool_t skipPrefix) 
 {
+  R__LOCKGUARD_IMT2(gRooMsgServiceMutex) ;
+
   if (level>=ERROR) {
     _errorCount++ ;
   }
@@ -521,6 +528,8 @@ ostream& RooMsgService::log(const RooAbsArg* self, RooFit::MsgLevel level, RooFi
 
 ostream& RooMsgService::log(const TObject* self, RooFit::MsgLevel level, RooFit::MsgTopic topic, Bool_t skipPrefix) 
 {
+  R__LOCKGUARD_IMT2(gRooMsgServiceMutex) ;
+
   if (level>=ERROR) {
     _errorCount++ ;
   }
@@ -43,11 +43,14 @@ In extended mode, a (Nexpect - Nobserved*log(NExpected) term is added
 #include "RooRealSumPdf.h"
 #include "RooRealVar.h"
 #include "RooProdPdf.h"
+#include "RooDataSet.h"
+#include "RooVectorDataStore.h"
 
 ClassImp(RooNLLVar)
 ;
 
 RooArgSet RooNLLVar::_emptySet ;
+Bool_t RooNLLVar::_batchEval = kTRUE ;
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -212,6 +215,28 @@ RooNLLVar::~RooNLLVar()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// If flag is true (the default), the p.d.f. is evaluated on batches of
+/// events with RooAbsReal::getValBatch() when the data is stored in a
+/// RooVectorDataStore. Set it to false to force event by event evaluation
+
+void RooNLLVar::setBatchEvaluation(Bool_t flag)
+{
+  _batchEval = flag ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the batch evaluation is enabled, see setBatchEvaluation()
+
+Bool_t RooNLLVar::batchEvaluation()
+{
+  return _batchEval ;
+}
+
+
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -227,9 +252,10 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
   } else if ( _gofOpMode==MPMaster) {
     for (Int_t i=0 ; i<_nCPU ; i++)
       _mpfeArray[i]->applyNLLWeightSquared(flag);
-  } else if ( _gofOpMode==SimMaster) {
+  } else if ( _gofOpMode==SimMaster || _gofOpMode==MTMaster) {
     for (Int_t i=0 ; i<_nGof ; i++)
       ((RooNLLVar*)_gofArray[i])->applyWeightSquared(flag);
+    _mtReady = kFALSE ;
   }
 }
 
@@ -306,7 +332,52 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 
   } else {
 
-    for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
+    // If the data is stored in vectors, evaluate the p.d.f. on batches of
+    // events (see RooAbsReal::getValBatch()). The events of a batch that
+    // cannot be evaluated this way, and all the following ones, are
+    // processed event by event below
+    i = firstEvent ;
+    const RooVectorDataStore* vstore = dynamic_cast<const RooVectorDataStore*>(_dataClone->store()) ;
+    if (_batchEval && stepSize==1 && vstore && dynamic_cast<RooDataSet*>(_dataClone) &&
+	(vstore->weightColumn() || !vstore->isWeighted())) {
+
+      const Int_t batchSize = 1024 ;
+      const Double_t* wgt = vstore->weightColumn() ;
+      std::vector<Double_t> prob(batchSize) ;
+
+      for ( ; i<lastEvent ; i+=batchSize) {
+	const Int_t end = std::min(i+batchSize,lastEvent) ;
+	if (!pdfClone->getValBatch(&prob[0],i,end,*vstore,_normSet)) break ;
+
+	// Leave the events with values for which getLogVal() reports a problem to the event loop
+	Bool_t ok(kTRUE) ;
+	for (Int_t j=i ; j<end ; j++) {
+	  const Double_t p = prob[j-i] ;
+	  if ((!wgt || wgt[j]!=0.) && !(p>0. && p<=1e6)) ok = kFALSE ;
+	}
+	if (!ok) break ;
+
+	for (Int_t j=i ; j<end ; j++) {
+	  Double_t eventWeight = wgt ? wgt[j] : 1. ;
+	  if (0. == eventWeight * eventWeight) continue ;
+	  if (_weightSq) eventWeight = eventWeight*eventWeight ;
+
+	  Double_t term = -eventWeight * log(prob[j-i]) ;
+
+	  Double_t y = eventWeight - sumWeightCarry;
+	  Double_t t = sumWeight + y;
+	  sumWeightCarry = (t - sumWeight) - y;
+	  sumWeight = t;
+
+	  y = term - carry;
+	  t = result + y;
+	  carry = (t - result) - y;
+	  result = t;
+	}
+      }
+    }
+
+    for ( ; i<lastEvent ; i+=stepSize) {
 
       _dataClone->get(i) ;
 
@@ -473,6 +473,17 @@ Double_t RooProdPdf::getValV(const RooArgSet* set) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Overload getValBatch() to intercept normalization set for use in evaluateBatch()
+
+Bool_t RooProdPdf::getValBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data, const RooArgSet* normSet) const
+{
+  _curNormSet = (RooArgSet*)normSet ;
+  return RooAbsPdf::getValBatch(output,begin,end,data,normSet) ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate current value of object
 
@@ -495,6 +506,63 @@ Double_t RooProdPdf::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): calculate the product of the terms of the
+/// cached factorization for the events [begin,end[ of data
+
+Bool_t RooProdPdf::evaluateBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data) const
+{
+  Int_t code ;
+  CacheElem* cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+
+  // If cache doesn't have our configuration, recalculate here
+  if (!cache) {
+    RooArgList *plist(0) ;
+    RooLinkedList *nlist(0) ;
+    getPartIntList(_curNormSet,0,plist,nlist,code) ;
+    cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+  }
+
+  const Int_t n = end-begin ;
+  std::vector<Double_t> term(n) ;
+
+  if (cache->_isRearranged) {
+    if (!cache->_rearrangedNum->getValBatch(output,begin,end,data) ||
+	!cache->_rearrangedDen->getValBatch(&term[0],begin,end,data)) return kFALSE ;
+    for (Int_t i=0 ; i<n ; i++) {
+      output[i] /= term[i] ;
+    }
+    return kTRUE ;
+  }
+
+  // Running product of the terms. As in calculate(), an event is not
+  // multiplied by further terms once its value is below the cut-off
+  RooAbsReal* partInt;
+  RooArgSet* normSet;
+  RooFIter plIter = cache->_partList.fwdIterator();
+  RooFIter nlIter = cache->_normList.fwdIterator();
+  Bool_t first(kTRUE) ;
+  std::fill(output,output+n,1.0) ;
+  for (partInt = (RooAbsReal*) plIter.next(),
+	 normSet = (RooArgSet*) nlIter.next(); partInt && normSet;
+       partInt = (RooAbsReal*) plIter.next(),
+	 normSet = (RooArgSet*) nlIter.next()) {
+    if (!partInt->getValBatch(&term[0],begin,end,data,normSet->getSize() > 0 ? normSet : 0)) return kFALSE ;
+    if (first) {
+      std::copy(term.begin(),term.end(),output) ;
+      first = kFALSE ;
+    } else {
+      for (Int_t i=0 ; i<n ; i++) {
+	output[i] = output[i] > _cutOff ? output[i]*term[i] : output[i] ;
+      }
+    }
+  }
+
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate running product of pdfs terms, using the supplied
 /// normalization set in 'normSetList' for each component
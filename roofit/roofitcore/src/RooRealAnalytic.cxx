@@ -29,6 +29,7 @@ RooAbsReal object (specified by a code) to a set of dependent variables.
 #include "RooRealAnalytic.h"
 #include "RooRealAnalytic.h"
 #include "RooAbsReal.h"
+#include "RooArgSet.h"
 
 #include <assert.h>
 
@@ -48,3 +49,21 @@ Double_t RooRealAnalytic::operator()(const Double_t xvector[]) const
   _ncall++ ;
   return _code ? _func->analyticalIntegralWN(_code,_nset,_rangeName?_rangeName->GetName():0):_func->getVal(_nset) ;
 }
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a binding to the same analytical integral of a deep copy of the
+/// bound function, see RooRealBinding::cloneForThread()
+
+RooAbsFunc* RooRealAnalytic::cloneForThread() const
+{
+  RooArgSet* ownedSet(0) ;
+  RooArgSet varsClone ;
+  RooAbsReal* funcClone = cloneFunction(ownedSet,varsClone) ;
+  if (!funcClone) return 0 ;
+
+  RooRealAnalytic* clone = new RooRealAnalytic(*funcClone,varsClone,_code,_nset,_rangeName) ;
+  clone->setThreadCloneOf(*this,ownedSet) ;
+  return clone ;
+}
@@ -33,6 +33,8 @@ of its servers and present it as a simple array oriented interface.
 #include "RooAbsRealLValue.h"
 #include "RooNameReg.h"
 #include "RooMsgService.h"
+#include "RooHistPdf.h"
+#include "RooHistFunc.h"
 
 #include <assert.h>
 
@@ -55,7 +57,8 @@ ClassImp(RooRealBinding)
 /// range.
 
 RooRealBinding::RooRealBinding(const RooAbsReal& func, const RooArgSet &vars, const RooArgSet* nset, Bool_t clipInvalid, const TNamed* rangeName) :
-  RooAbsFunc(vars.getSize()), _func(&func), _vars(0), _nset(nset), _clipInvalid(clipInvalid), _xsave(0), _rangeName(rangeName), _funcSave(0)
+  RooAbsFunc(vars.getSize()), _func(&func), _vars(0), _nset(nset), _clipInvalid(clipInvalid), _xsave(0), _rangeName(rangeName), _funcSave(0),
+  _cloneOwned(0), _cloneParams(0), _origParams(0)
 {
   // allocate memory
   _vars= new RooAbsRealLValue*[getDimension()];
@@ -92,7 +95,8 @@ RooRealBinding::RooRealBinding(const RooAbsReal& func, const RooArgSet &vars, co
 
 RooRealBinding::RooRealBinding(const RooRealBinding& other, const RooArgSet* nset) :
   RooAbsFunc(other), _func(other._func), _nset(nset?nset:other._nset), _xvecValid(other._xvecValid),
-  _clipInvalid(other._clipInvalid), _xsave(0), _rangeName(other._rangeName), _funcSave(other._funcSave)
+  _clipInvalid(other._clipInvalid), _xsave(0), _rangeName(other._rangeName), _funcSave(other._funcSave),
+  _cloneOwned(0), _cloneParams(0), _origParams(0)
 {
   // allocate memory
   _vars= new RooAbsRealLValue*[getDimension()];
@@ -110,6 +114,9 @@ RooRealBinding::~RooRealBinding()
 {
   if(0 != _vars) delete[] _vars;
   if (_xsave) delete[] _xsave ;
+  delete _cloneParams ;
+  delete _origParams ;
+  delete _cloneOwned ;
 }
 
 
@@ -249,3 +256,97 @@ std::list<Double_t>* RooRealBinding::binBoundaries(Int_t index) const
 {
   return _func->binBoundaries(*_vars[index],getMinLimit(index),getMaxLimit(index));
 }
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a binding to a deep copy of the bound function, that can be
+/// evaluated in another thread concurrently with this binding. The parameter
+/// values of the copy are updated from the original function by
+/// syncThreadClone(). Returns null if the function can not be copied, or if
+/// it contains components that share mutable state between copies, such as
+/// the RooDataHist of a RooHistPdf or RooHistFunc.
+
+RooAbsFunc* RooRealBinding::cloneForThread() const
+{
+  RooArgSet* ownedSet(0) ;
+  RooArgSet varsClone ;
+  RooAbsReal* funcClone = cloneFunction(ownedSet,varsClone) ;
+  if (!funcClone) return 0 ;
+
+  RooRealBinding* clone = new RooRealBinding(*funcClone,varsClone,_nset,_clipInvalid,_rangeName) ;
+  clone->setThreadCloneOf(*this,ownedSet) ;
+  return clone ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make a deep copy of the bound function for cloneForThread(). The copy is
+/// owned by ownedSet, varsClone is filled with the copies of the bound
+/// variables in the order of this binding.
+
+RooAbsReal* RooRealBinding::cloneFunction(RooArgSet*& ownedSet, RooArgSet& varsClone) const
+{
+  ownedSet = 0 ;
+
+  RooArgSet* comps = _func->getComponents() ;
+  RooFIter citer = comps->fwdIterator() ;
+  RooAbsArg* comp ;
+  while((comp=citer.next())) {
+    if (dynamic_cast<RooHistPdf*>(comp) || dynamic_cast<RooHistFunc*>(comp)) {
+      oocxcoutI((TObject*)0,Integration) << "RooRealBinding::cloneForThread(" << getName() << ") component " << comp->GetName()
+					 << " shares its histogram between copies, function can not be evaluated in multiple threads" << endl ;
+      delete comps ;
+      return 0 ;
+    }
+  }
+  delete comps ;
+
+  ownedSet = (RooArgSet*) RooArgSet(*_func).snapshot(kTRUE) ;
+  if (!ownedSet) return 0 ;
+
+  RooAbsReal* funcClone = (RooAbsReal*) ownedSet->find(_func->GetName()) ;
+  for (UInt_t i=0 ; i<getDimension() ; i++) {
+    RooAbsArg* var = ownedSet->find(_vars[i]->GetName()) ;
+    if (!var) {
+      delete ownedSet ;
+      ownedSet = 0 ;
+      return 0 ;
+    }
+    varsClone.add(*var) ;
+  }
+  return funcClone ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Take ownership of the copy of the function tree ownedSet and record the
+/// parameters that syncThreadClone() copies from the function of orig
+
+void RooRealBinding::setThreadCloneOf(const RooRealBinding& orig, RooArgSet* ownedSet)
+{
+  _cloneOwned = ownedSet ;
+
+  RooArgSet origVars, cloneVars ;
+  for (UInt_t i=0 ; i<getDimension() ; i++) {
+    origVars.add(*orig._vars[i]) ;
+    cloneVars.add(*_vars[i]) ;
+  }
+  _origParams = orig._func->getParameters(origVars) ;
+  _cloneParams = _func->getParameters(cloneVars) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the current parameter values of the original function into the
+/// function of a binding made by cloneForThread()
+
+void RooRealBinding::syncThreadClone() const
+{
+  if (_cloneParams && _origParams) {
+    _cloneParams->assignValueOnly(*_origParams) ;
+  }
+}
@@ -58,6 +58,7 @@ ClassImp(RooRealIntegral)
 
 
 Int_t RooRealIntegral::_cacheAllNDim(2) ;
+Int_t RooRealIntegral::_numMemoSize(0) ;
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -897,9 +898,19 @@ Double_t RooRealIntegral::evaluate() const
 	cacheVal = (RooDouble*) expensiveObjectCache().retrieveObject(GetName(),RooDouble::Class(),parameters())  ;
       }
 
+      // Look up the values memoized for the current parameter values
+      vector<Double_t> memoKey ;
+      Bool_t memoHit(kFALSE) ;
+      if (!cacheVal && _numMemoSize>0 && _intList.getSize()>0) {
+	fillMemoKey(memoKey) ;
+	memoHit = findMemo(memoKey,retVal) ;
+      }
+
       if (cacheVal) {
 	retVal = *cacheVal ;
 	//	cout << "using cached value of integral" << GetName() << endl ;
+      } else if (memoHit) {
+	cxcoutD(Integration) << "RooRealIntegral::evaluate(" << GetName() << ") using memoized value " << retVal << endl ;
       } else {
 
 
@@ -935,6 +946,12 @@ Double_t RooRealIntegral::evaluate() const
 	  expensiveObjectCache().registerObject(_function.arg().GetName(),GetName(),*val,parameters())  ;
 //  	  cout << "### caching value of integral" << GetName() << " in " << &expensiveObjectCache() << endl ;
 	}
+
+	// Memoize the value for the current parameter values
+	if (!memoKey.empty()) {
+	  _memo.push_front(make_pair(memoKey,retVal)) ;
+	  while (Int_t(_memo.size())>_numMemoSize) _memo.pop_back() ;
+	}
 	
       }
       break ;
@@ -996,6 +1013,45 @@ Double_t RooRealIntegral::evaluate() const
 
 
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate() for the events [begin,end[ of data. Only the
+/// pass-through mode, in which no integration is performed, is supported:
+/// this is the case of the accept-reject sampling functions of models
+/// that generate all their observables numerically.
+
+Bool_t RooRealIntegral::evaluateBatch(Double_t* output, Int_t begin, Int_t end, const RooVectorDataStore& data) const 
+{
+  if (_intOperMode!=PassThrough) return kFALSE ;
+
+  if (!((RooAbsReal&)_function.arg()).getValBatch(output,begin,end,data,_funcNormSet)) return kFALSE ;
+
+  // Multiply answer with integration ranges of factorized variables
+  if (_facList.getSize()>0) {
+    const Int_t n = end-begin ;
+    RooFIter iter = _facList.fwdIterator() ;
+    RooAbsArg* arg ;
+    while((arg=iter.next())) {
+      Double_t fac(1) ;
+      if (arg->IsA()->InheritsFrom(RooAbsRealLValue::Class())) {
+	RooAbsRealLValue* argLV = (RooAbsRealLValue*)arg ;
+	fac = argLV->getMax() - argLV->getMin() ;
+      } else if (arg->IsA()->InheritsFrom(RooAbsCategoryLValue::Class())) {
+	fac = ((RooAbsCategoryLValue*)arg)->numTypes() ;
+      } else {
+	continue ;
+      }
+      for (Int_t i=0 ; i<n ; i++) {
+	output[i] *= fac ;
+      }
+    }
+  }
+
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return product of jacobian terms originating from analytical integration
 
@@ -1089,6 +1145,7 @@ Bool_t RooRealIntegral::redirectServersHook(const RooAbsCollection& /*newServerL
     delete _params ;
     _params = 0 ;
   }
+  _memo.clear() ;
 
   return kFALSE ;
 }
@@ -1225,3 +1282,72 @@ Int_t RooRealIntegral::getCacheAllNumeric()
 }
 
 
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Global switch to memoize, in each integral that integrates at least one
+/// dimension numerically, the last size values calculated for different
+/// parameter values. When the parameters return to memoized values, as in
+/// likelihood scans or when the minimizer revisits a point, the value is
+/// returned without integration. Zero (default) disables memoization.
+///
+/// For a smooth approximation of an expensive integral as function of its
+/// parameters, see RooAbsReal::setParameterizeIntegral() instead.
+
+void RooRealIntegral::setNumericMemoSize(Int_t size)
+{
+  _numMemoSize = size>0 ? size : 0 ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of memoized numeric integral values, see setNumericMemoSize()
+
+Int_t RooRealIntegral::getNumericMemoSize()
+{
+  return _numMemoSize ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill key with the values on which the integral depends: the values of
+/// its parameters and the limits of the numerically integrated variables
+
+void RooRealIntegral::fillMemoKey(vector<Double_t>& key) const
+{
+  key.clear() ;
+  RooFIter piter = parameters().fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=piter.next())) {
+    if (dynamic_cast<RooAbsReal*>(arg)) {
+      key.push_back(((RooAbsReal*)arg)->getVal()) ;
+    } else if (dynamic_cast<RooAbsCategory*>(arg)) {
+      key.push_back(((RooAbsCategory*)arg)->getIndex()) ;
+    }
+  }
+
+  RooFIter iiter = _intList.fwdIterator() ;
+  while((arg=iiter.next())) {
+    RooAbsRealLValue* argLV = (RooAbsRealLValue*)arg ;
+    key.push_back(argLV->getMin(RooNameReg::str(_rangeName))) ;
+    key.push_back(argLV->getMax(RooNameReg::str(_rangeName))) ;
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Look up the value memoized for key. On success the entry becomes the
+/// most recently used one.
+
+Bool_t RooRealIntegral::findMemo(const vector<Double_t>& key, Double_t& value) const
+{
+  for (list<pair<vector<Double_t>,Double_t> >::iterator iter=_memo.begin() ; iter!=_memo.end() ; ++iter) {
+    if (iter->first==key) {
+      value = iter->second ;
+      if (iter!=_memo.begin()) _memo.splice(_memo.begin(),_memo,iter) ;
+      return kTRUE ;
+    }
+  }
+  return kFALSE ;
+}
@@ -0,0 +1,907 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * @(#)root/roofitcore:$Id$
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+/**
+\file RooTreeColumnDataStore.cxx
+\class RooTreeColumnDataStore
+\ingroup Roofitcore
+
+RooTreeColumnDataStore is a read-only data store that serves the rows of
+a dataset directly from the branches of a TTree or TChain, without making
+a copy of the tree.
+
+The branches of the observables are read on first access, one pass over
+the entries of the tree, and kept in contiguous arrays of doubles, or of
+floats if floatStorage is requested to halve the memory footprint. Only
+the branches of the observables of the dataset are read. The source tree
+must stay alive until the columns have been loaded, see loadColumns(); the
+store does not access it afterwards.
+
+Stores made by reduce() and by copying share the columns of the original
+store. A reduced store only holds the list of the selected rows of the
+tree, so that cuts and ranges applied to a large dataset do not duplicate
+its contents. The columns are released when the last store that uses them
+is deleted.
+
+Only RooRealVar observables are supported. The store can not be filled:
+to add or modify events, convert the dataset with
+RooAbsData::convertToVectorStore(). Function values are not cached in the
+store by the constant term optimizer of the likelihood.
+**/
+
+#include "RooFit.h"
+#include "RooMsgService.h"
+#include "RooTreeColumnDataStore.h"
+#include "RooVectorDataStore.h"
+
+#include "Riostream.h"
+#include "TTree.h"
+#include "TLeaf.h"
+#include "TBranch.h"
+#include "RooFormulaVar.h"
+#include "RooRealVar.h"
+#include "RooArgList.h"
+#include "RooTrace.h"
+
+#include <mutex>
+#include <algorithm>
+
+using namespace std ;
+
+ClassImp(RooTreeColumnDataStore)
+;
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Columns read from one tree, shared by all stores that view this tree.
+/// Columns are only appended, and their arrays are allocated at once, so
+/// that pointers to the arrays remain valid while other columns are added.
+
+struct RooTreeColumnDataStore::ColumnSource {
+
+  struct Column {
+    TString _branch ;                // Name of the source branch, empty for computed columns
+    Bool_t _loaded ;                 // Values have been read
+    Double_t _default ;              // Value used if the branch does not exist
+    std::vector<Double_t> _dvec ;
+    std::vector<Float_t> _fvec ;
+  } ;
+
+  ColumnSource(TTree* tree, Bool_t floatStorage) :
+    _tree(tree), _done(kFALSE), _float(floatStorage), _nEntries(tree ? Int_t(tree->GetEntries()) : 0) {}
+
+  ~ColumnSource() {
+    for (vector<Column*>::iterator iter=_cols.begin() ; iter!=_cols.end() ; ++iter) {
+      delete *iter ;
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Return the index of the column of the given branch, adding it if needed.
+  /// Once the tree has been read, new branches can not be added anymore: the
+  /// column is then filled with the default value.
+
+  Int_t column(const char* branch, Double_t defValue) {
+    lock_guard<mutex> lock(_mutex) ;
+    for (UInt_t i=0 ; i<_cols.size() ; i++) {
+      if (_cols[i]->_branch==branch) return i ;
+    }
+    Column* col = new Column ;
+    col->_branch = branch ;
+    col->_loaded = kFALSE ;
+    col->_default = defValue ;
+    if (_done) {
+      oocoutE((TObject*)0,InputArguments) << "RooTreeColumnDataStore: source tree has already been read, cannot add branch "
+					  << branch << ", using value " << defValue << endl ;
+      if (_float) {
+	col->_fvec.assign(_nEntries,Float_t(defValue)) ;
+      } else {
+	col->_dvec.assign(_nEntries,defValue) ;
+      }
+      col->_loaded = kTRUE ;
+    }
+    _cols.push_back(col) ;
+    return _cols.size()-1 ;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Add a computed column, its values are set by the caller
+
+  Int_t addComputed() {
+    lock_guard<mutex> lock(_mutex) ;
+    Column* col = new Column ;
+    col->_loaded = kTRUE ;
+    col->_default = 0 ;
+    if (_float) {
+      col->_fvec.assign(_nEntries,0) ;
+    } else {
+      col->_dvec.assign(_nEntries,0) ;
+    }
+    _cols.push_back(col) ;
+    return _cols.size()-1 ;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Read the branches of the given columns that have not been loaded yet,
+  /// in a single sequential pass over the entries of the tree. The tree is
+  /// not used anymore afterwards, so that it can be deleted by its owner.
+
+  void load(const vector<Int_t>& icols) {
+    lock_guard<mutex> lock(_mutex) ;
+
+    vector<Column*> todo ;
+    for (vector<Int_t>::const_iterator iter=icols.begin() ; iter!=icols.end() ; ++iter) {
+      Column* col = _cols[*iter] ;
+      if (col->_loaded || find(todo.begin(),todo.end(),col)!=todo.end()) continue ;
+      todo.push_back(col) ;
+    }
+    if (todo.empty()) {
+      _tree = 0 ;
+      _done = kTRUE ;
+      return ;
+    }
+
+    if (!_tree) {
+      oocoutE((TObject*)0,InputArguments) << "RooTreeColumnDataStore: source tree is not available, cannot read "
+					  << todo.size() << " column(s)" << endl ;
+    }
+
+    for (vector<Column*>::iterator iter=todo.begin() ; iter!=todo.end() ; ++iter) {
+      if (_float) {
+	(*iter)->_fvec.assign(_nEntries,Float_t((*iter)->_default)) ;
+      } else {
+	(*iter)->_dvec.assign(_nEntries,(*iter)->_default) ;
+      }
+    }
+
+    if (_tree) {
+      vector<TLeaf*> leaves(todo.size(),(TLeaf*)0) ;
+      vector<Bool_t> missing(todo.size(),kFALSE) ;
+      Int_t treeNumber(-1) ;
+      for (Int_t i=0 ; i<_nEntries ; i++) {
+	Long64_t local = _tree->LoadTree(i) ;
+	if (local<0) break ;
+
+	// Branches change when a TChain moves to the next file
+	if (_tree->GetTreeNumber()!=treeNumber) {
+	  treeNumber = _tree->GetTreeNumber() ;
+	  for (UInt_t k=0 ; k<todo.size() ; k++) {
+	    leaves[k] = _tree->GetLeaf(todo[k]->_branch) ;
+	    if (!leaves[k] && !missing[k]) {
+	      oocoutW((TObject*)0,InputArguments) << "RooTreeColumnDataStore: no branch " << todo[k]->_branch << " in tree "
+						  << _tree->GetName() << ", using value " << todo[k]->_default << endl ;
+	      missing[k] = kTRUE ;
+	    }
+	  }
+	}
+
+	for (UInt_t k=0 ; k<todo.size() ; k++) {
+	  if (!leaves[k]) continue ;
+	  leaves[k]->GetBranch()->GetEntry(local) ;
+	  if (_float) {
+	    todo[k]->_fvec[i] = Float_t(leaves[k]->GetValue()) ;
+	  } else {
+	    todo[k]->_dvec[i] = leaves[k]->GetValue() ;
+	  }
+	}
+      }
+    }
+
+    for (vector<Column*>::iterator iter=todo.begin() ; iter!=todo.end() ; ++iter) {
+      (*iter)->_loaded = kTRUE ;
+    }
+    _tree = 0 ;
+    _done = kTRUE ;
+  }
+
+  TTree* _tree ;                     // Source tree, not owned, null once the columns have been read
+  Bool_t _done ;                     // Columns have been read, no branch can be added
+  Bool_t _float ;                    // Store values in single precision
+  Int_t _nEntries ;                  // Number of entries of the tree
+  std::vector<Column*> _cols ;
+  std::mutex _mutex ;                // Protects column loading and addition
+
+} ;
+
+
+
+namespace {
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Return copy of allVars minus variable matching wgtName if specified
+
+  RooArgSet columnVarsNoWeight(const RooArgSet& allVars, const char* wgtName)
+  {
+    RooArgSet ret(allVars) ;
+    if (wgtName) {
+      RooAbsArg* wgt = allVars.find(wgtName) ;
+      if (wgt) {
+	ret.remove(*wgt,kTRUE,kTRUE) ;
+      }
+    }
+    return ret ;
+  }
+
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+RooTreeColumnDataStore::RooTreeColumnDataStore() :
+  _wgtVar(0),
+  _wgtCol(-1),
+  _select(0),
+  _init(kFALSE),
+  _selectPending(kFALSE),
+  _curWgt(1),
+  _sumWeight(0)
+{
+  TRACE_CREATE
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Construct a store on the branches of tree t matching the observables in
+/// vars. Entries outside the range of the observables, or not passing the
+/// optional selection expression selExpr, are not selected. The tree is not
+/// read before the first access to the data.
+
+RooTreeColumnDataStore::RooTreeColumnDataStore(const char* name, const char* title, const RooArgSet& vars, TTree& t,
+					       const char* selExpr, const char* wgtVarName, Bool_t floatStorage) :
+  RooAbsDataStore(name,title,columnVarsNoWeight(vars,wgtVarName)),
+  _varsww(vars),
+  _wgtVar(0),
+  _source(new ColumnSource(&t,floatStorage)),
+  _wgtCol(-1),
+  _select(0),
+  _init(kFALSE),
+  _selectPending(kTRUE),
+  _curWgt(1),
+  _sumWeight(0)
+{
+  initialize(wgtVarName) ;
+  if (selExpr && *selExpr) {
+    _select = new RooFormulaVar(selExpr,selExpr,RooArgList(_vars)) ;
+  }
+  TRACE_CREATE
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Construct a store on the branches of tree t matching the observables in
+/// vars, selecting the entries for which the formula select is not zero
+
+RooTreeColumnDataStore::RooTreeColumnDataStore(const char* name, const char* title, const RooArgSet& vars, TTree& t,
+					       const RooFormulaVar& select, const char* wgtVarName, Bool_t floatStorage) :
+  RooAbsDataStore(name,title,columnVarsNoWeight(vars,wgtVarName)),
+  _varsww(vars),
+  _wgtVar(0),
+  _source(new ColumnSource(&t,floatStorage)),
+  _wgtCol(-1),
+  _select(0),
+  _init(kFALSE),
+  _selectPending(kTRUE),
+  _curWgt(1),
+  _sumWeight(0)
+{
+  initialize(wgtVarName) ;
+  _select = (RooFormulaVar*) select.cloneTree() ;
+  _select->recursiveRedirectServers(_vars) ;
+  TRACE_CREATE
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Construct a reduced view of store other. The view shares the columns of
+/// other and only keeps the list of the rows that pass the selection cutVar,
+/// the ranges cutRange and that are in the range [nStart,nStop[ of the rows
+/// of other.
+
+RooTreeColumnDataStore::RooTreeColumnDataStore(const char *name, const char *title, const RooTreeColumnDataStore& other,
+					       const RooArgSet& vars, const RooFormulaVar* cutVar, const char* cutRange,
+					       Int_t nStart, Int_t nStop, const char* wgtVarName) :
+  RooAbsDataStore(name,title,columnVarsNoWeight(vars,wgtVarName)),
+  _varsww(vars),
+  _wgtVar(0),
+  _wgtCol(-1),
+  _select(0),
+  _init(kFALSE),
+  _selectPending(kFALSE),
+  _curWgt(1),
+  _sumWeight(0)
+{
+  other.checkInit() ;
+  _source = other._source ;
+  _rows = other._rows ;
+  initialize(wgtVarName,&other) ;
+
+  checkInit() ;
+  if (cutVar || cutRange || nStart>0 || nStop<numEntries()) {
+    selectRows(cutVar,cutRange,nStart,nStop) ;
+    sumWeights() ;
+  }
+  TRACE_CREATE
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy constructor, the copy shares the columns of other
+
+RooTreeColumnDataStore::RooTreeColumnDataStore(const RooTreeColumnDataStore& other, const char* newname) :
+  RooAbsDataStore(other,newname),
+  _varsww(other._varsww),
+  _wgtVar(0),
+  _wgtCol(-1),
+  _select(0),
+  _init(kFALSE),
+  _selectPending(kFALSE),
+  _curWgt(other._curWgt),
+  _sumWeight(0)
+{
+  other.checkInit() ;
+  _source = other._source ;
+  _rows = other._rows ;
+  initialize(other._wgtVar?other._wgtVar->GetName():0,&other) ;
+  TRACE_CREATE
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy constructor with new set of observables, the copy shares the
+/// columns of other
+
+RooTreeColumnDataStore::RooTreeColumnDataStore(const RooTreeColumnDataStore& other, const RooArgSet& vars, const char* newname) :
+  RooAbsDataStore(other,columnVarsNoWeight(vars,other._wgtVar?other._wgtVar->GetName():0),newname),
+  _varsww(vars),
+  _wgtVar(0),
+  _wgtCol(-1),
+  _select(0),
+  _init(kFALSE),
+  _selectPending(kFALSE),
+  _curWgt(other._curWgt),
+  _sumWeight(0)
+{
+  other.checkInit() ;
+  _source = other._source ;
+  _rows = other._rows ;
+  initialize(other._wgtVar?other._wgtVar->GetName():0,&other) ;
+  TRACE_CREATE
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+RooTreeColumnDataStore::~RooTreeColumnDataStore()
+{
+  delete _select ;
+  TRACE_DESTROY
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Associate a column to each observable. Columns already used by the
+/// parent store are reused, other observables are read from the branch
+/// with the same name.
+
+void RooTreeColumnDataStore::initialize(const char* wgtVarName, const RooTreeColumnDataStore* parent)
+{
+  RooFIter iter = _varsww.fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=iter.next())) {
+    RooRealVar* rrv = dynamic_cast<RooRealVar*>(arg) ;
+    if (!rrv) {
+      coutE(InputArguments) << "RooTreeColumnDataStore::initialize(" << GetName() << ") ERROR: observable " << arg->GetName()
+			    << " is not a RooRealVar, only real valued observables can be stored in columns, ignored" << endl ;
+      continue ;
+    }
+
+    Int_t icol(-1) ;
+    if (parent) {
+      for (UInt_t k=0 ; k<parent->_colVars.size() ; k++) {
+	if (!strcmp(parent->_colVars[k]->GetName(),rrv->GetName())) {
+	  icol = parent->_colIndex[k] ;
+	  break ;
+	}
+      }
+    }
+    if (icol<0) {
+      icol = _source->column(rrv->GetName(),rrv->getVal()) ;
+    }
+
+    if (wgtVarName && !strcmp(rrv->GetName(),wgtVarName)) {
+      _wgtVar = rrv ;
+      _wgtCol = _colVars.size() ;
+    }
+    _colVars.push_back(rrv) ;
+    _colBuf.push_back(rrv) ;
+    _colIndex.push_back(icol) ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load the columns of the observables and, for a store constructed from a
+/// tree, select the rows of the tree
+
+void RooTreeColumnDataStore::checkInit() const
+{
+  if (_init || !_source) return ;
+  _init = kTRUE ;
+
+  _source->load(_colIndex) ;
+  attachColumns() ;
+
+  if (_selectPending) {
+    _selectPending = kFALSE ;
+    selectRows(_select,0,0,2000000000) ;
+    delete _select ;
+    _select = 0 ;
+  }
+  sumWeights() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cache the pointers to the column arrays of the observables
+
+void RooTreeColumnDataStore::attachColumns() const
+{
+  lock_guard<mutex> lock(_source->_mutex) ;
+  _dcol.assign(_colIndex.size(),(const Double_t*)0) ;
+  _fcol.assign(_colIndex.size(),(const Float_t*)0) ;
+  for (UInt_t k=0 ; k<_colIndex.size() ; k++) {
+    const ColumnSource::Column* col = _source->_cols[_colIndex[k]] ;
+    if (_source->_float) {
+      _fcol[k] = col->_fvec.empty() ? 0 : &col->_fvec[0] ;
+    } else {
+      _dcol[k] = col->_dvec.empty() ? 0 : &col->_dvec[0] ;
+    }
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the list of selected rows by the rows in [nStart,nStop[ that
+/// have valid values for all observables, that are in the ranges rangeName
+/// and for which the formula select is not zero
+
+void RooTreeColumnDataStore::selectRows(const RooFormulaVar* select, const char* rangeName, Int_t nStart, Int_t nStop) const
+{
+  // Redirect formula servers to the observables of this store
+  RooFormulaVar* selectClone(0) ;
+  if (select) {
+    selectClone = (RooFormulaVar*) select->cloneTree() ;
+    selectClone->recursiveRedirectServers(_vars) ;
+    selectClone->setOperMode(RooAbsArg::ADirty,kTRUE) ;
+  }
+
+  Int_t nevent = nStop < numEntries() ? nStop : numEntries() ;
+  vector<Int_t>* rows = new vector<Int_t> ;
+  rows->reserve(nevent>nStart ? nevent-nStart : 0) ;
+
+  Int_t numInvalid(0) ;
+  for (Int_t i=nStart ; i<nevent ; i++) {
+    Int_t irow = row(i) ;
+
+    Bool_t allValid(kTRUE) ;
+    for (UInt_t k=0 ; k<_colVars.size() ; k++) {
+      Double_t val = value(k,irow) ;
+      if (!_colVars[k]->isValidReal(val)) {
+	allValid = kFALSE ;
+	break ;
+      }
+      _colVars[k]->_value = val ;
+      _colVars[k]->setValueDirty() ;
+    }
+    if (!allValid) {
+      numInvalid++ ;
+      continue ;
+    }
+
+    if (rangeName && !_vars.allInRange(rangeName)) continue ;
+    if (selectClone && selectClone->getVal()==0) continue ;
+
+    rows->push_back(irow) ;
+  }
+
+  if (numInvalid>0) {
+    coutI(Eval) << "RooTreeColumnDataStore::selectRows(" << GetName() << ") Ignored " << numInvalid << " out of range events" << endl ;
+  }
+
+  if (!_rows && Int_t(rows->size())==_source->_nEntries) {
+    // All rows of the tree are selected
+    delete rows ;
+  } else {
+    _rows.reset(rows) ;
+  }
+
+  delete selectClone ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Recalculate the sum of weights of the selected rows
+
+void RooTreeColumnDataStore::sumWeights() const
+{
+  if (_wgtCol<0) {
+    _sumWeight = numEntries() ;
+    return ;
+  }
+
+  Double_t sum(0), carry(0) ;
+  for (Int_t i=0 ; i<numEntries() ; i++) {
+    // Kahan summation
+    Double_t y = value(_wgtCol,row(i)) - carry ;
+    Double_t t = sum + y ;
+    carry = (t - sum) - y ;
+    sum = t ;
+  }
+  _sumWeight = sum ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// The store is read-only, fill() is not supported
+
+Int_t RooTreeColumnDataStore::fill()
+{
+  coutE(DataHandling) << "RooTreeColumnDataStore::fill(" << GetName() << ") ERROR: data store is read-only, "
+		      << "convert the dataset to vector storage to add events" << endl ;
+  return 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load the values of row index into the observables, or into the external
+/// observables given to attachBuffers()
+
+const RooArgSet* RooTreeColumnDataStore::get(Int_t index) const
+{
+  checkInit() ;
+
+  if (index<0 || index>=numEntries()) return 0 ;
+
+  Int_t irow = row(index) ;
+  for (UInt_t k=0 ; k<_colBuf.size() ; k++) {
+    _colBuf[k]->_value = value(k,irow) ;
+    if (_doDirtyProp) _colBuf[k]->setValueDirty() ;
+  }
+  _curWgt = _wgtCol<0 ? 1. : value(_wgtCol,irow) ;
+
+  return &_vars ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the weight of row index
+
+Double_t RooTreeColumnDataStore::weight(Int_t index) const
+{
+  checkInit() ;
+  return _wgtCol<0 ? 1. : value(_wgtCol,row(index)) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the error on the current weight, from the error of the weight
+/// variable
+
+Double_t RooTreeColumnDataStore::weightError(RooAbsData::ErrorType /*etype*/) const
+{
+  if (_wgtVar) {
+    if (_wgtVar->hasAsymError()) {
+      return ( _wgtVar->getAsymErrorHi() - _wgtVar->getAsymErrorLo() ) / 2 ;
+    } else if (_wgtVar->hasError(kFALSE)) {
+      return _wgtVar->getError() ;
+    }
+  }
+  return 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the asymmetric error on the current weight, from the error of
+/// the weight variable
+
+void RooTreeColumnDataStore::weightError(Double_t& lo, Double_t& hi, RooAbsData::ErrorType /*etype*/) const
+{
+  if (_wgtVar) {
+    if (_wgtVar->hasAsymError()) {
+      hi = _wgtVar->getAsymErrorHi() ;
+      lo = _wgtVar->getAsymErrorLo() ;
+    } else {
+      hi = _wgtVar->getError() ;
+      lo = _wgtVar->getError() ;
+    }
+  } else {
+    lo = 0 ;
+    hi = 0 ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+Bool_t RooTreeColumnDataStore::changeObservableName(const char* /*from*/, const char* /*to*/)
+{
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a column with the values of newVar computed for each selected row.
+/// Only real valued functions are supported. The column is stored in
+/// memory next to the columns read from the tree.
+
+RooAbsArg* RooTreeColumnDataStore::addColumn(RooAbsArg& newVar, Bool_t /*adjustRange*/)
+{
+  checkInit() ;
+
+  // Create a fundamental object of the right type to hold newVar values
+  RooAbsArg* valHolder = newVar.createFundamental() ;
+  RooRealVar* rrv = dynamic_cast<RooRealVar*>(valHolder) ;
+  if (!rrv) {
+    coutE(InputArguments) << GetName() << "::addColumn: only real valued columns can be added to a column data store: \""
+			  << newVar.GetName() << "\"" << endl ;
+    delete valHolder ;
+    return 0 ;
+  }
+
+  // Clone function and attach to the observables of this store
+  RooAbsReal* newVarClone = (RooAbsReal*) newVar.cloneTree() ;
+  newVarClone->recursiveRedirectServers(_vars,kFALSE) ;
+
+  Int_t icol = _source->addComputed() ;
+  ColumnSource::Column* col ;
+  {
+    lock_guard<mutex> lock(_source->_mutex) ;
+    col = _source->_cols[icol] ;
+  }
+
+  for (Int_t i=0 ; i<numEntries() ; i++) {
+    Int_t irow = row(i) ;
+    for (UInt_t k=0 ; k<_colVars.size() ; k++) {
+      _colVars[k]->_value = value(k,irow) ;
+      _colVars[k]->setValueDirty() ;
+    }
+
+    Double_t val = newVarClone->getVal(&_vars) ;
+    if (_source->_float) {
+      col->_fvec[irow] = Float_t(val) ;
+    } else {
+      col->_dvec[irow] = val ;
+    }
+  }
+  delete newVarClone ;
+
+  _vars.add(*rrv) ;
+  _varsww.add(*rrv) ;
+  _colVars.push_back(rrv) ;
+  _colBuf.push_back(rrv) ;
+  _colIndex.push_back(icol) ;
+  attachColumns() ;
+
+  return valHolder ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Utility function to add multiple columns in one call
+/// See addColumn() for details
+
+RooArgSet* RooTreeColumnDataStore::addColumns(const RooArgList& varList)
+{
+  RooArgSet* holderSet = new RooArgSet ;
+  RooFIter iter = varList.fwdIterator() ;
+  RooAbsArg* var ;
+  while((var=iter.next())) {
+    RooAbsArg* holder = addColumn(*var) ;
+    if (holder) holderSet->add(*holder) ;
+  }
+  return holderSet ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge columns of supplied data set(s) with this data set. The merged
+/// store is a RooVectorDataStore.
+
+RooAbsDataStore* RooTreeColumnDataStore::merge(const RooArgSet& allVars, list<RooAbsDataStore*> dstoreList)
+{
+  RooVectorDataStore* mergedStore = new RooVectorDataStore("merged","merged",allVars) ;
+  RooArgSet& mergedVars = (RooArgSet&) *mergedStore->get() ;
+
+  Int_t nevt = dstoreList.front()->numEntries() ;
+  mergedStore->reserve(nevt) ;
+  for (int i=0 ; i<nevt ; i++) {
+
+    // Copy data from self
+    mergedVars = *get(i) ;
+
+    // Copy variables from merge sets
+    for (list<RooAbsDataStore*>::iterator iter = dstoreList.begin() ; iter!=dstoreList.end() ; iter++) {
+      const RooArgSet* partSet = (*iter)->get(i) ;
+      mergedVars = *partSet ;
+    }
+
+    mergedStore->fill() ;
+  }
+  return mergedStore ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// The store is read-only, append() is not supported
+
+void RooTreeColumnDataStore::append(RooAbsDataStore& /*other*/)
+{
+  coutE(DataHandling) << "RooTreeColumnDataStore::append(" << GetName() << ") ERROR: data store is read-only, "
+		      << "convert the dataset to vector storage to add events" << endl ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+Bool_t RooTreeColumnDataStore::valid() const
+{
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+Int_t RooTreeColumnDataStore::numEntries() const
+{
+  checkInit() ;
+  if (!_source) return 0 ;
+  return _rows ? Int_t(_rows->size()) : _source->_nEntries ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+Double_t RooTreeColumnDataStore::sumEntries() const
+{
+  checkInit() ;
+  return _sumWeight ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Deselect all rows. The columns are kept for the other stores that use
+/// them.
+
+void RooTreeColumnDataStore::reset()
+{
+  checkInit() ;
+  _rows.reset(new vector<Int_t>) ;
+  _sumWeight = 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load the values of get() into the observables in extObs that have the
+/// same name as the observables of this store
+
+void RooTreeColumnDataStore::attachBuffers(const RooArgSet& extObs)
+{
+  for (UInt_t k=0 ; k<_colVars.size() ; k++) {
+    RooAbsReal* extArg = dynamic_cast<RooAbsReal*>(extObs.find(_colVars[k]->GetName())) ;
+    if (extArg) {
+      _colBuf[k] = extArg ;
+    }
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RooTreeColumnDataStore::resetBuffers()
+{
+  for (UInt_t k=0 ; k<_colVars.size() ; k++) {
+    _colBuf[k] = _colVars[k] ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Function values are not cached in this store: all nodes are removed
+/// from varSet so that the caller does not rely on cached values
+
+void RooTreeColumnDataStore::cacheArgs(const RooAbsArg* /*cacheOwner*/, RooArgSet& varSet, const RooArgSet* /*nset*/, Bool_t /*skipZeroWeights*/)
+{
+  if (varSet.getSize()>0) {
+    coutI(Optimization) << "RooTreeColumnDataStore::cacheArgs(" << GetName() << ") constant expressions are not cached in column data store, "
+			<< varSet.getSize() << " node(s) will be evaluated for each event" << endl ;
+  }
+  varSet.removeAll() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// The store is read-only, loadValues() is not supported
+
+void RooTreeColumnDataStore::loadValues(const RooAbsDataStore* /*tds*/, const RooFormulaVar* /*select*/, const char* /*rangeName*/,
+					Int_t /*nStart*/, Int_t /*nStop*/)
+{
+  coutE(DataHandling) << "RooTreeColumnDataStore::loadValues(" << GetName() << ") ERROR: data store is read-only" << endl ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+Bool_t RooTreeColumnDataStore::floatStorage() const
+{
+  return _source ? _source->_float : kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the memory in bytes used by the loaded columns shared by this
+/// store, and by the list of selected rows of this store
+
+Long64_t RooTreeColumnDataStore::columnMemory() const
+{
+  if (!_source) return 0 ;
+  Long64_t mem(0) ;
+  {
+    lock_guard<mutex> lock(_source->_mutex) ;
+    for (vector<ColumnSource::Column*>::const_iterator iter=_source->_cols.begin() ; iter!=_source->_cols.end() ; ++iter) {
+      mem += (*iter)->_dvec.capacity()*sizeof(Double_t) + (*iter)->_fvec.capacity()*sizeof(Float_t) ;
+    }
+  }
+  if (_rows) mem += _rows->capacity()*sizeof(Int_t) ;
+  return mem ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the source tree, or null once the columns have been loaded
+
+const TTree* RooTreeColumnDataStore::sourceTree() const
+{
+  return _source ? _source->_tree : 0 ;
+}
@@ -633,6 +633,117 @@ Double_t RooVectorDataStore::weight(Int_t index) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the column of values that get() loads into the value buffer of
+/// the given object, or a null pointer if no such column exists in this
+/// store or in its cache of precalculated function values. This is used by
+/// RooAbsReal::getValBatch() to process observables and cached nodes for
+/// a range of events without loading the events one by one.
+
+const Double_t* RooVectorDataStore::realColumn(const RooAbsReal& real) const 
+{
+  for (Int_t i=0 ; i<_nReal ; i++) {
+    if ((*(_firstReal+i))->_real==&real) return (*(_firstReal+i))->_vec0 ;
+  }
+  for (Int_t i=0 ; i<_nRealF ; i++) {
+    if ((*(_firstRealF+i))->_real==&real) return (*(_firstRealF+i))->_vec0 ;
+  }
+  return _cache ? _cache->realColumn(real) : 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the column of event weights. A null pointer is returned if the
+/// events are not weighted or if their weights are not stored in a column
+
+const Double_t* RooVectorDataStore::weightColumn() const 
+{
+  if (_extWgtArray) return _extWgtArray ;
+  if (_wgtVar) return realColumn(*_wgtVar) ;
+  return 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Overwrite the stored values of the given object for the events [begin,end[
+/// with those in values, e.g. with the values of a function calculated in
+/// batch for events filled earlier. Return kFALSE if the object has no
+/// column in this store.
+
+Bool_t RooVectorDataStore::setRealColumn(const RooAbsReal& real, Int_t begin, Int_t end, const Double_t* values) 
+{
+  if (begin<0 || end>_nEntries || begin>end) return kFALSE ;
+  for (Int_t i=0 ; i<_nReal ; i++) {
+    if ((*(_firstReal+i))->_real==&real) {
+      std::copy(values,values+(end-begin),(*(_firstReal+i))->_vec0+begin) ;
+      return kTRUE ;
+    }
+  }
+  for (Int_t i=0 ; i<_nRealF ; i++) {
+    if ((*(_firstRealF+i))->_real==&real) {
+      std::copy(values,values+(end-begin),(*(_firstRealF+i))->_vec0+begin) ;
+      return kTRUE ;
+    }
+  }
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the values stored in this store and load the events from the
+/// columns of 'other' instead, which must hold the same observables and
+/// the same events (e.g. a clone of this store). This allows several
+/// test statistics that evaluate partitions of the same data in different
+/// threads to share one copy of the dataset, while each of them keeps its
+/// own value buffers and cache of precalculated function values.
+/// The columns are shared read-only: 'other' must outlive this store and may
+/// not be filled, reset or resized afterwards. This store keeps reporting the
+/// size of the shared columns, and takes a private copy of a column before
+/// it is modified, copied or written out, so it can be used like any other
+/// store at the price of that copy. Stores with
+/// external weight arrays or with stored errors on the observables cannot
+/// share their columns, in which case kFALSE is returned and this store
+/// is left unchanged.
+
+Bool_t RooVectorDataStore::shareColumns(const RooVectorDataStore& other) 
+{
+  if (_nReal!=other._nReal || _nRealF!=other._nRealF || _nCat!=other._nCat || _nEntries!=other._nEntries) return kFALSE ;
+  if (_extWgtArray || other._extWgtArray) return kFALSE ;
+
+  for (Int_t i=0 ; i<_nReal ; i++) {
+    const RooAbsReal* arg = (*(_firstReal+i))->bufArg() ;
+    const RooAbsReal* otherArg = (*(other._firstReal+i))->bufArg() ;
+    if (!arg || !otherArg || strcmp(arg->GetName(),otherArg->GetName())) return kFALSE ;
+  }
+  for (Int_t i=0 ; i<_nRealF ; i++) {
+    const RealFullVector* fv = *(_firstRealF+i) ;
+    const RealFullVector* otherFv = *(other._firstRealF+i) ;
+    if (fv->_vecE || fv->_vecEL || otherFv->_vecE || otherFv->_vecEL) return kFALSE ;
+    if (!fv->bufArg() || !otherFv->bufArg() || strcmp(fv->bufArg()->GetName(),otherFv->bufArg()->GetName())) return kFALSE ;
+  }
+  for (Int_t i=0 ; i<_nCat ; i++) {
+    const RooAbsCategory* cat = (*(_firstCat+i))->bufArg() ;
+    const RooAbsCategory* otherCat = (*(other._firstCat+i))->bufArg() ;
+    if (!cat || !otherCat || strcmp(cat->GetName(),otherCat->GetName())) return kFALSE ;
+  }
+
+  for (Int_t i=0 ; i<_nReal ; i++) {
+    (*(_firstReal+i))->share(**(other._firstReal+i)) ;
+  }
+  for (Int_t i=0 ; i<_nRealF ; i++) {
+    (*(_firstRealF+i))->share(**(other._firstRealF+i)) ;
+  }
+  for (Int_t i=0 ; i<_nCat ; i++) {
+    (*(_firstCat+i))->share(**(other._firstCat+i)) ;
+  }
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the weight of the n-th data point (n='index') in memory
 
@@ -1483,9 +1594,9 @@ void RooVectorDataStore::dump()
   for (; iter!=_realStoreList.end() ; ++iter) {
     cout << "RealVector " << *iter << " _nativeReal = " << (*iter)->_nativeReal << " = " << (*iter)->_nativeReal->GetName() << " bufptr = " << (*iter)->_buf  << endl ;
     cout << " values : " ;
-    Int_t imax = (*iter)->_vec.size()>10 ? 10 : (*iter)->_vec.size() ;
+    Int_t imax = (*iter)->size()>10 ? 10 : (*iter)->size() ;
     for (Int_t i=0 ; i<imax ; i++) {
-      cout << (*iter)->_vec[i] << " " ;
+      cout << (*iter)->_vec0[i] << " " ;
     }
     cout << endl ;
   }    
@@ -1495,9 +1606,9 @@ void RooVectorDataStore::dump()
 	 << " bufptr = " << (*iter2)->_buf  << " errbufptr = " << (*iter2)->_bufE << endl ;
 
     cout << " values : " ;
-    Int_t imax = (*iter2)->_vec.size()>10 ? 10 : (*iter2)->_vec.size() ;
+    Int_t imax = (*iter2)->size()>10 ? 10 : (*iter2)->size() ;
     for (Int_t i=0 ; i<imax ; i++) {
-      cout << (*iter2)->_vec[i] << " " ;
+      cout << (*iter2)->_vec0[i] << " " ;
     }
     cout << endl ;
     if ((*iter2)->_vecE) {
@@ -1554,8 +1665,11 @@ void RooVectorDataStore::RealVector::Streamer(TBuffer &R__b)
 {
    if (R__b.IsReading()) {
       R__b.ReadClassBuffer(RooVectorDataStore::RealVector::Class(),this);
+      _nShared = 0 ;
       _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
    } else {
+      // Shared columns are written out as owned values
+      unshare() ;
       R__b.WriteClassBuffer(RooVectorDataStore::RealVector::Class(),this);
    }
 }
@@ -1575,6 +1689,7 @@ void RooVectorDataStore::RealFullVector::Streamer(TBuffer &R__b)
      if (_vecEL && _vecEL->empty()) { delete _vecEL ; _vecEL = 0 ; }
      if (_vecEH && _vecEH->empty()) { delete _vecEH ; _vecEH = 0 ; }
    } else {
+     unshare() ;
      R__b.WriteClassBuffer(RooVectorDataStore::RealFullVector::Class(),this);
    }
 }
@@ -1586,8 +1701,10 @@ void RooVectorDataStore::CatVector::Streamer(TBuffer &R__b)
 {
    if (R__b.IsReading()) {
       R__b.ReadClassBuffer(RooVectorDataStore::CatVector::Class(),this);
+      _nShared = 0 ;
       _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
    } else {
+      unshare() ;
       R__b.WriteClassBuffer(RooVectorDataStore::CatVector::Class(),this);
    }
 }
@@ -91,6 +91,13 @@ For parallel runs, ToyMCSampler can be given an instance of ProofConfig
 and then run in parallel using proof or proof-lite. Internally, it uses
 ToyMCStudy with the RooStudyManager.
 
+Without PROOF, the toys can be generated in parallel in local worker
+processes with SetNWorkers(). Each worker is forked from the current
+process with TProcPool, generates its share of the toys with its own
+random seed and returns its sampling distributions, which are merged
+in the order of the workers: for a given seed of RooRandom and a given
+number of workers, the result is always the same.
+
 \ingroup Roostats
 
 */
@@ -262,12 +269,20 @@ class ToyMCSampler: public TestStatSampler {
       // calling with argument or NULL deactivates proof
       void SetProofConfig(ProofConfig *pc = NULL) { fProofConfig = pc; }
 
+      // number of local worker processes used when no ProofConfig is given
+      // (0 or 1: the toys are generated in the current process)
+      void SetNWorkers(Int_t nWorkers) { fNWorkers = nWorkers; }
+      Int_t GetNWorkers() const { return fNWorkers; }
+
       void SetProtoData(const RooDataSet* d) { fProtoData = d; }
       
    protected:
 
       const RooArgList* EvaluateAllTestStatistics(RooAbsData& data, const RooArgSet& poi, DetailedOutputAggregator& detOutAgg);
 
+      // parallel run in local worker processes
+      RooDataSet* GetSamplingDistributionsMultiProcess(RooArgSet& paramPoint);
+
       // helper for GenerateToyData
       RooAbsData* Generate(RooAbsPdf &pdf, RooArgSet &observables, const RooDataSet *protoData=NULL, int forceEvents=0) const;
 
@@ -307,6 +322,7 @@ class ToyMCSampler: public TestStatSampler {
       const RooDataSet *fProtoData; // in dev
       
       ProofConfig *fProofConfig;   //!
+      Int_t fNWorkers;             //! number of local worker processes
       
       mutable NuisanceParametersSampler *fNuisanceParametersSampler; //!
 
@@ -35,6 +35,12 @@
 #include "RooCategory.h"
 
 #include "TMath.h"
+#include "TRandom2.h"
+#include "TProcPool.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
 
 
 using namespace RooFit;
@@ -157,6 +163,7 @@ ToyMCSampler::ToyMCSampler() : fSamplingDistName("SD"), fNToys(1)
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -196,6 +203,7 @@ ToyMCSampler::ToyMCSampler(TestStatistic &ts, Int_t ntoys) :
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -302,8 +310,11 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    // Use for serial and parallel runs.
 
    // ======= S I N G L E   R U N ? =======
-   if(!fProofConfig)
+   if(!fProofConfig) {
+      if(fNWorkers > 1)
+         return GetSamplingDistributionsMultiProcess(paramPointIn);
       return GetSamplingDistributionsSingleWorker(paramPointIn);
+   }
 
 
    // ======= P A R A L L E L   R U N =======
@@ -346,6 +357,85 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    return output;
 }
 
+RooDataSet* ToyMCSampler::GetSamplingDistributionsMultiProcess(RooArgSet& paramPointIn)
+{
+   // Parallel run in fNWorkers local processes, forked with TProcPool. Each
+   // worker starts from a copy of the model of this process, so the workspace
+   // is cloned only once per worker. A worker reseeds RooRandom with its own
+   // seed, generates its share of the toys with GetSamplingDistributionsSingleWorker
+   // and sends back the resulting sampling distributions. They are merged in
+   // the order of the workers, so that a given seed of RooRandom and a given
+   // number of workers always give the same result.
+
+   if (!CheckConfig()){
+      oocoutE((TObject*)NULL, InputArguments)
+         << "Bad COnfiguration in ToyMCSampler "
+         << endl;
+      return nullptr;
+   }
+
+   // turn adaptive sampling off if given
+   if(fToysInTails) {
+      fToysInTails = 0;
+      oocoutW((TObject*)NULL, InputArguments)
+         << "Adaptive sampling in ToyMCSampler is not supported for parallel runs."
+         << endl;
+   }
+
+   const Int_t totToys = fNToys;
+   const Int_t nWorkers = TMath::Min(fNWorkers, totToys);
+   if (nWorkers < 2)
+      return GetSamplingDistributionsSingleWorker(paramPointIn);
+
+   // one seed per worker, derived from the current state of RooRandom
+   TRandom2 r(RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max()));
+   std::vector<UInt_t> seeds(nWorkers);
+   for (Int_t i = 0; i < nWorkers; ++i)
+      seeds[i] = r.Integer(TMath::Limits<unsigned int>::Max());
+
+   // runs in the forked worker: the changes to this sampler and to the
+   // random generator are not seen by the current process
+   auto runWorker = [&](Int_t iworker) -> ToyMCPayload* {
+      RooRandom::randomGenerator()->SetSeed(seeds[iworker]);
+      fNToys = totToys / nWorkers + (iworker < totToys % nWorkers ? 1 : 0);
+      ToyMCPayload* payload = new ToyMCPayload(GetSamplingDistributionsSingleWorker(paramPointIn));
+      payload->SetUniqueID(iworker);
+      return payload;
+   };
+
+   oocoutP((TObject*)0,Generation) << "ToyMCSampler: generating " << totToys << " toys in " << nWorkers << " worker processes" << endl;
+
+   std::vector<Int_t> workers(nWorkers);
+   std::iota(workers.begin(), workers.end(), 0);
+   TProcPool pool(nWorkers);
+   std::vector<ToyMCPayload*> results = pool.Map(runWorker, workers);
+
+   if (Int_t(results.size()) != nWorkers) {
+      oocoutW((TObject*)NULL, Generation) << "ToyMCSampler: only " << results.size() << " of "
+                                          << nWorkers << " worker processes returned their toys" << endl;
+   }
+
+   // the results arrive in the order in which the workers finish
+   std::sort(results.begin(), results.end(),
+             [](ToyMCPayload* a, ToyMCPayload* b) { return a->GetUniqueID() < b->GetUniqueID(); });
+
+   RooDataSet* output = NULL;
+   for (auto payload : results) {
+      RooDataSet* sd = payload->GetSamplingDistributions();
+      if (sd) {
+         if (!output) {
+            output = sd;
+         } else {
+            output->append(*sd);
+            delete sd;
+         }
+      }
+      delete payload;
+   }
+
+   return output;
+}
+
 RooDataSet* ToyMCSampler::GetSamplingDistributionsSingleWorker(RooArgSet& paramPointIn)
 {
    // This is the main function for serial runs. It is called automatically
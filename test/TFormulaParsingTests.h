@@ -627,6 +627,48 @@ bool test36() {
    
    return ok; 
 } 
+bool test37() {
+   // test compiled parameter gradient against the numerical one
+   bool ok = true;
+   TF1 f1("f1","gaus(0) + [3]*sqrt(x) + [4]*x^2 + TMath::Power([5],2)*sin(x)",0,10);
+   f1.SetParameters(2,3,1.5,0.5,-0.2,0.7);
+   double x = 2.;
+   std::vector<double> gnum(f1.GetNpar());
+   f1.GradientPar(&x, gnum.data());
+   ok &= (f1.GenerateGradientPar() );
+   ok &= (f1.HasGeneratedGradient() );
+   std::vector<double> grad(f1.GetNpar());
+   f1.GradientPar(&x, grad.data());
+   for (int i = 0; i < f1.GetNpar(); ++i)
+      ok &= TMath::AreEqualAbs( grad[i], gnum[i], 1.E-6);
+   // gradient code is not available for functions not supported
+   TF1 f2("f2","[0]*TMath::Landau(x,[1],[2])",0,10);
+   ok &= (!f2.GenerateGradientPar() );
+   return ok;
+}
+
+bool test38() {
+   // test evaluation on arrays of points against the point by point evaluation
+   bool ok = true;
+   TF2 f1("f1","[0]*exp(-0.5*((x-[1])/[2])^2)*cos([3]*y) + [4]*atan(x*y) + log(1+x*x)",-5,5,-5,5);
+   f1.SetParameters(2,0.3,1.5,0.7,0.2);
+   const int n = 100;
+   std::vector<double> x(2*n);
+   for (int i = 0; i < n; ++i) {
+      x[2*i] = -5. + 0.1*i;
+      x[2*i+1] = 3. - 0.06*i;
+   }
+   std::vector<double> result(n);
+   f1.EvalParArray(n, x.data(), result.data() );
+   for (int i = 0; i < n; ++i)
+      ok &= TMath::AreEqualAbs( result[i], f1.EvalPar(&x[2*i]), 1.E-10);
+   // other parameter values
+   double par[5] = { 1, -0.5, 0.8, 2., -1 };
+   f1.EvalParArray(n, x.data(), result.data(), par);
+   for (int i = 0; i < n; ++i)
+      ok &= TMath::AreEqualAbs( result[i], f1.EvalPar(&x[2*i], par), 1.E-10);
+   return ok;
+}
    
 void PrintError(int itest)  { 
    Error("TFormula test","test%d FAILED ",itest);
@@ -681,6 +723,8 @@ int runTests(bool debug = false) {
    IncrTest(itest); if (!test34() ) { PrintError(itest); }
    IncrTest(itest); if (!test35() ) { PrintError(itest); }
    IncrTest(itest); if (!test36() ) { PrintError(itest); }
+   IncrTest(itest); if (!test37() ) { PrintError(itest); }
+   IncrTest(itest); if (!test38() ) { PrintError(itest); }
 
    std::cout << ".\n";
     
@@ -0,0 +1,143 @@
+// @(#)root/test:$Id$
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TMVA DNN -- benchmark of the mini-batch computation.                 //
+//                                                                      //
+// Compare the timing and the results (error and weight gradients) of   //
+// one forward and backward pass over a mini-batch of the neural net    //
+// of MethodDNN:                                                        //
+//   - elementary : pattern by pattern and neuron by neuron, with the   //
+//                  activation functions called through std::function   //
+//   - batched    : blocked matrix multiplications over the whole       //
+//                  mini-batch and vectorized activation functions      //
+//                                                                      //
+// To run in batch, do                                                  //
+//   benchDNN               : layout 20-100-100-100-1, batches of 100   //
+//   benchDNN 500           : idem, hidden layers of 500 nodes          //
+//   benchDNN 500 200       : idem, batches of 200 pattern              //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Riostream.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TMath.h"
+#include "TMVA/NeuralNet.h"
+
+#include <cstdlib>
+
+using namespace TMVA::DNN;
+
+// Forward and backward pass over the batch, pattern by pattern
+double ElementaryForwardBackward(Net &net,Settings &settings,Batch &batch,
+                                 std::vector<double> &weights,std::vector<double> &gradients)
+{
+   DropContainer dropContainer;
+   size_t totalNumWeights = 0;
+   std::vector<std::vector<LayerData>> layerPatternData =
+      net.prepareLayerData(net.layers(),batch,dropContainer,weights.begin(),weights.end(),
+                           gradients.begin(),gradients.end(),totalNumWeights);
+
+   for (size_t iLayer = 0; iLayer+1 < layerPatternData.size(); iLayer++) {
+      for (size_t iPattern = 0; iPattern < batch.size(); iPattern++) {
+         LayerData &curr = layerPatternData[iLayer+1][iPattern];
+         forward(layerPatternData[iLayer][iPattern],curr);
+         applyFunctions(curr.valuesBegin(),curr.valuesEnd(),curr.activationFunction(),
+                        curr.inverseActivationFunction(),curr.valueGradientsBegin());
+      }
+   }
+
+   double sumError = 0, sumWeights = 0;
+   std::tie(sumError,sumWeights) = net.computeError(settings,layerPatternData.back(),batch,
+                                                    weights.begin(),weights.begin()+totalNumWeights);
+
+   for (size_t iLayer = layerPatternData.size()-1; iLayer > 0; iLayer--) {
+      for (size_t iPattern = 0; iPattern < batch.size(); iPattern++) {
+         LayerData &prev = layerPatternData[iLayer-1][iPattern];
+         LayerData &curr = layerPatternData[iLayer][iPattern];
+         backward(prev,curr);
+         update(prev,curr,settings.factorWeightDecay()/totalNumWeights,settings.regularization());
+      }
+   }
+
+   for (auto &g : gradients) g /= batch.size();
+   return sumError/sumWeights;
+}
+
+// Return the largest element of |a-b| relative to the largest element of |b|
+double RelDiff(const std::vector<double> &a,const std::vector<double> &b)
+{
+   double diff = 0, norm = 0;
+   for (size_t i = 0; i < a.size(); i++) {
+      diff = TMath::Max(diff,TMath::Abs(a[i]-b[i]));
+      norm = TMath::Max(norm,TMath::Abs(b[i]));
+   }
+   return norm > 0 ? diff/norm : diff;
+}
+
+int main(int argc,char **argv)
+{
+   Int_t nodes = 100;
+   Int_t batchSize = 100;
+   if (argc > 1) nodes = atoi(argv[1]);
+   if (argc > 2) batchSize = atoi(argv[2]);
+
+   const Int_t nInput = 20;
+   const Int_t nBatches = 20;
+
+   Net net;
+   net.setInputSize(nInput);
+   net.addLayer(Layer(nodes,EnumFunction::TANH));
+   net.addLayer(Layer(nodes,EnumFunction::RELU));
+   net.addLayer(Layer(nodes,EnumFunction::SOFTSIGN));
+   net.addLayer(Layer(1,EnumFunction::LINEAR,ModeOutputValues::SIGMOID));
+   net.setErrorFunction(ModeErrorFunction::CROSSENTROPY);
+   net.setOutputSize(1);
+
+   std::cout << "DNN benchmark with layout " << nInput << "-" << nodes << "-" << nodes << "-" << nodes
+             << "-1, " << nBatches << " batches of " << batchSize << " pattern" << std::endl;
+
+   std::vector<double> weights;
+   net.initializeWeights(WeightInitializationStrategy::XAVIERUNIFORM,std::back_inserter(weights));
+
+   TRandom3 r(4357);
+   std::vector<Pattern> pattern;
+   for (Int_t i = 0; i < nBatches*batchSize; i++) {
+      std::vector<double> input(nInput);
+      for (auto &x : input) x = r.Gaus();
+      pattern.push_back(Pattern(input.begin(),input.end(),r.Uniform() < 0.5 ? 0.0 : 1.0,r.Uniform(0.5,1.5)));
+   }
+
+   Settings settings("benchDNN",15,batchSize,7,1e-3,EnumRegularization::L2);
+   DropContainer dropContainer;
+
+   TStopwatch timer;
+   double errorOld = 0, errorNew = 0;
+   std::vector<double> gradientsOld(weights.size(),0.), gradientsNew(weights.size(),0.);
+
+   timer.Start();
+   for (Int_t iBatch = 0; iBatch < nBatches; iBatch++) {
+      Batch batch(pattern.begin()+iBatch*batchSize,pattern.begin()+(iBatch+1)*batchSize);
+      errorOld += ElementaryForwardBackward(net,settings,batch,weights,gradientsOld);
+   }
+   const Double_t tOld = timer.RealTime();
+
+   timer.Start();
+   for (Int_t iBatch = 0; iBatch < nBatches; iBatch++) {
+      Batch batch(pattern.begin()+iBatch*batchSize,pattern.begin()+(iBatch+1)*batchSize);
+      pass_through_type passThrough(settings,batch,dropContainer);
+      errorNew += net(passThrough,weights,gradientsNew);
+   }
+   const Double_t tNew = timer.RealTime();
+
+   const double diffError = TMath::Abs(errorNew-errorOld)/TMath::Abs(errorOld);
+   const double diffGradients = RelDiff(gradientsNew,gradientsOld);
+   const Bool_t ok = diffError < 1e-10 && diffGradients < 1e-10;
+
+   std::cout << "  forward+backward : elementary " << tOld << " s   batched " << tNew << " s";
+   if (tNew > 0) std::cout << "   speed-up " << tOld/tNew;
+   std::cout << "   rel. difference " << TMath::Max(diffError,diffGradients) << (ok ? "   OK" : "   FAILED") << std::endl;
+
+   return ok ? 0 : 1;
+}
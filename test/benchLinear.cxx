@@ -0,0 +1,146 @@
+// @(#)root/test:$Id$
+// Authors: Fons Rademakers, Eddy Offermann  Jan 2004
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// Linear Algebra Package -- benchmark of the blocked kernels.          //
+//                                                                      //
+// Compare, for large matrices, the timing and the results of the       //
+// elementary routines of TMatrixT, TDecompLU and TDecompChol with the  //
+// cache-blocked (and multi-threaded) kernels of TMatrixTKernels:       //
+//   - general matrix multiplication   C = A * B                        //
+//   - inversion of a general matrix   (LU decomposition)               //
+//   - Cholesky decomposition of a positive definite matrix             //
+//                                                                      //
+// To run in batch, do                                                  //
+//   benchLinear            : matrices of size 500x500                  //
+//   benchLinear 2000       : matrices of size 2000x2000                //
+//   benchLinear 2000 4     : idem, with implicit multi-threading on    //
+//                            4 threads (if ROOT is built with imt=ON)  //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Riostream.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TMath.h"
+#include "TMatrixD.h"
+#include "TMatrixDSym.h"
+#include "TMatrixTKernels.h"
+#include "TDecompChol.h"
+
+#include <cstdlib>
+
+// Fill a with random numbers in [-1,1]
+void FillRandom(TMatrixD &a,TRandom &r)
+{
+   Double_t *p = a.GetMatrixArray();
+   for (Int_t i = 0; i < a.GetNoElements(); i++)
+      p[i] = r.Uniform(-1.,1.);
+}
+
+// Return the largest element of |a-b| relative to the largest element of |b|
+Double_t RelDiff(const TMatrixD &a,const TMatrixD &b)
+{
+   TMatrixD d(a);
+   d -= b;
+   const Double_t norm = b.Max() > -b.Min() ? b.Max() : -b.Min();
+   return TMath::Max(d.Max(),-d.Min())/norm;
+}
+
+void PrintTiming(const char *name,Double_t tOld,Double_t tNew,Double_t diff,Bool_t ok)
+{
+   std::cout << "  " << name << " : elementary " << tOld << " s   blocked " << tNew << " s";
+   if (tNew > 0) std::cout << "   speed-up " << tOld/tNew;
+   std::cout << "   rel. difference " << diff << (ok ? "   OK" : "   FAILED") << std::endl;
+}
+
+int main(int argc,char **argv)
+{
+   Int_t n = 500;
+   Int_t nthreads = 0;
+   if (argc > 1) n = atoi(argv[1]);
+   if (argc > 2) nthreads = atoi(argv[2]);
+
+   if (nthreads > 0) ROOT::EnableImplicitMT(nthreads);
+
+   const Int_t minBlocked = TMatrixTKernels::GetMinBlockedSize();
+   const Int_t noBlocked  = n+1;
+
+   std::cout << "Linear algebra benchmark with matrices of size " << n << "x" << n;
+   if (ROOT::IsImplicitMTEnabled()) std::cout << " using implicit multi-threading";
+   std::cout << std::endl;
+
+   TRandom3 r(4357);
+   TMatrixD a(n,n), b(n,n);
+   FillRandom(a,r);
+   FillRandom(b,r);
+
+   TStopwatch timer;
+   Int_t nfail = 0;
+
+   // matrix multiplication
+
+   TMatrixTKernels::SetMinBlockedSize(noBlocked);
+   timer.Start();
+   TMatrixD cOld(a,TMatrixD::kMult,b);
+   const Double_t tMultOld = timer.RealTime();
+
+   TMatrixTKernels::SetMinBlockedSize(minBlocked);
+   timer.Start();
+   TMatrixD cNew(a,TMatrixD::kMult,b);
+   const Double_t tMultNew = timer.RealTime();
+
+   Double_t diff = RelDiff(cNew,cOld);
+   Bool_t ok = diff < 1e-12;
+   if (!ok) nfail++;
+   PrintTiming("A * B      ",tMultOld,tMultNew,diff,ok);
+
+   // inversion through LU decomposition
+
+   TMatrixD invOld(a);
+   TMatrixTKernels::SetMinBlockedSize(noBlocked);
+   timer.Start();
+   invOld.Invert();
+   const Double_t tInvOld = timer.RealTime();
+
+   TMatrixD invNew(a);
+   TMatrixTKernels::SetMinBlockedSize(minBlocked);
+   timer.Start();
+   invNew.Invert();
+   const Double_t tInvNew = timer.RealTime();
+
+   diff = RelDiff(invNew,invOld);
+   TMatrixD prod(a,TMatrixD::kMult,invNew);
+   TMatrixD unit(TMatrixD::kUnit,prod);
+   unit -= prod;
+   ok = diff < 1e-8 && TMath::Max(unit.Max(),-unit.Min()) < 1e-8;
+   if (!ok) nfail++;
+   PrintTiming("Invert     ",tInvOld,tInvNew,diff,ok);
+
+   // Cholesky decomposition of A^T A + n I
+
+   TMatrixDSym s(n);
+   s.TMult(a);
+   for (Int_t i = 0; i < n; i++) s(i,i) += n;
+
+   TMatrixTKernels::SetMinBlockedSize(noBlocked);
+   TDecompChol cholOld(s);
+   timer.Start();
+   ok = cholOld.Decompose();
+   const Double_t tCholOld = timer.RealTime();
+
+   TMatrixTKernels::SetMinBlockedSize(minBlocked);
+   TDecompChol cholNew(s);
+   timer.Start();
+   ok &= cholNew.Decompose();
+   const Double_t tCholNew = timer.RealTime();
+
+   diff = RelDiff(cholNew.GetU(),cholOld.GetU());
+   ok &= diff < 1e-12;
+   if (!ok) nfail++;
+   PrintTiming("Cholesky   ",tCholOld,tCholNew,diff,ok);
+
+   return nfail;
+}
@@ -8,6 +8,7 @@
 #include "TSystem.h"
 #include "TMath.h"
 #include "TH1F.h"
+#include "TRandom3.h"
 #include "TMinuit.h"
 
 // RooFit headers
@@ -21,6 +22,8 @@
 // RooStats header(s)
 #include "RooStats/ModelConfig.h"
 #include "RooStats/RooStatsUtils.h"
+#include "RooStats/HistFactory/HistoToWorkspaceFactoryFast.h"
+#include "RooStats/HistFactory/HistFactoryCompiledNLL.h"
 
 #include "stressHistFactory_models.cxx"
 
@@ -477,3 +480,110 @@ private:
     return kTRUE;
   }
 };
+
+
+class CompiledNLLComparison : public RooUnitTest {
+private:
+  Double_t fTolerance;
+public:
+  CompiledNLLComparison(
+    TFile* refFile,
+    Bool_t writeRef,
+    Int_t verbose
+    ) :
+    RooUnitTest("Flattened likelihood for HistFactory", refFile, writeRef, verbose),
+    fTolerance(1e-8)
+  {
+  }
+
+  Bool_t testCode()
+  {
+    // build a model with normalization factors, overall and shape systematics
+    // and statistical uncertainties directly from histograms
+    const Int_t nBins = 20;
+    TH1F hSig("signal","signal",nBins,0,10);
+    TH1F hBkg("background","background",nBins,0,10);
+    TH1F hBkgLow("background_Low","background_Low",nBins,0,10);
+    TH1F hBkgHigh("background_High","background_High",nBins,0,10);
+    TH1F hData("data","data",nBins,0,10);
+    for (Int_t i = 1; i <= nBins; ++i) {
+      Double_t x = hSig.GetBinCenter(i);
+      hSig.SetBinContent(i,20*TMath::Gaus(x,5,1));
+      hBkg.SetBinContent(i,50-3*x);
+      hBkg.SetBinError(i,0.05*(50-3*x));
+      hBkgLow.SetBinContent(i,(50-3*x)*(0.9+0.01*x));
+      hBkgHigh.SetBinContent(i,(50-3*x)*(1.1-0.01*x));
+      hData.SetBinContent(i,TMath::Nint(hSig.GetBinContent(i)+hBkg.GetBinContent(i))+i%3-1);
+    }
+
+    HistFactory::Measurement meas("Compiled","Compiled");
+    meas.SetPOI("mu");
+    meas.SetLumi(1.0);
+    meas.SetLumiRelErr(0.1);
+    meas.AddConstantParam("Lumi");
+
+    HistFactory::Channel channel("SignalRegion");
+    channel.SetData(&hData);
+    channel.SetStatErrorConfig(0.01,HistFactory::Constraint::Poisson);
+
+    HistFactory::Sample signal("signal");
+    signal.SetHisto(&hSig);
+    signal.AddNormFactor("mu",1,0,10);
+    signal.AddOverallSys("AccSys",0.95,1.05);
+    channel.AddSample(signal);
+
+    HistFactory::Sample background("background");
+    background.SetHisto(&hBkg);
+    background.ActivateStatError();
+    HistFactory::HistoSys shape("bkg_shape");
+    shape.SetHistoLow(&hBkgLow);
+    shape.SetHistoHigh(&hBkgHigh);
+    background.AddHistoSys(shape);
+    background.AddOverallSys("bkg_unc",0.9,1.1);
+    channel.AddSample(background);
+
+    meas.AddChannel(channel);
+
+    RooWorkspace* w = HistFactory::HistoToWorkspaceFactoryFast::MakeCombinedModel(meas);
+    ModelConfig* mc = (ModelConfig*) w->obj("ModelConfig");
+    RooAbsData* data = w->data("obsData");
+    if (!mc || !data) {
+      Error("testCode","Error retrieving the ModelConfig or the data");
+      return kFALSE;
+    }
+
+    RooAbsReal* nll = mc->GetPdf()->createNLL(*data,GlobalObservables(*mc->GetGlobalObservables()));
+    HistFactory::HistFactoryCompiledNLL compiled("compiled","compiled",*mc->GetPdf(),*data,mc->GetGlobalObservables());
+
+    // compare the two likelihoods at random parameter points
+    RooArgSet* params = compiled.getParameters(RooArgSet());
+    RooArgSet* initial = (RooArgSet*) params->snapshot();
+    TRandom3 r(4357);
+    Bool_t ok = kTRUE;
+    for (Int_t itry = 0; itry < 10 && ok; ++itry) {
+      RooLinkedListIter it = params->iterator();
+      TObject* obj = 0;
+      while ((obj = it.Next())) {
+        RooRealVar* par = dynamic_cast<RooRealVar*>(obj);
+        if (!par || par->isConstant()) continue;
+        const RooRealVar* init = (const RooRealVar*) initial->find(par->GetName());
+        Double_t step = (TString(par->GetName()).BeginsWith("alpha_") ? 1.5 : 0.1*init->getVal());
+        par->setVal(init->getVal() + r.Uniform(-step,step));
+      }
+      Double_t v1 = nll->getVal();
+      Double_t v2 = compiled.getVal();
+      if (_verb > 0) std::cout << "createNLL " << v1 << " flattened " << v2 << std::endl;
+      if (!TMath::AreEqualRel(v1,v2,fTolerance)) {
+        Warning("testCode","likelihoods differ: %.10g vs %.10g",v1,v2);
+        ok = kFALSE;
+      }
+    }
+
+    delete initial;
+    delete params;
+    delete nll;
+    delete w;
+
+    return ok;
+  }
+};
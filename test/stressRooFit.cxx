@@ -164,6 +164,13 @@ Int_t stressRooFit(const char* refFile, Bool_t writeRef, Int_t doVerbose, Int_t
   testList.push_back(new TestBasic802(fref,writeRef,doVerbose)) ;
   testList.push_back(new TestBasic803(fref,writeRef,doVerbose)) ;
   testList.push_back(new TestBasic804(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic805(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic806(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic807(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic808(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic809(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic810(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic811(fref,writeRef,doVerbose)) ;
 
   cout << "*  Starting  S T R E S S  basic suite                            *" <<endl;
   cout << "******************************************************************" <<endl;
@@ -6444,3 +6444,827 @@ public:
   }
 } ;
 
+//////////////////////////////////////////////////////////////////////////
+//
+// 'LIKELIHOOD AND MINIMIZATION' RooFit test #805
+//
+// Batch evaluation of the likelihood: compare with the event by event
+// evaluation for a composite model
+//
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooPolynomial.h"
+#include "RooAddPdf.h"
+#include "RooProdPdf.h"
+#include "RooNLLVar.h"
+#include "RooVectorDataStore.h"
+
+using namespace RooFit ;
+
+
+class TestBasic805 : public RooUnitTest
+{
+public:
+  TestBasic805(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Batch evaluation of likelihood",refFile,writeRef,verbose) {} ;
+
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l
+  // -----------------------
+
+  RooRealVar x("x","x",0,10) ;
+  RooRealVar y("y","y",-5,5) ;
+
+  RooRealVar m("m","m",5.,0.,10.) ;
+  RooRealVar s("s","s",1.,0.1,10.) ;
+  RooGaussian g("g","g",x,m,s) ;
+
+  RooRealVar c("c","c",-0.3,-2.,0.) ;
+  RooExponential e("e","e",x,c) ;
+
+  RooRealVar f("f","f",0.3,0.,1.) ;
+  RooAddPdf sumx("sumx","sumx",RooArgList(g,e),f) ;
+
+  RooRealVar a1("a1","a1",0.01,-1.,1.) ;
+  RooRealVar a2("a2","a2",0.02,-1.,1.) ;
+  RooPolynomial py("py","py",y,RooArgList(a1,a2)) ;
+
+  RooProdPdf model("model","model",RooArgSet(sumx,py)) ;
+
+  RooDataSet* data = model.generate(RooArgSet(x,y),10000) ;
+
+
+  // C o m p a r e   b a t c h   a n d   e v e n t   b y   e v e n t   l i k e l i h o o d
+  // ---------------------------------------------------------------------------------------
+
+  RooAbsReal* nllEvent = model.createNLL(*data) ;
+  RooAbsReal* nllBatch = model.createNLL(*data) ;
+
+  Bool_t ok(kTRUE) ;
+  for (Int_t i=0 ; i<3 ; i++) {
+    m.setVal(4.5+0.5*i) ;
+    c.setVal(-0.2-0.1*i) ;
+
+    RooNLLVar::setBatchEvaluation(kFALSE) ;
+    Double_t vEvent = nllEvent->getVal() ;
+    RooNLLVar::setBatchEvaluation(kTRUE) ;
+    Double_t vBatch = nllBatch->getVal() ;
+
+    if (fabs(vEvent-vBatch) > 1e-9*fabs(vEvent)) {
+      cout << "TestBasic805: batch likelihood " << vBatch << " differs from event by event likelihood " << vEvent << endl ;
+      ok = kFALSE ;
+    }
+  }
+
+
+  // C o m p a r e   b a t c h   a n d   e v e n t   b y   e v e n t   p d f   v a l u e s
+  // ---------------------------------------------------------------------------------------
+
+  // The likelihoods above agree also if the batch evaluation falls back to
+  // the event by event evaluation, so check the batch values of the model itself
+  const RooVectorDataStore* store = dynamic_cast<const RooVectorDataStore*>(data->store()) ;
+  model.attachDataSet(*data) ;
+  const RooArgSet* obs = data->get() ;
+  std::vector<Double_t> batch(data->numEntries()) ;
+  if (!store || !model.getValBatch(&batch[0],0,data->numEntries(),*store,obs)) {
+    cout << "TestBasic805: batch evaluation of the model is not available" << endl ;
+    ok = kFALSE ;
+  } else {
+    for (Int_t i=0 ; i<data->numEntries() ; i++) {
+      data->get(i) ;
+      Double_t v = model.getVal(obs) ;
+      if (fabs(v-batch[i]) > 1e-9*fabs(v)) {
+        cout << "TestBasic805: batch value " << batch[i] << " of event " << i << " differs from value " << v << endl ;
+        ok = kFALSE ;
+        break ;
+      }
+    }
+  }
+
+  delete nllEvent ;
+  delete nllBatch ;
+  delete data ;
+
+  return ok ;
+  }
+} ;
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+// 'LIKELIHOOD AND MINIMIZATION' RooFit test #806
+//
+// Threaded evaluation of the likelihood: compare the partitions calculated
+// in threads on a shared dataset with the sequential likelihood
+//
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooAddPdf.h"
+#include "RooAbsTestStatistic.h"
+
+using namespace RooFit ;
+
+class TestBasic806 : public RooUnitTest
+{
+public:
+  TestBasic806(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Threaded evaluation of likelihood",refFile,writeRef,verbose) {} ;
+
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l
+  // -----------------------
+
+  RooRealVar x("x","x",0,10) ;
+
+  RooRealVar m("m","m",5.,0.,10.) ;
+  RooRealVar s("s","s",1.,0.1,10.) ;
+  RooGaussian g("g","g",x,m,s) ;
+
+  RooRealVar c("c","c",-0.3,-2.,0.) ;
+  RooExponential e("e","e",x,c) ;
+
+  RooRealVar f("f","f",0.3,0.,1.) ;
+  RooAddPdf model("model","model",RooArgList(g,e),f) ;
+
+  RooDataSet* data = model.generate(x,10000) ;
+
+
+  // C o m p a r e   t h r e a d e d   a n d   s e q u e n t i a l   l i k e l i h o o d
+  // -------------------------------------------------------------------------------------
+
+  RooAbsReal* nll = model.createNLL(*data) ;
+
+  RooAbsTestStatistic::setThreadedEvaluation(kTRUE) ;
+  RooAbsReal* nllBulk = model.createNLL(*data,NumCPU(4,RooFit::BulkPartition)) ;
+  RooAbsReal* nllInter = model.createNLL(*data,NumCPU(3,RooFit::Interleave)) ;
+  RooAbsTestStatistic::setThreadedEvaluation(kFALSE) ;
+
+  // Without implicit multi-threading the partitions are calculated sequentially
+#ifdef R__USE_IMT
+  ROOT::EnableImplicitMT(4) ;
+#endif
+
+  Bool_t ok(kTRUE) ;
+  for (Int_t i=0 ; i<3 ; i++) {
+    m.setVal(4.5+0.5*i) ;
+    c.setVal(-0.2-0.1*i) ;
+
+    Double_t v = nll->getVal() ;
+    Double_t vBulk = nllBulk->getVal() ;
+    Double_t vInter = nllInter->getVal() ;
+
+    if (fabs(v-vBulk) > 1e-9*fabs(v) || fabs(v-vInter) > 1e-9*fabs(v)) {
+      cout << "TestBasic806: threaded likelihoods " << vBulk << " and " << vInter << " differ from likelihood " << v << endl ;
+      ok = kFALSE ;
+    }
+
+    // The partitions are combined in a fixed order, recalculation must give identical results
+    const Double_t sVal = s.getVal() ;
+    s.setVal(sVal+0.1) ;
+    nllBulk->getVal() ;
+    nllInter->getVal() ;
+    s.setVal(sVal) ;
+    if (nllBulk->getVal()!=vBulk || nllInter->getVal()!=vInter) {
+      cout << "TestBasic806: threaded likelihood is not reproducible" << endl ;
+      ok = kFALSE ;
+    }
+  }
+
+#ifdef R__USE_IMT
+  ROOT::DisableImplicitMT() ;
+#endif
+
+  delete nll ;
+  delete nllBulk ;
+  delete nllInter ;
+  delete data ;
+
+  return ok ;
+  }
+} ;
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+// 'SPECIAL PDFS' RooFit tutorial macro #807
+//
+// Dirty state propagation through the dependency index in minimization
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooAddPdf.h"
+#include "RooMinimizer.h"
+#include "RooDependencyIndex.h"
+
+using namespace RooFit ;
+
+class TestBasic807 : public RooUnitTest
+{
+public:
+  TestBasic807(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Dependency index in minimization",refFile,writeRef,verbose) {} ;
+
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l
+  // -----------------------
+
+  RooRealVar x("x","x",0,10) ;
+
+  RooRealVar m("m","m",5.,0.,10.) ;
+  RooRealVar s("s","s",1.,0.1,10.) ;
+  RooGaussian g("g","g",x,m,s) ;
+
+  RooRealVar c("c","c",-0.3,-2.,0.) ;
+  RooExponential e("e","e",x,c) ;
+
+  RooRealVar f("f","f",0.3,0.,1.) ;
+  RooAddPdf model("model","model",RooArgList(g,e),f) ;
+
+  RooDataSet* data = model.generate(x,2000) ;
+
+
+  // C h e c k   t h e   d e p e n d e n c i e s   i n   t h e   i n d e x
+  // ---------------------------------------------------------------------
+
+  Bool_t ok(kTRUE) ;
+  RooDependencyIndex index(model,RooArgList(m,c)) ;
+  for (Int_t i=0 ; i<index.numNodes() ; i++) {
+    const RooAbsArg* node = index.node(i) ;
+    if (index.dependsOn(i,0)!=node->dependsOnValue(m) || index.dependsOn(i,1)!=node->dependsOnValue(c)) {
+      cout << "TestBasic807: wrong dependencies of " << node->GetName() << " in index" << endl ;
+      ok = kFALSE ;
+    }
+  }
+
+
+  // C o m p a r e   f i t s   w i t h   a n d   w i t h o u t   i n d e x
+  // -----------------------------------------------------------------------
+
+  RooAbsReal* nll = model.createNLL(*data) ;
+  RooArgSet params(m,s,c,f) ;
+  RooArgSet* init = (RooArgSet*) params.snapshot() ;
+
+  RooMinimizer m1(*nll) ;
+  m1.setDependencyIndex(kFALSE) ;
+  m1.setPrintLevel(-1) ;
+  m1.migrad() ;
+  RooFitResult* r1 = m1.save() ;
+
+  params = *init ;
+  RooMinimizer m2(*nll) ;
+  m2.setDependencyIndex(kTRUE) ;
+  m2.setFreezeConstantNodes(kTRUE) ;
+  m2.setPrintLevel(-1) ;
+  m2.migrad() ;
+  RooFitResult* r2 = m2.save() ;
+
+  if (!r2->isIdentical(*r1,1e-6)) {
+    cout << "TestBasic807: fit with dependency index differs from fit without" << endl ;
+    ok = kFALSE ;
+  }
+
+  delete r1 ;
+  delete r2 ;
+  delete init ;
+  delete nll ;
+  delete data ;
+
+  return ok ;
+  }
+} ;
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+// 'SPECIAL PDFS' RooFit tutorial macro #808
+//
+// Datasets stored in columns read from a TTree
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooTreeColumnDataStore.h"
+#include "TTree.h"
+#include "TRandom3.h"
+
+using namespace RooFit ;
+
+class TestBasic808 : public RooUnitTest
+{
+public:
+  TestBasic808(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Column storage of TTree datasets",refFile,writeRef,verbose) {} ;
+
+  Bool_t testCode() {
+
+  // C r e a t e   s o u r c e   t r e e
+  // -----------------------------------
+
+  TTree tree("tree","tree") ;
+  tree.SetDirectory(0) ;
+  Double_t xval ;
+  Float_t yval ;
+  tree.Branch("x",&xval,"x/D") ;
+  tree.Branch("y",&yval,"y/F") ;
+  TRandom3 rnd(808) ;
+  for (Int_t i=0 ; i<5000 ; i++) {
+    xval = rnd.Gaus(0,3) ;
+    yval = rnd.Uniform(-1,1) ;
+    tree.Fill() ;
+  }
+
+  RooRealVar x("x","x",-10,10) ;
+  RooRealVar y("y","y",-1,1) ;
+
+
+  // I m p o r t   w i t h   v e c t o r   a n d   c o l u m n   s t o r a g e
+  // ---------------------------------------------------------------------------
+
+  RooAbsData::StorageType defType = RooAbsData::getDefaultStorageType() ;
+  RooDataSet vdata("vdata","vdata",&tree,RooArgSet(x,y),"y>-0.5") ;
+  RooAbsData::setDefaultStorageType(RooAbsData::Column) ;
+  RooDataSet cdata("cdata","cdata",&tree,RooArgSet(x,y),"y>-0.5") ;
+  RooAbsData::setDefaultStorageType(defType) ;
+
+  Bool_t ok(kTRUE) ;
+  if (!dynamic_cast<const RooTreeColumnDataStore*>(cdata.store())) {
+    cout << "TestBasic808: dataset does not use column storage" << endl ;
+    ok = kFALSE ;
+  }
+  if (cdata.numEntries()!=vdata.numEntries()) {
+    cout << "TestBasic808: " << cdata.numEntries() << " entries with column storage, " << vdata.numEntries() << " with vector storage" << endl ;
+    ok = kFALSE ;
+  }
+  for (Int_t i=0 ; ok && i<cdata.numEntries() ; i++) {
+    Double_t cx = cdata.get(i)->getRealValue("x") ;
+    Double_t cy = cdata.get(i)->getRealValue("y") ;
+    if (cx!=vdata.get(i)->getRealValue("x") || cy!=vdata.get(i)->getRealValue("y")) {
+      cout << "TestBasic808: entry " << i << " differs between column and vector storage" << endl ;
+      ok = kFALSE ;
+    }
+  }
+
+
+  // R e d u c e   a n d   f i t   t h e   c o l u m n   d a t a s e t
+  // -------------------------------------------------------------------
+
+  RooDataSet* creduced = (RooDataSet*) cdata.reduce("x>0") ;
+  RooDataSet* vreduced = (RooDataSet*) vdata.reduce("x>0") ;
+  if (!dynamic_cast<const RooTreeColumnDataStore*>(creduced->store()) || creduced->numEntries()!=vreduced->numEntries()) {
+    cout << "TestBasic808: reduced column dataset differs from reduced vector dataset" << endl ;
+    ok = kFALSE ;
+  }
+
+  RooRealVar m("m","m",0,-5,5) ;
+  RooRealVar s("s","s",2,0.1,10) ;
+  RooGaussian g("g","g",x,m,s) ;
+
+  RooFitResult* r1 = g.fitTo(vdata,Save(),PrintLevel(-1)) ;
+  m.setVal(0) ; s.setVal(2) ;
+  RooFitResult* r2 = g.fitTo(cdata,Save(),PrintLevel(-1)) ;
+  if (!r2->isIdentical(*r1,1e-5)) {
+    cout << "TestBasic808: fit to column dataset differs from fit to vector dataset" << endl ;
+    ok = kFALSE ;
+  }
+
+  delete r1 ;
+  delete r2 ;
+  delete creduced ;
+  delete vreduced ;
+
+  return ok ;
+  }
+} ;
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+// 'NUMERIC ALGORITHMS' RooFit tutorial macro #809
+//
+// Parallel Monte Carlo integration and memoized numeric integrals
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooGenericPdf.h"
+#include "RooNumIntConfig.h"
+#include "RooRealIntegral.h"
+#include "RooRandom.h"
+
+using namespace RooFit ;
+
+class TestBasic809 : public RooUnitTest
+{
+public:
+  TestBasic809(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Parallel MC integration and memoization",refFile,writeRef,verbose) {} ;
+
+  Bool_t testCode() {
+
+  // C r e a t e   3 D   f u n c t i o n   w i t h o u t   a n a l y t i c a l   i n t e g r a l
+  // -----------------------------------------------------------------------------------------------
+
+  RooRealVar x("x","x",-5,5) ;
+  RooRealVar y("y","y",-5,5) ;
+  RooRealVar z("z","z",-5,5) ;
+  RooRealVar s("s","s",1.5,0.5,3) ;
+  RooGenericPdf f("f","f","exp(-0.5*(x*x+y*y+z*z)/(s*s))*(1+0.1*x*y*z*z)",RooArgList(x,y,z,s)) ;
+
+  RooNumIntConfig cfg(*RooAbsReal::defaultIntegratorConfig()) ;
+  cfg.methodND().setLabel("RooMCIntegrator") ;
+  cfg.getConfigSection("RooMCIntegrator").setCatLabel("genType","PseudoRandom") ;
+
+  RooNumIntConfig cfgMT(cfg) ;
+  cfgMT.getConfigSection("RooMCIntegrator").setRealValue("nThreads",4) ;
+
+
+  // C o m p a r e   s e q u e n t i a l   a n d   p a r a l l e l   i n t e g r a t i o n
+  // -----------------------------------------------------------------------------------------
+
+  // Do not share values between the integrals through the expensive object cache
+  Int_t cacheDim = RooRealIntegral::getCacheAllNumeric() ;
+  RooRealIntegral::setCacheAllNumeric(4) ;
+
+  RooAbsReal* intSeq = f.createIntegral(RooArgSet(x,y,z),0,&cfg) ;
+  RooAbsReal* intMT = f.createIntegral(RooArgSet(x,y,z),0,&cfgMT) ;
+
+  RooRandom::randomGenerator()->SetSeed(809) ;
+  Double_t vSeq = intSeq->getVal() ;
+
+  // Without implicit multi-threading the integrand is sampled sequentially
+#ifdef R__USE_IMT
+  ROOT::EnableImplicitMT(4) ;
+#endif
+  RooRandom::randomGenerator()->SetSeed(809) ;
+  Double_t vMT = intMT->getVal() ;
+#ifdef R__USE_IMT
+  ROOT::DisableImplicitMT() ;
+#endif
+
+  Bool_t ok(kTRUE) ;
+  if (fabs(vMT-vSeq)>1e-12*fabs(vSeq)) {
+    cout << "TestBasic809: parallel integral " << vMT << " differs from sequential integral " << vSeq << endl ;
+    ok = kFALSE ;
+  }
+
+  // The analytical value of the integral is (2*pi*s^2)^(3/2) within the integration ranges
+  Double_t expected = TMath::Power(TMath::TwoPi()*s.getVal()*s.getVal(),1.5) ;
+  if (fabs(vSeq-expected)>0.05*expected) {
+    cout << "TestBasic809: integral " << vSeq << " differs from expected value " << expected << endl ;
+    ok = kFALSE ;
+  }
+
+
+  // C h e c k   m e m o i z a t i o n   o f   n u m e r i c   i n t e g r a l s
+  // -------------------------------------------------------------------------------
+
+  Int_t memoSize = RooRealIntegral::getNumericMemoSize() ;
+  RooRealIntegral::setNumericMemoSize(4) ;
+
+  s.setVal(1.2) ;
+  Double_t v1 = intSeq->getVal() ;
+  s.setVal(1.4) ;
+  Double_t v2 = intSeq->getVal() ;
+  s.setVal(1.2) ;
+  Double_t v3 = intSeq->getVal() ;
+  if (v3!=v1 || v2==v1) {
+    cout << "TestBasic809: memoized integral " << v3 << " differs from first calculation " << v1 << endl ;
+    ok = kFALSE ;
+  }
+
+  RooRealIntegral::setNumericMemoSize(memoSize) ;
+  RooRealIntegral::setCacheAllNumeric(cacheDim) ;
+
+  delete intSeq ;
+  delete intMT ;
+
+  return ok ;
+  }
+} ;
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+// 'NUMERIC ALGORITHMS' RooFit tutorial macro #810
+//
+// Accept-reject event generation with batched evaluation of trial samples
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooPolynomial.h"
+#include "RooGenericPdf.h"
+#include "RooCBShape.h"
+#include "RooDataSet.h"
+#include "RooNumGenConfig.h"
+#include "RooRandom.h"
+#include "RooPlot.h"
+
+using namespace RooFit ;
+
+class TestBasic810 : public RooUnitTest
+{
+public:
+  TestBasic810(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Batched accept-reject generation",refFile,writeRef,verbose) {} ;
+
+  Bool_t sameEvents(const RooDataSet& d1, const RooDataSet& d2, const char* label) {
+    // Compare the generated events of both datasets
+    if (d1.numEntries()!=d2.numEntries()) {
+      cout << "TestBasic810: " << label << " number of events " << d2.numEntries() << " differs from " << d1.numEntries() << endl ;
+      return kFALSE ;
+    }
+    for (Int_t i=0 ; i<d1.numEntries() ; i++) {
+      const RooArgSet* ev1 = d1.get(i) ;
+      const RooArgSet* ev2 = d2.get(i) ;
+      RooFIter iter = ev1->fwdIterator() ;
+      RooAbsArg* arg ;
+      while((arg=iter.next())) {
+	if (fabs(ev1->getRealValue(arg->GetName())-ev2->getRealValue(arg->GetName()))>1e-12) {
+	  cout << "TestBasic810: " << label << " event " << i << " differs" << endl ;
+	  return kFALSE ;
+	}
+      }
+    }
+    return kTRUE ;
+  }
+
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l s   w i t h o u t   i n t e r n a l   g e n e r a t o r
+  // ---------------------------------------------------------------------------------
+
+  RooRealVar x("x","x",-1,1) ;
+  RooRealVar y("y","y",-1,1) ;
+  RooRealVar a1("a1","a1",0.3) ;
+  RooRealVar a2("a2","a2",0.8) ;
+
+  // Polynomial model, evaluated in batch over the trial samples
+  RooPolynomial p("p","p",x,RooArgList(a1,a2)) ;
+
+  // Generic model, evaluated trial sample by trial sample
+  RooGenericPdf g("g","g","1+a2*x*x+a1*x*y",RooArgList(x,y,a1,a2)) ;
+
+  p.specialGeneratorConfig(kTRUE)->method1D(kFALSE,kFALSE).setLabel("RooAcceptReject") ;
+  g.specialGeneratorConfig(kTRUE)->method2D(kFALSE,kFALSE).setLabel("RooAcceptReject") ;
+
+
+  // G e n e r a t e   e v e n t   b y   e v e n t   a n d   i n   b a t c h e s
+  // -----------------------------------------------------------------------------
+
+  RooRandom::randomGenerator()->SetSeed(810) ;
+  RooDataSet* dp1 = p.generate(x,5000) ;
+  RooRandom::randomGenerator()->SetSeed(810) ;
+  RooDataSet* dg1 = g.generate(RooArgSet(x,y),5000) ;
+
+  p.specialGeneratorConfig()->getConfigSection("RooAcceptReject").setRealValue("batchSize",1000) ;
+  g.specialGeneratorConfig()->getConfigSection("RooAcceptReject").setRealValue("batchSize",1000) ;
+  g.specialGeneratorConfig()->getConfigSection("RooAcceptReject").setRealValue("nThreads",4) ;
+
+  // Without implicit multi-threading the trial samples of g are evaluated sequentially
+#ifdef R__USE_IMT
+  ROOT::EnableImplicitMT(4) ;
+#endif
+  RooRandom::randomGenerator()->SetSeed(810) ;
+  RooDataSet* dp2 = p.generate(x,5000) ;
+  RooRandom::randomGenerator()->SetSeed(810) ;
+  RooDataSet* dg2 = g.generate(RooArgSet(x,y),5000) ;
+#ifdef R__USE_IMT
+  ROOT::DisableImplicitMT() ;
+#endif
+
+  // The trial samples are drawn in the same sequence in both modes
+  Bool_t ok = sameEvents(*dp1,*dp2,"polynomial") && sameEvents(*dg1,*dg2,"generic pdf") ;
+
+
+  // G e n e r a t e   w i t h   k n o w n   m a x i m u m   a n d   c o n d i t i o n a l   o b s e r v a b l e
+  // -------------------------------------------------------------------------------------------------------------------
+
+  RooRealVar m("m","m",-5,5) ;
+  RooRealVar m0("m0","m0",0,-2,2) ;
+  RooRealVar sigma("sigma","sigma",1) ;
+  RooRealVar alpha("alpha","alpha",1.5) ;
+  RooRealVar n("n","n",2) ;
+
+  // Crystal ball model, which provides its maximum to the generator
+  RooCBShape cb("cb","cb",m,m0,sigma,alpha,n) ;
+  cb.specialGeneratorConfig(kTRUE)->method1D(kFALSE,kFALSE).setLabel("RooAcceptReject") ;
+  cb.specialGeneratorConfig()->method1D(kTRUE,kFALSE).setLabel("RooAcceptReject") ;
+
+  // Values of the mean, used as conditional observable
+  RooRandom::randomGenerator()->SetSeed(8100) ;
+  RooDataSet proto("proto","proto",m0) ;
+  for (Int_t i=0 ; i<2000 ; i++) {
+    m0.setVal(-2+4*RooRandom::uniform()) ;
+    proto.add(m0) ;
+  }
+  m0.setVal(0) ;
+
+  RooRandom::randomGenerator()->SetSeed(810) ;
+  RooDataSet* dc1 = cb.generate(m,5000) ;
+  RooRandom::randomGenerator()->SetSeed(810) ;
+  RooDataSet* dcc1 = cb.generate(m,ProtoData(proto)) ;
+
+  cb.specialGeneratorConfig()->getConfigSection("RooAcceptReject").setRealValue("batchSize",1000) ;
+
+  RooRandom::randomGenerator()->SetSeed(810) ;
+  RooDataSet* dc2 = cb.generate(m,5000) ;
+  RooRandom::randomGenerator()->SetSeed(810) ;
+  RooDataSet* dcc2 = cb.generate(m,ProtoData(proto)) ;
+
+  // With a known maximum the random numbers of the accept step are drawn with the trial samples
+  ok = sameEvents(*dc1,*dc2,"crystal ball") && ok ;
+  ok = sameEvents(*dcc1,*dcc2,"conditional crystal ball") && ok ;
+
+  delete dc1 ;
+  delete dc2 ;
+  delete dcc1 ;
+  delete dcc2 ;
+
+  RooPlot* frame = x.frame(Bins(40)) ;
+  dp2->plotOn(frame) ;
+  p.plotOn(frame) ;
+
+  regPlot(frame,"rf810_plot1") ;
+
+  delete dp1 ;
+  delete dp2 ;
+  delete dg1 ;
+  delete dg2 ;
+
+  return ok ;
+  }
+} ;
+
+
+//////////////////////////////////////////////////////////////////////////
+//
+// 'ADDITION AND CONVOLUTION' RooFit tutorial macro #811
+//
+// Reuse of FFT plans between FFT convolution cache elements
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooGaussian.h"
+#include "RooLandau.h"
+#include "RooFFTConvPdf.h"
+#include "TPluginManager.h"
+
+using namespace RooFit ;
+
+class TestBasic811 : public RooUnitTest
+{
+public:
+  TestBasic811(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("FFT convolution plan reuse",refFile,writeRef,verbose) {} ;
+
+  Bool_t isTestAvailable() {
+     // only if ROOT was build with fftw3 enabled
+     TString conffeatures = gROOT->GetConfigFeatures();
+     if(conffeatures.Contains("fftw3")) {
+        TPluginHandler *h;
+        if ((h = gROOT->GetPluginManager()->FindHandler("TVirtualFFT"))) {
+           if (h->LoadPlugin() == -1) {
+              gROOT->ProcessLine("new TNamed ;") ;
+              return kFALSE;
+           } else {
+              return kTRUE ;
+           }
+        }
+     }
+     return kFALSE ;
+  }
+
+  Bool_t testCode() {
+
+  // C o n s t r u c t   c o n v o l u t i o n   p d f
+  // ---------------------------------------------------
+
+  RooRealVar t("t","t",-10,30) ;
+  t.setBins(2000,"cache") ;
+
+  RooRealVar ml("ml","mean landau",5.,-20,20) ;
+  RooRealVar sl("sl","sigma landau",1,0.1,10) ;
+  RooLandau landau("lx","lx",t,ml,sl) ;
+
+  RooRealVar mg("mg","mg",0) ;
+  RooRealVar sg("sg","sg",2,0.1,10) ;
+  RooGaussian gauss("gauss","gauss",t,mg,sg) ;
+
+  RooFFTConvPdf* lxg = new RooFFTConvPdf("lxg","landau (X) gauss",t,landau,gauss) ;
+
+
+  // C o m p a r e   v a l u e s   c a l c u l a t e d   w i t h   n e w   a n d   r e u s e d   p l a n s
+  // ---------------------------------------------------------------------------------------------------------
+
+  RooFFTConvPdf::clearPlanCache() ;
+
+  const Int_t npoint = 5 ;
+  Double_t ref[npoint] ;
+  for (Int_t i=0 ; i<npoint ; i++) {
+    t.setVal(-5+7.5*i) ;
+    ref[i] = lxg->getVal(t) ;
+  }
+
+  // Deleting the p.d.f returns the plans of its cache to the pool, from which
+  // a new p.d.f with the same sampling size takes them
+  delete lxg ;
+  lxg = new RooFFTConvPdf("lxg2","landau (X) gauss",t,landau,gauss) ;
+
+  Bool_t ok(kTRUE) ;
+  for (Int_t i=0 ; i<npoint ; i++) {
+    t.setVal(-5+7.5*i) ;
+    if (lxg->getVal(t)!=ref[i]) {
+      cout << "TestBasic811: value " << lxg->getVal(t) << " with reused plans differs from " << ref[i] << endl ;
+      ok = kFALSE ;
+    }
+  }
+  delete lxg ;
+
+  // Measured plans may use a different algorithm, with results equal up to rounding
+  RooFFTConvPdf::setPlanningFlag("M") ;
+  lxg = new RooFFTConvPdf("lxg3","landau (X) gauss",t,landau,gauss) ;
+  for (Int_t i=0 ; i<npoint ; i++) {
+    t.setVal(-5+7.5*i) ;
+    if (fabs(lxg->getVal(t)-ref[i])>1e-9*fabs(ref[i])) {
+      cout << "TestBasic811: value " << lxg->getVal(t) << " with measured plans differs from " << ref[i] << endl ;
+      ok = kFALSE ;
+    }
+  }
+  delete lxg ;
+
+  RooFFTConvPdf::setPlanningFlag("ES") ;
+
+
+  // C o m p a r e   s e q u e n t i a l   a n d   p a r a l l e l   s a m p l i n g
+  // -------------------------------------------------------------------------------------
+
+#ifdef R__USE_IMT
+  RooFFTConvPdf lxgSeq("lxgSeq","landau (X) gauss",t,landau,gauss) ;
+  RooFFTConvPdf lxgMT("lxgMT","landau (X) gauss",t,landau,gauss) ;
+
+  // The first filling of a cache is always sequential
+  t.setVal(0) ;
+  lxgSeq.getVal(t) ;
+  lxgMT.getVal(t) ;
+
+  for (Int_t j=0 ; j<3 ; j++) {
+    sg.setVal(1.5+0.75*j) ;
+    for (Int_t i=0 ; i<npoint ; i++) {
+      t.setVal(-5+7.5*i) ;
+      ref[i] = lxgSeq.getVal(t) ;
+    }
+
+    // The two input p.d.f.s are sampled and transformed concurrently
+    ROOT::EnableImplicitMT(4) ;
+    for (Int_t i=0 ; i<npoint ; i++) {
+      t.setVal(-5+7.5*i) ;
+      if (fabs(lxgMT.getVal(t)-ref[i])>1e-12*fabs(ref[i])) {
+	cout << "TestBasic811: value " << lxgMT.getVal(t) << " with parallel sampling differs from " << ref[i] << endl ;
+	ok = kFALSE ;
+      }
+    }
+    ROOT::DisableImplicitMT() ;
+  }
+  sg.setVal(2) ;
+#endif
+
+  RooFFTConvPdf::clearPlanCache() ;
+
+  return ok ;
+  }
+} ;
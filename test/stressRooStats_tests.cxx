@@ -1755,6 +1755,89 @@ public:
 };
 
 
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// TOY MC SAMPLER - LOCAL WORKER PROCESSES - ON / OFF MODEL
+//
+// This test generates the sampling distribution of the profile likelihood
+// ratio on the On / Off model in several local worker processes (see
+// ToyMCSampler::SetNWorkers). The toys of all the workers must be returned
+// and, for a given seed of RooRandom, two runs must give exactly the same
+// sampling distribution. No reference values are needed.
+//
+// ModelConfig (explicit) : On / Off Model
+//    built in stressRooStats_models.cxx
+//
+// Input Parameters:
+//    nWorkers -> number of worker processes
+//    nToys -> number of toys
+//
+///////////////////////////////////////////////////////////////////////////////
+
+class TestToyMCSamplerWorkers : public RooUnitTest {
+private:
+   Int_t fNWorkers;
+   Int_t fNToys;
+
+public:
+   TestToyMCSamplerWorkers(TFile* refFile, Bool_t writeRef, Int_t verbose, Int_t nWorkers = 2, Int_t nToys = 200) :
+      RooUnitTest(TString::Format("ToyMCSampler - %d Worker Processes - On / Off Model", nWorkers), refFile, writeRef, verbose),
+      fNWorkers(nWorkers),
+      fNToys(nToys)
+   {};
+
+   Bool_t testCode() {
+
+      // build workspace and model
+      RooWorkspace* w = new RooWorkspace("w");
+      buildOnOffModel(w);
+      ModelConfig *sbModel = (ModelConfig *)w->obj("S+B");
+
+      w->var("n_on")->setVal(150);
+      w->var("n_off")->setVal(100);
+      w->var("tau")->setVal(1.0);
+      w->var("tau")->setConstant();
+      w->var("bkg")->setVal(100);
+      w->var("sig")->setVal(50);
+
+      ProfileLikelihoodTestStat *plts = new ProfileLikelihoodTestStat(*sbModel->GetPdf());
+      ToyMCSampler *tmcs = new ToyMCSampler(*plts, fNToys);
+      tmcs->SetPdf(*sbModel->GetPdf());
+      tmcs->SetObservables(*sbModel->GetObservables());
+      tmcs->SetParametersForTestStat(*sbModel->GetParametersOfInterest());
+      tmcs->SetNEventsPerToy(1);
+      tmcs->SetNWorkers(fNWorkers);
+
+      RooArgSet paramPoint(*sbModel->GetParametersOfInterest(), *sbModel->GetNuisanceParameters());
+
+      RooRandom::randomGenerator()->SetSeed(4357);
+      SamplingDistribution *sd1 = tmcs->GetSamplingDistribution(paramPoint);
+      RooRandom::randomGenerator()->SetSeed(4357);
+      SamplingDistribution *sd2 = tmcs->GetSamplingDistribution(paramPoint);
+
+      Bool_t ok = sd1 && sd2;
+      if (ok && (Int_t)sd1->GetSamplingDistribution().size() != fNToys) {
+         if (_verb >= 0) Error("testCode", "%d toys were requested, %d were returned",
+                                  fNToys, (Int_t)sd1->GetSamplingDistribution().size());
+         ok = kFALSE;
+      }
+      if (ok && sd1->GetSamplingDistribution() != sd2->GetSamplingDistribution()) {
+         if (_verb >= 0) Error("testCode", "two runs with the same seed give different sampling distributions");
+         ok = kFALSE;
+      }
+
+      // cleanup
+      delete sd1;
+      delete sd2;
+      delete tmcs;
+      delete plts;
+      delete w;
+
+      return ok ;
+   }
+};
+
 //
 // END OF PART FIVE
 //
@@ -1948,6 +1948,10 @@ namespace UnitTesting
      MethodUnitTestWithROCLimits(const MethodUnitTestWithROCLimits&);
      MethodUnitTestWithROCLimits& operator=(const MethodUnitTestWithROCLimits&);
   };
+
+  // true if the flattened forest of a BDT gives the same tree responses on
+  // the test events as the trees evaluated node by node
+  bool flatForestAgreesWithTrees(TMVA::MethodBase* method);
 } // namespace UnitTesting
 #endif // METHODUNITTESTWITHROCLIMITS_H
 // including file tmvaut/MethodUnitTestWithROCLimits.cxx
@@ -1957,6 +1961,9 @@ namespace UnitTesting
 #include "TSystem.h"
 #include "TMath.h"
 #include "TMVA/MethodBase.h"
+#include "TMVA/MethodBDT.h"
+#include "TMVA/DecisionTree.h"
+#include "TMVA/FlatForest.h"
 #include "TMVA/Reader.h"
 #include <iostream>
 #include <fstream>
@@ -1966,6 +1973,35 @@ using namespace std;
 using namespace UnitTesting;
 using namespace TMVA;
 
+bool UnitTesting::flatForestAgreesWithTrees(MethodBase* method)
+{
+   MethodBDT* bdt = dynamic_cast<MethodBDT*>(method);
+   if (bdt == 0) return false;
+
+   const std::vector<DecisionTree*>& forest = bdt->GetForest();
+   FlatForest flat(forest);
+   if (!flat.IsValid()) return true; // such forests are evaluated node by node anyway
+   if (flat.GetNTrees() != forest.size()) return false;
+
+   DataSet* data = bdt->Data();
+   data->SetCurrentType(Types::kTesting);
+   std::vector<Float_t> x(bdt->GetNvar());
+   for (Long64_t ievt=0; ievt<data->GetNEvents(); ievt++) {
+      data->SetCurrentEvent(ievt);
+      const Event* ev = bdt->GetEvent();
+      for (UInt_t ivar=0; ivar<x.size(); ivar++) x[ivar] = ev->GetValue(ivar);
+      for (UInt_t itree=0; itree<forest.size(); itree++) {
+         if (flat.GetResponse(itree, &x[0], kFALSE) != forest[itree]->CheckEvent(ev, kFALSE) ||
+             flat.GetResponse(itree, &x[0], kTRUE)  != forest[itree]->CheckEvent(ev, kTRUE)) {
+            std::cout << "failure in " << bdt->GetMethodName() << ": flat and node by node response of tree "
+                      << itree << " differ for test event " << ievt << std::endl;
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
 MethodUnitTestWithROCLimits::MethodUnitTestWithROCLimits(const Types::EMVA& theMethod, const TString& methodTitle, const TString& theOption,
                                                          double lowLimit, double upLimit,
                                                          const std::string & /* xname */ ,const std::string & /* filename */ , std::ostream* /* sptr */ ) :
@@ -2080,6 +2116,7 @@ void MethodUnitTestWithROCLimits::run()
      }
      test_(ROCIntegralWithinInterval());
   }
+  if (_methodType == TMVA::Types::kBDT) test_(flatForestAgreesWithTrees(_theMethod));
   outputFile->Close();
   delete dataloader; 
   delete factory;
@@ -2224,6 +2261,25 @@ void MethodUnitTestWithROCLimits::run()
      }
 
   }
+
+  // batch evaluation must agree with the event by event evaluation
+  if (_methodType!=Types::kCuts){
+     const UInt_t nvar = _VariableNames->size();
+     vector<float>  batchInput(nevt*nvar);
+     vector<double> batchVal(nevt), singleVal(nevt);
+     for (Long64_t ievt=0;ievt<nevt;ievt++) {
+        testTree->GetEntry(ievt);
+        for (UInt_t i=0;i<nvar;i++){
+           batchInput[ievt*nvar+i]= testvar[i];
+           testvarFloat[i]= testvar[i];
+        }
+        singleVal[ievt]=reader[1]->EvaluateMVA( testvarFloat, readerName);
+     }
+     reader[1]->EvaluateMVA( &batchInput[0], nevt, &batchVal[0], readerName );
+     double batchdiff=0.;
+     for (Long64_t ievt=0;ievt<nevt;ievt++) batchdiff = TMath::Max(batchdiff, TMath::Abs(batchVal[ievt]-singleVal[ievt]));
+     test_(batchdiff <1.e-4);
+  }
   Bool_t ok=false;
   sumdiff=sumdiff/nevt;
   if (_methodType!=Types::kCuts){
@@ -2496,6 +2552,7 @@ void RegressionUnitTestWithDeviation::run()
         << _upper90PercentDeviationLimit << endl;
    }
    test_(DeviationWithinLimits());
+   if (_methodType == TMVA::Types::kBDT) test_(flatForestAgreesWithTrees(_theMethod));
 
    outputFile->Close();
    delete dataloader; 
@@ -2827,6 +2884,337 @@ bool MethodUnitTestWithComplexData::create_data(const char* filename, int nmax)
    dataFile->Close();
    return true;
 }
+// including file tmvaut/utModulekNN.h
+#ifndef UTMODULEKNN_H
+#define UTMODULEKNN_H
+
+// TMVA unit tests
+//
+// this class compares the nearest neighbours found by the flat copy of the
+// kd-tree of ModulekNN with the ones of the recursive search on the tree
+
+#include <string>
+#include <iostream>
+#include <vector>
+
+#include "TMVA/ModulekNN.h"
+
+
+
+namespace UnitTesting
+{
+  class utModulekNN : public UnitTest
+  {
+  public:
+    utModulekNN();
+    virtual ~utModulekNN();
+
+    virtual void run();
+
+  private:
+     // sorted distances of the neighbours in the list
+     static std::vector<TMVA::kNN::VarType> distances(const TMVA::kNN::List& list);
+
+     // disallow copy constructor and assignment
+     utModulekNN(const utModulekNN&);
+     utModulekNN& operator=(const utModulekNN&);
+  };
+} // namespace UnitTesting
+#endif // UTMODULEKNN_H
+// including file tmvaut/utModulekNN.cxx
+
+#include <algorithm>
+
+#include "TMath.h"
+#include "TRandom3.h"
+
+using namespace std;
+using namespace UnitTesting;
+using namespace TMVA;
+
+utModulekNN::utModulekNN()
+   : UnitTest(string("ModulekNN"))
+{
+}
+
+utModulekNN::~utModulekNN(){ }
+
+std::vector<kNN::VarType> utModulekNN::distances(const kNN::List& list)
+{
+   std::vector<kNN::VarType> dist;
+   for (kNN::List::const_iterator it = list.begin(); it != list.end(); ++it) dist.push_back(it->second);
+   std::sort(dist.begin(), dist.end());
+   return dist;
+}
+
+void utModulekNN::run()
+{
+   const UInt_t nvar = 4, nevt = 2000, nquery = 100, nfind = 20;
+   TRandom3 rnd(4357);
+
+   kNN::ModulekNN module;
+   kNN::VarVec vars(nvar);
+   for (UInt_t ievt=0; ievt<nevt; ievt++) {
+      const Short_t type = (ievt%2 == 0) ? 1 : 2;
+      for (UInt_t ivar=0; ivar<nvar; ivar++) vars[ivar] = rnd.Gaus(type == 1 ? 0.5 : -0.5, 1.0 + ivar);
+      module.Add(kNN::Event(vars, 1.0, type));
+   }
+   test_(module.Fill(6, 80, "metric"));
+
+   for (UInt_t iquery=0; iquery<nquery; iquery++) {
+      for (UInt_t ivar=0; ivar<nvar; ivar++) vars[ivar] = rnd.Gaus(0.0, 2.0);
+      const kNN::Event query(vars, 1.0, 1);
+
+      kNN::List flat, recursive;
+      test_(module.Find(query, nfind, flat));
+      test_(module.Find(query, nfind, recursive, "recursive"));
+      test_(flat.size() == nfind && recursive.size() == nfind);
+
+      // ties may select different events, but not different distances
+      const std::vector<kNN::VarType> flatDist = distances(flat), recursiveDist = distances(recursive);
+      bool same = flatDist.size() == recursiveDist.size();
+      for (UInt_t i=0; same && i<flatDist.size(); i++) {
+         same = TMath::Abs(flatDist[i] - recursiveDist[i]) <= 1.e-5*TMath::Max(1.0f, TMath::Abs(recursiveDist[i]));
+      }
+      if (!same) std::cout << "failure in ModulekNN: flat and recursive search differ for query " << iquery << std::endl;
+      test_(same);
+   }
+}
+// including file tmvaut/MethodUnitTestWithSameResponse.h
+#ifndef METHODUNITTESTWITHSAMERESPONSE_H
+#define METHODUNITTESTWITHSAMERESPONSE_H
+
+// TMVA unit tests
+//
+// this class trains the same methods on the toy data with two setups, for
+// example with and without multi-threading, and requires the responses of the
+// methods on the test events to agree
+
+#include <string>
+#include <iostream>
+#include <vector>
+
+#include "TString.h"
+
+#include "TMVA/MethodBase.h"
+#include "TMVA/Types.h"
+
+
+
+namespace UnitTesting
+{
+  // options of one of the two trainings
+  struct TrainingSetup
+  {
+     TrainingSetup(const TString& factoryOptions = "", const TString& prepareOptions = "",
+                   const TString& methodOptions = "", bool implicitMT = false)
+        : fFactoryOptions(factoryOptions), fPrepareOptions(prepareOptions),
+          fMethodOptions(methodOptions), fImplicitMT(implicitMT) {}
+
+     TString fFactoryOptions;  // added to the factory options
+     TString fPrepareOptions;  // added to the options of PrepareTrainingAndTestTree
+     TString fMethodOptions;   // added to the options of all methods
+     bool    fImplicitMT;      // train and test with ROOT::EnableImplicitMT
+  };
+
+  class MethodUnitTestWithSameResponse : public UnitTest
+  {
+  public:
+    MethodUnitTestWithSameResponse(const std::string& name, const TrainingSetup& reference, const TrainingSetup& setup,
+                                   double tolerance = 1.e-6);
+    virtual ~MethodUnitTestWithSameResponse();
+
+    void addMethod(const TMVA::Types::EMVA& theMethod, const TString& methodTitle, const TString& theOption);
+
+    virtual void run();
+
+  private:
+     TrainingSetup _reference;
+     TrainingSetup _setup;
+     double _tolerance;
+
+     std::vector<TMVA::Types::EMVA> _methodTypes;
+     std::vector<TString> _methodTitles;
+     std::vector<TString> _methodOptions;
+
+     // responses of each method on the test events, for cuts the cut values
+     // at a few signal efficiencies
+     bool train(const TrainingSetup& setup, std::vector< std::vector<Double_t> >& responses);
+     bool sameValue(Double_t a, Double_t b) const;
+
+     // disallow copy constructor and assignment
+     MethodUnitTestWithSameResponse(const MethodUnitTestWithSameResponse&);
+     MethodUnitTestWithSameResponse& operator=(const MethodUnitTestWithSameResponse&);
+  };
+} // namespace UnitTesting
+#endif // METHODUNITTESTWITHSAMERESPONSE_H
+// including file tmvaut/MethodUnitTestWithSameResponse.cxx
+
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TMath.h"
+#include "TCut.h"
+#include "RConfigure.h"
+#include "TMVA/DataLoader.h"
+#include "TMVA/MethodCuts.h"
+#include "TMVA/ResultsClassification.h"
+
+using namespace std;
+using namespace UnitTesting;
+using namespace TMVA;
+
+MethodUnitTestWithSameResponse::MethodUnitTestWithSameResponse(const std::string& name, const TrainingSetup& reference,
+                                                               const TrainingSetup& setup, double tolerance)
+   : UnitTest(name, __FILE__), _reference(reference), _setup(setup), _tolerance(tolerance)
+{
+}
+
+MethodUnitTestWithSameResponse::~MethodUnitTestWithSameResponse()
+{
+}
+
+void MethodUnitTestWithSameResponse::addMethod(const Types::EMVA& theMethod, const TString& methodTitle, const TString& theOption)
+{
+   _methodTypes.push_back(theMethod);
+   _methodTitles.push_back(methodTitle);
+   _methodOptions.push_back(theOption);
+}
+
+bool MethodUnitTestWithSameResponse::sameValue(Double_t a, Double_t b) const
+{
+   return TMath::Abs(a - b) <= _tolerance*TMath::Max(1.0, TMath::Max(TMath::Abs(a), TMath::Abs(b)));
+}
+
+bool MethodUnitTestWithSameResponse::train(const TrainingSetup& setup, std::vector< std::vector<Double_t> >& responses)
+{
+   TFile* outputFile = TFile::Open( "weights/TMVASameResponse.root", "RECREATE" );
+   if (!outputFile) return false;
+
+   TString factoryOptions( "!V:Silent:AnalysisType=Classification:!Color:!DrawProgressBar" );
+   if (setup.fFactoryOptions != "") factoryOptions += ":" + setup.fFactoryOptions;
+   Factory* factory = new Factory( "TMVASameResponse", outputFile, factoryOptions );
+   DataLoader* dataloader = new DataLoader("dataset");
+   dataloader->AddVariable( "myvar1 := var1+var2", 'F' );
+   dataloader->AddVariable( "myvar2 := var1-var2", "Expression 2", "", 'F' );
+   dataloader->AddVariable( "var3", "Variable 3", "units", 'F' );
+   dataloader->AddVariable( "var4", "Variable 4", "units", 'F' );
+
+   TFile* input(0);
+   FileStat_t stat;
+   TString fname = "../tmva/test/data/toy_sigbkg.root";
+   const char *fcname = gSystem->ExpandPathName("$ROOTSYS/tmva/test/data/toy_sigbkg.root");
+   if(!gSystem->GetPathInfo(fname,stat)) {
+      input = TFile::Open( fname );
+   } else if(!gSystem->GetPathInfo("../"+fname,stat)) {
+      input = TFile::Open( "../"+fname );
+   } else if(fcname && !gSystem->GetPathInfo(fcname,stat)) {
+      input = TFile::Open( fcname );
+   } else {
+      input = TFile::Open( "http://root.cern.ch/files/tmva_class_example.root" );
+   }
+   delete [] fcname;
+   if (input == NULL) {
+      cerr << "broken/inaccessible input file" << endl;
+      delete dataloader;
+      delete factory;
+      delete outputFile;
+      return false;
+   }
+
+   dataloader->AddSignalTree( (TTree*)input->Get("TreeS") );
+   dataloader->AddBackgroundTree( (TTree*)input->Get("TreeB") );
+   dataloader->SetBackgroundWeightExpression("weight");
+
+   TString prepareOptions( "nTrain_Signal=1000:nTrain_Background=1000:nTest_Signal=2000:nTest_Background=2000:SplitMode=Random:NormMode=NumEvents:!V" );
+   if (setup.fPrepareOptions != "") prepareOptions += ":" + setup.fPrepareOptions;
+   dataloader->PrepareTrainingAndTestTree( TCut(""), TCut(""), prepareOptions );
+
+   for (UInt_t imethod=0; imethod<_methodTypes.size(); imethod++) {
+      TString option = _methodOptions[imethod];
+      if (setup.fMethodOptions != "") option += ":" + setup.fMethodOptions;
+      factory->BookMethod(dataloader, _methodTypes[imethod], _methodTitles[imethod], option);
+   }
+
+#ifdef R__USE_IMT
+   if (setup.fImplicitMT) ROOT::EnableImplicitMT(4);
+#endif
+   factory->TrainAllMethods();
+   factory->TestAllMethods();
+#ifdef R__USE_IMT
+   if (setup.fImplicitMT) ROOT::DisableImplicitMT();
+#endif
+
+   bool ok = true;
+   responses.assign(_methodTypes.size(), std::vector<Double_t>());
+   for (UInt_t imethod=0; imethod<_methodTypes.size(); imethod++) {
+      MethodBase* mva = dynamic_cast<MethodBase*>(factory->GetMethod(dataloader->GetName(), _methodTitles[imethod]));
+      if (mva == 0) { ok = false; continue; }
+      std::vector<Double_t>& response = responses[imethod];
+
+      if (_methodTypes[imethod] == Types::kCuts) {
+         MethodCuts* cuts = dynamic_cast<MethodCuts*>(mva);
+         std::vector<Double_t> cutMin, cutMax;
+         const Double_t effS[] = { 0.2, 0.5, 0.8 };
+         for (UInt_t ieff=0; ieff<3; ieff++) {
+            cuts->GetCuts(effS[ieff], cutMin, cutMax);
+            response.insert(response.end(), cutMin.begin(), cutMin.end());
+            response.insert(response.end(), cutMax.begin(), cutMax.end());
+         }
+         continue;
+      }
+
+      // the responses stored by TestAllMethods come from the batched
+      // evaluation, and must agree with the evaluation event by event
+      ResultsClassification* results = dynamic_cast<ResultsClassification*>
+         ( mva->Data()->GetResults(mva->GetMethodName(), Types::kTesting, Types::kClassification) );
+      const std::vector<Float_t>* stored = results ? results->GetValueVector() : 0;
+
+      DataSet* data = mva->Data();
+      data->SetCurrentType(Types::kTesting);
+      if (stored == 0 || stored->size() != UInt_t(data->GetNEvents())) {
+         std::cout << "failure in " << _methodTitles[imethod] << ": no stored test responses" << std::endl;
+         ok = false;
+      }
+      for (Long64_t ievt=0; ievt<data->GetNEvents(); ievt++) {
+         data->SetCurrentEvent(ievt);
+         response.push_back( mva->GetMvaValue() );
+         if (ok && stored && TMath::Abs(response.back() - (*stored)[ievt]) > 1.e-5*TMath::Max(1.0, TMath::Abs(response.back()))) {
+            std::cout << "failure in " << _methodTitles[imethod] << ": batched and single response differ for test event "
+                      << ievt << ", " << (*stored)[ievt] << " != " << response.back() << std::endl;
+            ok = false;
+         }
+      }
+   }
+
+   outputFile->Close();
+   delete dataloader;
+   delete factory;
+   delete outputFile;
+   input->Close();
+   delete input;
+
+   return ok;
+}
+
+void MethodUnitTestWithSameResponse::run()
+{
+   std::vector< std::vector<Double_t> > reference, responses;
+   test_(train(_reference, reference));
+   test_(train(_setup, responses));
+   test_(reference.size() == responses.size());
+
+   for (UInt_t imethod=0; imethod<reference.size() && imethod<responses.size(); imethod++) {
+      bool same = reference[imethod].size() == responses[imethod].size() && !reference[imethod].empty();
+      for (UInt_t i=0; same && i<reference[imethod].size(); i++) {
+         same = sameValue(reference[imethod][i], responses[imethod][i]);
+         if (!same) std::cout << "failure in " << _methodTitles[imethod] << " (" << name() << "): response " << i
+                              << " differs, " << reference[imethod][i] << " != " << responses[imethod][i] << std::endl;
+      }
+      test_(same);
+   }
+}
+
 // including file stressTMVA.cxx
 // Authors: Christoph Rosemann, Eckhard von Toerne   July 2010
 // TMVA unit tests
@@ -2915,6 +3303,8 @@ void addClassificationTests( UnitTestSuite& TMVA_test, bool full=true)
                                                       "!H:!V:NTrees=400:BoostType=Grad:Shrinkage=0.30:UseBaggedBoost:GradBaggingFraction=0.6:SeparationType=GiniIndex:nCuts=20:MaxDepth=2" , 0.88, 0.98) );
    TMVA_test.addTest(new MethodUnitTestWithROCLimits( TMVA::Types::kBDT, "BDT",
                                                       "!H:!V:NTrees=400:nEventsMin=100:MaxDepth=3:BoostType=AdaBoost:SeparationType=GiniIndex:nCuts=10:PruneMethod=NoPruning" , 0.88, 0.98) );
+   TMVA_test.addTest(new MethodUnitTestWithROCLimits( TMVA::Types::kBDT, "BDTGBinned",
+                                                      "!H:!V:NTrees=400:BoostType=Grad:Shrinkage=0.30:UseBaggedBoost:GradBaggingFraction=0.6:SeparationType=GiniIndex:nCuts=40:MaxDepth=2:UseBinnedTraining" , 0.88, 0.98) );
    if (full) TMVA_test.addTest(new MethodUnitTestWithROCLimits( TMVA::Types::kBDT, "BDTB",
                                                                 "!H:!V:NTrees=400:nEventsMin=100:BoostType=Bagging:SeparationType=GiniIndex:nCuts=20:PruneMethod=NoPruning" , 0.8, 0.98) );
    if (full) TMVA_test.addTest(new MethodUnitTestWithROCLimits( TMVA::Types::kBDT, "BDTD",
@@ -2990,6 +3380,54 @@ void addComplexClassificationTests( UnitTestSuite& TMVA_test, bool full=true )
    TMVA_test.addTest(new MethodUnitTestWithComplexData(trees, prep, TMVA::Types::kSVM, "SVM", "Gamma=0.4:Tol=0.001" , 0.955, 0.975) );
 }
 
+void addSameResponseTests( UnitTestSuite& TMVA_test )
+{
+   const TString bdtString = "!H:!V:NTrees=50:MinNodeSize=5%:MaxDepth=3:BoostType=AdaBoost:SeparationType=GiniIndex:nCuts=20";
+
+   // transformations applied to the columns of the data set
+   MethodUnitTestWithSameResponse* columns = new MethodUnitTestWithSameResponse( "ColumnStorage",
+      TrainingSetup(), TrainingSetup("", "ColumnStorage"), 1.e-5 );
+   columns->addMethod( TMVA::Types::kLD, "LDNP", "H:!V:VarTransform=N,P" );
+   columns->addMethod( TMVA::Types::kLikelihood, "LikelihoodN",
+                       "!H:!V:!TransformOutput:PDFInterpol=Spline2:NSmooth=5:NAvEvtPerBin=50:VarTransform=N" );
+   columns->addMethod( TMVA::Types::kLD, "LDG", "H:!V:VarTransform=G" );
+   columns->addMethod( TMVA::Types::kBDT, "BDT", bdtString );
+   TMVA_test.addTest(columns);
+
+   // methods trained concurrently, cuts with MINUIT stay sequential
+   MethodUnitTestWithSameResponse* parallel = new MethodUnitTestWithSameResponse( "ParallelTraining",
+      TrainingSetup(), TrainingSetup("ParallelTraining") );
+   parallel->addMethod( TMVA::Types::kLD, "LD", "!H:!V" );
+   parallel->addMethod( TMVA::Types::kLikelihood, "Likelihood",
+                        "!H:!V:!TransformOutput:PDFInterpol=Spline2:NSmooth=5:NAvEvtPerBin=50" );
+   parallel->addMethod( TMVA::Types::kBDT, "BDT", bdtString );
+   parallel->addMethod( TMVA::Types::kKNN, "KNN", "H:nkNN=20:ScaleFrac=0.8:SigmaFact=1.0:Kernel=Gaus:UseKernel=F:UseWeight=T:!Trim" );
+   parallel->addMethod( TMVA::Types::kCuts, "CutsGA",
+                        "!H:!V:FitMethod=GA:EffSel:Steps=20:Cycles=2:PopSize=100:SC_steps=10:SC_rate=5:SC_factor=0.95" );
+   TMVA_test.addTest(parallel);
+
+   // batched kNN search under implicit multi-threading
+   MethodUnitTestWithSameResponse* knn = new MethodUnitTestWithSameResponse( "kNNBatch",
+      TrainingSetup(), TrainingSetup("", "", "", true) );
+   knn->addMethod( TMVA::Types::kKNN, "KNN", "H:nkNN=20:ScaleFrac=0.8:SigmaFact=1.0:Kernel=Gaus:UseKernel=F:UseWeight=T:!Trim" );
+   TMVA_test.addTest(knn);
+
+   // a kernel cache of 1 MB cannot hold the kernel matrix of the training sample
+   MethodUnitTestWithSameResponse* svm = new MethodUnitTestWithSameResponse( "SVMKernelCache",
+      TrainingSetup(), TrainingSetup("", "", "KernelCacheSize=1") );
+   svm->addMethod( TMVA::Types::kSVM, "SVM", "Gamma=0.25:Tol=0.001:VarTransform=Norm" );
+   TMVA_test.addTest(svm);
+
+   // fitters evaluating the estimator for several parameter sets at once
+   MethodUnitTestWithSameResponse* cuts = new MethodUnitTestWithSameResponse( "CutsIMT",
+      TrainingSetup(), TrainingSetup("", "", "", true) );
+   cuts->addMethod( TMVA::Types::kCuts, "CutsGA",
+                    "!H:!V:FitMethod=GA:EffSel:Steps=20:Cycles=2:PopSize=100:SC_steps=10:SC_rate=5:SC_factor=0.95" );
+   cuts->addMethod( TMVA::Types::kCuts, "CutsSA",
+                    "!H:!V:FitMethod=SA:EffSel:MaxCalls=5000:Chains=4:KernelTemp=IncAdaptive:InitialTemp=1e+6:MinTemp=1e-6:Eps=1e-10:UseDefaultScale" );
+   TMVA_test.addTest(cuts);
+}
+
 //#include <fenv.h>
 
 int main(int argc, char **argv)
@@ -3018,11 +3456,13 @@ int main(int argc, char **argv)
    TMVA_test.addTest(new utFactory);
    TMVA_test.addTest(new utReader);
    TMVA_test.addTest(new utReaderMT);
+   TMVA_test.addTest(new utModulekNN);
 
    addClassificationTests(TMVA_test, full);
    addRegressionTests(TMVA_test, full);
    addDataInputTests(TMVA_test, full);
    addComplexClassificationTests(TMVA_test, full);
+   addSameResponseTests(TMVA_test);
 
    // run all
    ROOT::EnableThreadSafety();
@@ -85,7 +85,7 @@ include/TMVA/%.icc: $(TMVADIRI)/TMVA/%.icc
 $(TMVALIB):     $(TMVAO) $(TMVADO) $(ORDER_) $(MAINLIBS) $(TMVALIBDEP)
 		@$(MAKELIB) $(PLATFORM) $(LD) "$(LDFLAGS)" \
 		   "$(SOFLAGS)" libTMVA.$(SOEXT) $@ "$(TMVAO) $(TMVADO)" \
-		   "$(OSTHREADLIBDIR) $(OSTHREADLIB) $(TMVALIBEXTRA)"
+		   "$(OSTHREADLIBDIR) $(OSTHREADLIB) $(TMVALIBEXTRA) $(TBBLIBDIR) $(TBBLIB)"
 
 $(call pcmrule,TMVA)
 	$(noop)
@@ -112,3 +112,8 @@ distclean-$(MODNAME): clean-$(MODNAME)
 		@rm -rf include/TMVA
 
 distclean::     distclean-$(MODNAME)
+
+##### extra rules ######
+ifeq ($(BUILDTBB),yes)
+$(TMVAO): CXXFLAGS += $(TBBINCDIR:%=-I%)
+endif
@@ -0,0 +1,83 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : BinnedEventSample                                                     *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Training events with their variables binned once on a fixed grid, stored *
+ *      column by column, used for histogram based decision tree training        *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#ifndef ROOT_TMVA_BinnedEventSample
+#define ROOT_TMVA_BinnedEventSample
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// BinnedEventSample                                                    //
+//                                                                      //
+// Bin indices of the variables of a set of training events             //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+namespace TMVA {
+
+   class Event;
+   class DataSetInfo;
+   class MsgLogger;
+
+   class BinnedEventSample {
+
+   public:
+
+      // maximum number of bins per variable (bin indices are stored in one byte)
+      static const UInt_t fgMaxBins = 256;
+
+      BinnedEventSample( const std::vector<const TMVA::Event*>& events, const DataSetInfo& dsi,
+                         UInt_t nvars, UInt_t nBins );
+      ~BinnedEventSample();
+
+      UInt_t GetNVariables() const { return fEdges.size(); }
+      UInt_t GetNEvents() const { return fNEvents; }
+
+      // number of bins of variable ivar and position of its first bin in the
+      // concatenation of the histograms of all variables
+      UInt_t GetNBins( UInt_t ivar ) const { return fEdges[ivar].size()+1; }
+      UInt_t GetOffset( UInt_t ivar ) const { return fOffsets[ivar]; }
+      UInt_t GetNTotalBins() const { return fOffsets.back(); }
+
+      // cut separating bins 0..ibin from the higher bins: the events in the
+      // higher bins are exactly those with a value >= GetCutValue(ivar,ibin)
+      Float_t GetCutValue( UInt_t ivar, UInt_t ibin ) const { return fEdges[ivar][ibin]; }
+
+      // bin indices of variable ivar for all events, indexed by row: the
+      // position of the event in the vector the sample was built from
+      const UChar_t* GetColumn( UInt_t ivar ) const { return &fBins[ivar][0]; }
+
+   private:
+
+      MsgLogger& Log() const { return *fLogger; }
+
+      std::vector< std::vector<UChar_t> > fBins;   // bin index of each event, column by column
+      std::vector< std::vector<Float_t> > fEdges;  // lower edges of the bins 1..nBins-1 of each variable
+      std::vector<UInt_t>                 fOffsets; // first bin of each variable in a concatenated histogram
+      UInt_t                              fNEvents; // number of binned events
+
+      mutable MsgLogger* fLogger;                   // message logger
+   };
+
+} // namespace TMVA
+
+#endif
@@ -128,8 +128,7 @@ namespace TMVA {
       Bool_t fWriteOptionsReference; // if set true: Configurable objects write file with option reference
       Bool_t fDrawProgressBar;       // draw progress bar to indicate training evolution
 #endif
-      mutable MsgLogger* fLogger;   // message logger
-      MsgLogger& Log() const { return *fLogger; }
+      MsgLogger& Log() const;
          
       ClassDef(Config,0); // Singleton class for global configuration settings
    };
@@ -40,6 +40,7 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <atomic>
 
 #ifndef ROOT_TObject
 #include "TObject.h"
@@ -69,6 +70,9 @@
 #ifndef ROOT_TMVA_VariableInfo
 #include "TMVA/VariableInfo.h"
 #endif
+#ifndef ROOT_TMVA_EventColumns
+#include "TMVA/EventColumns.h"
+#endif
 
 namespace TMVA {
 
@@ -92,12 +96,12 @@ namespace TMVA {
 
       // const getters
       const Event*    GetEvent()                        const; // returns event without transformations
-      const Event*    GetEvent        ( Long64_t ievt ) const { fCurrentEventIdx = ievt; return GetEvent(); } // returns event without transformations
+      const Event*    GetEvent        ( Long64_t ievt ) const { CurrentEventIdx() = ievt; return GetEvent(); } // returns event without transformations
       const Event*    GetTrainingEvent( Long64_t ievt ) const { return GetEvent(ievt, Types::kTraining); }
       const Event*    GetTestEvent    ( Long64_t ievt ) const { return GetEvent(ievt, Types::kTesting); }
       const Event*    GetEvent        ( Long64_t ievt, Types::ETreeType type ) const 
       {
-         fCurrentTreeIdx = TreeIndex(type); fCurrentEventIdx = ievt; return GetEvent();
+         CurrentTreeIdx() = TreeIndex(type); CurrentEventIdx() = ievt; return GetEvent();
       }
 
 
@@ -107,14 +111,25 @@ namespace TMVA {
       UInt_t    GetNTargets()     const;
       UInt_t    GetNSpectators()  const;
 
-      void      SetCurrentEvent( Long64_t ievt         ) const { fCurrentEventIdx = ievt; }
-      void      SetCurrentType ( Types::ETreeType type ) const { fCurrentTreeIdx = TreeIndex(type); }
+      void      SetCurrentEvent( Long64_t ievt         ) const { CurrentEventIdx() = ievt; }
+      void      SetCurrentType ( Types::ETreeType type ) const { CurrentTreeIdx() = TreeIndex(type); }
       Types::ETreeType GetCurrentType() const;
 
+      // while set, each thread has its own current tree type and event (used by the
+      // Factory to train and test several methods on the same dataset concurrently)
+      static void   SetMultiThreaded( Bool_t mt );
+      static Bool_t IsMultiThreaded() { return fgMultiThreaded; }
+
       void                       SetEventCollection( std::vector<Event*>*, Types::ETreeType );
       const std::vector<Event*>& GetEventCollection( Types::ETreeType type = Types::kMaxTreeType ) const;
       const TTree*               GetEventCollectionAsTree();
 
+      // store the training and testing events in columns instead of Event objects;
+      // GetEvent() then returns a view of the row, valid until the next call in the
+      // same thread, and GetEventCollection() creates one view per row on first use
+      void           ConvertToColumns();
+      EventColumns*  GetEventColumns( Types::ETreeType type = Types::kMaxTreeType ) const;
+
       Long64_t  GetNEvtSigTest();
       Long64_t  GetNEvtBkgdTest();
       Long64_t  GetNEvtSigTrain();
@@ -161,12 +176,25 @@ namespace TMVA {
 
       std::vector<Event*>::iterator        fEvtCollIt;
       std::vector< std::vector<Event*>*  > fEventCollection; //! list of events for training/testing/...
+      std::vector< EventColumns* >         fEventColumns;    //! columnar storage of the events for training/testing/..., or 0
+      mutable std::atomic<Bool_t>          fHasViews[4];     //! the event collection holds the views of the columns
+      mutable Event*                       fEventView;       //! view returned by GetEvent() for columnar storage
+
+      void          CreateEventViews( UInt_t treeIdx ) const;
+      const Event*  GetEventView( UInt_t treeIdx, Long64_t ievt ) const;
+      Bool_t        UseEventView( UInt_t treeIdx ) const { return fEventColumns[treeIdx]!=0 && !fHasViews[treeIdx]; }
 
       std::vector< std::map< TString, Results* > > fResults;         //!  [train/test/...][method-identifier]
 
       mutable UInt_t             fCurrentTreeIdx;
       mutable Long64_t           fCurrentEventIdx;
 
+      static Bool_t              fgMultiThreaded;  // per-thread current tree type and event
+
+      UInt_t&   CurrentTreeIdx()  const { return fgMultiThreaded ? ThreadCursor().first  : fCurrentTreeIdx;  }
+      Long64_t& CurrentEventIdx() const { return fgMultiThreaded ? ThreadCursor().second : fCurrentEventIdx; }
+      std::pair<UInt_t,Long64_t>& ThreadCursor() const;
+
       // event sampling
       std::vector<Char_t>        fSampling;                    // random or importance sampling (not all events are taken) !! Bool_t are stored ( no std::vector<bool> taken for speed (performance) issues )
       std::vector<Int_t>         fSamplingNEvents;            // number of events which should be sampled
@@ -200,19 +228,19 @@ namespace TMVA {
 inline UInt_t TMVA::DataSet::TreeIndex(Types::ETreeType type) const
 {
    switch (type) {
-   case Types::kMaxTreeType : return fCurrentTreeIdx;
+   case Types::kMaxTreeType : return CurrentTreeIdx();
    case Types::kTraining : return 0;
    case Types::kTesting : return 1;
    case Types::kValidation : return 2;
    case Types::kTrainingOriginal : return 3;
-   default : return fCurrentTreeIdx;
+   default : return CurrentTreeIdx();
    }
 }
 
 //_______________________________________________________________________
 inline TMVA::Types::ETreeType TMVA::DataSet::GetCurrentType() const
 {
-   switch (fCurrentTreeIdx) {
+   switch (CurrentTreeIdx()) {
    case 0: return Types::kTraining;
    case 1: return Types::kTesting;
    case 2: return Types::kValidation;
@@ -228,13 +256,28 @@ inline Long64_t TMVA::DataSet::GetNEvents(Types::ETreeType type) const
    if (fSampling.size() > UInt_t(treeIdx) && fSampling.at(treeIdx)) {
       return fSamplingSelected.at(treeIdx).size();
    }
+   if (UseEventView(treeIdx)) return fEventColumns[treeIdx]->GetNEvents();
    return GetEventCollection(type).size();
 }
 
+//_______________________________________________________________________
+inline TMVA::EventColumns* TMVA::DataSet::GetEventColumns( TMVA::Types::ETreeType type ) const
+{
+   // the columns no longer describe the event collection once events were
+   // added to it or removed from it
+   const UInt_t treeIdx = TreeIndex(type);
+   EventColumns* columns = fEventColumns.at(treeIdx);
+   if (columns && fHasViews[treeIdx] &&
+       fEventCollection.at(treeIdx)->size() != (UInt_t)columns->GetNEvents()) return 0;
+   return columns;
+}
+
 //_______________________________________________________________________
 inline const std::vector<TMVA::Event*>& TMVA::DataSet::GetEventCollection( TMVA::Types::ETreeType type ) const
 {
-   return *(fEventCollection.at(TreeIndex(type)));
+   const UInt_t treeIdx = TreeIndex(type);
+   if (UseEventView(treeIdx)) CreateEventViews(treeIdx);
+   return *(fEventCollection.at(treeIdx));
 }
 
 
@@ -306,6 +306,7 @@ namespace TMVA {
       TString                    fVerboseLevel;      //! VerboseLevel
 
       Bool_t                     fScaleWithPreselEff; //! how to deal with requested #events in connection with preselection cuts 
+      Bool_t                     fColumnStorage;     //! store the events of the dataset in columns
 
       // the event
       TTree*                     fCurrentTree;       //! the tree, events are currently read from
@@ -69,6 +69,7 @@ class TRandom3;
 namespace TMVA {
 
    class Event;
+   class BinnedEventSample;
 
    class DecisionTree : public BinaryTree {
 
@@ -201,6 +202,12 @@ namespace TMVA {
       inline void SetUseExclusiveVars(Bool_t t=kTRUE){fUseExclusiveVars = t;}
       inline void SetNVars(Int_t n){fNvars = n;}
 
+      // find the node splits from histograms of the pre-binned training events;
+      // rows are the rows in s of the events the tree is built from, in the same
+      // order, or null if the tree is built from the binned events themselves
+      inline void SetBinnedSample(const BinnedEventSample* s, const std::vector<UInt_t>* rows = 0)
+      {fBinnedSample = s; fBinnedRows = rows;}
+
 
    private:
       // utility functions
@@ -211,6 +218,18 @@ namespace TMVA {
       // calculates the purity S/(S+B) of a given event sample
       Double_t SamplePurity(EventList eventSample);
 
+      // tree building with histograms of the pre-binned events: the histograms
+      // hold 6 sums per bin (signal/background weights and counts, target and
+      // target^2 sums) for all bins of all variables, see BinnedEventSample
+      UInt_t   BuildTreeFromHistograms( const EventConstList & eventSample );
+      void     BuildNodeFromHistograms( const EventConstList & eventSample, const std::vector<UInt_t> & rows,
+                                        DecisionTreeNode *node, std::vector<Double_t> & hist );
+      void     FillHistograms( const EventConstList & eventSample, const std::vector<UInt_t> & rows,
+                               std::vector<Double_t> & hist ) const;
+      Double_t TrainNodeFromHistograms( const std::vector<Double_t> & hist, DecisionTreeNode *node,
+                                        Double_t nTotS, Double_t nTotB, Double_t nTotS_unWeighted, Double_t nTotB_unWeighted,
+                                        Double_t target, Double_t target2 );
+
       UInt_t    fNvars;          // number of variables used to separate S and B
       Int_t     fNCuts;          // number of grid point in variable cut scans
       Bool_t    fUseFisherCuts;  // use multivariate splits using the Fisher criterium
@@ -249,6 +268,9 @@ namespace TMVA {
 
       DataSetInfo*  fDataSetInfo;
 
+      const BinnedEventSample* fBinnedSample; // pre-binned training events for histogram split finding (not owned)
+      const std::vector<UInt_t>* fBinnedRows; // rows in fBinnedSample of the training events, null for all rows (not owned)
+
 
       ClassDef(DecisionTree,0);               // implementation of a Decision Tree
    };
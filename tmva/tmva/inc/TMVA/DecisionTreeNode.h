@@ -46,6 +46,7 @@
 #include "TMVA/Version.h"
 #endif
 
+#include <atomic>
 #include <iostream>
 #include <vector>
 #include <map>
@@ -350,7 +351,19 @@ namespace TMVA {
       void     SetSampleMin(UInt_t ivar, Float_t xmin);
       void     SetSampleMax(UInt_t ivar, Float_t xmax);
 
-      static bool fgIsTraining; // static variable to flag training phase in which we need fTrainInfo
+      static std::atomic<Bool_t> fgIsTraining; // static variable to flag training phase in which we need fTrainInfo
+      // raise/lower fgIsTraining; with concurrent trainings it stays raised until the last one ends
+      static void BeginTraining();
+      static void EndTraining();
+      // raises fgIsTraining for the lifetime of the guard, also when the training throws
+      class TrainingGuard {
+      public:
+         TrainingGuard()  { BeginTraining(); }
+         ~TrainingGuard() { EndTraining(); }
+      private:
+         TrainingGuard(const TrainingGuard&);
+         TrainingGuard& operator=(const TrainingGuard&);
+      };
       static UInt_t fgTmva_Version_Code;  // set only when read from weightfile 
 
    protected:
@@ -33,6 +33,7 @@
 
 #include <iosfwd>
 #include <vector>
+#include <atomic>
 
 #ifndef ROOT_Rtypes
 #include "Rtypes.h"
@@ -43,6 +44,9 @@
 #ifndef ROOT_TMVA_Types
 #include "TMVA/Types.h"
 #endif
+#ifndef ROOT_TMVA_EventColumns
+#include "TMVA/EventColumns.h"
+#endif
 
 
 
@@ -57,6 +61,7 @@ namespace TMVA {
    class Event {
 
       friend std::ostream& operator<<( std::ostream& os, const Event& event );
+      friend class EventColumns;
 
    public:
 
@@ -73,43 +78,53 @@ namespace TMVA {
       explicit Event( const std::vector<Float_t>&, 
                       UInt_t theClass, Double_t weight = 1.0, Double_t boostweight = 1.0 );
       explicit Event( const std::vector<Float_t*>*&, UInt_t nvar );
+      Event( EventColumns* columns, Long64_t ievt );
 
       ~Event();
 
+      // the copy of a view holds the values of the row
+      Event&  operator=( const Event& event );
+
       // accessors
       Bool_t  IsDynamic()         const {return fDynamic; }
 
+      // a view reads and writes the row of the event in a columnar storage
+      Bool_t  IsView()            const { return fColumns!=0; }
+      void    SetView( EventColumns* columns, Long64_t ievt );
+
       //      Double_t GetWeight()         const { return fWeight*fBoostWeight; }
       Double_t GetWeight()         const;
       Double_t GetOriginalWeight() const { return fWeight; }
-      Double_t GetBoostWeight()    const { return TMath::Max(Double_t(0.0001),fBoostWeight); }
+      Double_t GetBoostWeight()    const { return TMath::Max(Double_t(0.0001),fColumns ? fColumns->GetBoostWeight(fRow) : fBoostWeight); }
       UInt_t   GetClass()          const { return fClass; }  
 
       UInt_t   GetNVariables()        const;
       UInt_t   GetNTargets()          const;
       UInt_t   GetNSpectators()       const;
 
+      // the vectors are read-only: values are changed with SetVal, SetTarget and
+      // SetSpectator, which also write to the columns of a view
       Float_t  GetValue( UInt_t ivar) const;
-      std::vector<Float_t>& GetValues() 
-         {
-            //For a detailed explanation, please see the heading "Avoid Duplication in const and Non-const Member Function," on p. 23, in Item 3 "Use const whenever possible," in Effective C++, 3d ed by Scott Meyers, ISBN-13: 9780321334879.
-            // http://stackoverflow.com/questions/123758/how-do-i-remove-code-duplication-between-similar-const-and-non-const-member-func
-            return const_cast<std::vector<Float_t>&>( static_cast<const Event&>(*this).GetValues() );
-         }
       const std::vector<Float_t>& GetValues() const;
 
-      Float_t  GetTarget( UInt_t itgt ) const { return fTargets.at(itgt); }
-      std::vector<Float_t>& GetTargets()  { return fTargets; }
-      const std::vector<Float_t>& GetTargets() const { return fTargets; }
+      Float_t  GetTarget( UInt_t itgt ) const { return fColumns ? GetColumnValue( 't', itgt ) : fTargets.at(itgt); }
+      const std::vector<Float_t>& GetTargets() const;
 
       Float_t  GetSpectator( UInt_t ivar) const;
-      std::vector<Float_t>& GetSpectators()  { return fSpectators; }
-      const std::vector<Float_t>& GetSpectators() const { return fSpectators; }
-
-      void     SetWeight             ( Double_t w ) { fWeight=w; }
-      void     SetBoostWeight        ( Double_t w ) const { fDoNotBoost ? fDoNotBoost = kFALSE : fBoostWeight=w; }
-      void     ScaleBoostWeight      ( Double_t s ) const { fDoNotBoost ? fDoNotBoost = kFALSE : fBoostWeight *= s; }
-      void     SetClass              ( UInt_t t )  { fClass=t; }
+      const std::vector<Float_t>& GetSpectators() const;
+
+      void     SetWeight             ( Double_t w ) { fWeight=w; if (fColumns) fColumns->SetWeight(fRow,w); }
+      void     SetBoostWeight        ( Double_t w ) const {
+         if (fDoNotBoost)   fDoNotBoost = kFALSE;
+         else if (fColumns) fColumns->SetBoostWeight( fRow, w );
+         else               fBoostWeight = w;
+      }
+      void     ScaleBoostWeight      ( Double_t s ) const {
+         if (fDoNotBoost)   fDoNotBoost = kFALSE;
+         else if (fColumns) fColumns->SetBoostWeight( fRow, fColumns->GetBoostWeight(fRow)*s );
+         else               fBoostWeight *= s;
+      }
+      void     SetClass              ( UInt_t t )  { fClass=t; if (fColumns) fColumns->SetClass(fRow,t); }
       void     SetVal                ( UInt_t ivar, Float_t val );
       void     SetTarget             ( UInt_t itgt, Float_t value );
       void     SetSpectator          ( UInt_t ivar, Float_t value );
@@ -126,6 +141,10 @@ namespace TMVA {
 
    private:
 
+      Float_t  GetColumnValue( Char_t type, UInt_t idx ) const;
+      void     CopyFromColumns();
+      void     FillFromColumns() const;
+
       static   Bool_t          fgIsTraining;    // mark if we are in an actual training or "evaluation/testing" phase --> ignoreNegWeights only in actual training !
       static   Bool_t          fgIgnoreNegWeightsInTraining;
 
@@ -134,9 +153,12 @@ namespace TMVA {
 
       mutable std::vector<Float_t>   fValuesRearranged;   // the event values ; mutable, to be able to copy the dynamic values in there
       mutable std::vector<Float_t*>* fValuesDynamic;   // the event values
-      std::vector<Float_t>   fTargets;         // target values for regression
+      mutable std::vector<Float_t>   fTargets;         // target values for regression ; mutable, to be able to copy the values of a view in there
       mutable std::vector<Float_t>   fSpectators;      // "visisting" variables not used in MVAs ; mutable, to be able to copy the dynamic values in there
       mutable std::vector<UInt_t>*   fVariableArrangement;  // needed for MethodCategories, where we can train on other than the main variables
+      EventColumns*                  fColumns;         //! columnar storage the event is a view of (not owned), or 0
+      Long64_t                       fRow;             //! row of the event in fColumns
+      mutable std::atomic<Bool_t>    fFilled;          //! the vectors of the view hold the values of its row
 
       UInt_t                         fClass;           // class number
       Double_t                       fWeight;          // event weight (product of global and individual weights)
@@ -144,6 +166,41 @@ namespace TMVA {
       Bool_t                         fDynamic;         // is set when the dynamic values are taken
       mutable Bool_t                 fDoNotBoost;       // mark event as not to be boosted (used to compensate for events with negative event weights
    };
+
+   //////////////////////////////////////////////////////////////////////////
+   //                                                                      //
+   // EventCursor                                                          //
+   //                                                                      //
+   // Row-index access to the events of a collection or to the rows of a   //
+   // columnar storage. For columns a single view is moved to the row, so  //
+   // the event returned by GetEvent() is valid until the next call and no //
+   // event is created per row.                                            //
+   //                                                                      //
+   //////////////////////////////////////////////////////////////////////////
+
+   class EventCursor {
+
+   public:
+
+      explicit EventCursor( const std::vector<Event*>& events ) : fEvents( &events ), fColumns( 0 ) {}
+      explicit EventCursor( const EventColumns& columns ) : fEvents( 0 ), fColumns( const_cast<EventColumns*>(&columns) ) {}
+
+      Long64_t     GetNEvents() const { return fColumns ? fColumns->GetNEvents() : Long64_t(fEvents->size()); }
+      const Event* GetEvent( Long64_t ievt ) {
+         if (fColumns==0) return (*fEvents)[ievt];
+         fView.SetView( fColumns, ievt );
+         return &fView;
+      }
+
+   private:
+
+      EventCursor( const EventCursor& );
+      EventCursor& operator=( const EventCursor& );
+
+      const std::vector<Event*>* fEvents;   // the events, or 0
+      EventColumns*              fColumns;  // the columns (only read), or 0
+      Event                      fView;     // view of the current row of fColumns
+   };
 }
 
 #endif
@@ -0,0 +1,100 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : EventColumns                                                          *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Values, targets, spectators, classes and weights of a set of events,     *
+ *      stored column by column in contiguous arrays                             *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#ifndef ROOT_TMVA_EventColumns
+#define ROOT_TMVA_EventColumns
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EventColumns                                                         //
+//                                                                      //
+// Columnar storage of the events of a data set                         //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+namespace TMVA {
+
+   class Event;
+
+   class EventColumns {
+
+   public:
+
+      EventColumns( UInt_t nvar, UInt_t ntgt, UInt_t nspec );
+      EventColumns( const EventColumns& other );
+      ~EventColumns();
+
+      void     Reserve( Long64_t nevents );
+      void     AddEvent( const Event& ev );
+      void     Shrink();
+
+      Long64_t GetNEvents()     const { return fClass.size(); }
+      UInt_t   GetNVariables()  const { return fNVariables; }
+      UInt_t   GetNTargets()    const { return fNTargets; }
+      UInt_t   GetNSpectators() const { return fNSpectators; }
+
+      // the columns hold the variables, followed by the targets and the spectators
+      UInt_t   GetNColumns()    const { return fColumns.size(); }
+      UInt_t   VariableColumn ( UInt_t ivar )  const { return ivar; }
+      UInt_t   TargetColumn   ( UInt_t itgt )  const { return fNVariables+itgt; }
+      UInt_t   SpectatorColumn( UInt_t ispec ) const { return fNVariables+fNTargets+ispec; }
+
+      Float_t*       GetColumn( UInt_t icol )       { return fColumns[icol].data(); }
+      const Float_t* GetColumn( UInt_t icol ) const { return fColumns[icol].data(); }
+
+      Float_t  GetValue( UInt_t icol, Long64_t ievt ) const { return fColumns[icol][ievt]; }
+      void     SetValue( UInt_t icol, Long64_t ievt, Float_t val ) { fColumns[icol][ievt] = val; }
+
+      UInt_t   GetClass      ( Long64_t ievt ) const { return fClass[ievt]; }
+      Double_t GetWeight     ( Long64_t ievt ) const { return fWeight[ievt]; }
+      Double_t GetBoostWeight( Long64_t ievt ) const { return fBoostWeight[ievt]; }
+      void     SetClass      ( Long64_t ievt, UInt_t cls )  { fClass[ievt] = cls; }
+      void     SetWeight     ( Long64_t ievt, Double_t w )  { fWeight[ievt] = w; }
+      void     SetBoostWeight( Long64_t ievt, Double_t w )  { fBoostWeight[ievt] = w; }
+
+      // one view event per row; the vector is owned by the caller, the views
+      // are allocated in one block owned by the columns
+      std::vector<Event*>* CreateViews();
+      Bool_t   IsView( const Event* ev ) const;
+
+      // bytes allocated for the columns
+      Long64_t GetMemorySize() const;
+
+   private:
+
+      EventColumns& operator=( const EventColumns& );
+
+      UInt_t                              fNVariables;   // number of variables
+      UInt_t                              fNTargets;     // number of targets
+      UInt_t                              fNSpectators;  // number of spectators
+      std::vector< std::vector<Float_t> > fColumns;      // one array per variable, target and spectator
+      std::vector<UInt_t>                 fClass;        // class of each event
+      std::vector<Double_t>               fWeight;       // original weight of each event
+      std::vector<Double_t>               fBoostWeight;  // boost weight of each event
+      Event*                              fViews;        // views of the rows, or 0
+      Long64_t                            fNViews;       // number of views
+   };
+
+} // namespace TMVA
+
+#endif
@@ -186,6 +186,10 @@ namespace TMVA {
       
       void WriteDataInformation(DataSetInfo&     fDataSetInfo);
 
+      // train or test the given methods, concurrently if requested and possible
+      void   RunMethods( const std::vector<MethodBase*>& methods, Bool_t training );
+      Bool_t CanRunConcurrently( const MethodBase* mva, Bool_t training ) const;
+
       void SetInputTreesFromEventAssignTrees();
 
    private:
@@ -221,6 +225,7 @@ namespace TMVA {
 
       Types::EAnalysisType                      fAnalysisType;    //! the training type
       Bool_t                                    fModelPersistence;//!option to save the trained model in xml file or using serialization
+      Bool_t                                    fParallelTraining;//! train and test independent methods concurrently
       
       
    protected:
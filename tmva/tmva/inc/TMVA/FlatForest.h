@@ -0,0 +1,80 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : FlatForest                                                            *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Forest of decision trees flattened into contiguous arrays for fast        *
+ *      evaluation                                                                *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#ifndef ROOT_TMVA_FlatForest
+#define ROOT_TMVA_FlatForest
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// FlatForest                                                           //
+//                                                                      //
+// Read-only copy of a forest of decision trees stored in flat arrays   //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+namespace TMVA {
+
+   class DecisionTree;
+
+   class FlatForest {
+
+   public:
+
+      // flatten the trees; IsValid() is false if a tree cannot be flattened
+      FlatForest( const std::vector<DecisionTree*>& forest );
+
+      Bool_t IsValid() const { return fValid; }
+      UInt_t GetNTrees() const { return fRoot.size(); }
+
+      // response of tree itree to the variables x, as DecisionTree::CheckEvent
+      Double_t GetResponse( UInt_t itree, const Float_t* x, Bool_t useYesNoLeaf ) const
+      {
+         UInt_t node = fRoot[itree];
+         for (UInt_t d=0; d<fDepth[itree]; d++) node = fChild[2*node + (x[fVar[node]] >= fCut[node])];
+         return useYesNoLeaf ? fLeafYesNo[node] : fLeafValue[node];
+      }
+
+      // sum of the responses of the first nTrees trees, weighted with weights
+      // if not null
+      Double_t GetWeightedSum( const Float_t* x, UInt_t nTrees, Bool_t useYesNoLeaf, const Double_t* weights ) const;
+
+      // same for nEvents events, the nVars variables of each event stored after
+      // each other in x
+      void GetWeightedSums( const Float_t* x, UInt_t nEvents, UInt_t nVars, UInt_t nTrees, Bool_t useYesNoLeaf,
+                            const Double_t* weights, Double_t* sums ) const;
+
+   private:
+
+      Bool_t                fValid;      // all trees could be flattened
+      std::vector<UInt_t>   fRoot;       // index of the root node of each tree
+      std::vector<UInt_t>   fDepth;      // depth of each tree, the leaves loop on themselves
+      std::vector<UShort_t> fVar;        // cut variable of each node (0 for leaves)
+      std::vector<Float_t>  fCut;        // cut value of each node
+      std::vector<UInt_t>   fChild;      // daughters of each node, for value < cut and value >= cut
+      std::vector<Double_t> fLeafValue;  // purity (classification) or response (regression) of each leaf
+      std::vector<Double_t> fLeafYesNo;  // node type (classification) or response (regression) of each leaf
+   };
+
+} // namespace TMVA
+
+#endif
@@ -53,6 +53,10 @@ namespace TMVA {
 
       virtual Double_t EstimatorFunction( std::vector<Double_t>& parameters ) = 0;
 
+      // estimator values for a set of parameter vectors, estimators[i] for parameters[i];
+      // targets that can evaluate them concurrently override this function
+      virtual void     EstimatorFunctions( std::vector<std::vector<Double_t>*>& parameters, std::vector<Double_t>& estimators );
+
       // function to notify the FitterTarget of the progress status of the fitter
       // sender : "GA", "MC", ...
       // progress : "init", "iteration", "last", "stop"
@@ -59,6 +59,8 @@
 namespace TMVA {
 
    class SeparationBase;
+   class BinnedEventSample;
+   class FlatForest;
 
    class MethodBDT : public MethodBase {
 
@@ -107,12 +109,16 @@ namespace TMVA {
       // calculate the MVA value
       Double_t GetMvaValue( Double_t* err = 0, Double_t* errUpper = 0);
 
+      // calculate the MVA values of a range of events of the data set
+      std::vector<Double_t> GetMvaValues( Long64_t firstEvt = 0, Long64_t lastEvt = -1, Bool_t logProgress = false );
+
       // get the actual forest size (might be less than fNTrees, the requested one, if boosting is stopped early
       UInt_t   GetNTrees() const {return fForest.size();}
    private:
       Double_t GetMvaValue( Double_t* err, Double_t* errUpper, UInt_t useNTrees );
       Double_t PrivateGetMvaValue( const TMVA::Event *ev, Double_t* err=0, Double_t* errUpper=0, UInt_t useNTrees=0 );
       void     BoostMonitor(Int_t iTree);
+      void     BuildFlatForest();
 
    public:
       const std::vector<Float_t>& GetMulticlassValues();
@@ -205,6 +211,7 @@ namespace TMVA {
       std::vector<const TMVA::Event*>       fEventSample;     // the training events
       std::vector<const TMVA::Event*>       fValidationSample;// the Validation events
       std::vector<const TMVA::Event*>       fSubSample;       // subsample for bagged grad boost
+      std::vector<UInt_t>                   fSubSampleRows;   // position in fEventSample of each event of fSubSample
       std::vector<const TMVA::Event*>      *fTrainSample;     // pointer to sample actually used in training (fEventSample or fSubSample) for example
 
       Int_t                           fNTrees;          // number of decision trees requested
@@ -269,6 +276,10 @@ namespace TMVA {
       Double_t                         fCbb;             // Cost factor
       
       Bool_t                           fDoPreselection;  // do or do not perform automatic pre-selection of 100% eff. cuts
+      Bool_t                           fUseBinnedTraining; // find the node splits from histograms of the pre-binned training events
+      BinnedEventSample*               fBinnedSample;    //! training events binned once for all trees (only during training)
+      FlatForest*                      fFlatForest;      //! flattened copy of the forest used in the evaluation
+      std::vector<Float_t>             fFlatValues;      //! variables of the evaluated event
 
       std::vector<Double_t>            fVariableImportance; // the relative importance of the different variables
 
@@ -241,6 +241,7 @@ namespace TMVA {
    private:
       friend class MethodCategory;
       friend class MethodCompositeBase;
+      friend class Reader;
       void WriteStateToXML      ( void* parent ) const;
       void ReadStateFromXML     ( void* parent );
       void WriteStateToStream   ( std::ostream& tf ) const;   // needed for MakeClass
@@ -126,9 +126,14 @@ namespace TMVA {
       
       Double_t EstimatorFunction( std::vector<Double_t> & );
       Double_t EstimatorFunction( Int_t ievt1, Int_t ievt2 );
+      void     EstimatorFunctions( std::vector<std::vector<Double_t>*>& parameters,
+                                   std::vector<Double_t>& estimators );
 
       void     SetTestSignalEfficiency( Double_t effS ) { fTestSignalEff = effS; }
 
+      // the MINUIT fit goes through the global gMinuit
+      Bool_t   UsesMinuit() const { return fFitMethod == kUseMinuit; }
+
       // retrieve cut values for given signal efficiency
       void     PrintCuts( Double_t effS ) const;
       Double_t GetCuts  ( Double_t effS, std::vector<Double_t>& cutMin, std::vector<Double_t>& cutMax ) const;
@@ -246,6 +251,18 @@ namespace TMVA {
       void     GetEffsfromPDFs( Double_t* cutMin, Double_t* cutMax,
                                 Double_t& effS, Double_t& effB );
 
+      // pieces of the above that do not modify the method, and can be run concurrently
+      void     GetSelectedWeights( Double_t* cutMin, Double_t* cutMax,
+                                   Float_t& nSelS, Float_t& nSelB );
+      void     IntegratePDFs( Double_t* cutMin, Double_t* cutMax,
+                              Double_t& effS, Double_t& effB );
+      void     GetEffsfromSelectedWeights( Float_t nSelS, Float_t nSelB,
+                                           Double_t& effS, Double_t& effB );
+      void     CheckEffs( Double_t& effS, Double_t& effB );
+
+      // estimator for given efficiencies of the cuts in fTmpCutMin/Max
+      Double_t ComputeEstimator( Double_t effS, Double_t effB );
+
       // default initialisation method called by all constructors
       void     Init( void );
 
@@ -76,6 +76,7 @@ namespace TMVA
       void Train( void );
 
       Double_t GetMvaValue( Double_t* err = 0, Double_t* errUpper = 0 );
+      std::vector<Double_t> GetMvaValues(Long64_t firstEvt = 0, Long64_t lastEvt = -1, Bool_t logProgress = false);
       const std::vector<Float_t>& GetRegressionValues();
 
       using MethodBase::ReadWeightsFromStream;
@@ -116,6 +117,8 @@ namespace TMVA
 
       Double_t getKernelRadius(const kNN::List &rlist) const;
       const std::vector<Double_t> getRMS(const kNN::List &rlist, const kNN::Event &event_knn) const;
+
+      Double_t getkNNResponse(const kNN::List &rlist, const kNN::Event &event_knn) const;
       
       double getLDAValue(const kNN::List &rlist, const kNN::Event &event_knn);
 
@@ -201,6 +201,9 @@ namespace TMVA {
       // nice output
       void PrintCoefficients( void );
 
+      // copy of the event with the targets appended to the variables
+      Event* MakeMultiTargetEvent( const Event* ev ) const;
+
       // Square function (fastest implementation)
       template<typename T> T Sqr(T x) const { return x*x; }
 
@@ -135,10 +135,16 @@ namespace TMVA
       void DeclareCompatibilityOptions();
       void ProcessOptions();
       Double_t getLoss( TString lossFunction );
+
+      // store the support vectors column-wise for the evaluation
+      void BuildSupportVectorColumns();
+      // kernel values of the current event with all support vectors
+      const Float_t* EvaluateSupportVectorKernels();
       
       Float_t                       fCost;                // cost value
       Float_t                       fTolerance;           // tolerance parameter
       UInt_t                        fMaxIter;             // max number of iteration
+      UInt_t                        fKernelCacheSize;     // memory budget of the kernel matrix cache (MB)
       UShort_t                      fNSubSets;            // nr of subsets, default 1
       Float_t                       fBparm;               // free plane coefficient 
       Float_t                       fGamma;               // RBF Kernel parameter
@@ -146,6 +152,9 @@ namespace TMVA
       std::vector<TMVA::SVEvent*>*  fInputData;           // vector of training data in SVM format
       std::vector<TMVA::SVEvent*>*  fSupportVectors;      // contains support vectors
       SVKernelFunction*             fSVKernelFunction;    // kernel function
+      std::vector<Float_t>          fSVColumns;           //! variables of the support vectors, one column per variable
+      std::vector<Float_t>          fSVInput;             //! variables of the evaluated event
+      std::vector<Float_t>          fSVKernelValues;      //! kernel values of the evaluated event with the support vectors
 
       TVectorD*                     fMinVars;             // for normalization //is it still needed?? 
       TVectorD*                     fMaxVars;             // for normalization //is it still needed?? 
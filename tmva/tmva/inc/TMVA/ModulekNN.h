@@ -127,6 +127,9 @@ namespace TMVA {
 
          Bool_t Find(Event event, UInt_t nfind = 100, const std::string &option = "count") const;
          Bool_t Find(UInt_t nfind, const std::string &option) const;
+
+         // thread-safe search: the result goes to nlist, GetkNNList() and GetkNNEvent() are unchanged
+         Bool_t Find(Event event, UInt_t nfind, List &nlist, const std::string &option = "count") const;
       
          const EventVec& GetEventVec() const;
 
@@ -144,6 +147,9 @@ namespace TMVA {
 
          Node<Event>* Optimize(UInt_t optimize_depth);
 
+         void BuildFlatTree();
+         void FindFlat(const Event &event, UInt_t nfind, List &nlist) const;
+
          void ComputeMetric(UInt_t ifrac);
 
          const Event Scale(const Event &event) const;
@@ -158,6 +164,21 @@ namespace TMVA {
 
          Node<Event> *fTree;
 
+         // flat copy of fTree used by the searches for the k nearest events: nodes
+         // in depth-first order and their event variables in one contiguous array
+         struct FlatNode {
+            Int_t    fLeft;     // index of left child, -1 if none
+            Int_t    fRight;    // index of right child, -1 if none
+            UInt_t   fMod;      // splitting variable
+            Float_t  fVarDis;   // splitting value
+            Float_t  fVarMin;   // range of the splitting variable in the subtree
+            Float_t  fVarMax;
+            Double_t fWeight;   // event weight, not positive for the nodes made by Optimize()
+         };
+         std::vector<FlatNode>            fFlatNodes;
+         std::vector<VarType>             fFlatVars;   // fDimn variables per node
+         std::vector<const Node<Event>*>  fFlatTree;   // tree node of each flat node, as returned in List
+
          std::map<Int_t, Double_t> fVarScale;
 
          mutable List  fkNNList;     // latest result from kNN search
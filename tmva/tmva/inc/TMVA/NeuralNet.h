@@ -38,6 +38,8 @@
 #include <random>
 #include <thread>
 #include <future>
+#include <mutex>
+#include <condition_variable>
 #include <type_traits>
 
 #include "Pattern.h"
@@ -255,6 +257,82 @@ namespace TMVA
 
 
 
+      /*! \brief ThreadPool keeps worker threads alive for the whole training
+       *
+       *  The mini-batch ranges of the training cycles and the test batches are handed 
+       *  to the same workers instead of launching new threads in each cycle. The 
+       *  calling thread takes part in the execution of the tasks.
+       */
+      class ThreadPool
+      {
+      public:
+         static ThreadPool& instance (); ///< returns the pool shared by all nets (created on first use)
+
+         ~ThreadPool ();
+
+         size_t numThreads () const { return m_workers.size ()+1; } ///< number of threads executing tasks (including the calling thread)
+
+         /*! \brief execute task(0) ... task(numTasks-1) and wait until all of them are done
+          *
+          *  the tasks are distributed over the workers and the calling thread; calls of run from 
+          *  different threads are executed one after the other
+          */
+         void run (size_t numTasks, const std::function<void(size_t)>& task);
+
+      private:
+         ThreadPool (size_t numWorkers);
+         ThreadPool (const ThreadPool&) = delete;
+         ThreadPool& operator= (const ThreadPool&) = delete;
+
+         void work (); ///< loop of the worker threads
+         bool executeNext (std::unique_lock<std::mutex>& lock); ///< execute one pending task, returns false if there is none
+
+         std::vector<std::thread> m_workers; ///< worker threads
+         std::mutex m_runMutex; ///< serializes the calls of run
+         std::mutex m_mutex; ///< protects the task state
+         std::condition_variable m_cvWork; ///< signals new tasks to the workers
+         std::condition_variable m_cvDone; ///< signals the completion of the last task
+         const std::function<void(size_t)>* m_task; ///< task being executed
+         size_t m_nextTask; ///< index of the next task to be started
+         size_t m_numTasks; ///< number of tasks of the current run
+         size_t m_pendingTasks; ///< tasks not yet finished
+         bool m_stop; ///< workers have to exit
+      };
+
+
+
+      /*! \brief C(m,n) += A(m,k) * B(k,n)
+       *
+       *  cache-blocked matrix multiplication on row-major arrays (used for the forward pass of a mini-batch)
+       */
+      void multiplyAdd (const double* A, const double* B, double* C, size_t m, size_t k, size_t n);
+
+      /*! \brief C(m,k) += A(m,n) * B(k,n)^T
+       *
+       *  cache-blocked matrix multiplication on row-major arrays (used for the back-propagation of the deltas)
+       */
+      void multiplyAddTransB (const double* A, const double* B, double* C, size_t m, size_t k, size_t n);
+
+      /*! \brief C(k,n) += alpha * A(m,k)^T * B(m,n)
+       *
+       *  cache-blocked matrix multiplication on row-major arrays (used for the weight gradients of a mini-batch)
+       */
+      void multiplyAddTransA (const double* A, const double* B, double* C, size_t m, size_t k, size_t n, double alpha);
+
+      /*! \brief apply the activation function to n contiguous values
+       *
+       *  same functions as the ones held by Layer, evaluated in a loop without indirect calls
+       */
+      void applyActivation (EnumFunction eFunction, double* values, size_t n);
+
+      /*! \brief compute the gradients of the activation function from n contiguous activated values
+       *
+       *  same functions as the inverse activation functions held by Layer
+       */
+      void applyActivationGradient (EnumFunction eFunction, const double* values, double* gradients, size_t n);
+
+
+
       template <typename ItSource, typename ItWeight, typename ItTarget>
          void applyWeights (ItSource itSourceBegin, ItSource itSourceEnd, ItWeight itWeight, ItTarget itTargetBegin, ItTarget itTargetEnd);
 
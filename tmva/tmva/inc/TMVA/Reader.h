@@ -61,6 +61,7 @@
 
 #include <vector>
 #include <map>
+#include <mutex>
 #include <stdexcept>
 
 namespace TMVA {
@@ -102,6 +103,10 @@ namespace TMVA {
       Double_t EvaluateMVA( MethodBase* method,           Double_t aux = 0 );
       Double_t EvaluateMVA( const TString& methodTag,     Double_t aux = 0 );
 
+      // returns the MVA responses for a batch of events (thread-safe)
+      void     EvaluateMVA( const Float_t* inputs, Long64_t nEvents, Double_t* mvaValues,
+                            const TString& methodTag, Double_t aux = 0 );
+
       // returns error on MVA response for given event
       // NOTE: must be called AFTER "EvaluateMVA(...)" call !
       Double_t GetMVAError() const { return fMvaEventError; }
@@ -159,6 +164,11 @@ namespace TMVA {
 
       void DeclareOptions();
 
+      // copies of the booked methods for the batch evaluation
+      MethodBase* AcquireReplica( const TString& methodTag, MethodBase* method, Double_t aux );
+      void        ReleaseReplica( const TString& methodTag, MethodBase* replica );
+      Long64_t    EvaluateBatch( MethodBase* replica, const Float_t* inputs, Long64_t nEvents, Double_t* mvaValues ) const;
+
       Bool_t    fVerbose;            // verbosity
       Bool_t    fSilent;             // silent mode
       Bool_t    fColor;              // color mode
@@ -171,6 +181,10 @@ namespace TMVA {
 
       std::vector<Float_t> fTmpEvalVec; // temporary evaluation vector (if user input is v<double>)
 
+      std::map<TString, std::vector<MethodBase*> > fReplicas; // idle copies of the booked methods, for batch evaluation
+      std::map<TString, TString> fReplicaXML;                  // weights of the booked methods the copies are made from
+      std::mutex fReplicaMutex;                                //! protects the copies and the logger in batch evaluation
+
       mutable MsgLogger* fLogger;   // message logger
       MsgLogger& Log() const { return *fLogger; }
 
@@ -32,6 +32,8 @@
 #include "Rtypes.h"
 #endif
 
+#include <vector>
+
 namespace TMVA {
 
    class SVEvent;
@@ -49,11 +51,14 @@ namespace TMVA {
       ~SVKernelFunction();
       
       Float_t Evaluate( SVEvent* ev1, SVEvent* ev2 );
+      void    Evaluate( const Float_t* x, const Float_t* data, UInt_t nvar, UInt_t stride, UInt_t n, Float_t* result ) const;
 
       void setCompatibilityParams(EKernelType k, UInt_t order, Float_t theta, Float_t kappa);
          
    private:
 
+      void Evaluate( EKernelType k, const Float_t* x, const Float_t* data, UInt_t nvar, UInt_t stride, UInt_t n, Float_t* result ) const;
+
       Float_t fGamma;   // documentation
 
       // vector of gammas for multidimensional gaussian
@@ -32,6 +32,7 @@
 #include "Rtypes.h"
 #endif
 
+#include <list>
 #include <vector>
 
 namespace TMVA {
@@ -46,21 +47,39 @@ namespace TMVA {
 
       //constructors
       SVKernelMatrix();
-      SVKernelMatrix( std::vector<TMVA::SVEvent*>*, SVKernelFunction* );
+      SVKernelMatrix( std::vector<TMVA::SVEvent*>*, SVKernelFunction*, UInt_t cacheSize = 1000 );
       
       //destructor
       ~SVKernelMatrix();
       
       //functions
-      Float_t* GetLine   ( UInt_t );
-      Float_t* GetColumn ( UInt_t col ) { return this->GetLine(col);}
-      Float_t  GetElement( UInt_t i, UInt_t j );
+      const Float_t* GetLine   ( UInt_t );
+      const Float_t* GetColumn ( UInt_t col ) { return this->GetLine(col);}
+      Float_t        GetElement( UInt_t i, UInt_t j );
+
+      UInt_t    GetMaxCachedLines() const { return fMaxLines; }
+      ULong64_t GetCacheHits()      const { return fHits; }
+      ULong64_t GetCacheMisses()    const { return fMisses; }
 
    private:
 
-      UInt_t               fSize;              // matrix size
-      SVKernelFunction*    fKernelFunction;    // kernel function
-      Float_t**            fSVKernelMatrix;    // kernel matrix
+      void ComputeLine( UInt_t line, Float_t* values ) const;
+
+      UInt_t                       fSize;              // matrix size
+      UInt_t                       fNVar;              // number of input variables
+      SVKernelFunction*            fKernelFunction;    // kernel function
+      std::vector<TMVA::SVEvent*>* fInputVectors;      // input events
+      std::vector<Float_t>         fData;              // input variables of all events, stored variable by variable
+      std::vector<Float_t>         fDiagonal;          // diagonal of the kernel matrix
+
+      UInt_t                       fMaxLines;          // maximum number of cached lines
+      std::vector<Float_t*>        fLines;             // cached lines
+      std::vector<UInt_t>          fLineIndex;         // index of the line held by each cache slot
+      std::vector<Int_t>           fSlot;              // cache slot of each line, -1 if not cached
+      std::list<UInt_t>            fLRU;               // cache slots, most recently used first
+      std::vector<std::list<UInt_t>::iterator> fLRUPos; // position of each cache slot in fLRU
+      ULong64_t                    fHits;              // number of lines found in the cache
+      ULong64_t                    fMisses;            // number of lines computed
 
       mutable MsgLogger* fLogger;                     //! message logger
       MsgLogger& Log() const { return *fLogger; }
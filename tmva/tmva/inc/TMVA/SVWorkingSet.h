@@ -46,7 +46,7 @@ namespace TMVA {
    public:
 
       SVWorkingSet();
-      SVWorkingSet( std::vector<TMVA::SVEvent*>*, SVKernelFunction*, Float_t , Bool_t);
+      SVWorkingSet( std::vector<TMVA::SVEvent*>*, SVKernelFunction*, Float_t , Bool_t, UInt_t cacheSize = 1000 );
       ~SVWorkingSet();
                 
       Bool_t  ExamineExample( SVEvent*);
@@ -82,6 +82,7 @@ namespace TMVA {
       mutable MsgLogger*          fLogger;      //! message logger
       
       void SetIndex( TMVA::SVEvent* );
+      void UpdateErrorCache( TMVA::SVEvent*, TMVA::SVEvent*, Float_t, Float_t );
    };
 }
 
@@ -68,6 +68,8 @@ namespace TMVA {
       void SetAccuracy          ( Double_t eps   ) { fEps = eps; }
       void SetTemperatureScale  ( Double_t scale ) { fTemperatureScale = scale; }
       void SetAdaptiveSpeed     ( Double_t speed ) { fAdaptiveSpeed = speed; }
+      void SetChains            ( Int_t    n     ) { fChains = n; }
+      void SetSeed              ( UInt_t   seed  );
 
       void SetOptions( Int_t maxCalls, Double_t initialTemperature, Double_t minTemperature, Double_t eps,
                        TString  kernelTemperatureS, Double_t temperatureScale, Double_t adaptiveSpeed, 
@@ -86,17 +88,18 @@ namespace TMVA {
          kGeo
       } fKernelTemperature;
 
-      void FillWithRandomValues( std::vector<Double_t>& parameters );
+      void FillWithRandomValues( std::vector<Double_t>& parameters, TRandom* rnd );
       void ReWriteParameters( std::vector<Double_t>& from, std::vector<Double_t>& to );
-      void GenerateNewTemperature(Double_t& currentTemperature, Int_t Iter );
-      void GenerateNeighbour( std::vector<Double_t>& parameters, std::vector<Double_t>& oldParameters, Double_t currentTemperature );
-      Bool_t ShouldGoIn( Double_t currentFit, Double_t localFit, Double_t currentTemperature );
+      void GenerateNewTemperature(Double_t& currentTemperature, Int_t Iter, Double_t progress );
+      void GenerateNeighbour( std::vector<Double_t>& parameters, std::vector<Double_t>& oldParameters, Double_t currentTemperature, TRandom* rnd );
+      Bool_t ShouldGoIn( Double_t currentFit, Double_t localFit, Double_t currentTemperature, TRandom* rnd );
       void SetDefaultScale();
       Double_t GenerateMaxTemperature( std::vector<Double_t>& parameters );
       std::vector<Double_t> GenerateNeighbour( std::vector<Double_t>& parameters, Double_t currentTemperature );
 
       IFitterTarget&                fFitterTarget;           // the fitter target
       TRandom*                      fRandom;                 // random generator
+      UInt_t                        fSeed;                   // seed of fRandom, the other chains use the following seeds
       const std::vector<TMVA::Interval*>& fRanges;                 // parameter ranges
 
       // fitter setup 
@@ -112,12 +115,11 @@ namespace TMVA {
 
       Bool_t                        fUseDefaultScale;        // if TRUE, SA calculates its own TemperatureScale
       Bool_t                        fUseDefaultTemperature;  // if TRUE, SA calculates its own InitialTemperature (MinTemperautre)
+      Int_t                         fChains;                 // number of independent annealing chains
 
       mutable MsgLogger*            fLogger;   // message logger
       MsgLogger& Log() const { return *fLogger; }
 
-      Double_t fProgress;
-
       ClassDef(SimulatedAnnealing,0);  // Base class for Simulated Annealing fitting
    };
 
@@ -83,6 +83,8 @@ namespace TMVA {
       Double_t           fTemperatureAdaptiveStep; // used to calculate InitialTemperature if fUseDefaultTemperature
       Bool_t             fUseDefaultScale;         // if TRUE, SA calculates its own TemperatureScale
       Bool_t             fUseDefaultTemperature;   // if TRUE, SA calculates its own InitialTemperature (MinTemperautre)
+      Int_t              fChains;                  // number of independent annealing chains
+      UInt_t             fSeed;                    // seed of the random generator
 
       ClassDef(SimulatedAnnealingFitter,0); // Fitter using a Simulated Annealing Algorithm
    };
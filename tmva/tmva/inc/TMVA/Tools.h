@@ -85,6 +85,8 @@ class TXMLEngine;
 namespace TMVA {
 
    class Event;
+   class EventColumns;
+   class EventCursor;
    class PDF;
    class MsgLogger;
 
@@ -117,6 +119,16 @@ namespace TMVA {
                          Double_t&, Double_t&, Double_t&,
                          Double_t&, Double_t&, Double_t&, Int_t signalClass,
                          Bool_t norm = kFALSE );
+      void  ComputeStat( const EventColumns&,
+                         std::vector<Float_t>*,
+                         Double_t&, Double_t&, Double_t&,
+                         Double_t&, Double_t&, Double_t&, Int_t signalClass,
+                         Bool_t norm = kFALSE );
+      void  ComputeStat( EventCursor&,
+                         std::vector<Float_t>*,
+                         Double_t&, Double_t&, Double_t&,
+                         Double_t&, Double_t&, Double_t&, Int_t signalClass,
+                         Bool_t norm = kFALSE );
 
       // compute variance from sums
       inline Double_t ComputeVariance( Double_t sumx2, Double_t sumx, Int_t nx );
@@ -239,8 +251,7 @@ namespace TMVA {
 
       // variables
       const TString fRegexp;
-      mutable MsgLogger*    fLogger;
-      MsgLogger& Log() const { return *fLogger; }
+      MsgLogger& Log() const;
 #if __cplusplus > 199711L
       static std::atomic<Tools*> fgTools;
 #else
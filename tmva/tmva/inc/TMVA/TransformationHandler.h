@@ -53,6 +53,8 @@
 namespace TMVA {
 
    class Event;
+   class EventColumns;
+   class EventCursor;
    class DataSet;
    class Ranking;
    class VariableTransformBase;
@@ -84,6 +86,8 @@ namespace TMVA {
       const TList& GetTransformationList()   const { return fTransformations; }
       Int_t        GetNumOfTransformations() const { return fTransformations.GetSize(); }
       const std::vector<Event*>* CalcTransformations( const std::vector<Event*>&, Bool_t createNewVector = kFALSE );
+      const std::vector<Event*>* CalcTransformations( const EventColumns&, Bool_t createNewVector = kFALSE );
+      Bool_t       CanTransformColumns( const EventColumns& ) const;
       
       void         CalcStats( const std::vector<Event*>& events );
       void         AddStats ( Int_t k, UInt_t ivar, Double_t mean, Double_t rms, Double_t min, Double_t max );
@@ -116,8 +120,13 @@ namespace TMVA {
       void           SetRootDir( TDirectory *d ) { fRootBaseDir = d; }
 
       void           PlotVariables( const std::vector<Event*>& events, TDirectory* theDirectory = 0 );
+      void           PlotVariables( const EventColumns& columns, TDirectory* theDirectory = 0 );
 
    private:
+
+      const std::vector<Event*>* TransformEvents( std::vector<Event*>* transformedEvents, Bool_t createNewVector );
+      void           CalcStats( EventCursor& events );
+      void           PlotVariables( EventCursor& events, TDirectory* theDirectory = 0 );
       
       //      std::vector<TMVA::Event*>* TransformCollection( VariableTransformBase* trf,
       //                                                Int_t cls,
@@ -137,6 +146,7 @@ namespace TMVA {
       Int_t                 fNumC;               // number of categories (#classes +1)
 
       std::vector<Ranking*> fRanking;            //! ranking object
+      std::vector<EventColumns*> fTransformedColumns; //! columns of the events returned by CalcTransformations
       TDirectory*           fRootBaseDir;        //! if set put input var hists
       TString               fCallerName;         //! name of the caller for output 
       mutable MsgLogger*    fLogger;             //! message logger
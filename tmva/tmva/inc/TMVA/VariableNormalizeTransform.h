@@ -61,6 +61,8 @@ namespace TMVA {
 
       virtual const Event* Transform(const Event* const, Int_t cls ) const;
       virtual const Event* InverseTransform( const Event* const, Int_t cls ) const;
+      virtual Bool_t       PrepareColumnTransformation( const EventColumns& columns );
+      virtual void         TransformColumns( EventColumns& columns, Int_t cls ) const;
 
       void WriteTransformationToStream ( std::ostream& ) const;
       void ReadTransformationFromStream( std::istream&, const TString& );
@@ -79,7 +81,8 @@ namespace TMVA {
 
    private:
 
-      void CalcNormalizationParams( const std::vector< Event*>& events);
+      Bool_t Prepare( EventCursor& events );
+      void   CalcNormalizationParams( EventCursor& events );
 
       //      mutable Event*           fTransformedEvent;
 
@@ -59,6 +59,8 @@ namespace TMVA {
 
       virtual const Event* Transform(const Event* const, Int_t cls ) const;
       virtual const Event* InverseTransform(const Event* const, Int_t cls ) const;
+      virtual Bool_t       PrepareColumnTransformation( const EventColumns& columns );
+      virtual void         TransformColumns( EventColumns& columns, Int_t cls ) const;
 
       void WriteTransformationToStream ( std::ostream& ) const;
       void ReadTransformationFromStream( std::istream&, const TString& );
@@ -71,7 +73,8 @@ namespace TMVA {
 
    private:
 
-      void CalculatePrincipalComponents( const std::vector< Event*>& );
+      Bool_t Prepare( EventCursor& events );
+      void CalculatePrincipalComponents( EventCursor& events );
       void X2P( std::vector<Float_t>&, const std::vector<Float_t>&, Int_t cls ) const;
       void P2X( std::vector<Float_t>&, const std::vector<Float_t>&, Int_t cls ) const;
 
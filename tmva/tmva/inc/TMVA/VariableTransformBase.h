@@ -80,6 +80,11 @@ namespace TMVA {
       virtual const Event* Transform       ( const Event* const, Int_t cls ) const = 0;
       virtual const Event* InverseTransform( const Event* const, Int_t cls ) const = 0;
 
+      // preparation from and transformation of all events of a columnar storage, in place
+      virtual Bool_t       CanTransformColumns( const EventColumns& columns ) const;
+      virtual Bool_t       PrepareColumnTransformation( const EventColumns& columns );
+      virtual void         TransformColumns( EventColumns& columns, Int_t cls ) const;
+
       // accessors
       void   SetEnabled  ( Bool_t e ) { fEnabled = e; }
       void   SetNormalise( Bool_t n ) { fNormalise = n; }
@@ -132,6 +137,9 @@ namespace TMVA {
 
       void CalcNorm( const std::vector<const Event*>& );
 
+      // columns read (from fGet) and written (from fPut) by the transformation
+      Bool_t GetColumns( const EventColumns& columns, std::vector<UInt_t>& getColumns, std::vector<UInt_t>& putColumns ) const;
+
       void SetCreated( Bool_t c = kTRUE ) { fCreated = c; }
       void SetNVariables( UInt_t i )      { fNVars = i; }
       void SetName( const TString& c )    { fTransformName = c; }
@@ -0,0 +1,104 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : BinnedEventSample                                                     *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Implementation (see header for description)                               *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+//_______________________________________________________________________
+//
+// BinnedEventSample
+//
+// The variables of the training events of a decision tree forest are
+// binned once, before the first tree is grown, on the same grid the
+// node splitting scans (nCuts+1 bins spanning the range of the full
+// sample; integer variables with a small range get one bin per value).
+// The bin indices are stored in one byte per event and variable,
+// column by column, so that the histograms needed to find the best split
+// of a node are filled by a sequential pass over the columns.
+//
+// The cut value between two bins is stored as a Float_t, and the bin of
+// a value is the number of cut values not greater than it: the events of
+// the bins above a cut are exactly those for which
+// DecisionTreeNode::GoesRight() compares the value >= the cut.
+//_______________________________________________________________________
+
+#include "TMVA/BinnedEventSample.h"
+#include "TMVA/DataSetInfo.h"
+#include "TMVA/Event.h"
+#include "TMVA/MsgLogger.h"
+
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////////////////////
+/// bin the first nvars variables of the events, with nBins bins per variable
+/// (at most fgMaxBins)
+
+TMVA::BinnedEventSample::BinnedEventSample( const std::vector<const TMVA::Event*>& events, const DataSetInfo& dsi,
+                                            UInt_t nvars, UInt_t nBins )
+   : fBins( nvars ),
+     fEdges( nvars ),
+     fOffsets( nvars+1, 0 ),
+     fNEvents( events.size() ),
+     fLogger( new MsgLogger("BinnedEventSample") )
+{
+   if (nBins > fgMaxBins) {
+      Log() << kWARNING << "At most " << fgMaxBins << " bins per variable can be used, instead of " << nBins << Endl;
+      nBins = fgMaxBins;
+   }
+   if (nBins < 1) nBins = 1;
+
+   const UInt_t nevents = events.size();
+
+   for (UInt_t ivar=0; ivar<nvars; ivar++) {
+      Float_t xmin = 0, xmax = 0;
+      for (UInt_t iev=0; iev<nevents; iev++) {
+         const Float_t val = events[iev]->GetValue(ivar);
+         if (iev==0 || val < xmin) xmin = val;
+         if (iev==0 || val > xmax) xmax = val;
+      }
+
+      // the same grid as in DecisionTree::TrainNodeFast, here for the full sample
+      std::vector<Float_t>& edges = fEdges[ivar];
+      if (xmax > xmin) {
+         UInt_t   nb    = nBins;
+         Double_t width = (Double_t(xmax) - Double_t(xmin))/nb;
+         if (dsi.GetVariableInfo(ivar).GetVarType() == 'I' && xmax - xmin + 1 <= fgMaxBins) {
+            nb    = UInt_t(xmax - xmin + 1.5);
+            width = 1;
+         }
+         for (UInt_t icut=0; icut+1<nb; icut++) {
+            const Float_t cut = xmin + Double_t(icut+1)*width;
+            if (edges.empty() || cut > edges.back()) edges.push_back( cut );
+         }
+      }
+      fOffsets[ivar+1] = fOffsets[ivar] + edges.size() + 1;
+
+      std::vector<UChar_t>& bins = fBins[ivar];
+      bins.resize( nevents > 0 ? nevents : 1 );
+      for (UInt_t iev=0; iev<nevents; iev++) {
+         const Float_t val = events[iev]->GetValue(ivar);
+         bins[iev] = UChar_t( std::upper_bound( edges.begin(), edges.end(), val ) - edges.begin() );
+      }
+   }
+
+   Log() << kDEBUG << "Binned " << nvars << " variables of " << nevents << " events into "
+         << fOffsets.back() << " bins" << Endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// destructor
+
+TMVA::BinnedEventSample::~BinnedEventSample()
+{
+   delete fLogger;
+}
@@ -31,6 +31,7 @@
 
 #include "Rtypes.h"
 #include "TString.h"
+#include "ThreadLocalStorage.h"
 
 ClassImp(TMVA::Config)
 
@@ -49,8 +50,7 @@ TMVA::Config::Config() :
    fUseColoredConsole    ( kTRUE  ),
    fSilent               ( kFALSE ),
    fWriteOptionsReference( kFALSE ),
-   fDrawProgressBar      ( kTRUE ),
-   fLogger               ( new MsgLogger("Config") )
+   fDrawProgressBar      ( kTRUE )
 {
    // plotting
    fVariablePlotting.fTimesRMS = 8.0;
@@ -72,7 +72,15 @@ TMVA::Config::Config() :
 
 TMVA::Config::~Config()
 {
-   delete fLogger;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// message logger, one per thread as the configuration is a singleton
+
+TMVA::MsgLogger& TMVA::Config::Log() const
+{
+   TTHREAD_TLS_DECL_ARG(MsgLogger,logger,"Config");
+   return logger;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
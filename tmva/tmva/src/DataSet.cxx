@@ -29,6 +29,8 @@
 #include <cstdlib>
 #include <stdexcept>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 
 #ifndef ROOT_TMVA_DataSetInfo
 #include "TMVA/DataSetInfo.h"
@@ -60,6 +62,37 @@
 #include "TMVA/VariableInfo.h"
 
 #include "TRandom3.h"
+#include "ThreadLocalStorage.h"
+
+Bool_t TMVA::DataSet::fgMultiThreaded = kFALSE;
+
+namespace {
+   // the results of all datasets are created and deleted under this lock
+   std::mutex gResultsMutex;
+
+   // the views of the columnar storage of all datasets are created under this lock
+   std::mutex gViewsMutex;
+
+   // incremented each time the per-thread cursors are switched on, so that
+   // cursors left over by a previous parallel section are discarded
+   std::atomic<UInt_t> gCursorGeneration(0);
+
+   struct ThreadCursors {
+      ThreadCursors() : fGeneration(0), fLast(0), fLastCursor(0) {}
+      UInt_t fGeneration;
+      const TMVA::DataSet* fLast;                                // cache of the last lookup
+      std::pair<UInt_t,Long64_t>* fLastCursor;
+      std::map<const TMVA::DataSet*, std::pair<UInt_t,Long64_t> > fCursors;
+   };
+
+   // per-thread views returned by DataSet::GetEvent() for columnar storage
+   struct ThreadViews {
+      ~ThreadViews() {
+         for (auto it = fViews.begin(); it != fViews.end(); ++it) delete it->second;
+      }
+      std::map<const TMVA::DataSet*, TMVA::Event*> fViews;
+   };
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// constructor
@@ -67,6 +100,8 @@
 TMVA::DataSet::DataSet(const DataSetInfo& dsi) 
    : fdsi(dsi),
      fEventCollection(4,(std::vector<Event*>*)0),
+     fEventColumns(4,(EventColumns*)0),
+     fEventView(0),
      fCurrentTreeIdx(0),
      fCurrentEventIdx(0),
      fHasNegativeEventWeights(kFALSE),
@@ -74,6 +109,7 @@ TMVA::DataSet::DataSet(const DataSetInfo& dsi)
      fTrainingBlockSize(0)
 {
    for (UInt_t i=0; i<4; i++) fEventCollection[i] = new std::vector<Event*>;
+   for (UInt_t i=0; i<4; i++) fHasViews[i] = kFALSE;
    
    fClassEvents.resize(4);
    fBlockBelongToTraining.reserve(10);
@@ -127,9 +163,43 @@ TMVA::DataSet::~DataSet()
    DestroyCollection( Types::kValidation, deleteEvents );
    DestroyCollection( Types::kTrainingOriginal, deleteEvents );
 
+   delete fEventView;
    delete fLogger;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// switch the per-thread current tree type and event on or off; must be
+/// called while no other thread uses a dataset. On first use in a thread,
+/// the cursor of a dataset starts from its state before the switch.
+
+void TMVA::DataSet::SetMultiThreaded( Bool_t mt )
+{
+   if (mt && !fgMultiThreaded) gCursorGeneration++;
+   fgMultiThreaded = mt;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// current tree index and event index of this dataset in the calling thread
+
+std::pair<UInt_t,Long64_t>& TMVA::DataSet::ThreadCursor() const
+{
+   TTHREAD_TLS_DECL(ThreadCursors, cursors);
+   const UInt_t generation = gCursorGeneration;
+   if (cursors.fGeneration != generation) {
+      cursors.fCursors.clear();
+      cursors.fLast = 0;
+      cursors.fGeneration = generation;
+   }
+   if (cursors.fLast != this) {
+      auto it = cursors.fCursors.find(this);
+      if (it == cursors.fCursors.end())
+         it = cursors.fCursors.insert(std::make_pair(this, std::make_pair(fCurrentTreeIdx, fCurrentEventIdx))).first;
+      cursors.fLast = this;
+      cursors.fLastCursor = &it->second;
+   }
+   return *cursors.fLastCursor;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void TMVA::DataSet::IncrementNClassEvents( Int_t type, UInt_t classNumber ) 
@@ -175,22 +245,106 @@ void TMVA::DataSet::DestroyCollection(Types::ETreeType type, Bool_t deleteEvents
    UInt_t i = TreeIndex(type);
    if (i>=fEventCollection.size() || fEventCollection[i]==0) return;
    if (deleteEvents) {
-      for (UInt_t j=0; j<fEventCollection[i]->size(); j++) delete (*fEventCollection[i])[j];
+      // the views of the columns are deleted with them
+      EventColumns* columns = fEventColumns[i];
+      for (UInt_t j=0; j<fEventCollection[i]->size(); j++) {
+         Event* ev = (*fEventCollection[i])[j];
+         if (columns==0 || !columns->IsView(ev)) delete ev;
+      }
    }
    delete fEventCollection[i];
    fEventCollection[i]=0;
+   delete fEventColumns[i];
+   fEventColumns[i]=0;
+   fHasViews[i]=kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// move the training and testing events into columnar storage: the values,
+/// targets, spectators and weights of all events of a tree type are stored
+/// in one array each, and the Event objects are deleted. The per-event
+/// memory then is the size of the stored values, as long as the events are
+/// accessed through GetEvent(); GetEventCollection() creates one view
+/// event per row, in a single block, for the methods that need it.
+
+void TMVA::DataSet::ConvertToColumns()
+{
+   const Types::ETreeType types[2] = { Types::kTraining, Types::kTesting };
+   for (UInt_t i=0; i<2; i++) {
+      const UInt_t t = TreeIndex(types[i]);
+      if (fEventColumns[t]!=0) continue;
+
+      std::vector<Event*>& events = *fEventCollection[t];
+      EventColumns* columns = new EventColumns( GetNVariables(), GetNTargets(), GetNSpectators() );
+      columns->Reserve( events.size() );
+      for (UInt_t ievt=0; ievt<events.size(); ievt++) {
+         columns->AddEvent( *events[ievt] );
+         delete events[ievt];
+      }
+      std::vector<Event*>().swap( events );
+
+      fEventColumns[t] = columns;
+      fHasViews[t] = kFALSE;
+
+      Log() << kINFO << Form("Dataset[%s] : ",fdsi.GetName()) << "Stored " << columns->GetNEvents()
+            << (types[i]==Types::kTraining ? " training" : " testing") << " events in columns ("
+            << Form("%.1f",columns->GetMemorySize()/1048576.) << " MB)" << Endl;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// fill the (empty) event collection of a tree type with one view per row
+/// of its columnar storage
+
+void TMVA::DataSet::CreateEventViews( UInt_t treeIdx ) const
+{
+   std::lock_guard<std::mutex> guard(gViewsMutex);
+   if (fHasViews[treeIdx]) return;
+
+   std::vector<Event*>* views = fEventColumns[treeIdx]->CreateViews();
+   fEventCollection[treeIdx]->swap( *views );
+   delete views;
+   fHasViews[treeIdx] = kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// view of row ievt of the columnar storage of a tree type; the view is
+/// reused by the next call in the same thread
+
+const TMVA::Event* TMVA::DataSet::GetEventView( UInt_t treeIdx, Long64_t ievt ) const
+{
+   EventColumns* columns = fEventColumns[treeIdx];
+   if (ievt < 0 || ievt >= columns->GetNEvents()) throw std::out_of_range("TMVA::DataSet::GetEvent");
+
+   Event* view = 0;
+   if (fgMultiThreaded) {
+      TTHREAD_TLS_DECL(ThreadViews, views);
+      Event*& threadView = views.fViews[this];
+      if (threadView==0) threadView = new Event();
+      view = threadView;
+   }
+   else {
+      if (fEventView==0) fEventView = new Event();
+      view = fEventView;
+   }
+   view->SetView( columns, ievt );
+   return view;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 const TMVA::Event* TMVA::DataSet::GetEvent() const
 {
-   if (fSampling.size() > UInt_t(fCurrentTreeIdx) && fSampling.at(fCurrentTreeIdx)) {
-      Long64_t iEvt = fSamplingSelected.at(fCurrentTreeIdx).at( fCurrentEventIdx )->second;
-      return (*(fEventCollection.at(fCurrentTreeIdx))).at(iEvt);
+   const UInt_t   treeIdx  = CurrentTreeIdx();
+   const Long64_t eventIdx = CurrentEventIdx();
+   if (fSampling.size() > treeIdx && fSampling.at(treeIdx)) {
+      Long64_t iEvt = fSamplingSelected.at(treeIdx).at( eventIdx )->second;
+      if (UseEventView(treeIdx)) return GetEventView( treeIdx, iEvt );
+      return (*(fEventCollection.at(treeIdx))).at(iEvt);
    }
    else {
-      return (*(fEventCollection.at(fCurrentTreeIdx))).at(fCurrentEventIdx);
+      if (UseEventView(treeIdx)) return GetEventView( treeIdx, eventIdx );
+      return (*(fEventCollection.at(treeIdx))).at(eventIdx);
    }
 }
 
@@ -224,9 +378,11 @@ UInt_t TMVA::DataSet::GetNSpectators() const
 
 void TMVA::DataSet::AddEvent(Event * ev, Types::ETreeType type) 
 {
+   // with columnar storage, the event is added after the views of the columns
+   if (fEventColumns.at(Int_t(type)) && !fHasViews[Int_t(type)]) CreateEventViews(Int_t(type));
    fEventCollection.at(Int_t(type))->push_back(ev);
    if (ev->GetWeight()<0) fHasNegativeEventWeights = kTRUE;
-   fEvtCollIt=fEventCollection.at(fCurrentTreeIdx)->begin();
+   fEvtCollIt=fEventCollection.at(CurrentTreeIdx())->begin();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -243,7 +399,7 @@ void TMVA::DataSet::SetEventCollection(std::vector<TMVA::Event*>* events, Types:
    for (std::vector<Event*>::iterator it = fEventCollection.at(t)->begin(); it < fEventCollection.at(t)->end(); it++) {
       IncrementNClassEvents( t, (*it)->GetClass() );
    }
-   fEvtCollIt=fEventCollection.at(fCurrentTreeIdx)->begin();
+   fEvtCollIt=fEventCollection.at(CurrentTreeIdx())->begin();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -264,6 +420,7 @@ TMVA::Results* TMVA::DataSet::GetResults( const TString & resultsName,
                                           Types::ETreeType type,
                                           Types::EAnalysisType analysistype ) 
 {
+   std::lock_guard<std::mutex> guard(gResultsMutex);
    UInt_t t = TreeIndex(type);
    if (t<fResults.size()) {
       const std::map< TString, Results* >& resultsForType = fResults[t];
@@ -315,6 +472,7 @@ void TMVA::DataSet::DeleteResults( const TString & resultsName,
                                    Types::ETreeType type,
                                    Types::EAnalysisType /* analysistype */ ) 
 {
+   std::lock_guard<std::mutex> guard(gResultsMutex);
    if (fResults.empty()) return;
 
    if (UInt_t(type) > fResults.size()){
@@ -342,6 +500,8 @@ void TMVA::DataSet::DivideTrainingSet( UInt_t blockNum )
    Int_t tOrg = TreeIndex(Types::kTrainingOriginal),tTrn = TreeIndex(Types::kTraining);
    // not changing anything ??
    if (fBlockBelongToTraining.size() == blockNum) return;
+   // the blocks are made of the views of columnar storage
+   if (UseEventView(tTrn)) CreateEventViews(tTrn);
    // storing the original training vector
    if (fBlockBelongToTraining.size() == 1) {
       if (fEventCollection[tOrg] == 0)
@@ -542,33 +702,33 @@ void TMVA::DataSet::CreateSampling() const
 void TMVA::DataSet::EventResult( Bool_t successful, Long64_t evtNumber )
 {
 
-   if (!fSampling.at(fCurrentTreeIdx)) return;
-   if (fSamplingWeight.at(fCurrentTreeIdx) > 0.99999999999) return;
+   if (!fSampling.at(CurrentTreeIdx())) return;
+   if (fSamplingWeight.at(CurrentTreeIdx()) > 0.99999999999) return;
 
    Long64_t start = 0;
-   Long64_t stop  = fSamplingEventList.at(fCurrentTreeIdx).size() -1;
+   Long64_t stop  = fSamplingEventList.at(CurrentTreeIdx()).size() -1;
    if (evtNumber >= 0) {
       start = evtNumber; 
       stop  = evtNumber;
    }
    for ( Long64_t iEvt = start; iEvt <= stop; iEvt++ ){
-      if (Long64_t(fSamplingEventList.at(fCurrentTreeIdx).size()) < iEvt) {
+      if (Long64_t(fSamplingEventList.at(CurrentTreeIdx()).size()) < iEvt) {
          Log() << kWARNING << Form("Dataset[%s] : ",fdsi.GetName()) << "event number (" << iEvt 
                << ") larger than number of sampled events (" 
-               << fSamplingEventList.at(fCurrentTreeIdx).size() << " of tree " << fCurrentTreeIdx << ")" << Endl;
+               << fSamplingEventList.at(CurrentTreeIdx()).size() << " of tree " << CurrentTreeIdx() << ")" << Endl;
          return;
       }
-      Float_t weight = fSamplingEventList.at(fCurrentTreeIdx).at( iEvt )->first;
+      Float_t weight = fSamplingEventList.at(CurrentTreeIdx()).at( iEvt )->first;
       if (!successful) {
          //      weight /= (fSamplingWeight.at(fCurrentTreeIdx)/fSamplingEventList.at(fCurrentTreeIdx).size());
-         weight /= fSamplingWeight.at(fCurrentTreeIdx);
+         weight /= fSamplingWeight.at(CurrentTreeIdx());
          if (weight > 1.0 ) weight = 1.0;
       }
       else {
          //      weight *= (fSamplingWeight.at(fCurrentTreeIdx)/fSamplingEventList.at(fCurrentTreeIdx).size());
-         weight *= fSamplingWeight.at(fCurrentTreeIdx);
+         weight *= fSamplingWeight.at(CurrentTreeIdx());
       }
-      fSamplingEventList.at(fCurrentTreeIdx).at( iEvt )->first = weight;
+      fSamplingEventList.at(CurrentTreeIdx()).at( iEvt )->first = weight;
    }
 }
 
@@ -104,6 +104,7 @@ TMVA::DataSetFactory::DataSetFactory() :
    fVerbose(kFALSE),
    fVerboseLevel(TString("Info")),
    fScaleWithPreselEff(0),
+   fColumnStorage(kFALSE),
    fCurrentTree(0),
    fCurrentEvtIdx(0),
    fInputFormulas(0),
@@ -637,6 +638,9 @@ TMVA::DataSetFactory::InitOptions( TMVA::DataSetInfo& dsi,
 
    splitSpecs.DeclareOptionRef(fScaleWithPreselEff=kFALSE,"ScaleWithPreselEff","Scale the number of requested events by the eff. of the preselection cuts (or not)" );
 
+   splitSpecs.DeclareOptionRef( fColumnStorage=kFALSE, "ColumnStorage",
+                                "Store the training and testing events in one array per variable instead of one object per event, to reduce the memory used by large samples" );
+
    // the number of events
 
    // fill in the numbers
@@ -1364,6 +1368,7 @@ TMVA::DataSetFactory::MixEvents( DataSetInfo& dsi,
    Log() << kINFO << Form("Dataset[%s] : ",dsi.GetName()) << "Create internal testing tree" << Endl;
    ds->SetEventCollection(testingEventVector,  Types::kTesting  );
 
+   if (fColumnStorage) ds->ConvertToColumns();
    
    if (ds->GetNTrainingEvents() < 1){ 
       Log() << kFATAL << "Dataset " << std::string(dsi.GetName()) << " does not have any training events, I better stop here and let you fix that one first " << Endl;
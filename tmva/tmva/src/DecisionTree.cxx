@@ -83,6 +83,13 @@
 #include "TMVA/IPruneTool.h"
 #include "TMVA/CostComplexityPruneTool.h"
 #include "TMVA/ExpectedErrorPruneTool.h"
+#include "TMVA/BinnedEventSample.h"
+
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "tbb/parallel_for.h"
+#endif
 
 const Int_t TMVA::DecisionTree::fgRandomSeed = 0; // set nonzero for debugging and zero for random seeds
 
@@ -136,7 +143,9 @@ TMVA::DecisionTree::DecisionTree():
    fSigClass       (0),
    fTreeID         (0),
    fAnalysisType   (Types::kClassification),
-   fDataSetInfo    (NULL)
+   fDataSetInfo    (NULL),
+   fBinnedSample   (NULL),
+   fBinnedRows     (NULL)
 {
 }
 
@@ -173,7 +182,9 @@ TMVA::DecisionTree::DecisionTree( TMVA::SeparationBase *sepType, Float_t minSize
    fSigClass       (cls),
    fTreeID         (treeID),
    fAnalysisType   (Types::kClassification),
-   fDataSetInfo    (dataInfo)
+   fDataSetInfo    (dataInfo),
+   fBinnedSample   (NULL),
+   fBinnedRows     (NULL)
 {
    if (sepType == NULL) { // it is interpreted as a regression tree, where
                           // currently the separation type (simple least square)
@@ -220,7 +231,9 @@ TMVA::DecisionTree::DecisionTree( const DecisionTree &d ):
    fSigClass   (d.fSigClass),
    fTreeID     (d.fTreeID),
    fAnalysisType(d.fAnalysisType),
-   fDataSetInfo    (d.fDataSetInfo)
+   fDataSetInfo    (d.fDataSetInfo),
+   fBinnedSample   (d.fBinnedSample),
+   fBinnedRows     (d.fBinnedRows)
 {
    this->SetRoot( new TMVA::DecisionTreeNode ( *((DecisionTreeNode*)(d.GetRoot())) ) );
    this->SetParentTreeInNodes();
@@ -293,6 +306,10 @@ TMVA::DecisionTree* TMVA::DecisionTree::CreateFromXML(void* node, UInt_t tmva_Ve
 UInt_t TMVA::DecisionTree::BuildTree( const std::vector<const TMVA::Event*> & eventSample,
                                       TMVA::DecisionTreeNode *node)
 {
+   if (node==NULL && fBinnedSample && fNCuts > 0 && !fUseFisherCuts) {
+      return this->BuildTreeFromHistograms(eventSample);
+   }
+
    if (node==NULL) {
       //start with the root node
       node = new TMVA::DecisionTreeNode();
@@ -523,6 +540,342 @@ UInt_t TMVA::DecisionTree::BuildTree( const std::vector<const TMVA::Event*> & ev
    return fNNodes;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// building the decision tree from histograms of the pre-binned training
+/// events (see SetBinnedSample()). The nodes are split as in TrainNodeFast,
+/// but on the grid of the full sample instead of the range of each node.
+/// The histograms of a node are filled with one pass over the bin index
+/// columns of its events, the histograms of the larger daughter node are
+/// obtained by subtracting those of the smaller one from its parent.
+
+UInt_t TMVA::DecisionTree::BuildTreeFromHistograms( const EventConstList & eventSample )
+{
+   //start with the root node
+   DecisionTreeNode* node = new TMVA::DecisionTreeNode();
+   fNNodes = 1;
+   this->SetRoot(node);
+   // have to use "s" for start as "r" for "root" would be the same as "r" for "right"
+   this->GetRoot()->SetPos('s');
+   this->GetRoot()->SetDepth(0);
+   this->GetRoot()->SetParentTree(this);
+   fMinSize = fMinNodeSize/100. * eventSample.size();
+   if (GetTreeID()==0){
+      Log() << kINFO << "The minimal node size MinNodeSize=" << fMinNodeSize << " fMinNodeSize="<<fMinNodeSize<< "% is translated to an actual number of events = "<< fMinSize<< " for the training sample size of " << eventSample.size() << Endl;
+      Log() << kINFO << "Note: This number will be taken as absolute minimum in the node, " << Endl;
+      Log() << kINFO << "      in terms of 'weighted events' and unweighted ones !! " << Endl;
+   }
+
+   if (eventSample.empty()) Log() << kFATAL << ":<BuildTree> eventsample Size == 0 " << Endl;
+   if (fNvars==0) fNvars = eventSample[0]->GetNVariables(); // should have been set before, but ... well..
+   fVariableImportance.resize(fNvars);
+   if (fBinnedSample->GetNVariables() != fNvars) {
+      Log() << kFATAL << "<BuildTree> the binned sample has " << fBinnedSample->GetNVariables()
+            << " variables instead of " << fNvars << Endl;
+   }
+
+   std::vector<UInt_t> rows;
+   if (fBinnedRows) {
+      if (fBinnedRows->size() != eventSample.size())
+         Log() << kFATAL << "<BuildTree> " << fBinnedRows->size() << " binned rows are given for "
+               << eventSample.size() << " training events" << Endl;
+      rows = *fBinnedRows;
+   }
+   else {
+      if (fBinnedSample->GetNEvents() != eventSample.size())
+         Log() << kFATAL << "<BuildTree> the binned sample has " << fBinnedSample->GetNEvents()
+               << " events instead of " << eventSample.size() << Endl;
+      rows.resize( eventSample.size() );
+      for (UInt_t iev=0; iev<rows.size(); iev++) rows[iev] = iev;
+   }
+
+   std::vector<Double_t> hist;
+   this->BuildNodeFromHistograms( eventSample, rows, node, hist );
+   return fNNodes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// fill the node statistics, and split the node if possible and the daughter
+/// nodes recursively. rows are the rows of the events in the binned sample;
+/// hist are the histograms of the events if already known, otherwise empty.
+/// hist is used as work space and destroyed.
+
+void TMVA::DecisionTree::BuildNodeFromHistograms( const EventConstList & eventSample, const std::vector<UInt_t> & rows,
+                                                  TMVA::DecisionTreeNode *node, std::vector<Double_t> & hist )
+{
+   const UInt_t nevents = eventSample.size();
+
+   Double_t s=0, b=0;
+   Double_t suw=0, buw=0;
+   Double_t sub=0, bub=0; // unboosted!
+   Double_t target=0, target2=0;
+   for (UInt_t iev=0; iev<nevents; iev++) {
+      const TMVA::Event* evt = eventSample[iev];
+      const Double_t weight = evt->GetWeight();
+      if (evt->GetClass() == fSigClass) {
+         s += weight;
+         suw += 1;
+         sub += evt->GetOriginalWeight();
+      }
+      else {
+         b += weight;
+         buw += 1;
+         bub += evt->GetOriginalWeight();
+      }
+      if ( DoRegression() ) {
+         const Double_t tgt = evt->GetTarget(0);
+         target +=weight*tgt;
+         target2+=weight*tgt*tgt;
+      }
+   }
+
+   node->SetNSigEvents(s);
+   node->SetNBkgEvents(b);
+   node->SetNSigEvents_unweighted(suw);
+   node->SetNBkgEvents_unweighted(buw);
+   node->SetNSigEvents_unboosted(sub);
+   node->SetNBkgEvents_unboosted(bub);
+   node->SetPurity();
+   if (node == this->GetRoot()) {
+      node->SetNEvents(s+b);
+      node->SetNEvents_unweighted(suw+buw);
+      node->SetNEvents_unboosted(sub+bub);
+   }
+
+   Double_t separationGain = 0;
+   if ((nevents >= 2*fMinSize  && s+b >= 2*fMinSize) && node->GetDepth() < fMaxDepth
+       && ( ( s!=0 && b !=0 && !DoRegression()) || ( (s+b)!=0 && DoRegression()) ) ) {
+      if (hist.empty()) this->FillHistograms( eventSample, rows, hist );
+      separationGain = this->TrainNodeFromHistograms( hist, node, s, b, suw, buw, target, target2 );
+   }
+
+   if (separationGain < std::numeric_limits<double>::epsilon()) { // it is a leaf node
+      if (DoRegression()) {
+         node->SetSeparationIndex(fRegType->GetSeparationIndex(s+b,target,target2));
+         node->SetResponse(target/(s+b));
+         if( almost_equal_double(target2/(s+b), target/(s+b)*target/(s+b)) ) {
+            node->SetRMS(0);
+         }else{
+            node->SetRMS(TMath::Sqrt(target2/(s+b) - target/(s+b)*target/(s+b)));
+         }
+      }
+      else {
+         node->SetSeparationIndex(fSepType->GetSeparationIndex(s,b));
+         if   (node->GetPurity() > fNodePurityLimit) node->SetNodeType(1);
+         else node->SetNodeType(-1);
+      }
+      if (node->GetDepth() > this->GetTotalTreeDepth()) this->SetTotalTreeDepth(node->GetDepth());
+      return;
+   }
+
+   EventConstList leftSample, rightSample;
+   std::vector<UInt_t> leftRows, rightRows;
+   leftSample.reserve(nevents); rightSample.reserve(nevents);
+   leftRows.reserve(nevents); rightRows.reserve(nevents);
+
+   Double_t nRight=0, nLeft=0;
+   Double_t nRightUnBoosted=0, nLeftUnBoosted=0;
+
+   for (UInt_t ie=0; ie< nevents ; ie++) {
+      if (node->GoesRight(*eventSample[ie])) {
+         rightSample.push_back(eventSample[ie]);
+         rightRows.push_back(rows[ie]);
+         nRight += eventSample[ie]->GetWeight();
+         nRightUnBoosted += eventSample[ie]->GetOriginalWeight();
+      }
+      else {
+         leftSample.push_back(eventSample[ie]);
+         leftRows.push_back(rows[ie]);
+         nLeft += eventSample[ie]->GetWeight();
+         nLeftUnBoosted += eventSample[ie]->GetOriginalWeight();
+      }
+   }
+
+   // sanity check
+   if (leftSample.empty() || rightSample.empty()) {
+      Log() << kFATAL << "<TrainNode> all events went to the same branch when cutting on variable "
+            << node->GetSelector() << " at value " << node->GetCutValue() << Endl;
+   }
+
+   TMVA::DecisionTreeNode *rightNode = new TMVA::DecisionTreeNode(node,'r');
+   fNNodes++;
+   rightNode->SetNEvents(nRight);
+   rightNode->SetNEvents_unboosted(nRightUnBoosted);
+   rightNode->SetNEvents_unweighted(rightSample.size());
+
+   TMVA::DecisionTreeNode *leftNode = new TMVA::DecisionTreeNode(node,'l');
+   fNNodes++;
+   leftNode->SetNEvents(nLeft);
+   leftNode->SetNEvents_unboosted(nLeftUnBoosted);
+   leftNode->SetNEvents_unweighted(leftSample.size());
+
+   node->SetNodeType(0);
+   node->SetLeft(leftNode);
+   node->SetRight(rightNode);
+
+   // histograms of the daughters: fill the smaller one, the larger one is
+   // what remains of the parent. Daughters at the maximal depth are leaves
+   // and need none.
+   std::vector<Double_t> leftHist, rightHist;
+   if (node->GetDepth()+1 < fMaxDepth) {
+      const Bool_t leftIsSmaller = leftSample.size() < rightSample.size();
+      std::vector<Double_t>& smallHist = leftIsSmaller ? leftHist : rightHist;
+      std::vector<Double_t>& largeHist = leftIsSmaller ? rightHist : leftHist;
+      if (leftIsSmaller) this->FillHistograms( leftSample, leftRows, smallHist );
+      else               this->FillHistograms( rightSample, rightRows, smallHist );
+      largeHist.swap( hist );
+      for (UInt_t i=0; i<largeHist.size(); i++) largeHist[i] -= smallHist[i];
+   }
+   std::vector<Double_t>().swap( hist );
+
+   this->BuildNodeFromHistograms( rightSample, rightRows, rightNode, rightHist );
+   std::vector<Double_t>().swap( rightHist );
+   this->BuildNodeFromHistograms( leftSample, leftRows, leftNode, leftHist );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// fill the histograms of all variables for the given events. The event
+/// weights, classes and targets are gathered once, then each variable is
+/// filled in one pass over its bin index column; with implicit
+/// multi-threading enabled the variables are filled in parallel.
+
+void TMVA::DecisionTree::FillHistograms( const EventConstList & eventSample, const std::vector<UInt_t> & rows,
+                                         std::vector<Double_t> & hist ) const
+{
+   const UInt_t nevents = eventSample.size();
+   const Bool_t doRegression = DoRegression();
+
+   std::vector<Double_t> weight(nevents), tgt(doRegression ? nevents : 0);
+   std::vector<UChar_t>  isSignal(nevents);
+   for (UInt_t iev=0; iev<nevents; iev++) {
+      weight[iev]   = eventSample[iev]->GetWeight();
+      isSignal[iev] = eventSample[iev]->GetClass() == fSigClass;
+      if (doRegression) tgt[iev] = eventSample[iev]->GetTarget(0);
+   }
+
+   hist.assign( 6*fBinnedSample->GetNTotalBins(), 0. );
+
+   auto fillVariable = [&]( UInt_t ivar ) {
+      const UChar_t* column = fBinnedSample->GetColumn(ivar);
+      Double_t* h = &hist[6*fBinnedSample->GetOffset(ivar)];
+      for (UInt_t iev=0; iev<nevents; iev++) {
+         Double_t* bin = h + 6*column[rows[iev]];
+         if (isSignal[iev]) { bin[0] += weight[iev]; bin[2] += 1; }
+         else               { bin[1] += weight[iev]; bin[3] += 1; }
+         if (doRegression) {
+            bin[4] += weight[iev]*tgt[iev];
+            bin[5] += weight[iev]*tgt[iev]*tgt[iev];
+         }
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && ULong64_t(nevents)*fNvars > 100000) {
+      tbb::parallel_for( UInt_t(0), fNvars, fillVariable );
+      return;
+   }
+#endif
+   for (UInt_t ivar=0; ivar<fNvars; ivar++) fillVariable(ivar);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// decide how to split a node from the histograms of its events: for each
+/// variable the cuts between the bins are scanned as in TrainNodeFast, and
+/// the best cut of the best variable is set in the node
+
+Double_t TMVA::DecisionTree::TrainNodeFromHistograms( const std::vector<Double_t> & hist, TMVA::DecisionTreeNode *node,
+                                                      Double_t nTotS, Double_t nTotB,
+                                                      Double_t nTotS_unWeighted, Double_t nTotB_unWeighted,
+                                                      Double_t target, Double_t target2 )
+{
+   std::vector<Bool_t> useVariable(fNvars+1, kTRUE);
+   if (fRandomisedTree) { // choose for each node splitting a random subset of variables to choose from
+      Bool_t *useVar = new Bool_t[fNvars+1];
+      UInt_t *mapVar = new UInt_t[fNvars+1];
+      UInt_t tmp=fUseNvars;
+      GetRandomisedVariables(useVar,mapVar,tmp);
+      for (UInt_t ivar=0; ivar < fNvars; ivar++) useVariable[ivar] = useVar[ivar];
+      delete [] useVar;
+      delete [] mapVar;
+   }
+
+   Double_t separationGainTotal = -1;
+   Int_t    mxVar = -1, mxBin = -1;
+   Double_t mxSelS = 0, mxSelB = 0;
+
+   for (UInt_t ivar=0; ivar < fNvars; ivar++) {
+      if (!useVariable[ivar]) continue;
+      const Double_t* h = &hist[6*fBinnedSample->GetOffset(ivar)];
+      const UInt_t nBins = fBinnedSample->GetNBins(ivar);
+
+      // cumulative sums of the bins 0..iBin
+      Double_t slW=0, blW=0, sl=0, bl=0, t=0, t2=0;
+      Double_t separationGain = -1;
+      Int_t cutIndex = -1;
+      Double_t cutSelS = 0, cutSelB = 0;
+      for (UInt_t iBin=0; iBin+1<nBins; iBin++) { // the last bin contains "all events" -->skip
+         slW += h[6*iBin];   blW += h[6*iBin+1];
+         sl  += h[6*iBin+2]; bl  += h[6*iBin+3];
+         t   += h[6*iBin+4]; t2  += h[6*iBin+5];
+
+         const Double_t sr  = nTotS_unWeighted-sl;
+         const Double_t br  = nTotB_unWeighted-bl;
+         const Double_t srW = nTotS-slW;
+         const Double_t brW = nTotB-blW;
+         // only allow splits where both daughter nodes match the specified miniumum number
+         // of events, and which do not leave one of them empty
+         if ( (sl+bl)>0 && (sr+br)>0
+              && ((sl+bl)>=fMinSize && (sr+br)>=fMinSize)
+              && ((slW+blW)>=fMinSize && (srW+brW)>=fMinSize) ) {
+            Double_t sepTmp;
+            if (DoRegression()) {
+               sepTmp = fRegType->GetSeparationGain(slW+blW, t, t2, nTotS+nTotB, target, target2);
+            } else {
+               sepTmp = fSepType->GetSeparationGain(slW, blW, nTotS, nTotB);
+            }
+            if (separationGain < sepTmp) {
+               separationGain = sepTmp;
+               cutIndex       = iBin;
+               cutSelS        = slW;
+               cutSelB        = blW;
+            }
+         }
+      }
+
+      if (cutIndex >= 0 && separationGainTotal < separationGain) {
+         separationGainTotal = separationGain;
+         mxVar  = ivar;
+         mxBin  = cutIndex;
+         mxSelS = cutSelS;
+         mxSelB = cutSelB;
+      }
+   }
+
+   if (mxVar < 0) return 0;
+
+   Bool_t cutType = kTRUE;
+   if (DoRegression()) {
+      node->SetSeparationIndex(fRegType->GetSeparationIndex(nTotS+nTotB,target,target2));
+      node->SetResponse(target/(nTotS+nTotB));
+      if ( almost_equal_double(target2/(nTotS+nTotB), target/(nTotS+nTotB)*target/(nTotS+nTotB)) ) {
+         node->SetRMS(0);
+      }else{
+         node->SetRMS(TMath::Sqrt(target2/(nTotS+nTotB) - target/(nTotS+nTotB)*target/(nTotS+nTotB)));
+      }
+   }
+   else {
+      node->SetSeparationIndex(fSepType->GetSeparationIndex(nTotS,nTotB));
+      cutType = (mxSelS/nTotS > mxSelB/nTotB);
+   }
+   node->SetSelector((UInt_t)mxVar);
+   node->SetCutValue(fBinnedSample->GetCutValue(mxVar,mxBin));
+   node->SetCutType(cutType);
+   node->SetSeparationGain(separationGainTotal);
+   node->SetNFisherCoeff(0);
+   fVariableImportance[mxVar] += separationGainTotal*separationGainTotal * (nTotS+nTotB) * (nTotS+nTotB) ;
+
+   return separationGainTotal;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void TMVA::DecisionTree::FillTree( const std::vector<TMVA::Event*> & eventSample )
@@ -40,6 +40,7 @@
 #include <exception>
 #include <iomanip>
 #include <limits>
+#include <mutex>
 
 #include "TMVA/Types.h"
 #include "TMVA/MsgLogger.h"
@@ -51,8 +52,35 @@ using std::string;
 
 ClassImp(TMVA::DecisionTreeNode)
 
-bool     TMVA::DecisionTreeNode::fgIsTraining = false;
+std::atomic<Bool_t> TMVA::DecisionTreeNode::fgIsTraining(kFALSE);
 UInt_t   TMVA::DecisionTreeNode::fgTmva_Version_Code = 0;
+
+static std::mutex gTrainingMutex;
+static Int_t      gNTrainings = 0;   // number of tree trainings in progress
+
+////////////////////////////////////////////////////////////////////////////////
+/// mark the start of a tree training: the nodes created from now on carry
+/// the training information
+
+void TMVA::DecisionTreeNode::BeginTraining()
+{
+   std::lock_guard<std::mutex> guard(gTrainingMutex);
+   gNTrainings++;
+   fgIsTraining = kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// mark the end of a tree training; the flag is lowered only when no other
+/// training (e.g. of another method trained concurrently by the Factory) is
+/// still running
+
+void TMVA::DecisionTreeNode::EndTraining()
+{
+   std::lock_guard<std::mutex> guard(gTrainingMutex);
+   if (gNTrainings > 0) gNTrainings--;
+   if (gNTrainings == 0) fgIsTraining = kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// constructor of an essentially "empty" node floating in space
 
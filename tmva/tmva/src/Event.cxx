@@ -29,16 +29,24 @@
  **********************************************************************************/
 
 #include "TMVA/Event.h"
+#include "TMVA/EventColumns.h"
 #include "TMVA/Tools.h"
 #include <iostream>
 #include "assert.h"
 #include <iomanip>
 #include <cassert>
+#include <stdexcept>
+#include <mutex>
 #include "TCut.h"
 
 Bool_t TMVA::Event::fgIsTraining = kFALSE;
 Bool_t TMVA::Event::fgIgnoreNegWeightsInTraining = kFALSE;
 
+namespace {
+   // the vectors of the views shared between threads are filled under this lock
+   std::mutex gFillMutex;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// copy constructor
 
@@ -48,6 +56,9 @@ TMVA::Event::Event()
      fTargets(),
      fSpectators(),
      fVariableArrangement(0),
+     fColumns(0),
+     fRow(0),
+     fFilled(kFALSE),
      fClass(0),
      fWeight(1.0),
      fBoostWeight(1.0),
@@ -69,6 +80,9 @@ TMVA::Event::Event( const std::vector<Float_t>& ev,
      fTargets(tg),
      fSpectators(0),
      fVariableArrangement(0),
+     fColumns(0),
+     fRow(0),
+     fFilled(kFALSE),
      fClass(cls),
      fWeight(weight),
      fBoostWeight(boostweight),
@@ -91,6 +105,9 @@ TMVA::Event::Event( const std::vector<Float_t>& ev,
      fTargets(tg),
      fSpectators(vi),
      fVariableArrangement(0),
+     fColumns(0),
+     fRow(0),
+     fFilled(kFALSE),
      fClass(cls),
      fWeight(weight),
      fBoostWeight(boostweight),
@@ -111,6 +128,9 @@ TMVA::Event::Event( const std::vector<Float_t>& ev,
      fTargets(0),
      fSpectators(0),
      fVariableArrangement(0),
+     fColumns(0),
+     fRow(0),
+     fFilled(kFALSE),
      fClass(cls),
      fWeight(weight),
      fBoostWeight(boostweight),
@@ -128,6 +148,9 @@ TMVA::Event::Event( const std::vector<Float_t*>*& evdyn, UInt_t nvar )
      fTargets(0),
      fSpectators(evdyn->size()-nvar),
      fVariableArrangement(0),
+     fColumns(0),
+     fRow(0),
+     fFilled(kFALSE),
      fClass(0),
      fWeight(0),
      fBoostWeight(0),
@@ -137,6 +160,29 @@ TMVA::Event::Event( const std::vector<Float_t*>*& evdyn, UInt_t nvar )
    fValuesDynamic = (std::vector<Float_t*>*) evdyn;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// constructor of a view of row ievt of a columnar event storage: the
+/// values, targets, spectators and weights are read from (and written to)
+/// the columns, the event itself holds no copy of them
+
+TMVA::Event::Event( EventColumns* columns, Long64_t ievt )
+   : fValues(),
+     fValuesDynamic(0),
+     fTargets(),
+     fSpectators(),
+     fVariableArrangement(0),
+     fColumns(0),
+     fRow(0),
+     fFilled(kFALSE),
+     fClass(0),
+     fWeight(1.0),
+     fBoostWeight(1.0),
+     fDynamic(kFALSE),
+     fDoNotBoost(kFALSE)
+{
+   SetView( columns, ievt );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// copy constructor
 
@@ -146,6 +192,9 @@ TMVA::Event::Event( const Event& event )
      fTargets(event.fTargets),
      fSpectators(event.fSpectators),
      fVariableArrangement(event.fVariableArrangement),
+     fColumns(0),
+     fRow(0),
+     fFilled(kFALSE),
      fClass(event.fClass),
      fWeight(event.fWeight),
      fBoostWeight(event.fBoostWeight),
@@ -172,6 +221,38 @@ TMVA::Event::Event( const Event& event )
       fDynamic=kFALSE;
       fValuesDynamic=NULL;
    }
+   if (event.fColumns) {
+      fColumns = event.fColumns;
+      fRow     = event.fRow;
+      CopyFromColumns();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// assignment, member by member as the implicit one, except that the values
+/// of a view are copied into the event instead of making it a view as well
+
+TMVA::Event& TMVA::Event::operator=( const Event& event )
+{
+   if (this == &event) return *this;
+
+   fValues              = event.fValues;
+   fValuesRearranged    = event.fValuesRearranged;
+   fValuesDynamic       = event.fValuesDynamic;
+   fTargets             = event.fTargets;
+   fSpectators          = event.fSpectators;
+   fVariableArrangement = event.fVariableArrangement;
+   fColumns             = event.fColumns;
+   fRow                 = event.fRow;
+   fClass               = event.fClass;
+   fWeight              = event.fWeight;
+   fBoostWeight         = event.fBoostWeight;
+   fDynamic             = event.fDynamic;
+   fDoNotBoost          = event.fDoNotBoost;
+   fFilled              = kFALSE;
+
+   if (fColumns) CopyFromColumns();
+   return *this;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -181,6 +262,84 @@ TMVA::Event::~Event()
 {
    delete fValuesDynamic;
 }
+////////////////////////////////////////////////////////////////////////////////
+/// make the event a view of row ievt of the columns; the class and the
+/// weight are cached, all other quantities are read from the columns
+
+void TMVA::Event::SetView( EventColumns* columns, Long64_t ievt )
+{
+   fColumns = columns;
+   fRow     = ievt;
+   fFilled  = kFALSE;
+   fClass   = columns->GetClass( ievt );
+   fWeight  = columns->GetWeight( ievt );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// copy the row of a view into the event, which then no longer is a view
+
+void TMVA::Event::CopyFromColumns()
+{
+   const EventColumns* columns = fColumns;
+   const Long64_t ievt = fRow;
+   fColumns = 0;
+   fRow     = 0;
+
+   fValues.resize( columns->GetNVariables() );
+   for (UInt_t ivar=0; ivar<fValues.size(); ivar++) fValues[ivar] = columns->GetValue( columns->VariableColumn(ivar), ievt );
+   fTargets.resize( columns->GetNTargets() );
+   for (UInt_t itgt=0; itgt<fTargets.size(); itgt++) fTargets[itgt] = columns->GetValue( columns->TargetColumn(itgt), ievt );
+   fSpectators.resize( columns->GetNSpectators() );
+   for (UInt_t ispec=0; ispec<fSpectators.size(); ispec++) fSpectators[ispec] = columns->GetValue( columns->SpectatorColumn(ispec), ievt );
+
+   fClass       = columns->GetClass( ievt );
+   fWeight      = columns->GetWeight( ievt );
+   fBoostWeight = columns->GetBoostWeight( ievt );
+   fFilled      = kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// fill the value, target and spectator vectors of a view once, for the
+/// accessors returning them. A view of a collection may be read by several
+/// threads, so the first filling is done under a lock and the vectors are
+/// not touched afterwards, except by the setters of the view.
+
+void TMVA::Event::FillFromColumns() const
+{
+   if (fFilled) return;
+
+   std::lock_guard<std::mutex> guard(gFillMutex);
+   if (fFilled) return;
+
+   fValues.resize( fColumns->GetNVariables() );
+   for (UInt_t ivar=0; ivar<fValues.size(); ivar++) fValues[ivar] = GetColumnValue( 'v', ivar );
+   fTargets.resize( fColumns->GetNTargets() );
+   for (UInt_t itgt=0; itgt<fTargets.size(); itgt++) fTargets[itgt] = GetColumnValue( 't', itgt );
+   fSpectators.resize( fColumns->GetNSpectators() );
+   for (UInt_t ispec=0; ispec<fSpectators.size(); ispec++) fSpectators[ispec] = GetColumnValue( 's', ispec );
+   fFilled = kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// value of variable ('v'), target ('t') or spectator ('s') idx of a view;
+/// as for the vectors of an event, std::out_of_range is thrown for an
+/// index beyond the stored ones
+
+Float_t TMVA::Event::GetColumnValue( Char_t type, UInt_t idx ) const
+{
+   switch (type) {
+   case 'v':
+      if (idx >= fColumns->GetNVariables()) throw std::out_of_range("TMVA::Event::GetValue");
+      return fColumns->GetValue( fColumns->VariableColumn(idx), fRow );
+   case 't':
+      if (idx >= fColumns->GetNTargets()) throw std::out_of_range("TMVA::Event::GetTarget");
+      return fColumns->GetValue( fColumns->TargetColumn(idx), fRow );
+   default:
+      if (idx >= fColumns->GetNSpectators()) throw std::out_of_range("TMVA::Event::GetSpectator");
+      return fColumns->GetValue( fColumns->SpectatorColumn(idx), fRow );
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// set the variable arrangement
 
@@ -197,6 +356,16 @@ void TMVA::Event::SetVariableArrangement( std::vector<UInt_t>* const m ) const {
 
 void TMVA::Event::CopyVarValues( const Event& other )
 {
+   if (other.fColumns) {
+      fColumns = other.fColumns;
+      fRow     = other.fRow;
+      CopyFromColumns();
+      fDynamic = kFALSE;
+      fValuesDynamic = NULL;
+      return;
+   }
+   fColumns     = 0;
+   fRow         = 0;
    fValues      = other.fValues;
    fTargets     = other.fTargets;
    fSpectators  = other.fSpectators;
@@ -223,6 +392,7 @@ void TMVA::Event::CopyVarValues( const Event& other )
    fClass       = other.fClass;
    fWeight      = other.fWeight;
    fBoostWeight = other.fBoostWeight;
+   fFilled      = kFALSE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -231,6 +401,11 @@ void TMVA::Event::CopyVarValues( const Event& other )
 Float_t TMVA::Event::GetValue( UInt_t ivar ) const
 {
    Float_t retval;
+   if (fColumns) {
+      if (fVariableArrangement==0) return GetColumnValue( 'v', ivar );
+      UInt_t mapIdx = (*fVariableArrangement)[ivar];
+      return ( mapIdx<fColumns->GetNVariables() ) ? GetColumnValue( 'v', mapIdx ) : GetColumnValue( 's', mapIdx-fColumns->GetNVariables() );
+   }
    if (fVariableArrangement==0) {
       retval = fDynamic ? ( *((*fValuesDynamic).at(ivar)) ) : fValues.at(ivar); 
    } 
@@ -255,8 +430,9 @@ Float_t TMVA::Event::GetValue( UInt_t ivar ) const
 
 Float_t TMVA::Event::GetSpectator( UInt_t ivar) const 
 {
-   if (fDynamic) return *(fValuesDynamic->at(GetNVariables()+ivar));
-   else          return fSpectators.at(ivar);
+   if (fColumns)      return GetColumnValue( 's', ivar );
+   else if (fDynamic) return *(fValuesDynamic->at(GetNVariables()+ivar));
+   else               return fSpectators.at(ivar);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -264,6 +440,15 @@ Float_t TMVA::Event::GetSpectator( UInt_t ivar) const
 
 const std::vector<Float_t>& TMVA::Event::GetValues() const
 {
+   if (fColumns) {
+      FillFromColumns();
+      if (fVariableArrangement==0) return fValues;
+
+      // as for the other events, the arranged values are collected on each call
+      fValuesRearranged.clear();
+      for (UInt_t i=0; i< fVariableArrangement->size(); i++) fValuesRearranged.push_back( GetValue(i) );
+      return fValuesRearranged;
+   }
    if (fVariableArrangement==0) {
 
       if (fDynamic) {
@@ -297,6 +482,24 @@ const std::vector<Float_t>& TMVA::Event::GetValues() const
    return fValues;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// return target vector
+
+const std::vector<Float_t>& TMVA::Event::GetTargets() const
+{
+   if (fColumns) FillFromColumns();
+   return fTargets;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// return spectator vector
+
+const std::vector<Float_t>& TMVA::Event::GetSpectators() const
+{
+   if (fColumns) FillFromColumns();
+   return fSpectators;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// accessor to the number of variables 
 
@@ -304,8 +507,9 @@ UInt_t TMVA::Event::GetNVariables() const
 {
    // if variables have to arranged (as it is the case for the
    // composite classifier) the number of the variables changes
-   if (fVariableArrangement==0) return fValues.size();
-   else                         return fVariableArrangement->size();
+   if (fVariableArrangement!=0) return fVariableArrangement->size();
+   else if (fColumns)           return fColumns->GetNVariables();
+   else                         return fValues.size();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -313,7 +517,7 @@ UInt_t TMVA::Event::GetNVariables() const
 
 UInt_t TMVA::Event::GetNTargets() const 
 {
-   return fTargets.size();
+   return fColumns ? fColumns->GetNTargets() : fTargets.size();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -324,6 +528,10 @@ UInt_t TMVA::Event::GetNSpectators() const
    // if variables have to arranged (as it is the case for the
    // composite classifier) the number of the variables changes
 
+   if (fColumns) {
+      if (fVariableArrangement==0) return fColumns->GetNSpectators();
+      else                         return fColumns->GetNVariables()-fVariableArrangement->size();
+   }
    if (fVariableArrangement==0) return fSpectators.size();
    else                         return fValues.size()-fVariableArrangement->size();
 }
@@ -334,6 +542,13 @@ UInt_t TMVA::Event::GetNSpectators() const
 
 void TMVA::Event::SetVal( UInt_t ivar, Float_t val ) 
 {
+   if (fColumns) {
+      // the columns of a view cannot grow
+      if (ivar >= fColumns->GetNVariables()) throw std::out_of_range("TMVA::Event::SetVal");
+      fColumns->SetValue( fColumns->VariableColumn(ivar), fRow, val );
+      if (fFilled) fValues[ivar] = val;
+      return;
+   }
    if ((fDynamic ?( (*fValuesDynamic).size() ) : fValues.size())<=ivar)
       (fDynamic ?( (*fValuesDynamic).resize(ivar+1) ) : fValues.resize(ivar+1));
 
@@ -353,6 +568,12 @@ void TMVA::Event::Print( std::ostream& o ) const
 
 void TMVA::Event::SetTarget( UInt_t itgt, Float_t value ) 
 { 
+   if (fColumns) {
+      if (itgt >= fColumns->GetNTargets()) throw std::out_of_range("TMVA::Event::SetTarget");
+      fColumns->SetValue( fColumns->TargetColumn(itgt), fRow, value );
+      if (fFilled) fTargets[itgt] = value;
+      return;
+   }
    if (fTargets.size() <= itgt) fTargets.resize( itgt+1 );
    fTargets.at(itgt) = value;
 }
@@ -362,6 +583,12 @@ void TMVA::Event::SetTarget( UInt_t itgt, Float_t value )
 
 void TMVA::Event::SetSpectator( UInt_t ivar, Float_t value ) 
 { 
+   if (fColumns) {
+      if (ivar >= fColumns->GetNSpectators()) throw std::out_of_range("TMVA::Event::SetSpectator");
+      fColumns->SetValue( fColumns->SpectatorColumn(ivar), fRow, value );
+      if (fFilled) fSpectators[ivar] = value;
+      return;
+   }
    if (fSpectators.size() <= ivar) fSpectators.resize( ivar+1 );
    fSpectators.at(ivar) = value;
 }
@@ -375,7 +602,8 @@ void TMVA::Event::SetSpectator( UInt_t ivar, Float_t value )
 
 Double_t TMVA::Event::GetWeight() const 
 {
-   return (fgIgnoreNegWeightsInTraining && fgIsTraining && fWeight < 0) ? 0. : fWeight*fBoostWeight;
+   const Double_t boostWeight = fColumns ? fColumns->GetBoostWeight(fRow) : fBoostWeight;
+   return (fgIgnoreNegWeightsInTraining && fgIsTraining && fWeight < 0) ? 0. : fWeight*boostWeight;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -402,14 +630,17 @@ void TMVA::Event::SetIgnoreNegWeightsInTraining(Bool_t b)
 
 std::ostream& TMVA::operator << ( std::ostream& os, const TMVA::Event& event )
 { 
-   os << "Variables [" << event.fValues.size() << "]:";
-   for (UInt_t ivar=0; ivar<event.fValues.size(); ++ivar)
+   const UInt_t nvar  = event.fColumns ? event.fColumns->GetNVariables()  : event.fValues.size();
+   const UInt_t ntgt  = event.fColumns ? event.fColumns->GetNTargets()    : event.fTargets.size();
+   const UInt_t nspec = event.fColumns ? event.fColumns->GetNSpectators() : event.fSpectators.size();
+   os << "Variables [" << nvar << "]:";
+   for (UInt_t ivar=0; ivar<nvar; ++ivar)
       os << " " << std::setw(10) << event.GetValue(ivar);
-   os << ", targets [" << event.fTargets.size() << "]:";
-   for (UInt_t ivar=0; ivar<event.fTargets.size(); ++ivar)
+   os << ", targets [" << ntgt << "]:";
+   for (UInt_t ivar=0; ivar<ntgt; ++ivar)
       os << " " << std::setw(10) << event.GetTarget(ivar);
-   os << ", spectators ["<< event.fSpectators.size() << "]:";
-   for (UInt_t ivar=0; ivar<event.fSpectators.size(); ++ivar)
+   os << ", spectators ["<< nspec << "]:";
+   for (UInt_t ivar=0; ivar<nspec; ++ivar)
       os << " " << std::setw(10) << event.GetSpectator(ivar);
    os << ", weight: " << event.GetWeight();
    os << ", class: " << event.GetClass();
@@ -0,0 +1,156 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : EventColumns                                                          *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Implementation (see header for description)                               *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+//_______________________________________________________________________
+//
+// EventColumns
+//
+// The variables, targets and spectators of a set of events are stored in
+// one contiguous Float_t array each, indexed by the row of the event,
+// next to the arrays of the classes, weights and boost weights. Compared
+// to one Event object per event, with its own value vectors, this avoids
+// the per-event heap allocations, and lets the variable transformations
+// process a whole column in one pass.
+//
+// An Event constructed as a view of a row (Event::Event(EventColumns*,
+// Long64_t)) reads its values from the columns; setting its values or
+// its boost weight writes them to the columns.
+//_______________________________________________________________________
+
+#include <stdexcept>
+
+#include "TMVA/EventColumns.h"
+#include "TMVA/Event.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/// constructor of an empty storage
+
+TMVA::EventColumns::EventColumns( UInt_t nvar, UInt_t ntgt, UInt_t nspec )
+   : fNVariables( nvar ),
+     fNTargets( ntgt ),
+     fNSpectators( nspec ),
+     fColumns( nvar+ntgt+nspec ),
+     fViews( 0 ),
+     fNViews( 0 )
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// copy constructor
+
+TMVA::EventColumns::EventColumns( const EventColumns& other )
+   : fNVariables( other.fNVariables ),
+     fNTargets( other.fNTargets ),
+     fNSpectators( other.fNSpectators ),
+     fColumns( other.fColumns ),
+     fClass( other.fClass ),
+     fWeight( other.fWeight ),
+     fBoostWeight( other.fBoostWeight ),
+     fViews( 0 ),
+     fNViews( 0 )
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// destructor
+
+TMVA::EventColumns::~EventColumns()
+{
+   delete [] fViews;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// reserve the memory for nevents events
+
+void TMVA::EventColumns::Reserve( Long64_t nevents )
+{
+   for (UInt_t icol=0; icol<fColumns.size(); icol++) fColumns[icol].reserve( nevents );
+   fClass.reserve( nevents );
+   fWeight.reserve( nevents );
+   fBoostWeight.reserve( nevents );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// append a copy of the event as a new row
+
+void TMVA::EventColumns::AddEvent( const Event& ev )
+{
+   for (UInt_t ivar=0; ivar<fNVariables; ivar++)
+      fColumns[VariableColumn(ivar)].push_back( ev.GetValue(ivar) );
+   for (UInt_t itgt=0; itgt<fNTargets; itgt++)
+      fColumns[TargetColumn(itgt)].push_back( ev.GetTarget(itgt) );
+   for (UInt_t ispec=0; ispec<fNSpectators; ispec++)
+      fColumns[SpectatorColumn(ispec)].push_back( ev.GetSpectator(ispec) );
+
+   // the boost weight is stored as it is, GetBoostWeight() returns it bounded from below
+   fClass.push_back( ev.GetClass() );
+   fWeight.push_back( ev.GetOriginalWeight() );
+   fBoostWeight.push_back( ev.fColumns ? ev.fColumns->GetBoostWeight(ev.fRow) : ev.fBoostWeight );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// release the memory reserved beyond the stored events
+
+void TMVA::EventColumns::Shrink()
+{
+   for (UInt_t icol=0; icol<fColumns.size(); icol++) fColumns[icol].shrink_to_fit();
+   fClass.shrink_to_fit();
+   fWeight.shrink_to_fit();
+   fBoostWeight.shrink_to_fit();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// vector of one view event per row, owned by the caller. The views are
+/// allocated in a single block on the first call and are owned by the
+/// columns: they must not be deleted, see IsView(). All rows must be added
+/// before the first call.
+
+std::vector<TMVA::Event*>* TMVA::EventColumns::CreateViews()
+{
+   const Long64_t nevents = GetNEvents();
+   if (fViews==0 && nevents>0) {
+      fViews  = new Event[nevents];
+      fNViews = nevents;
+      for (Long64_t ievt=0; ievt<nevents; ievt++) fViews[ievt].SetView( this, ievt );
+   }
+   if (fNViews != nevents) throw std::logic_error("TMVA::EventColumns::CreateViews: rows added after the views");
+
+   std::vector<Event*>* views = new std::vector<Event*>( nevents );
+   for (Long64_t ievt=0; ievt<nevents; ievt++) (*views)[ievt] = fViews+ievt;
+   return views;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// true if the event is one of the views created by CreateViews(), which
+/// are deleted with the columns
+
+Bool_t TMVA::EventColumns::IsView( const Event* ev ) const
+{
+   return fViews!=0 && ev>=fViews && ev<fViews+fNViews;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// bytes allocated for the columns
+
+Long64_t TMVA::EventColumns::GetMemorySize() const
+{
+   Long64_t size = 0;
+   for (UInt_t icol=0; icol<fColumns.size(); icol++) size += fColumns[icol].capacity()*sizeof(Float_t);
+   size += fClass.capacity()*sizeof(UInt_t);
+   size += fWeight.capacity()*sizeof(Double_t);
+   size += fBoostWeight.capacity()*sizeof(Double_t);
+   return size;
+}
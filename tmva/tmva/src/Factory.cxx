@@ -60,6 +60,7 @@
 #include "TMath.h"
 #include "TObjString.h"
 #include "TSystem.h"
+#include "TStopwatch.h"
 
 #include "TMVA/Factory.h"
 #include "TMVA/ClassifierFactory.h"
@@ -76,6 +77,7 @@
 #include "TMVA/DataLoader.h"
 #include "TMVA/MethodBoost.h"
 #include "TMVA/MethodCategory.h"
+#include "TMVA/MethodCuts.h"
 #include "TMVA/ROCCalc.h"
 #include "TMVA/ROCCurve.h"
 #include "TMVA/MsgLogger.h"
@@ -87,8 +89,13 @@
 #include "TMVA/ResultsClassification.h"
 #include "TMVA/ResultsRegression.h"
 #include "TMVA/ResultsMulticlass.h"
+#include <algorithm>
 #include <list>
 #include <bitset>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 #include "TMVA/Types.h"
 
@@ -124,7 +131,8 @@ TMVA::Factory::Factory( TString jobName, TFile* theTargetFile, TString theOption
    fDataAssignType       ( kAssignEvents ),
    fATreeEvent           ( NULL ),
    fAnalysisType         ( Types::kClassification ),
-   fModelPersistence     (kTRUE)
+   fModelPersistence     (kTRUE),
+   fParallelTraining     (kFALSE)
 {
    fgTargetFile = theTargetFile;
 
@@ -161,6 +169,9 @@ TMVA::Factory::Factory( TString jobName, TFile* theTargetFile, TString theOption
    DeclareOptionRef( fModelPersistence,
                      "ModelPersistence",
                      "Option to save the trained model in xml file or using serialization");
+   DeclareOptionRef( fParallelTraining,
+                     "ParallelTraining",
+                     "Train and test the booked methods concurrently, each on its own thread (default: False)" );
 
    TString analysisType("Auto");
    DeclareOptionRef( analysisType,
@@ -202,7 +213,8 @@ TMVA::Factory::Factory( TString jobName, TString theOption )
    fDataAssignType       ( kAssignEvents ),
    fATreeEvent           ( NULL ),
    fAnalysisType         ( Types::kClassification ),
-   fModelPersistence     (kTRUE)
+   fModelPersistence     (kTRUE),
+   fParallelTraining     (kFALSE)
 {
    fgTargetFile = 0;
 
@@ -238,6 +250,9 @@ TMVA::Factory::Factory( TString jobName, TString theOption )
    DeclareOptionRef( fModelPersistence,
                      "ModelPersistence",
                      "Option to save the trained model in xml file or using serialization");
+   DeclareOptionRef( fParallelTraining,
+                     "ParallelTraining",
+                     "Train and test the booked methods concurrently, each on its own thread (default: False)" );
    
    TString analysisType("Auto");
    DeclareOptionRef( analysisType,
@@ -578,7 +593,8 @@ void TMVA::Factory::WriteDataInformation(DataSetInfo&     fDataSetInfo)
       if (trfS.BeginsWith('I')) identityTrHandler = trfs.back();
    }
 
-   const std::vector<Event*>& inputEvents = fDataSetInfo.GetDataSet()->GetEventCollection();
+   // columnar events are read row by row instead of through the event collection
+   const EventColumns* inputColumns = fDataSetInfo.GetDataSet()->GetEventColumns();
 
    // apply all transformations
    std::vector<TMVA::TransformationHandler*>::iterator trfIt = trfs.begin();
@@ -586,7 +602,8 @@ void TMVA::Factory::WriteDataInformation(DataSetInfo&     fDataSetInfo)
    for (;trfIt != trfs.end(); trfIt++) {
       // setting a Root dir causes the variables distributions to be saved to the root file
       (*trfIt)->SetRootDir(RootBaseDir()->GetDirectory(fDataSetInfo.GetName()));// every dataloader have its own dir
-      (*trfIt)->CalcTransformations(inputEvents);      
+      if (inputColumns) (*trfIt)->CalcTransformations(*inputColumns);
+      else              (*trfIt)->CalcTransformations(fDataSetInfo.GetDataSet()->GetEventCollection());
    }
    if(identityTrHandler) identityTrHandler->PrintVariableRanking();
 
@@ -849,7 +866,8 @@ void TMVA::Factory::TrainAllMethods()
       MVector *methods=itrMap->second;
       MVector::iterator itrMethod;
 
-      // iterate over methods and train
+      // iterate over methods and collect the ones to train
+      std::vector<MethodBase*> trainMethods;
       for( itrMethod = methods->begin(); itrMethod != methods->end(); itrMethod++ ) {
 	  Event::SetIsTraining(kTRUE);
 	  MethodBase* mva = dynamic_cast<MethodBase*>(*itrMethod);
@@ -878,13 +896,14 @@ void TMVA::Factory::TrainAllMethods()
 	    continue;
 	  }
 
-	  Log() << kINFO << "Train method: " << mva->GetMethodName() << " for "
-		<< (fAnalysisType == Types::kRegression ? "Regression" :
-		    (fAnalysisType == Types::kMulticlass ? "Multiclass classification" : "Classification")) << Endl;
-          mva->TrainMethod();
-          Log() << kINFO << "Training finished" << Endl;
+	  // the output directory of the method is created now, not by its training thread
+	  if (fParallelTraining && !IsSilentFile()) mva->SetBaseDir(mva->BaseDir());
+
+	  trainMethods.push_back(mva);
       }
 
+      RunMethods(trainMethods, kTRUE);
+
       if (fAnalysisType != Types::kRegression) {
 
 	  // variable ranking
@@ -976,16 +995,147 @@ void TMVA::Factory::TestAllMethods()
       MVector::iterator itrMethod;
 
       // iterate over methods and test
+      std::vector<MethodBase*> testMethods;
       for( itrMethod = methods->begin(); itrMethod != methods->end(); itrMethod++ ) {
-	  Event::SetIsTraining(kFALSE);
 	  MethodBase* mva = dynamic_cast<MethodBase*>(*itrMethod);
 	  if(mva==0) continue;
-	  Types::EAnalysisType analysisType = mva->GetAnalysisType();
-	  Log() << kINFO << "Test method: " << mva->GetMethodName() << " for "
-		<< (analysisType == Types::kRegression ? "Regression" :
-		    (analysisType == Types::kMulticlass ? "Multiclass classification" : "Classification")) << " performance" << Endl;
-	  mva->AddOutput( Types::kTesting, analysisType );
+	  testMethods.push_back(mva);
+      }
+      Event::SetIsTraining(kFALSE);
+      RunMethods(testMethods, kFALSE);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Train (training=kTRUE) or test the given methods and print the wall time
+/// spent on each of them. With the option ParallelTraining, the methods that
+/// can run concurrently are trained or tested at the same time after the
+/// others, each on its own thread: dedicated threads rather than tasks of the
+/// implicit-MT pool, so that the nested parallel loops of a method cannot
+/// interleave two methods on the same thread. The datasets keep one current
+/// event per thread meanwhile.
+
+void TMVA::Factory::RunMethods( const std::vector<MethodBase*>& methods, Bool_t training )
+{
+   if (methods.empty()) return;
+
+   std::vector<MethodBase*> sequential, concurrent;
+   for (UInt_t i=0; i<methods.size(); i++) {
+      if (fParallelTraining && CanRunConcurrently(methods[i], training)) concurrent.push_back(methods[i]);
+      else                                                               sequential.push_back(methods[i]);
+   }
+   if (concurrent.size() < 2) {
+      sequential = methods;
+      concurrent.clear();
+   }
+
+   // run one method; the factory logger is not used from concurrent threads
+   auto run = [&]( MethodBase* mva, Bool_t log ) -> Double_t {
+      TStopwatch timer;
+      Types::EAnalysisType analysisType = training ? fAnalysisType : mva->GetAnalysisType();
+      TString analysisName = (analysisType == Types::kRegression ? "Regression" :
+                              (analysisType == Types::kMulticlass ? "Multiclass classification" : "Classification"));
+      if (training) {
+         if (log) Log() << kINFO << "Train method: " << mva->GetMethodName() << " for " << analysisName << Endl;
+         mva->TrainMethod();
+         if (log) Log() << kINFO << "Training finished" << Endl;
       }
+      else {
+         if (log) Log() << kINFO << "Test method: " << mva->GetMethodName() << " for " << analysisName << " performance" << Endl;
+         mva->AddOutput( Types::kTesting, analysisType );
+      }
+      return timer.RealTime();
+   };
+
+   TStopwatch totalTimer;
+   std::map<const MethodBase*,Double_t> wallTime;
+
+   for (UInt_t i=0; i<sequential.size(); i++) wallTime[sequential[i]] = run(sequential[i], kTRUE);
+
+   if (!concurrent.empty()) {
+      const UInt_t nThreads = std::min<UInt_t>(concurrent.size(), std::max<UInt_t>(1, std::thread::hardware_concurrency()));
+      Log() << kINFO << (training ? "Train " : "Test ") << concurrent.size() << " methods concurrently on "
+            << nThreads << " threads:";
+      for (UInt_t i=0; i<concurrent.size(); i++) Log() << " " << concurrent[i]->GetMethodName();
+      Log() << Endl;
+
+      ROOT::EnableThreadSafety();
+      DataSet::SetMultiThreaded(kTRUE);
+
+      std::vector<Double_t> times(concurrent.size(), 0);
+      std::atomic<UInt_t> next(0);
+      std::exception_ptr error;
+      std::mutex errorMutex;
+      auto worker = [&]( Bool_t ownThread ) {
+         // histograms booked outside of a method directory must not go to gROOT,
+         // the default directory of new threads, which all threads share
+         if (ownThread) gDirectory = 0;
+         for (UInt_t i = next++; i < concurrent.size(); i = next++) {
+            try {
+               times[i] = run(concurrent[i], kFALSE);
+            }
+            catch (...) {
+               std::lock_guard<std::mutex> guard(errorMutex);
+               if (!error) error = std::current_exception();
+            }
+         }
+      };
+      std::vector<std::thread> threads;
+      for (UInt_t t=1; t<nThreads; t++) threads.emplace_back(worker, kTRUE);
+      worker(kFALSE);
+      for (UInt_t t=0; t<threads.size(); t++) threads[t].join();
+
+      DataSet::SetMultiThreaded(kFALSE);
+      if (error) std::rethrow_exception(error);
+
+      for (UInt_t i=0; i<concurrent.size(); i++) wallTime[concurrent[i]] = times[i];
+      Log() << kINFO << (training ? "Training" : "Testing") << " finished" << Endl;
+   }
+
+   // wall time summary
+   Log() << kINFO << Endl;
+   Log() << kINFO << "Wall time for the " << (training ? "training" : "testing") << " of each method:" << Endl;
+   for (UInt_t i=0; i<methods.size(); i++) {
+      Log() << kINFO << Form("   %-30s : %9.2f s", methods[i]->GetMethodName().Data(), wallTime[methods[i]])
+            << (std::find(concurrent.begin(), concurrent.end(), methods[i]) != concurrent.end() ? "  (concurrent)" : "")
+            << Endl;
+   }
+   Log() << kINFO << Form("   %-30s : %9.2f s", "total", totalTimer.RealTime()) << Endl;
+   Log() << kINFO << Endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Methods that change the events or the sampling of their dataset, that
+/// create datasets, or that rely on global state while being trained, are
+/// always run sequentially. Process-wide settings such as TH1::AddDirectory()
+/// must not be changed by the methods that can run concurrently.
+
+Bool_t TMVA::Factory::CanRunConcurrently( const MethodBase* mva, Bool_t training ) const
+{
+   switch (mva->GetMethodType()) {
+   case Types::kBoost:      // reweights the shared events
+   case Types::kCategory:   // builds datasets for its sub-methods
+   case Types::kPlugins:    // unknown implementation
+   case Types::kPyRandomForest: // Python interpreter
+   case Types::kPyAdaBoost:
+   case Types::kPyGTB:
+   case Types::kC50:        // R interpreter
+   case Types::kRSNNS:
+   case Types::kRSVM:
+   case Types::kRXGB:
+      return kFALSE;
+   case Types::kMLP:        // dataset sampling, Minuit through a static this pointer
+   case Types::kRuleFit:    // gRandom
+   case Types::kFDA:        // compiles its formula through the interpreter
+   case Types::kCFMlpANN:   // static random number generator state
+   case Types::kTMlpANN:    // weights dumped to a fixed temporary file
+      return !training;
+   case Types::kCuts: {     // MINUIT fits share gMinuit
+      const MethodCuts* cuts = dynamic_cast<const MethodCuts*>(mva);
+      return !training || (cuts && !cuts->UsesMinuit());
+   }
+   default:
+      return kTRUE;
    }
 }
 
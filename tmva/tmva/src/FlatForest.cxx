@@ -0,0 +1,152 @@
+// @(#)root/tmva $Id$
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : FlatForest                                                            *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Implementation (see header for description)                               *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+//_______________________________________________________________________
+//
+// FlatForest
+//
+// The nodes of all trees of a forest are stored breadth first in flat
+// arrays: cut variable, cut value and the indices of the two daughters.
+// The daughters are ordered by the result of the comparison value >= cut,
+// the cut type of the node being folded into the order, so that the next
+// node is found without branching. A leaf is its own daughter: every tree
+// is descended for a fixed number of steps, its depth.
+//
+// Trees using multivariate (Fisher) cuts cannot be flattened.
+//_______________________________________________________________________
+
+#include "TMVA/FlatForest.h"
+#include "TMVA/DecisionTree.h"
+#include "TMVA/DecisionTreeNode.h"
+
+#include <deque>
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////////////////////
+/// constructor, flattens the trees of the forest
+
+TMVA::FlatForest::FlatForest( const std::vector<DecisionTree*>& forest )
+   : fValid( kTRUE )
+{
+   fRoot.reserve( forest.size() );
+   fDepth.reserve( forest.size() );
+
+   for (UInt_t itree=0; itree<forest.size() && fValid; itree++) {
+      const DecisionTree* tree = forest[itree];
+      const DecisionTreeNode* root = tree->GetRoot();
+      if (root == 0) { fValid = kFALSE; break; }
+
+      fRoot.push_back( fVar.size() );
+      UInt_t depth = 0;
+
+      // breadth first: the position of a node is known when it is queued
+      std::deque< std::pair<const DecisionTreeNode*, UInt_t> > queue;
+      queue.push_back( std::make_pair( root, 0u ) );
+      UInt_t next = fVar.size() + 1;
+      while (!queue.empty()) {
+         const DecisionTreeNode* node = queue.front().first;
+         const UInt_t nodeDepth = queue.front().second;
+         queue.pop_front();
+         const UInt_t inode = fVar.size();
+
+         if (node->GetNodeType() == 0) { // intermediate node, as in DecisionTree::CheckEvent
+            const DecisionTreeNode* left  = node->GetLeft();
+            const DecisionTreeNode* right = node->GetRight();
+            if (left == 0 || right == 0 || node->GetNFisherCoeff() != 0 || node->GetSelector() < 0) {
+               fValid = kFALSE;
+               break;
+            }
+            // GoesRight() is (value >= cut) for cut type kTRUE, its negation otherwise
+            const DecisionTreeNode* below = node->GetCutType() ? left  : right;
+            const DecisionTreeNode* above = node->GetCutType() ? right : left;
+            fVar.push_back( node->GetSelector() );
+            fCut.push_back( node->GetCutValue() );
+            fChild.push_back( next++ );
+            fChild.push_back( next++ );
+            fLeafValue.push_back( 0 );
+            fLeafYesNo.push_back( 0 );
+            queue.push_back( std::make_pair( below, nodeDepth+1 ) );
+            queue.push_back( std::make_pair( above, nodeDepth+1 ) );
+         }
+         else {
+            fVar.push_back( 0 );
+            fCut.push_back( 0 );
+            fChild.push_back( inode );
+            fChild.push_back( inode );
+            // as DecisionTree::CheckEvent, regression trees return the response for both
+            if (tree->DoRegression()) {
+               fLeafValue.push_back( node->GetResponse() );
+               fLeafYesNo.push_back( node->GetResponse() );
+            }
+            else {
+               fLeafValue.push_back( node->GetPurity() );
+               fLeafYesNo.push_back( node->GetNodeType() );
+            }
+            depth = std::max( depth, nodeDepth );
+         }
+      }
+      fDepth.push_back( depth );
+   }
+
+   if (!fValid) {
+      fRoot.clear(); fDepth.clear(); fVar.clear(); fCut.clear();
+      fChild.clear(); fLeafValue.clear(); fLeafYesNo.clear();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// sum of the responses of the first nTrees trees to the variables x,
+/// each multiplied by its weight if weights is not null
+
+Double_t TMVA::FlatForest::GetWeightedSum( const Float_t* x, UInt_t nTrees, Bool_t useYesNoLeaf, const Double_t* weights ) const
+{
+   Double_t sum = 0;
+   for (UInt_t itree=0; itree<nTrees; itree++) {
+      const Double_t response = GetResponse( itree, x, useYesNoLeaf );
+      sum += weights ? weights[itree]*response : response;
+   }
+   return sum;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// weighted sums of the responses for a batch of events. The trees are
+/// evaluated one after the other on all events, blocks of events being
+/// descended together to overlap the memory accesses.
+
+void TMVA::FlatForest::GetWeightedSums( const Float_t* x, UInt_t nEvents, UInt_t nVars, UInt_t nTrees, Bool_t useYesNoLeaf,
+                                        const Double_t* weights, Double_t* sums ) const
+{
+   const UInt_t kBlock = 16;
+   const Double_t* leaf = useYesNoLeaf ? &fLeafYesNo[0] : &fLeafValue[0];
+
+   std::fill( sums, sums+nEvents, 0. );
+   for (UInt_t itree=0; itree<nTrees; itree++) {
+      const Double_t weight = weights ? weights[itree] : 1.;
+      for (UInt_t first=0; first<nEvents; first+=kBlock) {
+         const UInt_t n = std::min( kBlock, nEvents-first );
+         const Float_t* xb = x + ULong64_t(first)*nVars;
+         UInt_t node[kBlock];
+         for (UInt_t k=0; k<n; k++) node[k] = fRoot[itree];
+         for (UInt_t d=0; d<fDepth[itree]; d++) {
+            for (UInt_t k=0; k<n; k++) {
+               const UInt_t i = node[k];
+               node[k] = fChild[2*i + (xb[k*nVars + fVar[i]] >= fCut[i])];
+            }
+         }
+         for (UInt_t k=0; k<n; k++) sums[first+k] += weight*leaf[node[k]];
+      }
+   }
+}
@@ -126,7 +126,9 @@ Double_t TMVA::GeneticAlgorithm::NewFitness( Double_t /*oldValue*/, Double_t new
 /// the population. 
 ///
 /// this function calls implicitly (many times) the "fitnessFunction" which
-/// has been overridden by the user. 
+/// has been overridden by the user. All individuals are passed at once to
+/// IFitterTarget::EstimatorFunctions, so that targets able to do so can
+/// evaluate them concurrently.
 
 Double_t TMVA::GeneticAlgorithm::CalculateFitness()
 {
@@ -158,10 +160,16 @@ Double_t TMVA::GeneticAlgorithm::CalculateFitness()
 
 #else 
 
+   // the fitter target evaluates the whole population at once, possibly concurrently
+   std::vector<std::vector<Double_t>*> factors( fPopulation.GetPopulationSize() );
+   for ( int index = 0; index < fPopulation.GetPopulationSize(); ++index )
+      factors[index] = &fPopulation.GetGenes(index)->GetFactors();
+   std::vector<Double_t> estimators;
+   fFitterTarget.EstimatorFunctions( factors, estimators );
+
    for ( int index = 0; index < fPopulation.GetPopulationSize(); ++index ) {
       GeneticGenes* genes = fPopulation.GetGenes(index);
-      Double_t fitness = NewFitness( genes->GetFitness(),
-                                     fFitterTarget.EstimatorFunction(genes->GetFactors()) );
+      Double_t fitness = NewFitness( genes->GetFitness(), estimators[index] );
       genes->SetFitness( fitness );
       
       if ( fBestFitness  > fitness )
@@ -45,3 +45,13 @@ TMVA::IFitterTarget::IFitterTarget()
 {
 }            
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the estimator for each of the given parameter vectors. The
+/// default implementation calls EstimatorFunction for each of them in turn.
+
+void TMVA::IFitterTarget::EstimatorFunctions( std::vector<std::vector<Double_t>*>& parameters,
+                                              std::vector<Double_t>& estimators )
+{
+   estimators.resize( parameters.size() );
+   for (UInt_t i = 0; i < parameters.size(); i++) estimators[i] = EstimatorFunction( *parameters[i] );
+}
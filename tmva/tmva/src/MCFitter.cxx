@@ -38,10 +38,12 @@
 #include "TMVA/MCFitter.h"
 #include "TMVA/FitterBase.h"
 #include "TMVA/GeneticRange.h"
+#include "TMVA/IFitterTarget.h"
 #include "TMVA/Interval.h"
 #include "TMVA/MsgLogger.h"
 #include "TMVA/Timer.h"
 #include "TMVA/Types.h"
+#include "TMath.h"
 #include "TRandom3.h"
 
 ClassImp(TMVA::MCFitter)
@@ -117,40 +119,55 @@ Double_t TMVA::MCFitter::Run( std::vector<Double_t>& pars )
    std::vector<Double_t>::iterator parIt;
    std::vector<Double_t>::iterator parBestIt;
       
-   Double_t estimator = 0;
    Double_t bestFit   = 0;
 
+   // without Sigma the samples do not depend on each other: they are diced in batches,
+   // in the same order as one by one, and each batch is passed at once to the fitter target
+   const Int_t batchSize = (fSigma > 0.0) ? 1 : 256;
+   std::vector< std::vector<Double_t> > samples( batchSize, parameters );
+   std::vector< std::vector<Double_t>* > samplePtrs( batchSize );
+   for (Int_t i = 0; i < batchSize; i++) samplePtrs[i] = &samples[i];
+   std::vector<Double_t> estimators;
+
    // loop over all MC samples
-   for (Int_t sample = 0; sample < fSamples; sample++) {
+   for (Int_t first = 0; first < fSamples; first += batchSize) {
+      const Int_t nBatch = TMath::Min( batchSize, fSamples - first );
+      samplePtrs.resize( nBatch );
 
       // dice the parameters
-      parIt = parameters.begin();
-      if (fSigma > 0.0) {
-         parBestIt = bestParameters.begin();
-         for (std::vector<TMVA::GeneticRange*>::iterator rndIt = rndRanges.begin(); rndIt<rndRanges.end(); rndIt++) {
-            (*parIt) = (*rndIt)->Random( kTRUE, (*parBestIt), fSigma );
-            parIt++;
-            parBestIt++;
+      for (Int_t i = 0; i < nBatch; i++) {
+         parIt = samples[i].begin();
+         if (fSigma > 0.0) {
+            parBestIt = bestParameters.begin();
+            for (std::vector<TMVA::GeneticRange*>::iterator rndIt = rndRanges.begin(); rndIt<rndRanges.end(); rndIt++) {
+               (*parIt) = (*rndIt)->Random( kTRUE, (*parBestIt), fSigma );
+               parIt++;
+               parBestIt++;
+            }
          }
-      }
-      else {
-         for (std::vector<TMVA::GeneticRange*>::iterator rndIt = rndRanges.begin(); rndIt<rndRanges.end(); rndIt++) {
-            (*parIt) = (*rndIt)->Random();
-            parIt++;
+         else {
+            for (std::vector<TMVA::GeneticRange*>::iterator rndIt = rndRanges.begin(); rndIt<rndRanges.end(); rndIt++) {
+               (*parIt) = (*rndIt)->Random();
+               parIt++;
+            }
          }
       }
 
       // test the estimator value for the parameters
-      estimator = EstimatorFunction( parameters );
+      GetFitterTarget().EstimatorFunctions( samplePtrs, estimators );
 
-      // if the estimator ist better (=smaller), take the new parameters as the best ones
-      if (estimator < bestFit || sample==0) {
-         bestFit = estimator;
-         bestParameters.swap( parameters );
-      }
+      for (Int_t i = 0; i < nBatch; i++) {
+         const Int_t sample = first + i;
 
-      // whats the time please?
-      if ((fSamples<100) || sample%Int_t(fSamples/100.0) == 0) timer.DrawProgressBar( sample );
+         // if the estimator ist better (=smaller), take the new parameters as the best ones
+         if (estimators[i] < bestFit || sample==0) {
+            bestFit = estimators[i];
+            bestParameters = samples[i];
+         }
+
+         // whats the time please?
+         if ((fSamples<100) || sample%Int_t(fSamples/100.0) == 0) timer.DrawProgressBar( sample );
+      }
    }
    pars.swap( bestParameters ); // return best parameters found
 
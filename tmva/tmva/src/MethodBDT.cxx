@@ -116,13 +116,20 @@
 #include "TMath.h"
 #include "TObjString.h"
 #include "TGraph.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "tbb/parallel_for.h"
+#endif
 
 #include "TMVA/BDTEventWrapper.h"
+#include "TMVA/BinnedEventSample.h"
 #include "TMVA/BinarySearchTree.h"
 #include "TMVA/ClassifierFactory.h"
 #include "TMVA/CrossEntropy.h"
 #include "TMVA/DecisionTree.h"
 #include "TMVA/DataSet.h"
+#include "TMVA/FlatForest.h"
 #include "TMVA/GiniIndex.h"
 #include "TMVA/GiniIndexWithLaplace.h"
 #include "TMVA/Interval.h"
@@ -202,6 +209,9 @@ TMVA::MethodBDT::MethodBDT( const TString& jobName,
    , fCtb_ss(0)
    , fCbb(0)
    , fDoPreselection(kFALSE)
+   , fUseBinnedTraining(kFALSE)
+   , fBinnedSample(0)
+   , fFlatForest(0)
    , fHistoricBool(kFALSE) 
 {
    fMonitorNtuple = NULL;
@@ -255,6 +265,9 @@ TMVA::MethodBDT::MethodBDT( DataSetInfo& theData,
    , fCtb_ss(0)
    , fCbb(0)
    , fDoPreselection(kFALSE)
+   , fUseBinnedTraining(kFALSE)
+   , fBinnedSample(0)
+   , fFlatForest(0)
    , fHistoricBool(kFALSE) 
 {
    fMonitorNtuple = NULL;
@@ -298,6 +311,8 @@ Bool_t TMVA::MethodBDT::HasAnalysisType( Types::EAnalysisType type, UInt_t numbe
 /// nCuts:           the number of steps in the optimisation of the cut for a node (if < 0, then
 ///                  step size is determined by the events)
 /// UseFisherCuts:   use multivariate splits using the Fisher criterion
+/// UseBinnedTraining: bin the variables once on the nCuts grid of the full sample and find the
+///                  node splits from histograms (faster; nCuts < 256, no Fisher cuts)
 /// UseYesNoLeaf     decide if the classification is done simply by the node type, or the S/B
 ///                  (from the training) in the leaf node
 /// NodePurityLimit  the minimum purity to classify a node as a signal node (used in pruning and boosting to determine
@@ -395,6 +410,7 @@ void TMVA::MethodBDT::DeclareOptions()
    DeclareOptionRef(fUseFisherCuts=kFALSE, "UseFisherCuts", "Use multivariate splits using the Fisher criterion");
    DeclareOptionRef(fMinLinCorrForFisher=.8,"MinLinCorrForFisher", "The minimum linear correlation between two variables demanded for use in Fisher criterion in node splitting");
    DeclareOptionRef(fUseExclusiveVars=kFALSE,"UseExclusiveVars","Variables already used in fisher criterion are not anymore analysed individually for node splitting");
+   DeclareOptionRef(fUseBinnedTraining=kFALSE,"UseBinnedTraining","Bin the variables once on the nCuts grid of the full training sample and find the node splits from histograms (faster, needs nCuts < 256)");
 
 
    DeclareOptionRef(fDoPreselection=kFALSE,"DoPreselection","and and apply automatic pre-selection for 100% efficient signal (bkg) cuts prior to training");
@@ -563,6 +579,18 @@ void TMVA::MethodBDT::ProcessOptions()
       Log() << kWARNING << "--> I switch do default nCuts = 20 and use standard node splitting WITH possible Fisher criteria"<<Endl;
       fNCuts=20;
    }
+
+   if (fUseBinnedTraining) {
+      if (fUseFisherCuts || fNCuts <= 0) {
+         Log() << kWARNING << "UseBinnedTraining cannot be combined with UseFisherCuts or nCuts<0 --> I will use the standard node splitting" << Endl;
+         fUseBinnedTraining = kFALSE;
+      }
+      else if (fNCuts >= Int_t(BinnedEventSample::fgMaxBins)) {
+         Log() << kWARNING << "UseBinnedTraining needs nCuts < " << BinnedEventSample::fgMaxBins
+               << " --> I set nCuts = " << BinnedEventSample::fgMaxBins-1 << Endl;
+         fNCuts = BinnedEventSample::fgMaxBins-1;
+      }
+   }
    
    if (fNTrees==0){
       Log() << kERROR << " Zero Decision Trees demanded... that does not work !! "
@@ -713,6 +741,23 @@ void TMVA::MethodBDT::Reset( void )
 TMVA::MethodBDT::~MethodBDT( void )
 {
    for (UInt_t i=0; i<fForest.size();           i++) delete fForest[i];
+   delete fFlatForest;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// flatten the trained or read forest for the evaluation (see FlatForest).
+/// Forests with multivariate (Fisher) cuts are evaluated tree by tree.
+
+void TMVA::MethodBDT::BuildFlatForest()
+{
+   delete fFlatForest;
+   fFlatForest = new FlatForest( fForest );
+   if (!fFlatForest->IsValid()) {
+      Log() << kDEBUG << "The forest cannot be flattened, the trees are evaluated node by node" << Endl;
+      delete fFlatForest;
+      fFlatForest = 0;
+   }
+   fFlatValues.resize( GetNvar() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1097,7 +1142,11 @@ void TMVA::MethodBDT::SetTuneParameters(std::map<TString,Double_t> tuneParameter
 
 void TMVA::MethodBDT::Train()
 {
-   TMVA::DecisionTreeNode::fgIsTraining=true;
+   TMVA::DecisionTreeNode::TrainingGuard trainingGuard;
+
+   // the trees change during the training, they are flattened at the end
+   delete fFlatForest;
+   fFlatForest = 0;
 
    // fill the STL Vector with the event sample
    // (needs to be done here and cannot be done in "init" as the options need to be 
@@ -1211,6 +1260,9 @@ void TMVA::MethodBDT::Train()
       InitGradBoost(fEventSample);
    }
 
+   // the variables of the training events are binned once for all trees
+   if (fUseBinnedTraining) fBinnedSample = new BinnedEventSample( fEventSample, DataInfo(), GetNvar(), fNCuts+1 );
+
    Int_t itree=0;
    Bool_t continueBoost=kTRUE;
    //for (int itree=0; itree<fNTrees; itree++) {
@@ -1238,6 +1290,7 @@ void TMVA::MethodBDT::Train()
                                                  fRandomisedTrees, fUseNvars, fUsePoissonNvars, fMaxDepth,
                                                  itree*nClasses+i, fNodePurityLimit, itree*nClasses+1));
             fForest.back()->SetNVars(GetNvar());
+            fForest.back()->SetBinnedSample(fBinnedSample, fTrainSample == &fSubSample ? &fSubSampleRows : 0);
             if (fUseFisherCuts) {
                fForest.back()->SetUseFisherCuts();
                fForest.back()->SetMinLinCorrForFisher(fMinLinCorrForFisher); 
@@ -1262,6 +1315,7 @@ void TMVA::MethodBDT::Train()
                                               fRandomisedTrees, fUseNvars, fUsePoissonNvars, fMaxDepth,
                                               itree, fNodePurityLimit, itree));
          fForest.back()->SetNVars(GetNvar());
+         fForest.back()->SetBinnedSample(fBinnedSample, fTrainSample == &fSubSample ? &fSubSampleRows : 0);
          if (fUseFisherCuts) {
             fForest.back()->SetUseFisherCuts();
             fForest.back()->SetMinLinCorrForFisher(fMinLinCorrForFisher); 
@@ -1337,8 +1391,13 @@ void TMVA::MethodBDT::Train()
             << nNodesAfterPruningCount/GetNTrees()
             << Endl;
    }
-   TMVA::DecisionTreeNode::fgIsTraining=false;
 
+   // the trees keep no reference to the binned sample once grown
+   for (UInt_t i=0; i<fForest.size(); i++) fForest[i]->SetBinnedSample(0);
+   delete fBinnedSample;
+   fBinnedSample = 0;
+
+   BuildFlatForest();
 
    // reset all previously stored/accumulated BOOST weights in the event sample
    //   for (UInt_t iev=0; iev<fEventSample.size(); iev++) fEventSample[iev]->SetBoostWeight(1.);
@@ -1389,12 +1448,22 @@ void TMVA::MethodBDT::UpdateTargets(std::vector<const TMVA::Event*>& eventSample
       }
    }
    else{
-      for (std::vector<const TMVA::Event*>::const_iterator e=eventSample.begin(); e!=eventSample.end();e++) {
-         fResiduals[*e].at(0)+=fForest.back()->CheckEvent(*e,kFALSE);
-         Double_t p_sig=1.0/(1.0+exp(-2.0*fResiduals[*e].at(0)));
-         Double_t res = (DataInfo().IsSignal(*e)?1:0)-p_sig;
-         const_cast<TMVA::Event*>(*e)->SetTarget(0,res);
-      }
+      // the events are independent: each one only updates its own residual and target
+      auto update = [&]( UInt_t iev ) {
+         const TMVA::Event* e = eventSample[iev];
+         std::vector<double>& residual = fResiduals.find(e)->second;
+         residual.at(0)+=fForest.back()->CheckEvent(e,kFALSE);
+         Double_t p_sig=1.0/(1.0+exp(-2.0*residual.at(0)));
+         Double_t res = (DataInfo().IsSignal(e)?1:0)-p_sig;
+         const_cast<TMVA::Event*>(e)->SetTarget(0,res);
+      };
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled()) {
+         tbb::parallel_for( UInt_t(0), UInt_t(eventSample.size()), update );
+         return;
+      }
+#endif
+      for (UInt_t iev=0; iev<eventSample.size(); iev++) update(iev);
    }   
 }
 
@@ -2022,10 +2091,14 @@ void TMVA::MethodBDT::GetBaggedSubSample(std::vector<const TMVA::Event*>& eventS
    TRandom3 *trandom   = new TRandom3(100*fForest.size()+1234);
 
    if (!fSubSample.empty()) fSubSample.clear();
+   fSubSampleRows.clear();
 
    for (std::vector<const TMVA::Event*>::const_iterator e=eventSample.begin(); e!=eventSample.end();e++) {
       n = trandom->PoissonD(fBaggedSampleFraction);
-      for (Int_t i=0;i<n;i++) fSubSample.push_back(*e);
+      for (Int_t i=0;i<n;i++) {
+         fSubSample.push_back(*e);
+         fSubSampleRows.push_back(e-eventSample.begin());
+      }
    }
    
    delete trandom;
@@ -2268,6 +2341,8 @@ void TMVA::MethodBDT::ReadWeightsFromXML(void* parent) {
       fBoostWeights.push_back(boostWeight);
       ch = gTools().GetNextChild(ch);
    }
+
+   BuildFlatForest();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2304,6 +2379,8 @@ void  TMVA::MethodBDT::ReadWeightsFromStream( std::istream& istr )
       fForest.back()->Read(istr, GetTrainingTMVAVersionCode());
       fBoostWeights.push_back(boostWeight);
    }
+
+   BuildFlatForest();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2343,6 +2420,18 @@ Double_t TMVA::MethodBDT::PrivateGetMvaValue(const TMVA::Event* ev, Double_t* er
 
    if (useNTrees > 0 ) nTrees = useNTrees;
 
+   if (fFlatForest && nTrees <= fFlatForest->GetNTrees()) {
+      for (UInt_t ivar=0; ivar<fFlatValues.size(); ivar++) fFlatValues[ivar] = ev->GetValue(ivar);
+      if (fBoostType=="Grad") {
+         Double_t sum = fFlatForest->GetWeightedSum( &fFlatValues[0], nTrees, kFALSE, 0 );
+         return 2.0/(1.0+exp(-2.0*sum))-1;
+      }
+      Double_t myMVA = fFlatForest->GetWeightedSum( &fFlatValues[0], nTrees, fUseYesNoLeaf, &fBoostWeights[0] );
+      Double_t norm  = 0;
+      for (UInt_t itree=0; itree<nTrees; itree++) norm += fBoostWeights[itree];
+      return ( norm > std::numeric_limits<double>::epsilon() ) ? myMVA /= norm : 0 ;
+   }
+
    if (fBoostType=="Grad") return GetGradBoostMVA(ev,nTrees);
    
    Double_t myMVA = 0;
@@ -2355,6 +2444,62 @@ Double_t TMVA::MethodBDT::PrivateGetMvaValue(const TMVA::Event* ev, Double_t* er
    return ( norm > std::numeric_limits<double>::epsilon() ) ? myMVA /= norm : 0 ;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the MVA values of the events firstEvt to lastEvt of the current
+/// data set. With a flattened forest the events are evaluated in batches,
+/// each tree being applied to all events of a batch at once.
+
+std::vector<Double_t> TMVA::MethodBDT::GetMvaValues(Long64_t firstEvt, Long64_t lastEvt, Bool_t logProgress)
+{
+   if (fFlatForest == 0 || fDoPreselection) return MethodBase::GetMvaValues(firstEvt, lastEvt, logProgress);
+
+   Long64_t nEvents = Data()->GetNEvents();
+   if (firstEvt > lastEvt || lastEvt > nEvents) lastEvt = nEvents;
+   if (firstEvt < 0) firstEvt = 0;
+   std::vector<Double_t> values(lastEvt-firstEvt);
+   nEvents = values.size();
+
+   Timer timer( nEvents, GetName(), kTRUE );
+   if (logProgress)
+      Log() << kINFO<<Form("Dataset[%s] : ",DataInfo().GetName())<< "Evaluation of " << GetMethodName() << " on "
+            << (Data()->GetCurrentType()==Types::kTraining?"training":"testing") << " sample (" << nEvents << " events)" << Endl;
+
+   const UInt_t   nVars     = GetNvar();
+   const UInt_t   nTrees    = fFlatForest->GetNTrees();
+   const Bool_t   gradBoost = (fBoostType=="Grad");
+   const Long64_t batchSize = 1024;
+   Double_t norm = 0;
+   for (UInt_t itree=0; itree<nTrees; itree++) norm += fBoostWeights[itree];
+
+   std::vector<Float_t> x( batchSize*nVars );
+   for (Long64_t first=firstEvt; first<lastEvt; first+=batchSize) {
+      const Long64_t n = TMath::Min( batchSize, lastEvt-first );
+      for (Long64_t i=0; i<n; i++) {
+         Data()->SetCurrentEvent(first+i);
+         const Event* ev = GetEvent();
+         for (UInt_t ivar=0; ivar<nVars; ivar++) x[i*nVars+ivar] = ev->GetValue(ivar);
+      }
+
+      Double_t* sums = &values[first-firstEvt];
+      if (gradBoost) {
+         fFlatForest->GetWeightedSums( &x[0], n, nVars, nTrees, kFALSE, 0, sums );
+         for (Long64_t i=0; i<n; i++) sums[i] = 2.0/(1.0+exp(-2.0*sums[i]))-1;
+      }
+      else {
+         fFlatForest->GetWeightedSums( &x[0], n, nVars, nTrees, fUseYesNoLeaf, &fBoostWeights[0], sums );
+         for (Long64_t i=0; i<n; i++) sums[i] = ( norm > std::numeric_limits<double>::epsilon() ) ? sums[i]/norm : 0;
+      }
+
+      if (logProgress) timer.DrawProgressBar( first+n-firstEvt );
+   }
+   if (logProgress) {
+      Log() << kINFO <<Form("Dataset[%s] : ",DataInfo().GetName())<< "Elapsed time for evaluation of " << nEvents <<  " events: "
+            << timer.GetElapsedTime() << "       " << Endl;
+   }
+
+   return values;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// get the multiclass MVA response for the BDT classifier
@@ -2368,8 +2513,17 @@ const std::vector<Float_t>& TMVA::MethodBDT::GetMulticlassValues()
    std::vector<double> temp;
 
    UInt_t nClasses = DataInfo().GetNClasses();
+   if (fFlatForest) {
+      for (UInt_t ivar=0; ivar<fFlatValues.size(); ivar++) fFlatValues[ivar] = e->GetValue(ivar);
+   }
    for(UInt_t iClass=0; iClass<nClasses; iClass++){
       temp.push_back(0.0);
+      if (fFlatForest) {
+         for(UInt_t itree = iClass; itree<fForest.size(); itree+=nClasses){
+            temp[iClass] += fFlatForest->GetResponse(itree, &fFlatValues[0], kFALSE);
+         }
+         continue;
+      }
       for(UInt_t itree = iClass; itree<fForest.size(); itree+=nClasses){
          temp[iClass] += fForest[itree]->CheckEvent(e,kFALSE);
       }
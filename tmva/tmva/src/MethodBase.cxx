@@ -91,6 +91,7 @@
 #include "TGraph.h"
 #include "Riostream.h"
 #include "TXMLEngine.h"
+#include "TVirtualMutex.h"
 
 #include "TMVA/Config.h"
 #include "TMVA/DataSetInfo.h"
@@ -290,9 +291,10 @@ TMVA::MethodBase::~MethodBase( void )
 
    for (Int_t i = 0; i < 2; i++ ) {
       if (fEventCollections.at(i)) {
+         // views of transformed columns are deleted by the transformation handler
          for (std::vector<Event*>::const_iterator it = fEventCollections.at(i)->begin();
               it != fEventCollections.at(i)->end(); it++) {
-            delete (*it);
+            if (!(*it)->IsView()) delete (*it);
          }
          delete fEventCollections.at(i);
          fEventCollections.at(i) = 0;
@@ -559,8 +561,12 @@ void TMVA::MethodBase::TrainMethod()
    if(!IsSilentFile()) BaseDir()->cd();
 
    // once calculate all the transformation (e.g. the sequence of Decorr:Gauss:Decorr)
-   //    needed for this classifier
-   GetTransformationHandler().CalcTransformations(Data()->GetEventCollection());
+   //    needed for this classifier; columnar events are read row by row
+   const EventColumns* columns = Data()->GetEventColumns();
+   if (columns)
+      GetTransformationHandler().CalcTransformations(*columns);
+   else
+      GetTransformationHandler().CalcTransformations(Data()->GetEventCollection());
 
    // call training of derived MVA
    Log() << kINFO <<Form("Dataset[%s] : ",DataInfo().GetName())<< "Begin training" << Endl;
@@ -610,6 +616,8 @@ void TMVA::MethodBase::TrainMethod()
    // again, make sure the histograms go into the method's subdirectory
    if(!IsSilentFile())
    {
+       // the target file is shared by the methods the Factory trains concurrently
+       R__LOCKGUARD2(gROOTMutex);
        BaseDir()->cd();
        WriteMonitoringHistosToFile();
    }
@@ -988,9 +996,15 @@ void TMVA::MethodBase::TestClassification()
             << " not found in tree" << Endl;
    }
 
-   // basic statistics operations are made in base class
-   gTools().ComputeStat( GetEventCollection(Types::kTesting), mvaRes->GetValueVector(),
-                         fMeanS, fMeanB, fRmsS, fRmsB, fXmin, fXmax, fSignalClass );
+   // basic statistics operations are made in base class; they only need the
+   // classes and weights, which columnar events provide without a collection
+   const EventColumns* columns = Data()->GetEventColumns(Types::kTesting);
+   if (columns)
+      gTools().ComputeStat( *columns, mvaRes->GetValueVector(),
+                            fMeanS, fMeanB, fRmsS, fRmsB, fXmin, fXmax, fSignalClass );
+   else
+      gTools().ComputeStat( GetEventCollection(Types::kTesting), mvaRes->GetValueVector(),
+                            fMeanS, fMeanB, fRmsS, fRmsB, fXmin, fXmax, fSignalClass );
 
    // choose reasonable histogram ranges, by removing outliers
    Double_t nrms = 10;
@@ -1946,7 +1960,13 @@ void TMVA::MethodBase::WriteEvaluationHistosToFile(Types::ETreeType treetype)
             << "/kMaxAnalysisType" << Endl;
    results->GetStorage()->Write();
    if (treetype==Types::kTesting) {
-      GetTransformationHandler().PlotVariables (GetEventCollection( Types::kTesting ), BaseDir() );
+      // columnar events are transformed and plotted row by row, unless the
+      // method has created their transformed collection already
+      const EventColumns* columns = Data()->GetEventColumns(Types::kTesting);
+      if (columns && fEventCollections.at(Data()->TreeIndex(Types::kTesting))==0)
+         GetTransformationHandler().PlotVariables( *columns, BaseDir() );
+      else
+         GetTransformationHandler().PlotVariables (GetEventCollection( Types::kTesting ), BaseDir() );
    }
 }
 
@@ -3115,8 +3135,15 @@ const std::vector<TMVA::Event*>& TMVA::MethodBase::GetEventCollection( Types::ET
    // done before, I don't need to do it again, but just "hand over" the pointer to those events.
    Int_t idx = Data()->TreeIndex(type);  //index indicating Training,Testing,...  events/datasets
    if (fEventCollections.at(idx) == 0) {
-      fEventCollections.at(idx) = &(Data()->GetEventCollection(type));
-      fEventCollections.at(idx) = GetTransformationHandler().CalcTransformations(*(fEventCollections.at(idx)),kTRUE);
+      const EventColumns* columns = Data()->GetEventColumns(type);
+      if (columns) {
+         // the events are views of a transformed copy of the columns, or transformed copies of the rows
+         fEventCollections.at(idx) = GetTransformationHandler().CalcTransformations(*columns,kTRUE);
+      }
+      else {
+         fEventCollections.at(idx) = &(Data()->GetEventCollection(type));
+         fEventCollections.at(idx) = GetTransformationHandler().CalcTransformations(*(fEventCollections.at(idx)),kTRUE);
+      }
    }
    return *(fEventCollections.at(idx));
 }
@@ -101,6 +101,12 @@
 #include "TGraph.h"
 #include "TSpline.h"
 #include "TRandom3.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#endif
 
 #include "TMVA/BinarySearchTree.h"
 #include "TMVA/ClassifierFactory.h"
@@ -875,6 +881,68 @@ Double_t TMVA::MethodCuts::EstimatorFunction( std::vector<Double_t>& pars )
    return ComputeEstimator( pars );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// returns the estimators of a set of cuts, as if EstimatorFunction was 
+/// called for each of them in turn. The efficiencies of the cuts are 
+/// computed concurrently when implicit multi-threading is enabled; the 
+/// update of the best cuts, which depends on the order of the calls, is 
+/// done afterwards in the order of the parameter sets.
+
+void TMVA::MethodCuts::EstimatorFunctions( std::vector<std::vector<Double_t>*>& parameters,
+                                           std::vector<Double_t>& estimators )
+{
+   const UInt_t nvar = GetNvar();
+   const UInt_t npar = parameters.size();
+   const Bool_t usePDFs = (fEffMethod == kUsePDFs);
+
+   std::vector<Double_t> cutMin( npar*nvar ), cutMax( npar*nvar );
+   std::vector<Double_t> selS( npar ), selB( npar );
+
+   auto computeEffs = [&]( UInt_t begin, UInt_t end ) {
+      for (UInt_t i = begin; i < end; i++) {
+         Double_t* cmin = &cutMin[i*nvar];
+         Double_t* cmax = &cutMax[i*nvar];
+         this->MatchParsToCuts( *parameters[i], cmin, cmax );
+         if (usePDFs) {
+            this->IntegratePDFs( cmin, cmax, selS[i], selB[i] );
+         }
+         else {
+            Float_t nSelS = 0, nSelB = 0;
+            this->GetSelectedWeights( cmin, cmax, nSelS, nSelB );
+            selS[i] = nSelS;
+            selB[i] = nSelB;
+         }
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && npar > 1) {
+      tbb::parallel_for( tbb::blocked_range<UInt_t>(0, npar),
+                         [&]( const tbb::blocked_range<UInt_t>& r ) { computeEffs(r.begin(), r.end()); } );
+   }
+   else
+#endif
+      computeEffs( 0, npar );
+
+   estimators.resize( npar );
+   for (UInt_t i = 0; i < npar; i++) {
+      Double_t effS = 0, effB = 0;
+      if (usePDFs) {
+         effS = selS[i];
+         effB = selB[i];
+         CheckEffs( effS, effB );
+      }
+      else {
+         GetEffsfromSelectedWeights( Float_t(selS[i]), Float_t(selB[i]), effS, effB );
+      }
+      for (UInt_t ivar=0; ivar<nvar; ivar++) {
+         fTmpCutMin[ivar] = cutMin[i*nvar+ivar];
+         fTmpCutMax[ivar] = cutMax[i*nvar+ivar];
+      }
+      estimators[i] = ComputeEstimator( effS, effB );
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// returns estimator for "cut fitness" used by GA
 /// there are two requirements:
@@ -904,6 +972,17 @@ Double_t TMVA::MethodCuts::ComputeEstimator( std::vector<Double_t>& pars )
       this->GetEffsfromSelection (&fTmpCutMin[0], &fTmpCutMax[0], effS, effB);
    }
 
+   return ComputeEstimator( effS, effB );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// returns the estimator for the cuts in fTmpCutMin and fTmpCutMax, of 
+/// signal and background efficiencies effS and effB; if the cuts give a 
+/// better background efficiency than found so far for effS, they are
+/// kept as the best cuts of the efficiency bin
+
+Double_t TMVA::MethodCuts::ComputeEstimator( Double_t effS, Double_t effB )
+{
    Double_t eta = 0;      
    
    // test for a estimator function which optimizes on the whole background-rejection signal-efficiency plot
@@ -1015,6 +1094,17 @@ void TMVA::MethodCuts::MatchCutsToPars( std::vector<Double_t>& pars,
 
 void TMVA::MethodCuts::GetEffsfromPDFs( Double_t* cutMin, Double_t* cutMax,
                                         Double_t& effS, Double_t& effB )
+{
+   IntegratePDFs( cutMin, cutMax, effS, effB );
+   CheckEffs( effS, effB );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// product of the integrals of the signal and background PDFs of the 
+/// variables within the cuts; does not modify the method
+
+void TMVA::MethodCuts::IntegratePDFs( Double_t* cutMin, Double_t* cutMax,
+                                      Double_t& effS, Double_t& effB )
 {
    effS = 1.0;
    effB = 1.0;
@@ -1022,7 +1112,13 @@ void TMVA::MethodCuts::GetEffsfromPDFs( Double_t* cutMin, Double_t* cutMax,
       effS *= (*fVarPdfS)[ivar]->GetIntegral( cutMin[ivar], cutMax[ivar] );
       effB *= (*fVarPdfB)[ivar]->GetIntegral( cutMin[ivar], cutMax[ivar] );
    }
+}
 
+////////////////////////////////////////////////////////////////////////////////
+/// set negative efficiencies to 0
+
+void TMVA::MethodCuts::CheckEffs( Double_t& effS, Double_t& effB )
+{
    // quick fix to prevent from efficiencies < 0
    if( effS < 0.0 ) {
       effS = 0.0;
@@ -1043,9 +1139,18 @@ void TMVA::MethodCuts::GetEffsfromPDFs( Double_t* cutMin, Double_t* cutMax,
 void TMVA::MethodCuts::GetEffsfromSelection( Double_t* cutMin, Double_t* cutMax,
                                              Double_t& effS, Double_t& effB)
 {
-   Float_t nTotS = 0, nTotB = 0;
    Float_t nSelS = 0, nSelB = 0;  
-   
+   GetSelectedWeights( cutMin, cutMax, nSelS, nSelB );
+   GetEffsfromSelectedWeights( nSelS, nSelB, effS, effB );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// sums of the weights of the signal and background events passing the
+/// cuts; does not modify the method
+
+void TMVA::MethodCuts::GetSelectedWeights( Double_t* cutMin, Double_t* cutMax,
+                                           Float_t& nSelS, Float_t& nSelB )
+{
    Volume* volume = new Volume( cutMin, cutMax, GetNvar() );
   
    // search for all events lying in the volume, and add up their weights
@@ -1053,6 +1158,16 @@ void TMVA::MethodCuts::GetEffsfromSelection( Double_t* cutMin, Double_t* cutMax,
    nSelB = fBinaryTreeB->SearchVolume( volume );
 
    delete volume;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// compute signal and background efficiencies from the sums of the 
+/// weights of the selected events
+
+void TMVA::MethodCuts::GetEffsfromSelectedWeights( Float_t nSelS, Float_t nSelB,
+                                                   Double_t& effS, Double_t& effB )
+{
+   Float_t nTotS = 0, nTotB = 0;
 
    // total number of "events" (sum of weights) as reference to compute efficiency
    nTotS = fBinaryTreeS->GetSumOfWeights();
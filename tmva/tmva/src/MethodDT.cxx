@@ -368,7 +368,7 @@ TMVA::MethodDT::~MethodDT( void )
 
 void TMVA::MethodDT::Train( void )
 {
-   TMVA::DecisionTreeNode::fgIsTraining=true;
+   TMVA::DecisionTreeNode::TrainingGuard trainingGuard;
    fTree = new DecisionTree( fSepType, fMinNodeSize, fNCuts, &(DataInfo()), 0, 
                              fRandomisedTrees, fUseNvars, fUsePoissonNvars,fMaxDepth,0 );
    fTree->SetNVars(GetNvar());
@@ -387,8 +387,6 @@ void TMVA::MethodDT::Train( void )
    }
    fTree->BuildTree(tmp);
    if (fPruneMethod != DecisionTree::kNoPruning) fTree->PruneTree();
-
-   TMVA::DecisionTreeNode::fgIsTraining=false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -34,6 +34,7 @@
 #include "TMVA/MethodKNN.h"
 
 // C/C++
+#include <atomic>
 #include <cmath>
 #include <string>
 #include <cstdlib>
@@ -41,8 +42,14 @@
 // ROOT
 #include "TFile.h"
 #include "TMath.h"
+#include "TROOT.h"
 #include "TTree.h"
 
+#ifdef R__USE_IMT
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#endif
+
 // TMVA
 #include "TMVA/ClassifierFactory.h"
 #include "TMVA/DataSetInfo.h"
@@ -51,6 +58,7 @@
 #include "TMVA/MethodBase.h"
 #include "TMVA/MsgLogger.h"
 #include "TMVA/Ranking.h"
+#include "TMVA/Timer.h"
 #include "TMVA/Tools.h"
 #include "TMVA/Types.h"
 
@@ -326,6 +334,27 @@ Double_t TMVA::MethodKNN::GetMvaValue( Double_t* err, Double_t* errUpper )
    
    if (fUseLDA) return MethodKNN::getLDAValue(rlist, event_knn);
 
+   // Warn about Monte-Carlo event with zero distance
+   // this happens when this query event is also in learning sample
+   UInt_t count = 0;
+   for (kNN::List::const_iterator lit = rlist.begin(); lit != rlist.end() && count < knn; ++lit, ++count) {
+      if (!(lit->second > 0.0) && !(lit->second < 0.0)) {
+         Log() << kVERBOSE << "A neighbor has zero distance to query event" << Endl;
+      }
+   }
+
+   return MethodKNN::getkNNResponse(rlist, event_knn);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the classifier response from the list of the nearest neighbors
+/// of event_knn, applying the kernel weight function if requested.
+/// The list is not modified: this function can be called concurrently.
+
+Double_t TMVA::MethodKNN::getkNNResponse(const kNN::List &rlist, const kNN::Event &event_knn) const
+{
+   const UInt_t knn = static_cast<UInt_t>(fnkNN);
+
    //
    // Set flags for kernel option=Gaus, Poln
    //
@@ -371,14 +400,9 @@ Double_t TMVA::MethodKNN::GetMvaValue( Double_t* err, Double_t* errUpper )
       // get reference to current node to make code more readable
       const kNN::Node<kNN::Event> &node = *(lit->first);
       
-      // Warn about Monte-Carlo event with zero distance
-      // this happens when this query event is also in learning sample
       if (lit->second < 0.0) {
          Log() << kFATAL << "A neighbor has negative distance to query event" << Endl;
       }
-      else if (!(lit->second > 0.0)) {
-         Log() << kVERBOSE << "A neighbor has zero distance to query event" << Endl;
-      }
       
       // get event weight and scale weight by kernel function
       Double_t evweight = node.GetWeight();
@@ -428,6 +452,85 @@ Double_t TMVA::MethodKNN::GetMvaValue( Double_t* err, Double_t* errUpper )
    return weight_sig/weight_all;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the MVA values of the events firstEvt to lastEvt of the current
+/// data set. The input variables are read in batches, and the neighbor
+/// searches of a batch are run concurrently if implicit multi-threading
+/// is enabled, each search filling its own result list.
+
+std::vector<Double_t> TMVA::MethodKNN::GetMvaValues(Long64_t firstEvt, Long64_t lastEvt, Bool_t logProgress)
+{
+   if (fUseLDA) return MethodBase::GetMvaValues(firstEvt, lastEvt, logProgress);
+
+   Long64_t nEvents = Data()->GetNEvents();
+   if (firstEvt > lastEvt || lastEvt > nEvents) lastEvt = nEvents;
+   if (firstEvt < 0) firstEvt = 0;
+   std::vector<Double_t> values(lastEvt-firstEvt);
+   nEvents = values.size();
+
+   Timer timer( nEvents, GetName(), kTRUE );
+   if (logProgress)
+      Log() << kINFO<<Form("Dataset[%s] : ",DataInfo().GetName())<< "Evaluation of " << GetMethodName() << " on "
+            << (Data()->GetCurrentType()==Types::kTraining?"training":"testing") << " sample (" << nEvents << " events)" << Endl;
+
+   const UInt_t   nvar      = GetNVariables();
+   const UInt_t   knn       = static_cast<UInt_t>(fnkNN);
+   const Long64_t batchSize = 1024;
+
+   std::vector<kNN::Event> batch;
+   batch.reserve(batchSize);
+   std::atomic<Bool_t> failed(kFALSE);
+
+   // search for fnkNN+2 nearest neighbors, as in GetMvaValue
+   auto evaluate = [&](Long64_t begin, Long64_t end, Double_t *result) {
+      kNN::List rlist;
+      for (Long64_t i = begin; i < end; ++i) {
+         if (!fModule->Find(batch[i], knn + 2, rlist) || rlist.size() != knn + 2) {
+            failed = kTRUE;
+            result[i] = -100.0;
+            continue;
+         }
+         result[i] = getkNNResponse(rlist, batch[i]);
+      }
+   };
+
+   kNN::VarVec vvec(nvar, 0.0);
+   for (Long64_t first=firstEvt; first<lastEvt; first+=batchSize) {
+      const Long64_t n = TMath::Min( batchSize, lastEvt-first );
+      batch.clear();
+      for (Long64_t i=0; i<n; i++) {
+         Data()->SetCurrentEvent(first+i);
+         const Event* ev = GetEvent();
+         for (UInt_t ivar=0; ivar<nvar; ivar++) vvec[ivar] = ev->GetValue(ivar);
+         batch.push_back(kNN::Event(vvec, ev->GetWeight(), 3));
+      }
+
+      Double_t* result = &values[first-firstEvt];
+#ifdef R__USE_IMT
+      const Long64_t chunkSize = 64;
+      if (ROOT::IsImplicitMTEnabled() && n > chunkSize) {
+         tbb::parallel_for( tbb::blocked_range<Long64_t>(0, n, chunkSize),
+                            [&]( const tbb::blocked_range<Long64_t>& r ) { evaluate(r.begin(), r.end(), result); } );
+      }
+      else
+#endif
+         evaluate(0, n, result);
+
+      if (failed) {
+         Log() << kFATAL << "kNN result list is empty" << Endl;
+         return values;
+      }
+
+      if (logProgress) timer.DrawProgressBar( first+n-firstEvt );
+   }
+   if (logProgress) {
+      Log() << kINFO <<Form("Dataset[%s] : ",DataInfo().GetName())<< "Elapsed time for evaluation of " << nEvents <<  " events: "
+            << timer.GetElapsedTime() << "       " << Endl;
+   }
+
+   return values;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// Return vector of averages for target values of k-nearest neighbors.
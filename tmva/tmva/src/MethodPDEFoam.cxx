@@ -648,14 +648,9 @@ void TMVA::MethodPDEFoam::TrainMultiTargetRegression()
          << Endl;
    // insert event to BinarySearchTree
    for (Long64_t k=0; k<GetNEvents(); ++k) {
-      Event *ev = new Event(*GetEvent(k));
       // since in multi-target regression targets are handled like
       // variables --> remove targets and add them to the event variabels
-      std::vector<Float_t> targets(ev->GetTargets());
-      const UInt_t nVariables = ev->GetValues().size();
-      for (UInt_t i = 0; i < targets.size(); ++i)
-         ev->SetVal(i+nVariables, targets.at(i));
-      ev->GetTargets().clear();
+      Event *ev = MakeMultiTargetEvent(GetEvent(k));
       if (!(IgnoreEventsWithNegWeightsInTraining() && ev->GetWeight()<=0))
          fFoam.back()->FillBinarySearchTree(ev);
       // since the binary search tree copies the event, one can delete
@@ -669,15 +664,10 @@ void TMVA::MethodPDEFoam::TrainMultiTargetRegression()
    Log() << kVERBOSE << "Filling foam cells with events" << Endl;
    // loop over all events -> fill foam cells with number of events
    for (Long64_t k=0; k<GetNEvents(); ++k) {
-      Event *ev = new Event(*GetEvent(k));
       // since in multi-target regression targets are handled like
       // variables --> remove targets and add them to the event variabels
-      std::vector<Float_t> targets = ev->GetTargets();
-      const UInt_t nVariables = ev->GetValues().size();
+      Event *ev = MakeMultiTargetEvent(GetEvent(k));
       Float_t weight = fFillFoamWithOrigWeights ? ev->GetOriginalWeight() : ev->GetWeight();
-      for (UInt_t i = 0; i < targets.size(); ++i)
-         ev->SetVal(i+nVariables, targets.at(i));
-      ev->GetTargets().clear();
       if (!(IgnoreEventsWithNegWeightsInTraining() && ev->GetWeight()<=0))
          fFoam.back()->FillFoamCells(ev, weight);
       // since the PDEFoam copies the event, one can delete it
@@ -685,6 +675,19 @@ void TMVA::MethodPDEFoam::TrainMultiTargetRegression()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Create a new event (owned by the caller) whose variables are the
+/// variables followed by the targets of the given event, and which has
+/// no targets.  The spectators, class and weights are kept.
+
+TMVA::Event* TMVA::MethodPDEFoam::MakeMultiTargetEvent( const Event* ev ) const
+{
+   std::vector<Float_t> values( ev->GetValues() );
+   values.insert( values.end(), ev->GetTargets().begin(), ev->GetTargets().end() );
+   return new Event( values, std::vector<Float_t>(), ev->GetSpectators(),
+                     ev->GetClass(), ev->GetOriginalWeight(), ev->GetBoostWeight() );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return Mva-Value.
 ///
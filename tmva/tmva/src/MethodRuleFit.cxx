@@ -437,7 +437,7 @@ void TMVA::MethodRuleFit::InitEventSample( void )
 
 void TMVA::MethodRuleFit::Train( void )
 {
-   TMVA::DecisionTreeNode::fgIsTraining=true;
+   TMVA::DecisionTreeNode::TrainingGuard trainingGuard;
    // training of rules
 
   if(!IsSilentFile()) InitMonitorNtuple();
@@ -452,7 +452,6 @@ void TMVA::MethodRuleFit::Train( void )
       TrainTMVARuleFit();
    }
    fRuleFit.GetRuleEnsemblePtr()->ClearRuleMap();
-   TMVA::DecisionTreeNode::fgIsTraining=false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -100,6 +100,7 @@ ClassImp(TMVA::MethodSVM)
    , fCost(0)
    , fTolerance(0)
    , fMaxIter(0)
+   , fKernelCacheSize(0)
    , fNSubSets(0)
    , fBparm(0)
    , fGamma(0)
@@ -135,6 +136,7 @@ TMVA::MethodSVM::MethodSVM( DataSetInfo& theData, const TString& theWeightFile)
    , fCost(0)
    , fTolerance(0)
    , fMaxIter(0)
+   , fKernelCacheSize(0)
    , fNSubSets(0)
    , fBparm(0)
    , fGamma(0)
@@ -249,6 +251,7 @@ void TMVA::MethodSVM::DeclareOptions()
    }
    DeclareOptionRef( fTolerance = 0.01, "Tol",      "Tolerance parameter" );  //should be fixed
    DeclareOptionRef( fMaxIter   = 1000, "MaxIter",  "Maximum number of training loops" );
+   DeclareOptionRef( fKernelCacheSize = 1000, "KernelCacheSize", "Memory budget in MB for the cached lines of the kernel matrix" );
 
 }
 
@@ -375,7 +378,7 @@ void TMVA::MethodSVM::Train()
 
    Log()<< kINFO << "Building SVM Working Set...with "<<fInputData->size()<<" event instances"<< Endl;
    Timer bldwstime( GetName());
-   fWgSet = new SVWorkingSet( fInputData, fSVKernelFunction,fTolerance, DoRegression() );
+   fWgSet = new SVWorkingSet( fInputData, fSVKernelFunction,fTolerance, DoRegression(), fKernelCacheSize );
    Log() << kINFO <<"Elapsed time for Working Set build: "<< bldwstime.GetElapsedTime()<<Endl;
 
    // timing
@@ -391,6 +394,8 @@ void TMVA::MethodSVM::Train()
    fSupportVectors = fWgSet->GetSupportVectors();
    delete fWgSet;
    fWgSet=0;
+
+   BuildSupportVectorColumns();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -499,6 +504,8 @@ void TMVA::MethodSVM::ReadWeightsFromXML( void* wghtnode )
       exit(1);
    }
    delete svector;
+
+   BuildSupportVectorColumns();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -563,6 +570,8 @@ void  TMVA::MethodSVM::ReadWeightsFromStream( std::istream& istr )
       fSVKernelFunction->setCompatibilityParams(k, fOrder, fTheta, fKappa);
    }
    delete svector;
+
+   BuildSupportVectorColumns();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -579,17 +588,13 @@ Double_t TMVA::MethodSVM::GetMvaValue( Double_t* err, Double_t* errUpper )
 {
    Double_t myMVA = 0;
 
-   // TODO: avoid creation of a new SVEvent every time (Joerg)
-   SVEvent* ev = new SVEvent( GetEvent(), 0. ); // check for specificators
-
+   const Float_t* kernel = EvaluateSupportVectorKernels();
    for (UInt_t ievt = 0; ievt < fSupportVectors->size() ; ievt++) {
       myMVA += ( fSupportVectors->at(ievt)->GetAlpha()
                  * fSupportVectors->at(ievt)->GetTypeFlag()
-                 * fSVKernelFunction->Evaluate( fSupportVectors->at(ievt), ev ) );
+                 * kernel[ievt] );
    }
 
-   delete ev;
-
    myMVA -= fBparm;
 
    // cannot determine error
@@ -609,11 +614,11 @@ const std::vector<Float_t>& TMVA::MethodSVM::GetRegressionValues()
    Double_t myMVA = 0;
 
    const Event *baseev = GetEvent();
-   SVEvent* ev = new SVEvent( baseev,0. ); //check for specificators
 
+   const Float_t* kernel = EvaluateSupportVectorKernels();
    for (UInt_t ievt = 0; ievt < fSupportVectors->size() ; ievt++) {
       myMVA += ( fSupportVectors->at(ievt)->GetDeltaAlpha()
-                 *fSVKernelFunction->Evaluate( fSupportVectors->at(ievt), ev ) );
+                 *kernel[ievt] );
    }
    myMVA += fBparm;
    Event * evT = new Event(*baseev);
@@ -625,11 +630,45 @@ const std::vector<Float_t>& TMVA::MethodSVM::GetRegressionValues()
 
    delete evT;
 
-   delete ev;
-
    return *fRegressionReturnVal;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// copy the variables of the support vectors into one column per variable,
+/// the layout of the batched kernel evaluation
+
+void TMVA::MethodSVM::BuildSupportVectorColumns()
+{
+   const UInt_t nsv  = fSupportVectors ? fSupportVectors->size() : 0;
+   const UInt_t nvar = GetNvar();
+
+   fSVColumns.assign( nsv*nvar, 0 );
+   for (UInt_t isv = 0; isv < nsv; isv++) {
+      const std::vector<Float_t>* v = fSupportVectors->at(isv)->GetDataVector();
+      for (UInt_t ivar = 0; ivar < nvar && ivar < v->size(); ivar++) fSVColumns[ivar*nsv + isv] = (*v)[ivar];
+   }
+   fSVInput.resize( nvar );
+   fSVKernelValues.resize( nsv );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// kernel values of the current event with all support vectors, computed
+/// in one pass over the support vector columns; the values are the same as
+/// those of the pairwise SVKernelFunction::Evaluate
+
+const Float_t* TMVA::MethodSVM::EvaluateSupportVectorKernels()
+{
+   const UInt_t nsv  = fSupportVectors->size();
+   const UInt_t nvar = GetNvar();
+   if (fSVColumns.size() != nsv*nvar || fSVKernelValues.size() != nsv) BuildSupportVectorColumns();
+
+   const Event* ev = GetEvent();
+   for (UInt_t ivar = 0; ivar < nvar; ivar++) fSVInput[ivar] = ev->GetValue(ivar);
+
+   if (nsv > 0) fSVKernelFunction->Evaluate( &fSVInput[0], &fSVColumns[0], nvar, nsv, nsv, &fSVKernelValues[0] );
+   return nsv > 0 ? &fSVKernelValues[0] : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// write specific classifier response
 
@@ -745,6 +784,11 @@ void TMVA::MethodSVM::GetHelpMessage() const
    Log() << "each evaluation scales like the square of the number of training " << Endl;
    Log() << "events so that a coarse preliminary tuning should be performed on " << Endl;
    Log() << "reduced data sets." << Endl;
+   Log() << Endl;
+   Log() << "The lines of the kernel matrix are computed on demand and cached. If " << Endl;
+   Log() << "the matrix does not fit into \"KernelCacheSize\" (in MB), the least " << Endl;
+   Log() << "recently used lines are recomputed when needed: large training " << Endl;
+   Log() << "samples can be used at the price of a longer training." << Endl;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
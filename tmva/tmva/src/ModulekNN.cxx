@@ -199,6 +199,10 @@ void TMVA::kNN::ModulekNN::Clear()
    fCount.clear();
    fEvent.clear();
    fVar.clear();
+
+   fFlatNodes.clear();
+   fFlatVars.clear();
+   fFlatTree.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -326,6 +330,8 @@ Bool_t TMVA::kNN::ModulekNN::Fill(const UShort_t odepth, const UInt_t ifrac, con
       }
    }
 
+   BuildFlatTree();
+
    for (std::map<Short_t, UInt_t>::const_iterator it = fCount.begin(); it != fCount.end(); ++it) {
       Log() << kINFO << "<Fill> Class " << it->first << " has " << std::setw(8)
             << it->second << " events" << Endl;
@@ -339,6 +345,9 @@ Bool_t TMVA::kNN::ModulekNN::Fill(const UShort_t odepth, const UInt_t ifrac, con
 /// if tree has been filled then search for nfind closest events
 /// if metic (fVarScale map) is computed then rescale event variables
 /// using previsouly computed width of variable distribution
+/// option "weight" finds the events with a sum of weights >= nfind, otherwise
+/// the nfind closest events are counted with the flat copy of the tree, or
+/// with the recursive search on the tree itself for option "recursive"
 
 Bool_t TMVA::kNN::ModulekNN::Find(Event event, const UInt_t nfind, const std::string &option) const
 {
@@ -372,12 +381,57 @@ Bool_t TMVA::kNN::ModulekNN::Find(Event event, const UInt_t nfind, const std::st
          // that have sum of weights >= nfind
          kNN::Find<kNN::Event>(fkNNList, fTree, event, Double_t(nfind), 0.0);
       }
-   else
+   else if(option.find("recursive") != std::string::npos)
       {
          // recursive kd-tree search for nfind-nearest neighbors
          // count nodes and do not use event weight
          kNN::Find<kNN::Event>(fkNNList, fTree, event, nfind);
       }
+   else
+      {
+         // kd-tree search for nfind-nearest neighbors
+         // count nodes and do not use event weight
+         FindFlat(event, nfind, fkNNList);
+      }
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// find in tree the nfind closest events, like Find(event, nfind, option),
+/// but write the result to nlist instead of the latest result of the module:
+/// this function can be called concurrently from several threads
+
+Bool_t TMVA::kNN::ModulekNN::Find(Event event, const UInt_t nfind, List &nlist, const std::string &option) const
+{
+   nlist.clear();
+
+   if (!fTree) {
+      Log() << kFATAL << "ModulekNN::Find() - tree has not been filled" << Endl;
+      return kFALSE;
+   }
+   if (fDimn != event.GetNVar()) {
+      Log() << kFATAL << "ModulekNN::Find() - number of dimension does not match training events" << Endl;
+      return kFALSE;
+   }
+   if (nfind < 1) {
+      Log() << kFATAL << "ModulekNN::Find() - requested 0 nearest neighbors" << Endl;
+      return kFALSE;
+   }
+
+   if (!fVarScale.empty()) {
+      event = Scale(event);
+   }
+
+   if (option.find("weight") != std::string::npos) {
+      kNN::Find<kNN::Event>(nlist, fTree, event, Double_t(nfind), 0.0);
+   }
+   else if (option.find("recursive") != std::string::npos) {
+      kNN::Find<kNN::Event>(nlist, fTree, event, nfind);
+   }
+   else {
+      FindFlat(event, nfind, nlist);
+   }
 
    return kTRUE;
 }
@@ -528,6 +582,155 @@ TMVA::kNN::Node<TMVA::kNN::Event>* TMVA::kNN::ModulekNN::Optimize(const UInt_t o
    return tree;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// copy the tree into the flat layout used by FindFlat(): nodes in depth-first
+/// order, so that a left child follows its parent in memory, and the event
+/// variables of all nodes in one array
+
+void TMVA::kNN::ModulekNN::BuildFlatTree()
+{
+   fFlatNodes.clear();
+   fFlatVars.clear();
+   fFlatTree.clear();
+
+   if (!fTree) return;
+
+   fFlatNodes.reserve(fEvent.size());
+   fFlatTree.reserve(fEvent.size());
+   fFlatVars.reserve(fEvent.size()*fDimn);
+
+   // pairs of (tree node, index of the flat parent node, left or right)
+   std::vector<std::pair<const Node<Event>*, Int_t> > stack;
+   stack.push_back(std::make_pair(fTree, -1));
+
+   while (!stack.empty()) {
+      const Node<Event> *node = stack.back().first;
+      const Int_t parent = stack.back().second;
+      stack.pop_back();
+
+      const Int_t inode = fFlatNodes.size();
+      if (parent >= 0) {
+         // the right child is pushed first, hence visited last
+         if (fFlatTree[parent]->GetNodeL() == node) fFlatNodes[parent].fLeft  = inode;
+         else                                       fFlatNodes[parent].fRight = inode;
+      }
+
+      FlatNode flat;
+      flat.fLeft   = -1;
+      flat.fRight  = -1;
+      flat.fMod    = node->GetMod();
+      flat.fVarDis = node->GetVarDis();
+      flat.fVarMin = node->GetVarMin();
+      flat.fVarMax = node->GetVarMax();
+      flat.fWeight = node->GetWeight();
+      fFlatNodes.push_back(flat);
+      fFlatTree.push_back(node);
+
+      const Event &event = node->GetEvent();
+      for (UInt_t ivar = 0; ivar < fDimn; ++ivar) {
+         fFlatVars.push_back(ivar < event.GetNVar() ? event.GetVar(ivar) : 0);
+      }
+
+      if (node->GetNodeR()) stack.push_back(std::make_pair(node->GetNodeR(), inode));
+      if (node->GetNodeL()) stack.push_back(std::make_pair(node->GetNodeL(), inode));
+   }
+}
+
+namespace {
+   ////////////////////////////////////////////////////////////////////////////////
+   /// squared distance between two points; the four independent partial sums
+   /// map onto the lanes of the SIMD registers
+
+   inline TMVA::kNN::VarType FlatDist(const TMVA::kNN::VarType *x, const TMVA::kNN::VarType *y, const UInt_t n)
+   {
+      TMVA::kNN::VarType s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+      UInt_t i = 0;
+      for (; i + 4 <= n; i += 4) {
+         const TMVA::kNN::VarType d0 = x[i]   - y[i];
+         const TMVA::kNN::VarType d1 = x[i+1] - y[i+1];
+         const TMVA::kNN::VarType d2 = x[i+2] - y[i+2];
+         const TMVA::kNN::VarType d3 = x[i+3] - y[i+3];
+         s0 += d0*d0;
+         s1 += d1*d1;
+         s2 += d2*d2;
+         s3 += d3*d3;
+      }
+      for (; i < n; ++i) {
+         const TMVA::kNN::VarType d = x[i] - y[i];
+         s0 += d*d;
+      }
+      return (s0 + s1) + (s2 + s3);
+   }
+
+   bool CloserThan(const TMVA::kNN::VarType dist, const TMVA::kNN::Elem &elem)
+   {
+      return dist < elem.second;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// search the flat tree for the nfind nearest events with positive weight.
+/// Nodes are visited in the same order, and with the same pruning, as by the
+/// recursive kNN::Find() on the tree; the candidates are kept in a sorted
+/// array while searching, and copied to nlist at the end.
+
+void TMVA::kNN::ModulekNN::FindFlat(const Event &event, const UInt_t nfind, List &nlist) const
+{
+   nlist.clear();
+   if (fFlatNodes.empty() || nfind < 1) return;
+
+   const VarVec &xvec = event.GetVars();
+   const VarType *x = &xvec[0];
+
+   std::vector<Elem> best;
+   best.reserve(nfind + 1);
+
+   std::vector<Int_t> stack;
+   stack.reserve(64);
+   stack.push_back(0);
+
+   while (!stack.empty()) {
+      const Int_t inode = stack.back();
+      stack.pop_back();
+
+      const FlatNode &node = fFlatNodes[inode];
+      const VarType value = x[node.fMod];
+
+      if (node.fWeight > 0.0) {
+
+         VarType max_dist = 0.0;
+
+         if (!best.empty()) {
+            max_dist = best.back().second;
+
+            // skip the subtree if it lies completely outside the current neighbourhood
+            if (best.size() == nfind) {
+               if (value > node.fVarMax && (node.fVarMax - value)*(node.fVarMax - value) > max_dist) continue;
+               if (value < node.fVarMin && (node.fVarMin - value)*(node.fVarMin - value) > max_dist) continue;
+            }
+         }
+
+         const VarType distance = FlatDist(x, &fFlatVars[std::size_t(inode)*fDimn], fDimn);
+
+         if (best.size() < nfind || distance < max_dist) {
+            if (best.size() == nfind) best.pop_back();
+            best.insert(std::upper_bound(best.begin(), best.end(), distance, CloserThan),
+                        Elem(fFlatTree[inode], distance));
+         }
+      }
+
+      // the nearer child is visited first, so it is pushed last
+      Int_t first = node.fLeft, second = node.fRight;
+      if (first >= 0 && second >= 0 && !(value < node.fVarDis)) std::swap(first, second);
+      else if (first < 0) std::swap(first, second);
+
+      if (second >= 0) stack.push_back(second);
+      if (first  >= 0) stack.push_back(first);
+   }
+
+   nlist.assign(best.begin(), best.end());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// compute scale factor for each variable (dimension) so that
 /// distance is computed uniformely along each dimension
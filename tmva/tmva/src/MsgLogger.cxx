@@ -43,6 +43,7 @@
 #include <assert.h>
 
 #include <memory>
+#include <mutex>
 
 #include <stdexcept>
 // ROOT include(s):
@@ -68,6 +69,8 @@ const std::map<TMVA::EMsgType, std::string>* TMVA::MsgLogger::fgColorMap = 0;
 #endif
 static std::auto_ptr<const std::map<TMVA::EMsgType, std::string> > gOwnTypeMap;
 static std::auto_ptr<const std::map<TMVA::EMsgType, std::string> > gOwnColorMap;
+// serializes the output of the loggers used from concurrent threads
+static std::mutex gOutputMutex;
  
 
 void   TMVA::MsgLogger::InhibitOutput() { fgInhibitOutput = kTRUE;  }
@@ -217,6 +220,7 @@ void TMVA::MsgLogger::WriteMsg( EMsgType type, const std::string& line ) const
 
    if ((stype = fgTypeMap.load()->find( type )) != fgTypeMap.load()->end()) {
       if (!gConfig().IsSilent() || type==kFATAL) {
+         std::lock_guard<std::mutex> guard(gOutputMutex);
          if (gConfig().UseColor()) {
             // no text for INFO or VERBOSE
             if (type == kINFO || type == kVERBOSE)
@@ -234,7 +238,10 @@ void TMVA::MsgLogger::WriteMsg( EMsgType type, const std::string& line ) const
 
    // take decision to stop if fatal error
    if (type == kFATAL) {
-      std::cout << "***> abort program execution" << std::endl;
+      {
+         std::lock_guard<std::mutex> guard(gOutputMutex);
+         std::cout << "***> abort program execution" << std::endl;
+      }
       throw std::runtime_error("FATAL error");
       
       //std::exit(1);
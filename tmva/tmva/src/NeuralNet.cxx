@@ -207,6 +207,303 @@ namespace TMVA
 
 
 
+        ThreadPool& ThreadPool::instance ()
+        {
+            static ThreadPool pool (std::max (std::thread::hardware_concurrency (), 1u) - 1);
+            return pool;
+        }
+
+
+
+        ThreadPool::ThreadPool (size_t numWorkers)
+            : m_task (nullptr)
+            , m_nextTask (0)
+            , m_numTasks (0)
+            , m_pendingTasks (0)
+            , m_stop (false)
+        {
+            for (size_t iWorker = 0; iWorker < numWorkers; ++iWorker)
+                m_workers.push_back (std::thread (&ThreadPool::work, this));
+        }
+
+
+
+        ThreadPool::~ThreadPool ()
+        {
+            {
+                std::lock_guard<std::mutex> lock (m_mutex);
+                m_stop = true;
+            }
+            m_cvWork.notify_all ();
+            for (auto& worker : m_workers)
+                worker.join ();
+        }
+
+
+
+        /** \brief execute the next pending task of the current run; the lock is released during the execution
+         *
+         */
+        bool ThreadPool::executeNext (std::unique_lock<std::mutex>& lock)
+        {
+            if (!m_task || m_nextTask >= m_numTasks)
+                return false;
+            const std::function<void(size_t)>& task = *m_task;
+            size_t idxTask = m_nextTask++;
+            lock.unlock ();
+            task (idxTask);
+            lock.lock ();
+            if (--m_pendingTasks == 0)
+                m_cvDone.notify_all ();
+            return true;
+        }
+
+
+
+        void ThreadPool::work ()
+        {
+            std::unique_lock<std::mutex> lock (m_mutex);
+            while (true)
+            {
+                m_cvWork.wait (lock, [this]{ return m_stop || (m_task && m_nextTask < m_numTasks); });
+                if (m_stop)
+                    return;
+                executeNext (lock);
+            }
+        }
+
+
+
+        void ThreadPool::run (size_t numTasks, const std::function<void(size_t)>& task)
+        {
+            if (numTasks == 0)
+                return;
+            std::lock_guard<std::mutex> runLock (m_runMutex);
+            std::unique_lock<std::mutex> lock (m_mutex);
+            m_task = &task;
+            m_nextTask = 0;
+            m_numTasks = numTasks;
+            m_pendingTasks = numTasks;
+            m_cvWork.notify_all ();
+
+            while (executeNext (lock))
+                ;
+            m_cvDone.wait (lock, [this]{ return m_pendingTasks == 0; });
+            m_task = nullptr;
+        }
+
+
+
+
+
+        /** \brief dot product with independent partial sums (vectorizable)
+         *
+         */
+        static inline double dotProduct (const double* a, const double* b, size_t n)
+        {
+            double sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+            size_t j = 0;
+            for (; j+4 <= n; j += 4)
+            {
+                sum0 += a[j]*b[j];
+                sum1 += a[j+1]*b[j+1];
+                sum2 += a[j+2]*b[j+2];
+                sum3 += a[j+3]*b[j+3];
+            }
+            for (; j < n; ++j)
+                sum0 += a[j]*b[j];
+            return (sum0+sum1)+(sum2+sum3);
+        }
+
+
+
+        // block sizes of the matrix multiplications: a block of rows of B (resp. C) 
+        // of blockRows x blockCols values stays in the L1/L2 cache 
+        static const size_t blockRows = 64;
+        static const size_t blockCols = 256;
+
+
+
+        void multiplyAdd (const double* A, const double* B, double* C, size_t m, size_t k, size_t n)
+        {
+            for (size_t k0 = 0; k0 < k; k0 += blockRows)
+            {
+                size_t k1 = std::min (k0+blockRows, k);
+                for (size_t j0 = 0; j0 < n; j0 += blockCols)
+                {
+                    size_t j1 = std::min (j0+blockCols, n);
+                    for (size_t i = 0; i < m; ++i)
+                    {
+                        const double* a = A + i*k;
+                        double* c = C + i*n;
+                        for (size_t p = k0; p < k1; ++p)
+                        {
+                            double aip = a[p];
+                            if (aip == 0.0) // dropped or inactive node
+                                continue;
+                            const double* b = B + p*n;
+                            for (size_t j = j0; j < j1; ++j)
+                                c[j] += aip * b[j];
+                        }
+                    }
+                }
+            }
+        }
+
+
+
+        void multiplyAddTransB (const double* A, const double* B, double* C, size_t m, size_t k, size_t n)
+        {
+            for (size_t p0 = 0; p0 < k; p0 += blockRows)
+            {
+                size_t p1 = std::min (p0+blockRows, k);
+                for (size_t i = 0; i < m; ++i)
+                {
+                    const double* a = A + i*n;
+                    double* c = C + i*k;
+                    for (size_t p = p0; p < p1; ++p)
+                        c[p] += dotProduct (a, B + p*n, n);
+                }
+            }
+        }
+
+
+
+        void multiplyAddTransA (const double* A, const double* B, double* C, size_t m, size_t k, size_t n, double alpha)
+        {
+            for (size_t p0 = 0; p0 < k; p0 += blockRows)
+            {
+                size_t p1 = std::min (p0+blockRows, k);
+                for (size_t j0 = 0; j0 < n; j0 += blockCols)
+                {
+                    size_t j1 = std::min (j0+blockCols, n);
+                    for (size_t i = 0; i < m; ++i)
+                    {
+                        const double* a = A + i*k;
+                        const double* b = B + i*n;
+                        for (size_t p = p0; p < p1; ++p)
+                        {
+                            double aip = alpha * a[p];
+                            if (aip == 0.0)
+                                continue;
+                            double* c = C + p*n;
+                            for (size_t j = j0; j < j1; ++j)
+                                c[j] += aip * b[j];
+                        }
+                    }
+                }
+            }
+        }
+
+
+
+        void applyActivation (EnumFunction eFunction, double* values, size_t n)
+        {
+            const double margin = 0.3;
+            const double s = 6.0;
+            switch (eFunction)
+            {
+            case EnumFunction::ZERO:
+                std::fill (values, values+n, 0.0);
+                break;
+            case EnumFunction::LINEAR:
+                break;
+            case EnumFunction::TANH:
+                for (size_t i = 0; i < n; ++i)
+                    values[i] = tanh (values[i]);
+                break;
+            case EnumFunction::RELU:
+                for (size_t i = 0; i < n; ++i)
+                    values[i] = values[i] > 0.0 ? values[i] : 0.0;
+                break;
+            case EnumFunction::SYMMRELU:
+                for (size_t i = 0; i < n; ++i)
+                    values[i] = values[i] > margin ? values[i]-margin : values[i] < -margin ? values[i]+margin : 0.0;
+                break;
+            case EnumFunction::TANHSHIFT:
+                for (size_t i = 0; i < n; ++i)
+                    values[i] = tanh (values[i]-margin);
+                break;
+            case EnumFunction::SOFTSIGN:
+                for (size_t i = 0; i < n; ++i)
+                    values[i] = values[i] / (1.0 + fabs (values[i]));
+                break;
+            case EnumFunction::SIGMOID:
+                for (size_t i = 0; i < n; ++i)
+                    values[i] = 1.0/(1.0 + std::exp (-std::max (-100.0, std::min (100.0, values[i]))));
+                break;
+            case EnumFunction::GAUSS:
+                for (size_t i = 0; i < n; ++i)
+                    values[i] = exp (-(values[i]*s)*(values[i]*s));
+                break;
+            case EnumFunction::GAUSSCOMPLEMENT:
+                for (size_t i = 0; i < n; ++i)
+                    values[i] = 1.0 - exp (-(values[i]*s)*(values[i]*s));
+                break;
+            }
+        }
+
+
+
+        void applyActivationGradient (EnumFunction eFunction, const double* values, double* gradients, size_t n)
+        {
+            const double margin = 0.3;
+            const double s = 6.0;
+            switch (eFunction)
+            {
+            case EnumFunction::ZERO:
+                std::fill (gradients, gradients+n, 0.0);
+                break;
+            case EnumFunction::LINEAR:
+                std::fill (gradients, gradients+n, 1.0);
+                break;
+            case EnumFunction::TANH:
+                for (size_t i = 0; i < n; ++i)
+                    gradients[i] = 1.0 - values[i]*values[i];
+                break;
+            case EnumFunction::RELU:
+                for (size_t i = 0; i < n; ++i)
+                    gradients[i] = values[i] > 0.0 ? 1.0 : 0.0;
+                break;
+            case EnumFunction::SYMMRELU:
+                for (size_t i = 0; i < n; ++i)
+                    gradients[i] = (values[i] > margin || values[i] < -margin) ? 1.0 : 0.0;
+                break;
+            case EnumFunction::TANHSHIFT:
+                for (size_t i = 0; i < n; ++i)
+                    gradients[i] = margin + (1.0 - values[i]*values[i]);
+                break;
+            case EnumFunction::SOFTSIGN:
+                for (size_t i = 0; i < n; ++i)
+                    gradients[i] = (1.0 - fabs (values[i]))*(1.0 - fabs (values[i]));
+                break;
+            case EnumFunction::SIGMOID:
+                for (size_t i = 0; i < n; ++i)
+                {
+                    double sig = 1.0/(1.0 + std::exp (-std::max (-100.0, std::min (100.0, values[i]))));
+                    gradients[i] = sig*(1.0-sig);
+                }
+                break;
+            case EnumFunction::GAUSS:
+                for (size_t i = 0; i < n; ++i)
+                    gradients[i] = -2.0 * values[i] * s*s * exp (-(values[i]*s)*(values[i]*s));
+                break;
+            case EnumFunction::GAUSSCOMPLEMENT:
+                for (size_t i = 0; i < n; ++i)
+                    gradients[i] = +2.0 * values[i] * s*s * (1.0 - exp (-(values[i]*s)*(values[i]*s)));
+                break;
+            }
+        }
+
+
+
+
+
+
+
+
+
+
         Settings::Settings (TString name,
                             size_t _convergenceSteps, size_t _batchSize, size_t _testRepetitions, 
                             double _factorWeightDecay, EnumRegularization eRegularization,
@@ -100,6 +100,9 @@
 #ifndef ROOT_TColor
 #include "TColor.h"
 #endif
+#ifndef ROOT_TDirectory
+#include "TDirectory.h"
+#endif
 
 ClassImp(TMVA::PDEFoam)
 
@@ -302,8 +305,10 @@ void TMVA::PDEFoam::SetXmax(Int_t idim, Double_t wmax)
 
 void TMVA::PDEFoam::Create()
 {
-   Bool_t addStatus = TH1::AddDirectoryStatus();
-   TH1::AddDirectory(kFALSE);
+   // the histograms of the foam build-up are not attached to any directory;
+   // the current directory is local to the thread, unlike TH1::AddDirectory(),
+   // so that this does not affect methods trained concurrently
+   TDirectory::TContext noDirectory(0);
 
    if(fPseRan==0) Log() << kFATAL << "Random number generator not set" << Endl;
    if(fDistr==0)  Log() << kFATAL << "Distribution function not set" << Endl;
@@ -354,8 +359,6 @@ void TMVA::PDEFoam::Create()
    InitCells();
    Grow();
 
-   TH1::AddDirectory(addStatus);
-
    // prepare PDEFoam for the filling with events
    ResetCellElements(); // reset all cell elements
 } // Create
@@ -86,6 +86,16 @@
 //    delete reader;
 //  ---------------------------------------------------------------------
 //
+//  Many events can be evaluated in one call, from an array holding the
+//  values of the variables event after event:
+//
+//    std::vector<Float_t>  inputs( 4*nEvents ); // var1, ..., var4 of each event
+//    std::vector<Double_t> mvaNN( nEvents );
+//    reader->EvaluateMVA( &inputs[0], nEvents, &mvaNN[0], "MLP method" );
+//
+//  This batch evaluation uses private copies of the booked method and may be
+//  called from several threads sharing one Reader.
+//
 //  An example application of the Reader can be found in TMVA/macros/TMVApplication.C.
 //_______________________________________________________________________
 
@@ -114,8 +124,15 @@
 #include "TVector.h"
 #include "TXMLEngine.h"
 #include "TMath.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#endif
 
 #include <cstdlib>
+#include <atomic>
 
 #include <string>
 #include <vector>
@@ -292,6 +309,10 @@ TMVA::Reader::~Reader( void )
       MethodBase * kl = dynamic_cast<TMVA::MethodBase*>(it->second);
       delete kl;
    }
+
+   for (auto it=fReplicas.begin(); it!=fReplicas.end(); it++){
+      for (auto rep=it->second.begin(); rep!=it->second.end(); rep++) delete *rep;
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -579,6 +600,144 @@ Double_t TMVA::Reader::EvaluateMVA( MethodBase* method, Double_t aux )
                                (fCalculateError?&fMvaEventErrorUpper:0) );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// evaluates the MVA for a batch of nEvents events. The values of the
+/// variables are read from inputs, event after event, in the order in which
+/// the variables were declared to the Reader; the MVA values are written to
+/// mvaValues. Events with a NaN variable get the MVA value -999.
+///
+/// The booked method itself is not used: the events are evaluated by private
+/// copies of it, so that several threads may call this function on the same
+/// Reader at the same time. With implicit multi-threading enabled the batch
+/// is split into chunks which are evaluated in parallel.
+
+void TMVA::Reader::EvaluateMVA( const Float_t* inputs, Long64_t nEvents, Double_t* mvaValues,
+                                const TString& methodTag, Double_t aux )
+{
+   if (nEvents<=0) return;
+
+   MethodBase* method = 0;
+   {
+      std::lock_guard<std::mutex> lock( fReplicaMutex );
+      method = dynamic_cast<TMVA::MethodBase*>( FindMVA( methodTag ) );
+      if (method==0) {
+         Log() << kFATAL << "<EvaluateMVA> " << methodTag << " is not a booked method" << Endl;
+         return;
+      }
+   }
+
+   const UInt_t nvar = DataInfo().GetNVariables();
+   Long64_t nNaN = 0;
+
+#ifdef R__USE_IMT
+   const Long64_t chunkSize = 1024;
+   if (ROOT::IsImplicitMTEnabled() && nEvents>chunkSize) {
+      std::atomic<Long64_t> nNaNChunks(0);
+      tbb::parallel_for( tbb::blocked_range<Long64_t>(0, nEvents, chunkSize),
+                         [&]( const tbb::blocked_range<Long64_t>& r ) {
+                            MethodBase* replica = AcquireReplica( methodTag, method, aux );
+                            nNaNChunks += EvaluateBatch( replica, inputs + r.begin()*nvar, r.end()-r.begin(),
+                                                         mvaValues + r.begin() );
+                            ReleaseReplica( methodTag, replica );
+                         } );
+      nNaN = nNaNChunks;
+   }
+   else
+#endif
+   {
+      MethodBase* replica = AcquireReplica( methodTag, method, aux );
+      nNaN = EvaluateBatch( replica, inputs, nEvents, mvaValues );
+      ReleaseReplica( methodTag, replica );
+   }
+
+   if (nNaN>0) {
+      std::lock_guard<std::mutex> lock( fReplicaMutex );
+      Log() << kERROR << nNaN << " of " << nEvents << " events have a NaN variable --> return MVA value -999 for them, \n"
+            << " that's all I can do, please fix or remove these events." << Endl;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// evaluates nEvents events with the given copy of a booked method, reusing
+/// a single event object; returns the number of events with a NaN variable
+
+Long64_t TMVA::Reader::EvaluateBatch( MethodBase* replica, const Float_t* inputs, Long64_t nEvents, Double_t* mvaValues ) const
+{
+   const UInt_t nvar = DataInfo().GetNVariables();
+   std::vector<Float_t> values( nvar );
+   Event ev( values, nvar );
+
+   Long64_t nNaN = 0;
+   for (Long64_t ievt=0; ievt<nEvents; ievt++) {
+      const Float_t* row = inputs + ievt*nvar;
+      Bool_t isNaN = kFALSE;
+      for (UInt_t ivar=0; ivar<nvar; ivar++) {
+         if (TMath::IsNaN(row[ivar])) isNaN = kTRUE;
+         ev.SetVal( ivar, row[ivar] );
+      }
+      if (isNaN) {
+         mvaValues[ievt] = -999;
+         nNaN++;
+         continue;
+      }
+      mvaValues[ievt] = replica->GetMvaValue( &ev );
+   }
+   return nNaN;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// returns an idle copy of the booked method for the exclusive use of the
+/// caller. New copies are booked from the weights of the method, which are
+/// serialised to XML the first time a copy is needed.
+
+TMVA::MethodBase* TMVA::Reader::AcquireReplica( const TString& methodTag, MethodBase* method, Double_t aux )
+{
+   MethodBase* replica = 0;
+   {
+      std::lock_guard<std::mutex> lock( fReplicaMutex );
+      std::vector<MethodBase*>& idle = fReplicas[methodTag];
+      if (!idle.empty()) {
+         replica = idle.back();
+         idle.pop_back();
+      }
+      else {
+         std::map<TString, TString>::iterator it = fReplicaXML.find( methodTag );
+         if (it == fReplicaXML.end()) {
+            void* doc      = gTools().xmlengine().NewDoc();
+            void* rootnode = gTools().AddChild(0,"MethodSetup", "", true);
+            gTools().xmlengine().DocSetRootElement(doc,rootnode);
+            gTools().AddAttr(rootnode,"Method", method->GetMethodTypeName() + "::" + method->GetMethodName());
+            method->WriteStateToXML(rootnode);
+            it = fReplicaXML.insert( std::make_pair( methodTag, TString() ) ).first;
+            gTools().xmlengine().SaveSingleNode( rootnode, &it->second );
+            gTools().xmlengine().FreeDoc(doc);
+         }
+         replica = dynamic_cast<MethodBase*>( BookMVA( method->GetMethodType(), it->second.Data() ) );
+         if (replica==0) {
+            Log() << kFATAL << "<EvaluateMVA> failed to copy method " << methodTag << " for batch evaluation" << Endl;
+         }
+      }
+   }
+
+   // the aux value is only needed for MethodCuts: it sets the
+   // required signal efficiency
+   if (replica->GetMethodType() == TMVA::Types::kCuts) {
+      TMVA::MethodCuts* mc = dynamic_cast<TMVA::MethodCuts*>(replica);
+      if(mc)
+         mc->SetTestSignalEfficiency( aux );
+   }
+   return replica;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// returns a copy obtained from AcquireReplica() to the idle pool
+
+void TMVA::Reader::ReleaseReplica( const TString& methodTag, MethodBase* replica )
+{
+   std::lock_guard<std::mutex> lock( fReplicaMutex );
+   fReplicas[methodTag].push_back( replica );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// evaluates MVA for given set of input variables
 
@@ -230,3 +230,93 @@ Float_t TMVA::SVKernelFunction::Evaluate( SVEvent* ev1, SVEvent* ev2 )
    return 0;
 }
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the kernel values of the point x with n points stored column-wise,
+/// the value of variable ivar of point i being data[ivar*stride+i].
+/// The loops run over the points for each variable, so that they can be
+/// vectorized while each value is accumulated in the same order as in
+/// Evaluate(SVEvent*,SVEvent*). Unlike the latter, this function does not
+/// modify the kernel function and can be called concurrently.
+
+void TMVA::SVKernelFunction::Evaluate( const Float_t* x, const Float_t* data, UInt_t nvar, UInt_t stride,
+                                       UInt_t n, Float_t* result ) const
+{
+   Evaluate( fKernel, x, data, nvar, stride, n, result );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// column-wise kernel values for the kernel type k
+
+void TMVA::SVKernelFunction::Evaluate( EKernelType k, const Float_t* x, const Float_t* data, UInt_t nvar,
+                                       UInt_t stride, UInt_t n, Float_t* result ) const
+{
+   switch(k) {
+   case kRBF:
+      {
+         for (UInt_t j = 0; j < n; j++) result[j] = 0;
+         for (UInt_t i = 0; i < nvar; i++) {
+            const Float_t  xi  = x[i];
+            const Float_t* col = data + i*stride;
+            for (UInt_t j = 0; j < n; j++) result[j] += (xi - col[j]) * (xi - col[j]);
+         }
+         for (UInt_t j = 0; j < n; j++) result[j] = TMath::Exp(-result[j]*fGamma);
+         return;
+      }
+   case kMultiGauss:
+      {
+         if(fmGamma.size() != nvar){
+            std::cout <<  "Fewer gammas than input variables! #Gammas= " << fmGamma.size() << " #Input variables= " << nvar << std::endl;
+            std::cout << "***> abort program execution" << std::endl;
+            exit(1);
+         }
+         for (UInt_t j = 0; j < n; j++) result[j] = 1.;
+         for (UInt_t i = 0; i < nvar; i++) {
+            const Float_t  xi  = x[i];
+            const Float_t* col = data + i*stride;
+            for (UInt_t j = 0; j < n; j++) result[j] *= TMath::Exp( -(xi - col[j])*(xi - col[j])*fmGamma[i] );
+         }
+         return;
+      }
+   case kPolynomial:
+   case kLinear:
+      {
+         const Float_t theta = (k == kPolynomial) ? fTheta : 0;
+         for (UInt_t j = 0; j < n; j++) result[j] = theta;
+         for (UInt_t i = 0; i < nvar; i++) {
+            const Float_t  xi  = x[i];
+            const Float_t* col = data + i*stride;
+            for (UInt_t j = 0; j < n; j++) result[j] += xi * col[j];
+         }
+         if (k == kPolynomial) {
+            Int_t order = fOrder;
+            for (UInt_t j = 0; j < n; j++) result[j] = TMath::Power(result[j],order);
+         }
+         return;
+      }
+   case kSigmoidal:
+      {
+         for (UInt_t j = 0; j < n; j++) result[j] = 0;
+         for (UInt_t i = 0; i < nvar; i++) {
+            const Float_t  xi  = x[i];
+            const Float_t* col = data + i*stride;
+            for (UInt_t j = 0; j < n; j++) result[j] += (xi - col[j]) * (xi - col[j]);
+         }
+         for (UInt_t j = 0; j < n; j++) result[j] = TMath::TanH( result[j]*fKappa + fTheta );
+         return;
+      }
+   case kProd:
+   case kSum:
+      {
+         std::vector<Float_t> tmp(n);
+         for (UInt_t j = 0; j < n; j++) result[j] = (k == kProd) ? 1 : 0;
+         for (UInt_t l = 0; l < fKernelsList.size(); l++) {
+            Evaluate( fKernelsList[l], x, data, nvar, stride, n, &tmp[0] );
+            if (k == kProd) for (UInt_t j = 0; j < n; j++) result[j] *= tmp[j];
+            else            for (UInt_t j = 0; j < n; j++) result[j] += tmp[j];
+         }
+         return;
+      }
+   }
+   for (UInt_t j = 0; j < n; j++) result[j] = 0;
+}
@@ -39,42 +39,74 @@
 #include "TMVA/Types.h"
 
 #include "RtypesCore.h"
+#include "TMath.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#endif
 
 #include <iostream>
+#include <new>
 #include <stdexcept>
 
 ////////////////////////////////////////////////////////////////////////////////
-/// constructor
+/// default constructor
 
 TMVA::SVKernelMatrix::SVKernelMatrix()
    : fSize(0),
+     fNVar(0),
      fKernelFunction(0),
-     fSVKernelMatrix(0),
-     fLogger( new MsgLogger("ResultsRegression", kINFO) )
+     fInputVectors(0),
+     fMaxLines(0),
+     fHits(0),
+     fMisses(0),
+     fLogger( new MsgLogger("SVKernelMatrix", kINFO) )
 {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// constructor
+/// Constructor. The lines of the kernel matrix are computed when they are
+/// first requested and kept in a cache of at most cacheSize MB; when the
+/// cache is full, the least recently used line is replaced. Only the
+/// diagonal is computed upfront.
 
-TMVA::SVKernelMatrix::SVKernelMatrix( std::vector<TMVA::SVEvent*>* inputVectors, SVKernelFunction* kernelFunction )
+TMVA::SVKernelMatrix::SVKernelMatrix( std::vector<TMVA::SVEvent*>* inputVectors, SVKernelFunction* kernelFunction,
+                                      UInt_t cacheSize )
    : fSize(inputVectors->size()),
+     fNVar(0),
      fKernelFunction(kernelFunction),
+     fInputVectors(inputVectors),
+     fMaxLines(0),
+     fHits(0),
+     fMisses(0),
      fLogger( new MsgLogger("SVKernelMatrix", kINFO) )
 {
-   fSVKernelMatrix = new Float_t*[fSize];
-   try{
-      for (UInt_t i = 0; i < fSize; i++) fSVKernelMatrix[i] = new Float_t[i+1];
-   }catch(...){
-      Log() << kFATAL << "Input data too large. Not enough memory to allocate memory for Support Vector Kernel Matrix. Please reduce the number of input events or use a different method."<<Endl;
-   }
-   // We compute the diagonal and one half of the off diagonal. When reading back we use
-   // the symmetry of i,j to j,i to ensure the correct values are returned.
+   if (fSize == 0) return;
+
+   // store the input variables variable by variable, for the evaluation of full lines
+   fNVar = (*inputVectors)[0]->GetDataVector()->size();
+   fData.resize( fNVar*fSize );
    for (UInt_t i = 0; i < fSize; i++) {
-      for (UInt_t j = 0; j <=i; j++) {
-         fSVKernelMatrix[i][j] = fKernelFunction->Evaluate((*inputVectors)[i], (*inputVectors)[j]);
-      }
+      const std::vector<Float_t>* v = (*inputVectors)[i]->GetDataVector();
+      for (UInt_t ivar = 0; ivar < fNVar; ivar++) fData[ivar*fSize+i] = (*v)[ivar];
    }
+
+   fDiagonal.resize( fSize );
+   for (UInt_t i = 0; i < fSize; i++) fDiagonal[i] = fKernelFunction->Evaluate((*inputVectors)[i], (*inputVectors)[i]);
+
+   // at least two lines are needed to update the error cache with the lines of a pair of events
+   const ULong64_t lineSize = ULong64_t(fSize)*sizeof(Float_t);
+   const ULong64_t maxLines = ULong64_t(cacheSize)*1024*1024/lineSize;
+   fMaxLines = UInt_t( TMath::Max( ULong64_t(2), TMath::Min( ULong64_t(fSize), maxLines ) ) );
+   fSlot.assign( fSize, -1 );
+
+   Log() << kVERBOSE << "Kernel matrix of " << fSize << " events, cache of " << fMaxLines << " lines ("
+         << (fMaxLines*lineSize)/(1024*1024) << " MB)" << Endl;
+   if (fMaxLines < fSize)
+      Log() << kINFO << "Kernel matrix cache holds " << fMaxLines << " of " << fSize
+            << " lines, increase KernelCacheSize to speed up the training" << Endl;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -82,38 +114,95 @@ TMVA::SVKernelMatrix::SVKernelMatrix( std::vector<TMVA::SVEvent*>* inputVectors,
 
 TMVA::SVKernelMatrix::~SVKernelMatrix()
 {
-   for (UInt_t i = fSize -1; i > 0; i--) {
-      delete[] fSVKernelMatrix[i];
-      fSVKernelMatrix[i] = 0;
-   }
-   delete[] fSVKernelMatrix;
-   fSVKernelMatrix = 0;
+   if (fHits+fMisses > 0)
+      Log() << kVERBOSE << "Kernel matrix cache: " << fHits << " hits, " << fMisses << " lines computed" << Endl;
+   for (UInt_t i = 0; i < fLines.size(); i++) delete[] fLines[i];
+   fLines.clear();
+   delete fLogger;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// returns a row of the kernel matrix
+/// Return the kernel values of event line with all events. The returned
+/// array is owned by the cache: it stays valid as long as fewer than
+/// GetMaxCachedLines() other lines are requested, in particular after the
+/// next call of GetLine.
 
-Float_t* TMVA::SVKernelMatrix::GetLine( UInt_t line )
+const Float_t* TMVA::SVKernelMatrix::GetLine( UInt_t line )
 {
-   Float_t* fLine = NULL;
-   if (line >= fSize) {
-      return NULL;
+   if (line >= fSize) return NULL;
+
+   Int_t slot = fSlot[line];
+   if (slot >= 0) {
+      ++fHits;
+      fLRU.splice( fLRU.begin(), fLRU, fLRUPos[slot] );
+      return fLines[slot];
+   }
+   ++fMisses;
+
+   Float_t* values = 0;
+   if (fLines.size() < fMaxLines) {
+      try {
+         values = new Float_t[fSize];
+      }
+      catch (std::bad_alloc&) {
+         if (fLines.size() < 2) {
+            Log() << kFATAL << "Input data too large. Not enough memory to allocate memory for Support Vector Kernel Matrix. Please reduce the number of input events or use a different method."<<Endl;
+         }
+         // continue with the lines allocated so far
+         fMaxLines = fLines.size();
+      }
+   }
+   if (values) {
+      slot = fLines.size();
+      fLines.push_back( values );
+      fLineIndex.push_back( line );
+      fLRU.push_front( slot );
+      fLRUPos.push_back( fLRU.begin() );
    }
    else {
-      fLine = new Float_t[fSize];
-      for( UInt_t i = 0; i <line; i++)
-         fLine[i] = fSVKernelMatrix[line][i];
-      for( UInt_t i = line; i < fSize; i++)
-         fLine[i] = fSVKernelMatrix[i][line];
-      return fLine;
+      // replace the least recently used line
+      slot = fLRU.back();
+      fSlot[fLineIndex[slot]] = -1;
+      fLineIndex[slot] = line;
+      fLRU.splice( fLRU.begin(), fLRU, fLRUPos[slot] );
    }
+   fSlot[line] = slot;
+
+   ComputeLine( line, fLines[slot] );
+   return fLines[slot];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// returns an element of the kernel matrix
+/// Return one element of the kernel matrix, taken from a cached line if
+/// possible, otherwise computed directly
 
 Float_t TMVA::SVKernelMatrix::GetElement(UInt_t i, UInt_t j)
 { 
-   if (i > j) return fSVKernelMatrix[i][j]; 
-   else       return fSVKernelMatrix[j][i]; // it's symmetric, ;)
+   if (i == j)       return fDiagonal[i];
+   if (fSlot[i] >= 0) return fLines[fSlot[i]][j];
+   if (fSlot[j] >= 0) return fLines[fSlot[j]][i]; // it's symmetric, ;)
+   return fKernelFunction->Evaluate((*fInputVectors)[i], (*fInputVectors)[j]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the kernel values of event line with all events. With implicit
+/// multi-threading enabled, long lines are computed in parallel chunks.
+
+void TMVA::SVKernelMatrix::ComputeLine( UInt_t line, Float_t* values ) const
+{
+   std::vector<Float_t> x( fNVar );
+   for (UInt_t ivar = 0; ivar < fNVar; ivar++) x[ivar] = fData[ivar*fSize+line];
+
+#ifdef R__USE_IMT
+   const UInt_t chunkSize = 1024;
+   if (ROOT::IsImplicitMTEnabled() && fSize > 4*chunkSize) {
+      tbb::parallel_for( tbb::blocked_range<UInt_t>(0, fSize, chunkSize),
+                         [&]( const tbb::blocked_range<UInt_t>& r ) {
+                            fKernelFunction->Evaluate( x.data(), fData.data()+r.begin(), fNVar, fSize,
+                                                       r.end()-r.begin(), values+r.begin() );
+                         } );
+      return;
+   }
+#endif
+   fKernelFunction->Evaluate( x.data(), fData.data(), fNVar, fSize, fSize, values );
 }
@@ -36,6 +36,12 @@
 
 #include "TMath.h"
 #include "TRandom3.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#endif
 
 #include <iostream>
 #include <vector>
@@ -62,7 +68,7 @@ TMVA::SVWorkingSet::SVWorkingSet()
 /// constructor
 
 TMVA::SVWorkingSet::SVWorkingSet(std::vector<TMVA::SVEvent*>*inputVectors, SVKernelFunction* kernelFunction,
-                                 Float_t tol, Bool_t doreg)
+                                 Float_t tol, Bool_t doreg, UInt_t cacheSize)
    : fdoRegression(doreg),
      fInputData(inputVectors),
      fSupVec(0),
@@ -74,11 +80,8 @@ TMVA::SVWorkingSet::SVWorkingSet(std::vector<TMVA::SVEvent*>*inputVectors, SVKer
      fTolerance(tol),      
      fLogger( new MsgLogger( "SVWorkingSet", kINFO ) )
 {
-   fKMatrix = new TMVA::SVKernelMatrix(inputVectors, kernelFunction);
-   Float_t *pt;
+   fKMatrix = new TMVA::SVKernelMatrix(inputVectors, kernelFunction, cacheSize);
    for( UInt_t i = 0; i < fInputData->size(); i++){ 
-      pt = fKMatrix->GetLine(i);
-      fInputData->at(i)->SetLine(pt);
       fInputData->at(i)->SetNs(i);
       if(fdoRegression) fInputData->at(i)->SetErrorCache(fInputData->at(i)->GetTarget());
    }
@@ -127,7 +130,7 @@ Bool_t TMVA::SVWorkingSet::ExamineExample( TMVA::SVEvent* jevt )
    Float_t fErrorC_J = 0.;
    if( jevt->GetIdx()==0) fErrorC_J = jevt->GetErrorCache();
    else{
-      Float_t *fKVals = jevt->GetLine();
+      const Float_t *fKVals = fKMatrix->GetLine(jevt->GetNs());
       fErrorC_J = 0.;
       std::vector<TMVA::SVEvent*>::iterator idIter;
       
@@ -303,16 +306,7 @@ Bool_t TMVA::SVWorkingSet::TakeStep(TMVA::SVEvent* ievt,TMVA::SVEvent* jevt )
    Float_t dL_I = type_I * ( newAlpha_I - alpha_I );
    Float_t dL_J = type_J * ( newAlpha_J - alpha_J );  
 
-   Int_t k = 0; 
-   for(idIter = fInputData->begin(); idIter != fInputData->end(); idIter++){
-      k++;
-      if((*idIter)->GetIdx()==0){
-         Float_t ii = fKMatrix->GetElement(ievt->GetNs(), (*idIter)->GetNs());
-         Float_t jj = fKMatrix->GetElement(jevt->GetNs(), (*idIter)->GetNs());
-         
-         (*idIter)->UpdateErrorCache(dL_I * ii + dL_J * jj);       
-      }
-   }
+   UpdateErrorCache(ievt, jevt, dL_I, dL_J);
    ievt->SetAlpha(newAlpha_I);
    jevt->SetAlpha(newAlpha_J);
    // set new indexes
@@ -448,6 +442,36 @@ void TMVA::SVWorkingSet::SetIndex( TMVA::SVEvent* event )
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add dAlpha_I*K(I,k) + dAlpha_J*K(J,k) to the error cache of the events k
+/// in I0 after a step on the pair (ievt,jevt). The kernel matrix lines of
+/// the pair are fetched once; with implicit multi-threading enabled, large
+/// sets of events are updated in parallel chunks.
+
+void TMVA::SVWorkingSet::UpdateErrorCache( TMVA::SVEvent* ievt, TMVA::SVEvent* jevt, Float_t dAlpha_I, Float_t dAlpha_J )
+{
+   const Float_t *line_I = fKMatrix->GetLine(ievt->GetNs());
+   const Float_t *line_J = fKMatrix->GetLine(jevt->GetNs());
+   const std::vector<TMVA::SVEvent*> &events = *fInputData;
+
+   auto update = [&]( UInt_t begin, UInt_t end ) {
+      for (UInt_t k = begin; k < end; k++) {
+         SVEvent* ev = events[k];
+         if (ev->GetIdx()==0) ev->UpdateErrorCache(dAlpha_I * line_I[ev->GetNs()] + dAlpha_J * line_J[ev->GetNs()]);
+      }
+   };
+
+#ifdef R__USE_IMT
+   const UInt_t chunkSize = 4096;
+   if (ROOT::IsImplicitMTEnabled() && events.size() > 4*chunkSize) {
+      tbb::parallel_for( tbb::blocked_range<UInt_t>(0, events.size(), chunkSize),
+                         [&]( const tbb::blocked_range<UInt_t>& r ) { update(r.begin(), r.end()); } );
+      return;
+   }
+#endif
+   update(0, events.size());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void TMVA::SVWorkingSet::PrintStat() 
@@ -627,17 +651,8 @@ Bool_t TMVA::SVWorkingSet::TakeStepReg(TMVA::SVEvent* ievt,TMVA::SVEvent* jevt )
       const Float_t diff_alpha_j = jevt->GetDeltaAlpha()+b_alpha_j_p - jevt->GetAlpha();
 
       //update error cache
-      Int_t k = 0; 
-      for(idIter = fInputData->begin(); idIter != fInputData->end(); idIter++){
-         k++;
-         //there will be some changes in Idx notation
-         if((*idIter)->GetIdx()==0){
-            Float_t k_ii = fKMatrix->GetElement(ievt->GetNs(), (*idIter)->GetNs());
-            Float_t k_jj = fKMatrix->GetElement(jevt->GetNs(), (*idIter)->GetNs());
-         
-            (*idIter)->UpdateErrorCache(diff_alpha_i * k_ii + diff_alpha_j * k_jj);
-         }
-      }
+      //there will be some changes in Idx notation
+      UpdateErrorCache(ievt, jevt, diff_alpha_i, diff_alpha_j);
          
       //store new alphas in SVevents
       ievt->SetAlpha(b_alpha_i);
@@ -679,7 +694,7 @@ Bool_t TMVA::SVWorkingSet::ExamineExampleReg(TMVA::SVEvent* jevt)
       fErrorC_J = jevt->GetErrorCache();
    }
    else{
-      Float_t *fKVals = jevt->GetLine();
+      const Float_t *fKVals = fKMatrix->GetLine(jevt->GetNs());
       fErrorC_J = 0.;
       std::vector<TMVA::SVEvent*>::iterator idIter;
       
@@ -51,6 +51,7 @@ TMVA::SimulatedAnnealing::SimulatedAnnealing( IFitterTarget& target, const std::
 : fKernelTemperature     (kIncreasingAdaptive),
    fFitterTarget          ( target ),
    fRandom                ( new TRandom3(100) ),
+   fSeed                  ( 100 ),
    fRanges                ( ranges ),
    fMaxCalls              ( 500000 ),
    fInitialTemperature    ( 1000 ),
@@ -61,12 +62,22 @@ TMVA::SimulatedAnnealing::SimulatedAnnealing( IFitterTarget& target, const std::
    fTemperatureAdaptiveStep( 0.0 ),
    fUseDefaultScale       ( kFALSE ),
    fUseDefaultTemperature ( kFALSE ),
-   fLogger( new MsgLogger("SimulatedAnnealing") ),
-   fProgress(0.0)
+   fChains                ( 1 ),
+   fLogger( new MsgLogger("SimulatedAnnealing") )
 {
    fKernelTemperature = kIncreasingAdaptive;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// seed of the random generator (0 gives random seeds); with several chains,
+/// chain c uses the seed + c
+
+void TMVA::SimulatedAnnealing::SetSeed( UInt_t seed )
+{
+   fSeed = seed;
+   fRandom->SetSeed( seed );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// option setter
 
@@ -128,10 +139,10 @@ TMVA::SimulatedAnnealing::~SimulatedAnnealing()
 ////////////////////////////////////////////////////////////////////////////////
 /// random starting parameters
 
-void TMVA::SimulatedAnnealing::FillWithRandomValues( std::vector<Double_t>& parameters )
+void TMVA::SimulatedAnnealing::FillWithRandomValues( std::vector<Double_t>& parameters, TRandom* rnd )
 {
    for (UInt_t rIter = 0; rIter < parameters.size(); rIter++) {
-      parameters[rIter] = fRandom->Uniform(0.0,1.0)*(fRanges[rIter]->GetMax() - fRanges[rIter]->GetMin()) + fRanges[rIter]->GetMin();
+      parameters[rIter] = rnd->Uniform(0.0,1.0)*(fRanges[rIter]->GetMax() - fRanges[rIter]->GetMin()) + fRanges[rIter]->GetMin();
    }
 }
 
@@ -147,14 +158,14 @@ void TMVA::SimulatedAnnealing::ReWriteParameters( std::vector<Double_t>& from, s
 /// generate adjacent parameters
 
 void TMVA::SimulatedAnnealing::GenerateNeighbour( std::vector<Double_t>& parameters, std::vector<Double_t>& oldParameters, 
-                                                  Double_t currentTemperature )
+                                                  Double_t currentTemperature, TRandom* rnd )
 {
    ReWriteParameters( parameters, oldParameters );
 
    for (UInt_t rIter=0;rIter<parameters.size();rIter++) {
       Double_t uni,distribution,sign;
       do {
-         uni = fRandom->Uniform(0.0,1.0);
+         uni = rnd->Uniform(0.0,1.0);
          sign = (uni - 0.5 >= 0.0) ? (1.0) : (-1.0);
          distribution = currentTemperature * (TMath::Power(1.0 + 1.0/currentTemperature, TMath::Abs(2.0*uni - 1.0)) -1.0)*sign;
          parameters[rIter] = oldParameters[rIter] +  (fRanges[rIter]->GetMax()-fRanges[rIter]->GetMin())*0.1*distribution;
@@ -186,7 +197,7 @@ std::vector<Double_t> TMVA::SimulatedAnnealing::GenerateNeighbour( std::vector<D
 ////////////////////////////////////////////////////////////////////////////////
 /// generate new temperature
 
-void TMVA::SimulatedAnnealing::GenerateNewTemperature( Double_t& currentTemperature, Int_t Iter )
+void TMVA::SimulatedAnnealing::GenerateNewTemperature( Double_t& currentTemperature, Int_t Iter, Double_t progress )
 {
    if      (fKernelTemperature == kSqrt) {
       currentTemperature = fInitialTemperature/(Double_t)TMath::Sqrt(Iter+2) * fTemperatureScale;
@@ -204,7 +215,7 @@ void TMVA::SimulatedAnnealing::GenerateNewTemperature( Double_t& currentTemperat
       currentTemperature = currentTemperature*fTemperatureScale;
    }
    else if (fKernelTemperature == kIncreasingAdaptive) {
-      currentTemperature = fMinTemperature + fTemperatureScale*TMath::Log(1.0+fProgress*fAdaptiveSpeed);
+      currentTemperature = fMinTemperature + fTemperatureScale*TMath::Log(1.0+progress*fAdaptiveSpeed);
    }
    else if (fKernelTemperature == kDecreasingAdaptive) {
       currentTemperature = currentTemperature*fTemperatureScale;
@@ -215,11 +226,11 @@ void TMVA::SimulatedAnnealing::GenerateNewTemperature( Double_t& currentTemperat
 ////////////////////////////////////////////////////////////////////////////////
 /// result checker
 
-Bool_t TMVA::SimulatedAnnealing::ShouldGoIn( Double_t currentFit, Double_t localFit, Double_t currentTemperature )
+Bool_t TMVA::SimulatedAnnealing::ShouldGoIn( Double_t currentFit, Double_t localFit, Double_t currentTemperature, TRandom* rnd )
 {
    if (currentTemperature < fEps) return kFALSE;
    Double_t lim  = TMath::Exp( -TMath::Abs( currentFit - localFit ) / currentTemperature );
-   Double_t prob = fRandom->Uniform(0.0, 1.0);
+   Double_t prob = rnd->Uniform(0.0, 1.0);
    return (prob < lim) ? kTRUE : kFALSE;
 }
 
@@ -306,81 +317,105 @@ Double_t TMVA::SimulatedAnnealing::GenerateMaxTemperature( std::vector<Double_t>
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// minimisation algorithm
+/// Minimisation algorithm. With more than one chain (see SetChains), as many
+/// independent annealing chains are run side by side, each with its own
+/// random generator and temperature; at each step the new points of all
+/// chains are passed at once to IFitterTarget::EstimatorFunctions, which may
+/// evaluate them concurrently. The best point over all chains is returned.
+/// The first chain uses the same random sequence as a single chain.
 
 Double_t TMVA::SimulatedAnnealing::Minimize( std::vector<Double_t>& parameters )
 {
-   std::vector<Double_t> bestParameters(fRanges.size());
-   std::vector<Double_t> oldParameters (fRanges.size());
+   const Int_t nChains = TMath::Max( fChains, 1 );
 
-   Double_t currentTemperature, bestFit, currentFit;
-   Int_t optimizeCalls, generalCalls, equals;
+   std::vector<TRandom*> rnd( nChains, fRandom );
+   for (Int_t c = 1; c < nChains; c++) rnd[c] = new TRandom3( fSeed == 0 ? 0 : fSeed + c );
 
-   equals = 0;
+   std::vector< std::vector<Double_t> > chainParameters( nChains, parameters );
+   std::vector< std::vector<Double_t> > bestParameters ( nChains );
+   std::vector< std::vector<Double_t> > oldParameters  ( nChains, std::vector<Double_t>(fRanges.size()) );
 
+   std::vector<Double_t> currentTemperature( nChains ), bestFit( nChains ), currentFit( nChains ), progress( nChains, 0.0 );
+   std::vector<Int_t>    equals( nChains, 0 );
+   Int_t optimizeCalls, generalCalls;
+
+   Double_t startTemperature;
    if (fUseDefaultTemperature) {
       if (fKernelTemperature == kIncreasingAdaptive) {
-         fMinTemperature = currentTemperature = 1e-06; 
-         FillWithRandomValues( parameters );
+         fMinTemperature = startTemperature = 1e-06; 
+         for (Int_t c = 0; c < nChains; c++) FillWithRandomValues( chainParameters[c], rnd[c] );
+      }
+      else {
+         fInitialTemperature = startTemperature = GenerateMaxTemperature( parameters );
+         for (Int_t c = 0; c < nChains; c++) chainParameters[c] = parameters;
       }
-      else fInitialTemperature = currentTemperature = GenerateMaxTemperature( parameters );
    }
    else {
       if (fKernelTemperature == kIncreasingAdaptive)
-         currentTemperature = fMinTemperature; 
+         startTemperature = fMinTemperature; 
       else
-         currentTemperature = fInitialTemperature;
-      FillWithRandomValues( parameters ); 
+         startTemperature = fInitialTemperature;
+      for (Int_t c = 0; c < nChains; c++) FillWithRandomValues( chainParameters[c], rnd[c] );
    }
+   for (Int_t c = 0; c < nChains; c++) currentTemperature[c] = startTemperature;
 
    if (fUseDefaultScale) SetDefaultScale();
 
    Log() << kINFO
          << "Temperatur scale = "      << fTemperatureScale  
-         << ", current temperature = " << currentTemperature  << Endl;
+         << ", current temperature = " << startTemperature;
+   if (nChains > 1) Log() << ", " << nChains << " chains";
+   Log() << Endl;
+
+   std::vector< std::vector<Double_t>* > points( nChains );
+   for (Int_t c = 0; c < nChains; c++) points[c] = &chainParameters[c];
+   std::vector<Double_t> localFit( nChains );
 
-   bestParameters = parameters;
-   bestFit        = currentFit = fFitterTarget.EstimatorFunction( bestParameters );
+   bestParameters = chainParameters;
+   fFitterTarget.EstimatorFunctions( points, localFit );
+   for (Int_t c = 0; c < nChains; c++) bestFit[c] = currentFit[c] = localFit[c];
 
    optimizeCalls = fMaxCalls/100;             //use 1% calls to optimize best founded minimum
    generalCalls  = fMaxCalls - optimizeCalls; //and 99% calls to found that one
-   fProgress = 0.0;
 
    Timer timer( fMaxCalls, fLogger->GetSource().c_str() );
 
    for (Int_t sample = 0; sample < generalCalls; sample++) {
-      GenerateNeighbour( parameters, oldParameters, currentTemperature );
-      Double_t localFit = fFitterTarget.EstimatorFunction( parameters );
-      
-      if (localFit < currentFit || TMath::Abs(currentFit-localFit) < fEps) { // if not worse than last one
-         if (TMath::Abs(currentFit-localFit) < fEps) { // if the same as last one
-            equals++;
-            if (equals >= 3) //if we still at the same level, we should increase temperature
-               fProgress+=1.0;
-         }
-         else {
-            fProgress = 0.0;
-            equals = 0;
-         }
+      for (Int_t c = 0; c < nChains; c++)
+         GenerateNeighbour( chainParameters[c], oldParameters[c], currentTemperature[c], rnd[c] );
+      fFitterTarget.EstimatorFunctions( points, localFit );
+
+      for (Int_t c = 0; c < nChains; c++) {
+         if (localFit[c] < currentFit[c] || TMath::Abs(currentFit[c]-localFit[c]) < fEps) { // if not worse than last one
+            if (TMath::Abs(currentFit[c]-localFit[c]) < fEps) { // if the same as last one
+               equals[c]++;
+               if (equals[c] >= 3) //if we still at the same level, we should increase temperature
+                  progress[c]+=1.0;
+            }
+            else {
+               progress[c] = 0.0;
+               equals[c] = 0;
+            }
          
-         currentFit = localFit;
+            currentFit[c] = localFit[c];
          
-         if (currentFit < bestFit) {
-            ReWriteParameters( parameters, bestParameters );
-            bestFit = currentFit;
+            if (currentFit[c] < bestFit[c]) {
+               ReWriteParameters( chainParameters[c], bestParameters[c] );
+               bestFit[c] = currentFit[c];
+            }
          }
-      }
-      else {
-         if (!ShouldGoIn(localFit, currentFit, currentTemperature))
-            ReWriteParameters( oldParameters, parameters );
-         else
-            currentFit = localFit;
+         else {
+            if (!ShouldGoIn(localFit[c], currentFit[c], currentTemperature[c], rnd[c]))
+               ReWriteParameters( oldParameters[c], chainParameters[c] );
+            else
+               currentFit[c] = localFit[c];
          
-         fProgress+=1.0;
-         equals = 0;
-      }
+            progress[c]+=1.0;
+            equals[c] = 0;
+         }
       
-      GenerateNewTemperature( currentTemperature, sample );
+         GenerateNewTemperature( currentTemperature[c], sample, progress[c] );
+      }
       
       if ((fMaxCalls<100) || sample%Int_t(fMaxCalls/100.0) == 0) timer.DrawProgressBar( sample );
    }
@@ -392,29 +427,36 @@ Double_t TMVA::SimulatedAnnealing::Minimize( std::vector<Double_t>& parameters )
    // supose this minimum is the best one, now just try to improve it
 
    Double_t startingTemperature = fMinTemperature*(fRanges.size())*2.0; 
-   currentTemperature = startingTemperature;
+   for (Int_t c = 0; c < nChains; c++) currentTemperature[c] = startingTemperature;
 
-   Int_t changes = 0;
    for (Int_t sample=0;sample<optimizeCalls;sample++) {
-      GenerateNeighbour( parameters, oldParameters, currentTemperature );
-      Double_t localFit = fFitterTarget.EstimatorFunction( parameters );
-      
-      if (localFit < currentFit) { //if better than last one
-         currentFit = localFit;
-         changes++;
+      for (Int_t c = 0; c < nChains; c++)
+         GenerateNeighbour( chainParameters[c], oldParameters[c], currentTemperature[c], rnd[c] );
+      fFitterTarget.EstimatorFunctions( points, localFit );
+
+      for (Int_t c = 0; c < nChains; c++) {
+         if (localFit[c] < currentFit[c]) { //if better than last one
+            currentFit[c] = localFit[c];
          
-         if (currentFit < bestFit) {
-            ReWriteParameters( parameters, bestParameters );
-            bestFit = currentFit;
+            if (currentFit[c] < bestFit[c]) {
+               ReWriteParameters( chainParameters[c], bestParameters[c] );
+               bestFit[c] = currentFit[c];
+            }
          }
-      }
-      else ReWriteParameters( oldParameters, parameters ); //we never try worse parameters
+         else ReWriteParameters( oldParameters[c], chainParameters[c] ); //we never try worse parameters
 
-      currentTemperature-=(startingTemperature - fEps)/optimizeCalls;
+         currentTemperature[c]-=(startingTemperature - fEps)/optimizeCalls;
+      }
    }
 
-   ReWriteParameters( bestParameters, parameters );
+   // best point of all chains
+   Int_t best = 0;
+   for (Int_t c = 1; c < nChains; c++) if (bestFit[c] < bestFit[best]) best = c;
+   if (nChains > 1) Log() << kINFO << "Best minimum found by chain " << best << " of " << nChains << Endl;
 
-   return bestFit; 
-}
+   ReWriteParameters( bestParameters[best], parameters );
+
+   for (Int_t c = 1; c < nChains; c++) delete rnd[c];
 
+   return bestFit[best]; 
+}
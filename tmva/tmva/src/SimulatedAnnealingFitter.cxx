@@ -71,6 +71,8 @@ void TMVA::SimulatedAnnealingFitter::DeclareOptions()
    // Eps                      <int>      number of epochs for simulated annealing
    // NFunLoops                <int>      number of loops for simulated annealing      
    // NEps                     <int>      number of epochs for simulated annealing
+   // Chains                   <int>      number of independent annealing chains, run side by side
+   // Seed                     <int>      seed of the random generator, chain c uses seed+c (0 gives random seeds)
 
    // default settings
    fMaxCalls                = 100000;
@@ -83,6 +85,8 @@ void TMVA::SimulatedAnnealingFitter::DeclareOptions()
    fKernelTemperatureS      = "IncAdaptive";
    fUseDefaultScale         = kFALSE;
    fUseDefaultTemperature   = kFALSE;
+   fChains                  = 1;
+   fSeed                    = 100;
 
    DeclareOptionRef(fMaxCalls,               "MaxCalls",              "Maximum number of minimisation calls");
    DeclareOptionRef(fInitialTemperature,     "InitialTemp",           "Initial temperature");  
@@ -93,6 +97,8 @@ void TMVA::SimulatedAnnealingFitter::DeclareOptions()
    DeclareOptionRef(fTemperatureAdaptiveStep,"TempAdaptiveStep",      "Step made in each generation temperature adaptive");
    DeclareOptionRef(fUseDefaultScale,        "UseDefaultScale",       "Use default temperature scale for temperature minimisation algorithm");
    DeclareOptionRef(fUseDefaultTemperature,  "UseDefaultTemp",        "Use default initial temperature");
+   DeclareOptionRef(fChains,                 "Chains",                "Number of independent annealing chains, evaluated together");
+   DeclareOptionRef(fSeed,                   "Seed",                  "Seed of the random generator, the other chains use the following seeds (0 gives random seeds)");
 
    DeclareOptionRef(fKernelTemperatureS,     "KernelTemp",            "Temperature minimisation algorithm");
    AddPreDefVal(TString("IncAdaptive"));
@@ -142,6 +148,8 @@ Double_t TMVA::SimulatedAnnealingFitter::Run( std::vector<Double_t>& pars )
    sa.SetOptions( fMaxCalls, fInitialTemperature, fMinTemperature, fEps, fKernelTemperatureS,
                   fTemperatureScale, fAdaptiveSpeed, fTemperatureAdaptiveStep, 
                   fUseDefaultScale, fUseDefaultTemperature );
+   sa.SetChains( fChains );
+   sa.SetSeed( fSeed );
    // minimise
    Double_t fcn = sa.Minimize( pars );
 
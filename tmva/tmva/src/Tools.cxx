@@ -63,6 +63,7 @@
 #include "TTreeFormula.h"
 #include "TXMLEngine.h"
 #include "TROOT.h"
+#include "ThreadLocalStorage.h"
 #include "TMatrixDSymEigen.h"
 
 #include <algorithm>
@@ -107,7 +108,6 @@ void         TMVA::Tools::DestroyInstance() {
 
 TMVA::Tools::Tools() :
    fRegexp("$&|!%^&()'<>?= "),
-   fLogger(new MsgLogger("Tools")),
    fXMLEngine(new TXMLEngine())
 {
 }
@@ -117,10 +117,18 @@ TMVA::Tools::Tools() :
 
 TMVA::Tools::~Tools()
 {
-   delete fLogger;
    delete fXMLEngine;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// message logger, one per thread as the tools are shared by all methods
+
+TMVA::MsgLogger& TMVA::Tools::Log() const
+{
+   TTHREAD_TLS_DECL_ARG(MsgLogger,logger,"Tools");
+   return logger;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// normalise to output range: [-1, 1]
 
@@ -217,13 +225,38 @@ void TMVA::Tools::ComputeStat( const std::vector<TMVA::Event*>& events, std::vec
                                Double_t& rmsS,  Double_t& rmsB,
                                Double_t& xmin,  Double_t& xmax,
                                Int_t signalClass, Bool_t  norm )
+{
+   EventCursor cursor( events );
+   ComputeStat( cursor, valVec, meanS, meanB, rmsS, rmsB, xmin, xmax, signalClass, norm );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// same for the events stored in columns, read row by row
+
+void TMVA::Tools::ComputeStat( const EventColumns& columns, std::vector<Float_t>* valVec,
+                               Double_t& meanS, Double_t& meanB,
+                               Double_t& rmsS,  Double_t& rmsB,
+                               Double_t& xmin,  Double_t& xmax,
+                               Int_t signalClass, Bool_t  norm )
+{
+   EventCursor cursor( columns );
+   ComputeStat( cursor, valVec, meanS, meanB, rmsS, rmsB, xmin, xmax, signalClass, norm );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TMVA::Tools::ComputeStat( EventCursor& events, std::vector<Float_t>* valVec,
+                               Double_t& meanS, Double_t& meanB,
+                               Double_t& rmsS,  Double_t& rmsB,
+                               Double_t& xmin,  Double_t& xmax,
+                               Int_t signalClass, Bool_t  norm )
 {
    if (0 == valVec)
       Log() << kFATAL << "<Tools::ComputeStat> value vector is zero pointer" << Endl;
 
-   if ( events.size() != valVec->size() )
+   if ( events.GetNEvents() != (Long64_t)valVec->size() )
       Log() << kWARNING << "<Tools::ComputeStat> event and value vector have different lengths "
-            << events.size() << "!=" << valVec->size() << Endl;
+            << events.GetNEvents() << "!=" << valVec->size() << Endl;
 
    Long64_t entries = valVec->size();
 
@@ -247,12 +280,13 @@ void TMVA::Tools::ComputeStat( const std::vector<TMVA::Event*>& events, std::vec
       Double_t theVar = (*valVec)[ievt];
       if (norm) theVar = Tools::NormVariable( theVar, xmin_, xmax_ );
 
-      if (Int_t(events[ievt]->GetClass()) == signalClass ){
-         wgtVecS[nEventsS]   = events[ievt]->GetWeight(); // this is signal
+      const Event* ev = events.GetEvent(ievt);
+      if (Int_t(ev->GetClass()) == signalClass ){
+         wgtVecS[nEventsS]   = ev->GetWeight(); // this is signal
          varVecS[nEventsS++] = theVar; // this is signal
       }
       else {
-         wgtVecB[nEventsB]   = events[ievt]->GetWeight(); // this is signal
+         wgtVecB[nEventsB]   = ev->GetWeight(); // this is signal
          varVecB[nEventsB++] = theVar; // this is background
       }
 
@@ -34,6 +34,7 @@
 #include "TMVA/DataSet.h"
 #include "TMVA/DataSetInfo.h"
 #include "TMVA/Event.h"
+#include "TMVA/EventColumns.h"
 #include "TMVA/MsgLogger.h"
 #include "TMVA/Ranking.h"
 #include "TMVA/Tools.h"
@@ -80,6 +81,7 @@ TMVA::TransformationHandler::~TransformationHandler()
 {
    std::vector<Ranking*>::const_iterator it = fRanking.begin();
    for (; it != fRanking.end(); it++) delete *it;
+   for (UInt_t i=0; i<fTransformedColumns.size(); i++) delete fTransformedColumns[i];
 
    fTransformations.SetOwner();
    delete fLogger;
@@ -206,6 +208,15 @@ const std::vector<TMVA::Event*>* TMVA::TransformationHandler::CalcTransformation
    for ( UInt_t ievt = 0; ievt<events.size(); ievt++)
       transformedEvents->at(ievt) = new Event(*events.at(ievt));
 
+   return TransformEvents( transformedEvents, createNewVector );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// prepare and apply the transformations to the copied events, see above
+
+const std::vector<TMVA::Event*>* TMVA::TransformationHandler::TransformEvents( std::vector<Event*>* transformedEvents,
+                                                                               Bool_t createNewVector )
+{
    TListIter trIt(&fTransformations);
    std::vector< Int_t >::iterator rClsIt = fTransformationsReferenceClasses.begin();
    while (VariableTransformBase *trf = (VariableTransformBase*) trIt()) {
@@ -234,21 +245,93 @@ const std::vector<TMVA::Event*>* TMVA::TransformationHandler::CalcTransformation
    return transformedEvents; // give back the newly created event collection (containing the transformed events)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// true if there are transformations and all of them can be applied to the
+/// columns; without transformations the columns are used as they are
+
+Bool_t TMVA::TransformationHandler::CanTransformColumns( const EventColumns& columns ) const
+{
+   if (fTransformations.GetEntries() <= 0) return kFALSE;
+
+   TListIter trIt(&fTransformations);
+   while (VariableTransformBase *trf = (VariableTransformBase*) trIt()) {
+      if (!trf->CanTransformColumns( columns )) return kFALSE;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// same as above for events stored in columns. If all transformations can
+/// be applied to columns, a copy of the columns is transformed in place, one
+/// transformation after the other, and the statistics and plots are made
+/// row by row, without creating events. The returned events are views of
+/// the transformed copy, which is kept by the handler together with the
+/// views; only the vector is owned by the caller. Otherwise the rows are
+/// copied into events, which are transformed as the events of a collection.
+/// Without transformations, nothing is done and 0 is returned.
+
+const std::vector<TMVA::Event*>* TMVA::TransformationHandler::CalcTransformations( const EventColumns& columns,
+                                                                                   Bool_t createNewVector )
+{
+   if (fTransformations.GetEntries() <= 0) return NULL;
+
+   if (!CanTransformColumns( columns )) {
+      EventCursor cursor( columns );
+      std::vector<Event*>* transformedEvents = new std::vector<Event*>( cursor.GetNEvents() );
+      for (Long64_t ievt=0; ievt<cursor.GetNEvents(); ievt++)
+         (*transformedEvents)[ievt] = new Event( *cursor.GetEvent(ievt) );
+      return TransformEvents( transformedEvents, createNewVector );
+   }
+
+   EventColumns* transformedColumns = new EventColumns( columns );
+
+   TListIter trIt(&fTransformations);
+   std::vector< Int_t >::iterator rClsIt = fTransformationsReferenceClasses.begin();
+   while (VariableTransformBase *trf = (VariableTransformBase*) trIt()) {
+      if (trf->PrepareColumnTransformation( *transformedColumns )) {
+         trf->TransformColumns( *transformedColumns, (*rClsIt) );
+         rClsIt++;
+      }
+   }
+
+   EventCursor cursor( *transformedColumns );
+   CalcStats( cursor );
+
+   // plot the variables once in this transformation
+   PlotVariables( cursor );
+
+   if (!createNewVector) {
+      delete transformedColumns;
+      return NULL;
+   }
+
+   fTransformedColumns.push_back( transformedColumns );
+   return transformedColumns->CreateViews();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void TMVA::TransformationHandler::CalcStats (const std::vector<Event*>& events )
+{
+   EventCursor cursor( events );
+   CalcStats( cursor );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TMVA::TransformationHandler::CalcStats( EventCursor& events )
 {
    // method to calculate minimum, maximum, mean, and RMS for all
    // variables used in the MVA
 
-   UInt_t nevts = events.size();
+   UInt_t nevts = events.GetNEvents();
 
    if (nevts==0)
       Log() << kFATAL << "No events available to find min, max, mean and rms" << Endl;
 
    // if transformation has not been succeeded, the tree may be empty
-   const UInt_t nvar = events[0]->GetNVariables();
-   const UInt_t ntgt = events[0]->GetNTargets();
+   const UInt_t nvar = events.GetEvent(0)->GetNVariables();
+   const UInt_t ntgt = events.GetEvent(0)->GetNTargets();
 
    Double_t  *sumOfWeights = new Double_t[fNumC];
    Double_t* *x2           = new Double_t*[fNumC];
@@ -270,7 +353,7 @@ void TMVA::TransformationHandler::CalcStats (const std::vector<Event*>& events )
    }
 
    for (UInt_t ievt=0; ievt<nevts; ievt++) {
-      const Event* ev  = events[ievt];
+      const Event* ev  = events.GetEvent(ievt);
       Int_t  cls = ev->GetClass();
 
       Double_t weight = ev->GetWeight();
@@ -440,6 +523,48 @@ TString TMVA::TransformationHandler::GetVariableAxisTitle( const VariableInfo& i
 /// - scatter plots for all pairs of input variables
 
 void TMVA::TransformationHandler::PlotVariables (const std::vector<Event*>& events, TDirectory* theDirectory )
+{
+   EventCursor cursor( events );
+   PlotVariables( cursor, theDirectory );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// same for the events stored in columns, to which the (prepared)
+/// transformations are applied first: in place on a copy of the columns if
+/// possible, otherwise on a copy of each row
+
+void TMVA::TransformationHandler::PlotVariables( const EventColumns& columns, TDirectory* theDirectory )
+{
+   if (fRootBaseDir==0 && theDirectory == 0) return;
+
+   if (fTransformations.GetEntries() <= 0) {
+      EventCursor cursor( columns );
+      PlotVariables( cursor, theDirectory );
+   }
+   else if (CanTransformColumns( columns )) {
+      EventColumns transformedColumns( columns );
+      TListIter trIt(&fTransformations);
+      std::vector<Int_t>::const_iterator rClsIt = fTransformationsReferenceClasses.begin();
+      while (VariableTransformBase *trf = (VariableTransformBase*) trIt()) {
+         trf->TransformColumns( transformedColumns, (*rClsIt) );
+         rClsIt++;
+      }
+      EventCursor cursor( transformedColumns );
+      PlotVariables( cursor, theDirectory );
+   }
+   else {
+      EventCursor cursor( columns );
+      std::vector<Event*> transformedEvents( cursor.GetNEvents() );
+      for (Long64_t ievt=0; ievt<cursor.GetNEvents(); ievt++)
+         transformedEvents[ievt] = new Event( *Transform( cursor.GetEvent(ievt) ) );
+      PlotVariables( transformedEvents, theDirectory );
+      for (UInt_t ievt=0; ievt<transformedEvents.size(); ievt++) delete transformedEvents[ievt];
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TMVA::TransformationHandler::PlotVariables( EventCursor& events, TDirectory* theDirectory )
 {
    if (fRootBaseDir==0 && theDirectory == 0) return;
 
@@ -603,7 +728,7 @@ void TMVA::TransformationHandler::PlotVariables (const std::vector<Event*>& even
       }
    }
 
-   UInt_t nevts = events.size();
+   UInt_t nevts = events.GetNEvents();
 
    // compute correlation coefficient between target value and variables (regression only)
    std::vector<Double_t> xregmean ( nvar+1, 0 );
@@ -613,7 +738,7 @@ void TMVA::TransformationHandler::PlotVariables (const std::vector<Event*>& even
    // fill the histograms (this approach should be faster than individual projection
    for (UInt_t ievt=0; ievt<nevts; ievt++) {
 
-      const Event* ev = events[ievt];
+      const Event* ev = events.GetEvent(ievt);
 
       Float_t weight = ev->GetWeight();
       Int_t   cls    = ev->GetClass();
@@ -32,6 +32,7 @@
 #include "TMVA/DataSet.h"
 #include "TMVA/DataSetInfo.h"
 #include "TMVA/Event.h"
+#include "TMVA/EventColumns.h"
 #include "TMVA/MsgLogger.h"
 #include "TMVA/Tools.h"
 #include "TMVA/Types.h"
@@ -41,10 +42,12 @@
 #include "TMatrixDBase.h"
 #include "TVectorD.h"
 #include "TVectorF.h"
+#include "TMath.h"
 
 #include <iostream>
 #include <iomanip>
 #include <cfloat>
+#include <algorithm>
 
 ClassImp(TMVA::VariableNormalizeTransform)
 
@@ -84,6 +87,23 @@ void TMVA::VariableNormalizeTransform::Initialize()
 /// prepare transformation
 
 Bool_t TMVA::VariableNormalizeTransform::PrepareTransformation (const std::vector<Event*>& events)
+{
+   EventCursor cursor( events );
+   return Prepare( cursor );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// prepare the transformation from the rows of the columns, without copying them
+
+Bool_t TMVA::VariableNormalizeTransform::PrepareColumnTransformation( const EventColumns& columns )
+{
+   EventCursor cursor( columns );
+   return Prepare( cursor );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Bool_t TMVA::VariableNormalizeTransform::Prepare( EventCursor& events )
 {
    if (!IsEnabled() || IsCreated()) return kTRUE;
 
@@ -154,6 +174,48 @@ const TMVA::Event* TMVA::VariableNormalizeTransform::Transform( const TMVA::Even
    return fTransformedEvent;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// apply the normalization transformation to all events of the columns, in
+/// place, with the same single precision arithmetic as Transform(); the
+/// rows are processed in blocks, each variable in one loop over the block
+
+void TMVA::VariableNormalizeTransform::TransformColumns( EventColumns& columns, Int_t cls ) const
+{
+   if (!IsCreated()) Log() << kFATAL << "Transformation not yet created" << Endl;
+
+   std::vector<UInt_t> getColumns, putColumns;
+   if (!GetColumns( columns, getColumns, putColumns ))
+      Log() << kFATAL << "The transformation " << GetName() << " cannot be applied to columns" << Endl;
+
+   if (cls < 0 || cls >= (int) fMin.size()) cls = fMin.size()-1;
+   const FloatVector& minVector = fMin.at(cls); 
+   const FloatVector& maxVector = fMax.at(cls);
+
+   const UInt_t   ncol    = getColumns.size();
+   const Long64_t nevents = columns.GetNEvents();
+   const Long64_t blockSize = 1024;
+   std::vector<Float_t> output( ncol*blockSize );
+
+   for (Long64_t start=0; start<nevents; start+=blockSize) {
+      const Long64_t nblock = TMath::Min( blockSize, nevents-start );
+
+      // the outputs of a block are written once all its inputs are read, as an
+      // input column may also be the output column of another variable
+      for (UInt_t iidx=0; iidx<ncol; iidx++) {
+         const Float_t  offset = minVector.at(iidx);
+         const Float_t  scale  = 1.0/(maxVector.at(iidx)-minVector.at(iidx));
+         const Float_t* x = columns.GetColumn( getColumns[iidx] ) + start;
+         Float_t*       y = &output[iidx*blockSize];
+         for (Long64_t i=0; i<nblock; i++) y[i] = (x[i]-offset)*scale * 2 - 1;
+      }
+      for (UInt_t iidx=0; iidx<ncol; iidx++) {
+         const Float_t* y = &output[iidx*blockSize];
+         Float_t*       x = columns.GetColumn( putColumns[iidx] ) + start;
+         std::copy( y, y+nblock, x );
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// apply the inverse transformation
 
@@ -202,10 +264,10 @@ const TMVA::Event* TMVA::VariableNormalizeTransform::InverseTransform(const TMVA
 ////////////////////////////////////////////////////////////////////////////////
 /// compute offset and scale from min and max
 
-void TMVA::VariableNormalizeTransform::CalcNormalizationParams( const std::vector< Event*>& events )
+void TMVA::VariableNormalizeTransform::CalcNormalizationParams( EventCursor& events )
 {
-   if (events.size() <= 1) 
-      Log() << kFATAL << "Not enough events (found " << events.size() << ") to calculate the normalization" << Endl;
+   if (events.GetNEvents() <= 1) 
+      Log() << kFATAL << "Not enough events (found " << events.GetNEvents() << ") to calculate the normalization" << Endl;
    
    FloatVector input; // will be filled with the selected variables, targets, (spectators)
    std::vector<Char_t> mask;
@@ -227,11 +289,10 @@ void TMVA::VariableNormalizeTransform::CalcNormalizationParams( const std::vecto
       }
    }
 
-   std::vector<Event*>::const_iterator evIt = events.begin();
-   for (;evIt!=events.end();evIt++) { // loop over all events
-      const TMVA::Event* event = (*evIt);   // get the event
+   for (Long64_t ievt=0; ievt<events.GetNEvents(); ievt++) { // loop over all events
+      const TMVA::Event* event = events.GetEvent(ievt);   // get the event
 
-      UInt_t cls = (*evIt)->GetClass(); // get the class of this event
+      UInt_t cls = event->GetClass(); // get the class of this event
 
       FloatVector& minVector = fMin.at(cls); 
       FloatVector& maxVector = fMax.at(cls);
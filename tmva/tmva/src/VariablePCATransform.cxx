@@ -31,6 +31,7 @@
 
 #include "TMVA/DataSet.h"
 #include "TMVA/Event.h"
+#include "TMVA/EventColumns.h"
 #include "TMVA/MsgLogger.h"
 #include "TMVA/Tools.h"
 #include "TMVA/Types.h"
@@ -40,6 +41,7 @@
 #include "TPrincipal.h"
 #include "TVectorD.h"
 #include "TVectorF.h"
+#include "TMath.h"
 
 #include <iostream>
 #include <iomanip>
@@ -82,6 +84,23 @@ void TMVA::VariablePCATransform::Initialize()
 /// and the normalization
 
 Bool_t TMVA::VariablePCATransform::PrepareTransformation (const std::vector<Event*>& events)
+{
+   EventCursor cursor( events );
+   return Prepare( cursor );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// same from the rows of the columns, without copying them
+
+Bool_t TMVA::VariablePCATransform::PrepareColumnTransformation( const EventColumns& columns )
+{
+   EventCursor cursor( columns );
+   return Prepare( cursor );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Bool_t TMVA::VariablePCATransform::Prepare( EventCursor& events )
 {
    Initialize();
 
@@ -163,6 +182,59 @@ const TMVA::Event* TMVA::VariablePCATransform::Transform( const Event* const ev,
    return fTransformedEvent;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// apply the principal component analysis to all events of the columns, in
+/// place. The rows are processed in blocks: the principal components of a
+/// block are accumulated over the input variables, in the order of X2P(),
+/// in loops over the rows of the block.
+
+void TMVA::VariablePCATransform::TransformColumns( EventColumns& columns, Int_t cls ) const
+{
+   if (!IsCreated()) Log() << kFATAL << "Transformation not yet created" << Endl;
+
+   std::vector<UInt_t> getColumns, putColumns;
+   if (!GetColumns( columns, getColumns, putColumns ))
+      Log() << kFATAL << "The transformation " << GetName() << " cannot be applied to columns" << Endl;
+
+   if (cls < 0 || cls >= (int) fMeanValues.size()) cls = fMeanValues.size()-1;
+   const TVectorD& meanValues   = *fMeanValues.at(cls);
+   const TMatrixD& eigenVectors = *fEigenVectors.at(cls);
+
+   const UInt_t   nInput  = getColumns.size();
+   const Long64_t nevents = columns.GetNEvents();
+   const Long64_t blockSize = 256;
+   std::vector<Double_t> diff( nInput*blockSize );
+   std::vector<Double_t> pc( blockSize );
+   std::vector<Float_t>  output( nInput*blockSize );
+
+   for (Long64_t start=0; start<nevents; start+=blockSize) {
+      const Long64_t nblock = TMath::Min( blockSize, nevents-start );
+
+      for (UInt_t j=0; j<nInput; j++) {
+         const Float_t* x    = columns.GetColumn( getColumns[j] ) + start;
+         const Double_t mean = meanValues(j);
+         Double_t*      d    = &diff[j*blockSize];
+         for (Long64_t k=0; k<nblock; k++) d[k] = ((Double_t)x[k]) - mean;
+      }
+
+      for (UInt_t i=0; i<nInput; i++) {
+         std::fill( pc.begin(), pc.begin()+nblock, 0. );
+         for (UInt_t j=0; j<nInput; j++) {
+            const Double_t  e = eigenVectors(j,i);
+            const Double_t* d = &diff[j*blockSize];
+            for (Long64_t k=0; k<nblock; k++) pc[k] += d[k] * e;
+         }
+         Float_t* y = &output[i*blockSize];
+         for (Long64_t k=0; k<nblock; k++) y[k] = pc[k];
+      }
+
+      for (UInt_t i=0; i<nInput; i++) {
+         const Float_t* y = &output[i*blockSize];
+         std::copy( y, y+nblock, columns.GetColumn( putColumns[i] ) + start );
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// apply the principal component analysis
 /// TODO: implementation of inverse transformation
@@ -198,7 +270,7 @@ const TMVA::Event* TMVA::VariablePCATransform::InverseTransform( const Event* co
 /// calculate the principal components for the signal and the background data
 /// it uses the MakePrincipal method of ROOT's TPrincipal class
 
-void TMVA::VariablePCATransform::CalculatePrincipalComponents( const std::vector< Event*>& events )
+void TMVA::VariablePCATransform::CalculatePrincipalComponents( EventCursor& events )
 {
    UInt_t nvars = 0, ntgts = 0, nspcts = 0;
    CountVariableTypes( nvars, ntgts, nspcts );
@@ -218,13 +290,13 @@ void TMVA::VariablePCATransform::CalculatePrincipalComponents( const std::vector
    // !! Not normalizing and not storing input data, for performance reasons. Should perhaps restore normalization.
    // But this can be done afterwards by adding a normalisation transformation (user defined)
 
-   Long64_t ievt, entries = events.size();
+   Long64_t ievt, entries = events.GetNEvents();
    Double_t *dvec = new Double_t[inputSize];
 
    std::vector<Float_t> input;
    std::vector<Char_t>  mask;
    for (ievt=0; ievt<entries; ievt++) {
-      const Event* ev = events[ievt];
+      const Event* ev = events.GetEvent(ievt);
       UInt_t cls = ev->GetClass();
 
       Bool_t hasMaskedEntries = GetInput( ev, input, mask );
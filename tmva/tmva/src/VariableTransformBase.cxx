@@ -29,6 +29,7 @@
 
 #include "TMVA/Config.h"
 #include "TMVA/DataSetInfo.h"
+#include "TMVA/EventColumns.h"
 #include "TMVA/MsgLogger.h"
 #include "TMVA/Ranking.h"
 #include "TMVA/Tools.h"
@@ -418,6 +419,109 @@ void TMVA::VariableTransformBase::SetOutput( Event* event, std::vector<Float_t>&
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// columns of the variables, targets and spectators the transformation
+/// reads (fGet) and writes (fPut, or fGet if not set); returns kFALSE if
+/// they are not all stored in the columns or if their numbers differ
+
+Bool_t TMVA::VariableTransformBase::GetColumns( const EventColumns& columns, std::vector<UInt_t>& getColumns,
+                                                std::vector<UInt_t>& putColumns ) const
+{
+   getColumns.clear();
+   putColumns.clear();
+
+   for (Int_t i=0; i<2; i++) {
+      const VectorOfCharAndInt& entries = (i==0 || fPut.empty()) ? fGet : fPut;
+      std::vector<UInt_t>& cols = (i==0) ? getColumns : putColumns;
+      for (ItVarTypeIdxConst itEntry = entries.begin(); itEntry != entries.end(); ++itEntry) {
+         const UInt_t idx = (*itEntry).second;
+         switch ((*itEntry).first) {
+         case 'v':
+            if (idx >= columns.GetNVariables()) return kFALSE;
+            cols.push_back( columns.VariableColumn(idx) );
+            break;
+         case 't':
+            if (idx >= columns.GetNTargets()) return kFALSE;
+            cols.push_back( columns.TargetColumn(idx) );
+            break;
+         case 's':
+            if (idx >= columns.GetNSpectators()) return kFALSE;
+            cols.push_back( columns.SpectatorColumn(idx) );
+            break;
+         default:
+            return kFALSE;
+         }
+      }
+   }
+   return getColumns.size() == putColumns.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// true if TransformColumns() can be applied to the columns: the transformed
+/// variables, targets and spectators must keep their place in the columns
+
+Bool_t TMVA::VariableTransformBase::CanTransformColumns( const EventColumns& columns ) const
+{
+   std::vector<UInt_t> getColumns, putColumns;
+   return GetColumns( columns, getColumns, putColumns );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// prepare the transformation from the events stored in columns. This
+/// implementation copies the rows into temporary events for
+/// PrepareTransformation(), as the transformation of an event collection
+/// does; the transformations computing their parameters in one pass
+/// override it and read the rows through an EventCursor.
+
+Bool_t TMVA::VariableTransformBase::PrepareColumnTransformation( const EventColumns& columns )
+{
+   // a created or disabled transformation does not read the events
+   std::vector<Event*> events;
+   if (IsEnabled() && !IsCreated()) {
+      EventCursor cursor( columns );
+      events.resize( cursor.GetNEvents() );
+      for (Long64_t ievt=0; ievt<cursor.GetNEvents(); ievt++) events[ievt] = new Event( *cursor.GetEvent(ievt) );
+   }
+
+   Bool_t prepared = PrepareTransformation( events );
+
+   for (UInt_t ievt=0; ievt<events.size(); ievt++) delete events[ievt];
+   return prepared;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// transform all events of the columns in place. This implementation
+/// transforms the events one by one through a view of their row; the
+/// transformations with a simple form override it with passes over whole
+/// columns.
+
+void TMVA::VariableTransformBase::TransformColumns( EventColumns& columns, Int_t cls ) const
+{
+   std::vector<UInt_t> getColumns, putColumns;
+   if (!GetColumns( columns, getColumns, putColumns ))
+      Log() << kFATAL << "The transformation " << GetName() << " cannot be applied to columns" << Endl;
+
+   const VectorOfCharAndInt& put = fPut.empty() ? fGet : fPut;
+   std::vector<Float_t> output( put.size() );
+
+   Event view;
+   for (Long64_t ievt=0; ievt<columns.GetNEvents(); ievt++) {
+      view.SetView( &columns, ievt );
+      const Event* trEv = Transform( &view, cls );
+
+      // all outputs are read before they are written: the transformed event may be the view
+      for (UInt_t i=0; i<put.size(); i++) {
+         const UInt_t idx = put[i].second;
+         switch (put[i].first) {
+         case 'v': output[i] = trEv->GetValue(idx);     break;
+         case 't': output[i] = trEv->GetTarget(idx);    break;
+         default:  output[i] = trEv->GetSpectator(idx); break;
+         }
+      }
+      for (UInt_t i=0; i<put.size(); i++) columns.SetValue( putColumns[i], ievt, output[i] );
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// count variables, targets and spectators
 